@@ -1,7 +1,10 @@
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
+#include <velox/formulas/array_kernels.h>
 #include <velox/formulas/xl-formula.h>
+#include <algorithm>
 #include <chrono>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -63,8 +66,9 @@ class JSValue {
 
     double asDate() const {
         if (value_.isDate()) {
-            auto time_t = std::chrono::system_clock::to_time_t(value_.asDate());
-            return static_cast<double>(time_t);
+            // JS dates are instants; read the floating date on the host's local clock
+            return static_cast<double>(
+                    dates::toUnixSeconds(value_.asDate(), TimeZonePolicy::LOCAL));
         }
         return 0.0;
     }
@@ -217,6 +221,71 @@ class JSEvaluationResult {
     }
 };
 
+/**
+ * @brief Convert formula references to a plain JS object
+ *
+ * Shape: { success, variables: string[], functions: string[], isVolatile, isPure, errors }
+ */
+static val convertReferences(const ParseResult& parsed) {
+    val jsObj = val::object();
+    val variables = val::array();
+    val functions = val::array();
+    val errors = val::array();
+
+    const auto& refs = parsed.getReferences();
+    for (size_t i = 0; i < refs.variables.size(); ++i) {
+        variables.set(i, refs.variables[i]);
+    }
+    for (size_t i = 0; i < refs.functions.size(); ++i) {
+        functions.set(i, refs.functions[i]);
+    }
+    for (size_t i = 0; i < parsed.getErrors().size(); ++i) {
+        errors.set(i, parsed.getErrors()[i].message);
+    }
+
+    jsObj.set("success", parsed.isSuccess());
+    jsObj.set("variables", variables);
+    jsObj.set("functions", functions);
+    jsObj.set("isVolatile", refs.is_volatile);
+    jsObj.set("isPure", parsed.isSuccess() && refs.is_pure);
+    jsObj.set("errors", errors);
+    return jsObj;
+}
+
+/**
+ * @brief Handle to a formula prepared once for repeated (column) evaluation
+ */
+class JSPreparedFormula {
+  private:
+    PreparedFormula prepared_;
+
+  public:
+    JSPreparedFormula(PreparedFormula prepared) : prepared_(std::move(prepared)) {}
+
+    bool isSuccess() const {
+        return prepared_.isSuccess();
+    }
+
+    std::string getFormula() const {
+        return prepared_.getFormula();
+    }
+
+    val analyze() const {
+        val jsObj = val::object();
+        val variables = val::array();
+        const auto& refs = prepared_.getReferences();
+        for (size_t i = 0; i < refs.variables.size(); ++i) {
+            variables.set(i, refs.variables[i]);
+        }
+        jsObj.set("variables", variables);
+        return jsObj;
+    }
+
+    const PreparedFormula& get() const {
+        return prepared_;
+    }
+};
+
 /**
  * @brief JavaScript-friendly wrapper for the FormulaEngine
  */
@@ -245,11 +314,28 @@ class JSFormulaEngine {
     }
 
     JSValue getVariable(const std::string& name) const {
-        auto context = engine_.getContext();
-        if (context.hasVariable(name)) {
-            return JSValue(context.getVariable(name));
+        const Value* value = engine_.findVariable(name);
+        return value != nullptr ? JSValue(*value) : JSValue();
+    }
+
+    // Number, date serial or 1/0 of a variable without wrapping it; NaN otherwise
+    double getNumberVariable(const std::string& name) const {
+        const Value* value = engine_.findVariable(name);
+        if (value != nullptr && (value->isNumber() || value->isDate() || value->isBoolean())) {
+            return value->toNumber();
         }
-        return JSValue();  // empty value
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    /**
+     * Read variables as numbers into a Float64Array in WASM memory
+     *
+     * out is the byte offset into HEAPF64's buffer of one double per name; see
+     * FormulaEngine::getVariables for the encoding. Returns the number of NaN entries.
+     */
+    unsigned getVariables(const val& names, uintptr_t out) const {
+        return static_cast<unsigned>(engine_.getVariables(vecFromJSArray<std::string>(names),
+                                                          reinterpret_cast<double*>(out)));
     }
 
     bool hasVariable(const std::string& name) const {
@@ -292,6 +378,42 @@ class JSFormulaEngine {
         return JSEvaluationResult(engine_.evaluate(formula, overrides));
     }
 
+    // Parse and fold a formula once for evaluateColumns
+    JSPreparedFormula prepare(const std::string& formula) const {
+        return JSPreparedFormula(engine_.prepare(formula));
+    }
+
+    /**
+     * Evaluate a prepared formula over Float64Array columns living in WASM memory
+     *
+     * columns holds the byte offset into HEAPF64's buffer of each column (one per name),
+     * out the byte offset of the rows doubles receiving the results. The whole column is
+     * evaluated in this one call; see FormulaEngine::evaluateColumns for the encoding.
+     * threads caps the worker threads of the threaded module (at most its pool size);
+     * other builds evaluate on the calling thread. Returns the number of rows whose
+     * result was not a number.
+     */
+    unsigned evaluateColumns(const JSPreparedFormula& prepared, const val& names,
+                             const val& columns, unsigned rows, uintptr_t out,
+                             unsigned threads) {
+        const auto column_names = vecFromJSArray<std::string>(names);
+        const auto offsets = vecFromJSArray<uintptr_t>(columns);
+        std::vector<const double*> buffers;
+        buffers.reserve(offsets.size());
+        for (uintptr_t offset : offsets) {
+            buffers.push_back(reinterpret_cast<const double*>(offset));
+        }
+        return static_cast<unsigned>(engine_.evaluateColumns(prepared.get(), column_names,
+                                                             buffers, rows,
+                                                             reinterpret_cast<double*>(out),
+                                                             std::max(1u, threads)));
+    }
+
+    // Dependency analysis (variables, functions, volatility) without evaluation
+    val analyze(const std::string& formula) const {
+        return convertReferences(xl_formula::parse(formula));
+    }
+
     // Trace-enabled evaluation for tooling
     val evaluateWithTrace(const std::string& formula) {
         std::unique_ptr<TraceNode> trace_root;
@@ -314,10 +436,46 @@ JSEvaluationResult quickEvaluate(const std::string& formula) {
     return JSEvaluationResult(xl_formula::evaluate(formula));
 }
 
+val quickAnalyze(const std::string& formula) {
+    return convertReferences(xl_formula::parse(formula));
+}
+
 std::string getVersion() {
     return Version::toString();
 }
 
+// "simd128" for the SIMD build of the module, "scalar" for the baseline one
+std::string getSimdTarget() {
+    return kernels::simdTarget();
+}
+
+// True for the threaded (-pthread) build of the module
+bool isThreaded() {
+#if defined(__EMSCRIPTEN_PTHREADS__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Side modules (formulas-<name>.wasm) holding functions a formula calls that are not
+// loaded yet; always empty outside the split build, where every module is linked in
+val getMissingModules(const std::string& formula) {
+    using namespace functions::dispatcher;
+    val modules = val::array();
+    unsigned count = 0;
+    bool listed[kFunctionModuleCount] = {};
+    for (const auto& name : xl_formula::parse(formula).getReferences().functions) {
+        FunctionModule module;
+        if (find_function_module(name, module) && !is_function_module_loaded(module) &&
+            !listed[static_cast<size_t>(module)]) {
+            listed[static_cast<size_t>(module)] = true;
+            modules.set(count++, std::string(function_module_name(module)));
+        }
+    }
+    return modules;
+}
+
 // Emscripten bindings
 EMSCRIPTEN_BINDINGS(velox_formulas) {
     // JSValue class
@@ -357,6 +515,12 @@ EMSCRIPTEN_BINDINGS(velox_formulas) {
             .function("getErrorMessage", &JSEvaluationResult::getErrorMessage)
             .function("getErrors", &JSEvaluationResult::getErrors);
 
+    // JSPreparedFormula class
+    class_<JSPreparedFormula>("PreparedFormula")
+            .function("isSuccess", &JSPreparedFormula::isSuccess)
+            .function("getFormula", &JSPreparedFormula::getFormula)
+            .function("analyze", &JSPreparedFormula::analyze);
+
     // JSFormulaEngine class
     class_<JSFormulaEngine>("FormulaEngine")
             .constructor<>()
@@ -365,16 +529,25 @@ EMSCRIPTEN_BINDINGS(velox_formulas) {
             .function("setTextVariable", &JSFormulaEngine::setTextVariable)
             .function("setBooleanVariable", &JSFormulaEngine::setBooleanVariable)
             .function("getVariable", &JSFormulaEngine::getVariable)
+            .function("getNumberVariable", &JSFormulaEngine::getNumberVariable)
+            .function("getVariables", &JSFormulaEngine::getVariables)
             .function("hasVariable", &JSFormulaEngine::hasVariable)
             .function("removeVariable", &JSFormulaEngine::removeVariable)
             .function("clearVariables", &JSFormulaEngine::clearVariables)
             .function("evaluate", &JSFormulaEngine::evaluate)
             .function("evaluateWithVariables", &JSFormulaEngine::evaluateWithVariables)
+            .function("prepare", &JSFormulaEngine::prepare)
+            .function("evaluateColumns", &JSFormulaEngine::evaluateColumns)
+            .function("analyze", &JSFormulaEngine::analyze)
             .function("evaluateWithTrace", &JSFormulaEngine::evaluateWithTrace);
 
     // Standalone functions
     function("evaluate", &quickEvaluate);
+    function("analyze", &quickAnalyze);
     function("getVersion", &getVersion);
+    function("getSimdTarget", &getSimdTarget);
+    function("isThreaded", &isThreaded);
+    function("getMissingModules", &getMissingModules);
 
     // Vector bindings for arrays
     register_vector<std::string>("StringVector");
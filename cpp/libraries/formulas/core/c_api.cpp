@@ -0,0 +1,245 @@
+#include "velox/formulas/c_api.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+#include "velox/formulas/xl-formula.h"
+
+using namespace xl_formula;
+
+struct velox_engine {
+    FormulaEngine engine;
+};
+
+struct velox_prepared {
+    PreparedFormula formula;
+};
+
+namespace {
+
+velox_status statusOf(ErrorType error) {
+    switch (error) {
+        case ErrorType::NONE:
+            return VELOX_OK;
+        case ErrorType::DIV_ZERO:
+            return VELOX_DIV_ZERO;
+        case ErrorType::VALUE_ERROR:
+            return VELOX_VALUE_ERROR;
+        case ErrorType::REF_ERROR:
+            return VELOX_REF_ERROR;
+        case ErrorType::NAME_ERROR:
+            return VELOX_NAME_ERROR;
+        case ErrorType::NUM_ERROR:
+            return VELOX_NUM_ERROR;
+        case ErrorType::NA_ERROR:
+            return VELOX_NA_ERROR;
+        case ErrorType::PARSE_ERROR:
+            return VELOX_PARSE_ERROR;
+    }
+    return VELOX_INTERNAL_ERROR;
+}
+
+/**
+ * @brief Number and status of a value, encoded as in FormulaEngine::evaluateColumns()
+ */
+velox_status toNumber(const Value& value, double& number) {
+    if (value.isNumber() || value.isDate() || value.isBoolean()) {
+        number = value.toNumber();
+        return VELOX_OK;
+    }
+    number = std::numeric_limits<double>::quiet_NaN();
+    return value.isError() ? statusOf(value.asError()) : VELOX_NOT_NUMBER;
+}
+
+/// Set a variable, keeping exceptions on this side of the interface
+velox_status setVariable(velox_engine* engine, const char* name, const Value& value) {
+    if (engine == nullptr || name == nullptr) {
+        return VELOX_INVALID_ARGUMENT;
+    }
+    try {
+        engine->engine.setVariable(name, value);
+        return VELOX_OK;
+    } catch (...) {
+        return VELOX_INTERNAL_ERROR;
+    }
+}
+
+/// Fill a batch's output buffers with one status
+size_t failRows(size_t rows, double* out, velox_status* codes, velox_status status) {
+    if (out != nullptr) {
+        std::fill(out, out + rows, std::numeric_limits<double>::quiet_NaN());
+    }
+    if (codes != nullptr) {
+        std::fill(codes, codes + rows, status);
+    }
+    return rows;
+}
+
+}  // anonymous namespace
+
+extern "C" {
+
+uint32_t velox_api_version(void) {
+    return VELOX_C_API_VERSION;
+}
+
+velox_engine* velox_engine_create(void) {
+    try {
+        return new velox_engine();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void velox_engine_destroy(velox_engine* engine) {
+    delete engine;
+}
+
+velox_status velox_engine_set_number(velox_engine* engine, const char* name, double value) {
+    return setVariable(engine, name, Value(value));
+}
+
+velox_status velox_engine_set_text(velox_engine* engine, const char* name, const char* value) {
+    if (value == nullptr) {
+        return VELOX_INVALID_ARGUMENT;
+    }
+    return setVariable(engine, name, Value(value));
+}
+
+velox_status velox_engine_set_boolean(velox_engine* engine, const char* name, int value) {
+    return setVariable(engine, name, Value(value != 0));
+}
+
+velox_status velox_engine_remove(velox_engine* engine, const char* name) {
+    if (engine == nullptr || name == nullptr) {
+        return VELOX_INVALID_ARGUMENT;
+    }
+    try {
+        engine->engine.getContext().removeVariable(name);
+        return VELOX_OK;
+    } catch (...) {
+        return VELOX_INTERNAL_ERROR;
+    }
+}
+
+size_t velox_engine_get_numbers(const velox_engine* engine, const char* const* names,
+                                size_t count, double* out, velox_status* codes) {
+    if (engine == nullptr || (count > 0 && (names == nullptr || out == nullptr))) {
+        return failRows(count, out, codes, VELOX_INVALID_ARGUMENT);
+    }
+    try {
+        size_t non_numeric = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const Value* value =
+                    names[i] == nullptr ? nullptr : engine->engine.findVariable(names[i]);
+            velox_status status = VELOX_NOT_NUMBER;
+            if (value == nullptr) {
+                out[i] = std::numeric_limits<double>::quiet_NaN();
+            } else {
+                status = toNumber(*value, out[i]);
+            }
+            non_numeric += status != VELOX_OK;
+            if (codes != nullptr) {
+                codes[i] = status;
+            }
+        }
+        return non_numeric;
+    } catch (...) {
+        return failRows(count, out, codes, VELOX_INTERNAL_ERROR);
+    }
+}
+
+velox_prepared* velox_prepare(const velox_engine* engine, const char* formula) {
+    if (engine == nullptr || formula == nullptr) {
+        return nullptr;
+    }
+    try {
+        return new velox_prepared{engine->engine.prepare(formula)};
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void velox_prepared_destroy(velox_prepared* prepared) {
+    delete prepared;
+}
+
+velox_status velox_prepared_status(const velox_prepared* prepared) {
+    if (prepared == nullptr) {
+        return VELOX_INVALID_ARGUMENT;
+    }
+    return prepared->formula.isSuccess() ? VELOX_OK : VELOX_PARSE_ERROR;
+}
+
+size_t velox_prepared_variable_count(const velox_prepared* prepared) {
+    return prepared == nullptr ? 0 : prepared->formula.getReferences().variables.size();
+}
+
+const char* velox_prepared_variable_name(const velox_prepared* prepared, size_t index) {
+    if (prepared == nullptr) {
+        return nullptr;
+    }
+    const auto& variables = prepared->formula.getReferences().variables;
+    return index < variables.size() ? variables[index].c_str() : nullptr;
+}
+
+velox_status velox_evaluate(velox_engine* engine, const velox_prepared* prepared, double* out) {
+    if (engine == nullptr || prepared == nullptr || out == nullptr) {
+        failRows(1, out, nullptr, VELOX_INVALID_ARGUMENT);
+        return VELOX_INVALID_ARGUMENT;
+    }
+    if (!prepared->formula.isSuccess()) {
+        *out = std::numeric_limits<double>::quiet_NaN();
+        return VELOX_PARSE_ERROR;
+    }
+    try {
+        return toNumber(engine->engine.evaluate(prepared->formula).getValue(), *out);
+    } catch (...) {
+        *out = std::numeric_limits<double>::quiet_NaN();
+        return VELOX_INTERNAL_ERROR;
+    }
+}
+
+size_t velox_evaluate_columns(velox_engine* engine, const velox_prepared* prepared,
+                              const char* const* names, const double* const* columns,
+                              size_t column_count, size_t rows, double* out,
+                              velox_status* codes, unsigned threads) {
+    if (engine == nullptr || prepared == nullptr || (rows > 0 && out == nullptr) ||
+        (column_count > 0 && (names == nullptr || columns == nullptr))) {
+        return failRows(rows, out, codes, VELOX_INVALID_ARGUMENT);
+    }
+    try {
+        std::vector<std::string> column_names;
+        std::vector<const double*> column_data(columns, columns + column_count);
+        column_names.reserve(column_count);
+        for (size_t c = 0; c < column_count; ++c) {
+            if (names[c] == nullptr || (rows > 0 && columns[c] == nullptr)) {
+                return failRows(rows, out, codes, VELOX_INVALID_ARGUMENT);
+            }
+            column_names.emplace_back(names[c]);
+        }
+
+        // Count failures from the row statuses whether or not the caller wants them, so a
+        // NaN result is a failure either way
+        std::vector<ErrorType> errors(rows);
+        engine->engine.evaluateColumns(prepared->formula, column_names, column_data, rows, out,
+                                       threads, errors.data());
+        size_t failed = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            velox_status status = statusOf(errors[i]);
+            if (status == VELOX_OK && std::isnan(out[i])) {
+                status = VELOX_NOT_NUMBER;
+            }
+            if (codes != nullptr) {
+                codes[i] = status;
+            }
+            failed += status != VELOX_OK;
+        }
+        return failed;
+    } catch (...) {
+        return failRows(rows, out, codes, VELOX_INTERNAL_ERROR);
+    }
+}
+
+}  // extern "C"
@@ -1,4 +1,7 @@
 #include "velox/formulas/types.h"
+#include "velox/formulas/business_calendar.h"
+#include "velox/formulas/lookup_index.h"
+#include "velox/formulas/statistical_utils.h"
 
 namespace xl_formula {
 
@@ -15,6 +18,16 @@ Value Context::getVariable(const std::string& name) const {
     return Value::empty();
 }
 
+const Value* Context::findVariable(const std::string& name) const {
+    auto it = variables_.find(name);
+    return it != variables_.end() ? &it->second : nullptr;
+}
+
+Value* Context::findVariable(const std::string& name) {
+    auto it = variables_.find(name);
+    return it != variables_.end() ? &it->second : nullptr;
+}
+
 bool Context::hasVariable(const std::string& name) const {
     return variables_.find(name) != variables_.end();
 }
@@ -25,6 +38,15 @@ void Context::removeVariable(const std::string& name) {
 
 void Context::clear() {
     variables_.clear();
+    if (lookup_cache_) {
+        lookup_cache_->clear();
+    }
+    if (sorted_cache_) {
+        sorted_cache_->clear();
+    }
+    if (calendar_cache_) {
+        calendar_cache_->clear();
+    }
 }
 
 std::vector<std::string> Context::getVariableNames() const {
@@ -36,4 +58,33 @@ std::vector<std::string> Context::getVariableNames() const {
     return names;
 }
 
+lookup::LookupIndexCache& Context::getLookupCache() const {
+    if (!lookup_cache_) {
+        lookup_cache_ = std::make_shared<lookup::LookupIndexCache>();
+    }
+    return *lookup_cache_;
+}
+
+void Context::setTimeZonePolicy(TimeZonePolicy policy) {
+    time_zone_ = policy;
+}
+
+TimeZonePolicy Context::getTimeZonePolicy() const {
+    return time_zone_;
+}
+
+statistics::SortedArrayCache& Context::getSortedArrayCache() const {
+    if (!sorted_cache_) {
+        sorted_cache_ = std::make_shared<statistics::SortedArrayCache>();
+    }
+    return *sorted_cache_;
+}
+
+dates::BusinessCalendarCache& Context::getCalendarCache() const {
+    if (!calendar_cache_) {
+        calendar_cache_ = std::make_shared<dates::BusinessCalendarCache>();
+    }
+    return *calendar_cache_;
+}
+
 }  // namespace xl_formula
\ No newline at end of file
@@ -1,7 +1,10 @@
 #include "velox/formulas/types.h"
+#include <algorithm>
+#include <cstdio>
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
+#include "velox/formulas/civil_date.h"
 
 namespace xl_formula {
 
@@ -42,18 +45,38 @@ ErrorType Value::asError() const {
 }
 
 const std::vector<Value>& Value::asArray() const {
+    return asArrayData().values();
+}
+
+const ArrayData& Value::asArrayData() const {
     if (type_ != ValueType::ARRAY) {
         throw std::runtime_error("Value is not an array");
     }
     return *std::get<ArrayType>(data_);
 }
 
+const Value::ArrayType& Value::asArrayPtr() const {
+    if (type_ != ValueType::ARRAY) {
+        throw std::runtime_error("Value is not an array");
+    }
+    return std::get<ArrayType>(data_);
+}
+
+Value::Value(const std::vector<Value>& array)
+    : data_(ArrayData::fromValues(array)), type_(ValueType::ARRAY) {}
+
+Value Value::numberArray(std::vector<double> numbers) {
+    return Value(ArrayData::fromNumbers(std::move(numbers)));
+}
+
 bool Value::canConvertToNumber() const {
     switch (type_) {
         case ValueType::NUMBER:
             return true;
         case ValueType::BOOLEAN:
             return true;
+        case ValueType::DATE:
+            return true;
         case ValueType::TEXT: {
             const auto& text = std::get<std::string>(data_);
             try {
@@ -74,6 +97,8 @@ double Value::toNumber() const {
             return std::get<double>(data_);
         case ValueType::BOOLEAN:
             return std::get<bool>(data_) ? 1.0 : 0.0;
+        case ValueType::DATE:
+            return std::get<DateType>(data_).serial;
         case ValueType::TEXT: {
             const auto& text = std::get<std::string>(data_);
             try {
@@ -110,11 +135,12 @@ std::string Value::toString() const {
             return std::get<bool>(data_) ? "TRUE" : "FALSE";
         case ValueType::DATE: {
             // Format date and time - always include time for consistency
-            auto time_t = std::chrono::system_clock::to_time_t(std::get<DateType>(data_));
-            auto local_tm = *std::localtime(&time_t);
-            std::ostringstream oss;
-            oss << std::put_time(&local_tm, "%Y-%m-%d %H:%M:%S");
-            return oss.str();
+            auto fields = dates::splitDate(std::get<DateType>(data_));
+            char buffer[40];
+            std::snprintf(buffer, sizeof(buffer), "%04lld-%02u-%02u %02u:%02u:%02u",
+                          static_cast<long long>(fields.date.year), fields.date.month,
+                          fields.date.day, fields.hour, fields.minute, fields.second);
+            return buffer;
         }
         case ValueType::ERROR:
             switch (std::get<ErrorType>(data_)) {
@@ -142,7 +168,7 @@ std::string Value::toString() const {
             for (size_t i = 0; i < arr.size(); ++i) {
                 if (i > 0)
                     oss << ", ";
-                oss << arr[i].toString();
+                oss << arr.at(i).toString();
             }
             oss << "}";
             return oss.str();
@@ -154,16 +180,50 @@ std::string Value::toString() const {
     }
 }
 
+namespace {
+
+/// Dates are serial numbers, so they compare with numbers by value
+bool isSerial(ValueType type) {
+    return type == ValueType::NUMBER || type == ValueType::DATE;
+}
+
+}  // anonymous namespace
+
 bool Value::operator==(const Value& other) const {
     if (type_ != other.type_) {
-        return false;
+        return isSerial(type_) && isSerial(other.type_) && toNumber() == other.toNumber();
+    }
+    if (type_ == ValueType::ARRAY) {
+        // Arrays compare by contents, not by shared storage
+        const auto& lhs = *std::get<ArrayType>(data_);
+        const auto& rhs = *std::get<ArrayType>(other.data_);
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        if (lhs.isNumeric() && rhs.isNumeric()) {
+            NumberSpan a = lhs.numbers();
+            return std::equal(a.begin(), a.end(), rhs.numbers().begin());
+        }
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            if (!(lhs.at(i) == rhs.at(i))) {
+                return false;
+            }
+        }
+        return true;
     }
     return data_ == other.data_;
 }
 
 bool Value::operator<(const Value& other) const {
     if (type_ != other.type_) {
-        return static_cast<int>(type_) < static_cast<int>(other.type_);
+        if (isSerial(type_) && isSerial(other.type_)) {
+            return toNumber() < other.toNumber();
+        }
+        // Dates rank with numbers, so mixed orderings stay transitive
+        auto rank = [](ValueType type) {
+            return static_cast<int>(type == ValueType::DATE ? ValueType::NUMBER : type);
+        };
+        return rank(type_) < rank(other.type_);
     }
 
     switch (type_) {
@@ -177,7 +237,8 @@ bool Value::operator<(const Value& other) const {
             return std::get<DateType>(data_) < std::get<DateType>(other.data_);
         case ValueType::ARRAY:
             // Arrays compare lexicographically
-            return *std::get<ArrayType>(data_) < *std::get<ArrayType>(other.data_);
+            return std::get<ArrayType>(data_)->values() <
+                   std::get<ArrayType>(other.data_)->values();
         default:
             return false;
     }
@@ -195,4 +256,82 @@ bool Value::operator>=(const Value& other) const {
     return !(*this < other);
 }
 
+std::shared_ptr<const ArrayData> ArrayData::fromValues(const std::vector<Value>& elements) {
+    auto data = std::make_shared<ArrayData>();
+    size_t numbers = 0;
+    size_t packable = 0;
+    for (const auto& element : elements) {
+        if (element.isNumber()) {
+            ++numbers;
+            ++packable;
+        } else if (element.isError() || element.isEmpty()) {
+            ++packable;
+        }
+    }
+
+    // Dates stay generic: packed slots read back as plain numbers and would lose the type
+    if (numbers == 0 || packable != elements.size()) {
+        data->storage_ = Storage::GENERIC;
+        data->values_ = elements;
+        return data;
+    }
+
+    data->numbers_.resize(elements.size());
+    if (numbers == elements.size()) {
+        data->storage_ = Storage::NUMERIC;
+        for (size_t i = 0; i < elements.size(); ++i) {
+            data->numbers_[i] = elements[i].asNumber();
+        }
+        return data;
+    }
+
+    data->storage_ = Storage::MASKED;
+    data->non_numeric_.assign((elements.size() + 63) / 64, 0);
+    for (size_t i = 0; i < elements.size(); ++i) {
+        const Value& element = elements[i];
+        if (element.isNumber()) {
+            data->numbers_[i] = element.asNumber();
+        } else {
+            data->non_numeric_[i / 64] |= uint64_t{1} << (i % 64);
+            ErrorType code = element.isError() ? element.asError() : ErrorType::NONE;
+            data->numbers_[i] = static_cast<double>(static_cast<int>(code));
+        }
+    }
+    return data;
+}
+
+std::shared_ptr<const ArrayData> ArrayData::fromNumbers(std::vector<double> numbers) {
+    auto data = std::make_shared<ArrayData>();
+    data->storage_ = Storage::NUMERIC;
+    data->numbers_ = std::move(numbers);
+    return data;
+}
+
+Value ArrayData::at(size_t index) const {
+    switch (storage_) {
+        case Storage::NUMERIC:
+            return Value(numbers_[index]);
+        case Storage::MASKED:
+            if (isMasked(index)) {
+                auto code = static_cast<ErrorType>(static_cast<int>(numbers_[index]));
+                return code == ErrorType::NONE ? Value::empty() : Value::error(code);
+            }
+            return Value(numbers_[index]);
+        default:
+            return values_[index];
+    }
+}
+
+const std::vector<Value>& ArrayData::values() const {
+    if (storage_ != Storage::GENERIC) {
+        std::call_once(values_once_, [this]() {
+            values_.reserve(numbers_.size());
+            for (size_t i = 0; i < numbers_.size(); ++i) {
+                values_.push_back(at(i));
+            }
+        });
+    }
+    return values_;
+}
+
 }  // namespace xl_formula
\ No newline at end of file
@@ -0,0 +1,716 @@
+#include "velox/formulas/array_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define VELOX_KERNELS_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define VELOX_KERNELS_SSE2 1
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define VELOX_KERNELS_SIMD128 1
+#endif
+
+namespace xl_formula {
+namespace kernels {
+
+namespace {
+
+using Op = BinaryOpNode::Operator;
+
+#if defined(VELOX_KERNELS_AVX)
+
+struct Lanes {
+    using V = __m256d;
+    static constexpr size_t width = 4;
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+    static V splat(double d) { return _mm256_set1_pd(d); }
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm256_div_pd(a, b); }
+    // Comparison masks are all-ones lanes; AND with 1.0 turns them into 1.0 / 0.0
+    static V mask(V m) { return _mm256_and_pd(m, _mm256_set1_pd(1.0)); }
+    static V eq(V a, V b) { return mask(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+    static V ne(V a, V b) { return mask(_mm256_cmp_pd(a, b, _CMP_NEQ_UQ)); }
+    static V lt(V a, V b) { return mask(_mm256_cmp_pd(a, b, _CMP_LT_OQ)); }
+    static V le(V a, V b) { return mask(_mm256_cmp_pd(a, b, _CMP_LE_OQ)); }
+    static V gt(V a, V b) { return mask(_mm256_cmp_pd(a, b, _CMP_GT_OQ)); }
+    static V ge(V a, V b) { return mask(_mm256_cmp_pd(a, b, _CMP_GE_OQ)); }
+};
+#define VELOX_KERNELS_SIMD 1
+constexpr const char* kTarget = "avx";
+
+#elif defined(VELOX_KERNELS_SSE2)
+
+struct Lanes {
+    using V = __m128d;
+    static constexpr size_t width = 2;
+    static V load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, V v) { _mm_storeu_pd(p, v); }
+    static V splat(double d) { return _mm_set1_pd(d); }
+    static V add(V a, V b) { return _mm_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm_div_pd(a, b); }
+    static V mask(V m) { return _mm_and_pd(m, _mm_set1_pd(1.0)); }
+    static V eq(V a, V b) { return mask(_mm_cmpeq_pd(a, b)); }
+    static V ne(V a, V b) { return mask(_mm_cmpneq_pd(a, b)); }
+    static V lt(V a, V b) { return mask(_mm_cmplt_pd(a, b)); }
+    static V le(V a, V b) { return mask(_mm_cmple_pd(a, b)); }
+    static V gt(V a, V b) { return mask(_mm_cmpgt_pd(a, b)); }
+    static V ge(V a, V b) { return mask(_mm_cmpge_pd(a, b)); }
+};
+#define VELOX_KERNELS_SIMD 1
+constexpr const char* kTarget = "sse2";
+
+#elif defined(VELOX_KERNELS_SIMD128)
+
+struct Lanes {
+    using V = v128_t;
+    static constexpr size_t width = 2;
+    static V load(const double* p) { return wasm_v128_load(p); }
+    static void store(double* p, V v) { wasm_v128_store(p, v); }
+    static V splat(double d) { return wasm_f64x2_splat(d); }
+    static V add(V a, V b) { return wasm_f64x2_add(a, b); }
+    static V sub(V a, V b) { return wasm_f64x2_sub(a, b); }
+    static V mul(V a, V b) { return wasm_f64x2_mul(a, b); }
+    static V div(V a, V b) { return wasm_f64x2_div(a, b); }
+    static V mask(V m) { return wasm_v128_and(m, wasm_f64x2_splat(1.0)); }
+    static V eq(V a, V b) { return mask(wasm_f64x2_eq(a, b)); }
+    static V ne(V a, V b) { return mask(wasm_f64x2_ne(a, b)); }
+    static V lt(V a, V b) { return mask(wasm_f64x2_lt(a, b)); }
+    static V le(V a, V b) { return mask(wasm_f64x2_le(a, b)); }
+    static V gt(V a, V b) { return mask(wasm_f64x2_gt(a, b)); }
+    static V ge(V a, V b) { return mask(wasm_f64x2_ge(a, b)); }
+};
+#define VELOX_KERNELS_SIMD 1
+constexpr const char* kTarget = "simd128";
+
+#else
+constexpr const char* kTarget = "scalar";
+#endif
+
+#if defined(VELOX_KERNELS_SIMD)
+#define VELOX_LANE_OP(NAME, EXPR, LANE_FN)                                      \
+    struct NAME {                                                               \
+        static double scalar(double a, double b) { return EXPR; }               \
+        static Lanes::V vec(Lanes::V a, Lanes::V b) { return Lanes::LANE_FN(a, b); } \
+    };
+#else
+#define VELOX_LANE_OP(NAME, EXPR, LANE_FN)                        \
+    struct NAME {                                                 \
+        static double scalar(double a, double b) { return EXPR; } \
+    };
+#endif
+
+VELOX_LANE_OP(AddOp, a + b, add)
+VELOX_LANE_OP(SubOp, a - b, sub)
+VELOX_LANE_OP(MulOp, a * b, mul)
+VELOX_LANE_OP(DivOp, a / b, div)
+VELOX_LANE_OP(EqOp, a == b ? 1.0 : 0.0, eq)
+VELOX_LANE_OP(NeOp, a != b ? 1.0 : 0.0, ne)
+VELOX_LANE_OP(LtOp, a < b ? 1.0 : 0.0, lt)
+VELOX_LANE_OP(LeOp, a <= b ? 1.0 : 0.0, le)
+VELOX_LANE_OP(GtOp, a > b ? 1.0 : 0.0, gt)
+VELOX_LANE_OP(GeOp, a >= b ? 1.0 : 0.0, ge)
+
+#undef VELOX_LANE_OP
+
+template <typename LaneOp>
+void loopArrayArray(const double* a, const double* b, double* out, size_t n) {
+    size_t i = 0;
+#if defined(VELOX_KERNELS_SIMD)
+    for (; i + Lanes::width <= n; i += Lanes::width) {
+        Lanes::store(out + i, LaneOp::vec(Lanes::load(a + i), Lanes::load(b + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = LaneOp::scalar(a[i], b[i]);
+    }
+}
+
+template <typename LaneOp>
+void loopArrayScalar(const double* a, double b, double* out, size_t n) {
+    size_t i = 0;
+#if defined(VELOX_KERNELS_SIMD)
+    const Lanes::V vb = Lanes::splat(b);
+    for (; i + Lanes::width <= n; i += Lanes::width) {
+        Lanes::store(out + i, LaneOp::vec(Lanes::load(a + i), vb));
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = LaneOp::scalar(a[i], b);
+    }
+}
+
+template <typename LaneOp>
+void loopScalarArray(double a, const double* b, double* out, size_t n) {
+    size_t i = 0;
+#if defined(VELOX_KERNELS_SIMD)
+    const Lanes::V va = Lanes::splat(a);
+    for (; i + Lanes::width <= n; i += Lanes::width) {
+        Lanes::store(out + i, LaneOp::vec(va, Lanes::load(b + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = LaneOp::scalar(a, b[i]);
+    }
+}
+
+/**
+ * @brief Invoke f with the lane functor for op; returns false for operators without one
+ */
+template <typename F>
+bool withLaneOp(Op op, F&& f) {
+    switch (op) {
+        case Op::ADD:
+            f(AddOp{});
+            return true;
+        case Op::SUBTRACT:
+            f(SubOp{});
+            return true;
+        case Op::MULTIPLY:
+            f(MulOp{});
+            return true;
+        case Op::DIVIDE:
+            f(DivOp{});
+            return true;
+        case Op::EQUAL:
+            f(EqOp{});
+            return true;
+        case Op::NOT_EQUAL:
+            f(NeOp{});
+            return true;
+        case Op::LESS_THAN:
+            f(LtOp{});
+            return true;
+        case Op::LESS_EQUAL:
+            f(LeOp{});
+            return true;
+        case Op::GREATER_THAN:
+            f(GtOp{});
+            return true;
+        case Op::GREATER_EQUAL:
+            f(GeOp{});
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Map a double to an unsigned key with the same ordering (-0 sorts as 0)
+ */
+uint64_t orderedBits(double value, bool descending) {
+    if (value == 0.0) {
+        value = 0.0;
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    // Negative numbers: flip every bit; positive: flip the sign bit
+    bits = (bits & 0x8000000000000000ULL) ? ~bits : bits | 0x8000000000000000ULL;
+    return descending ? ~bits : bits;
+}
+
+// Below this size a comparison sort beats the radix histogram passes
+constexpr size_t kRadixThreshold = 256;
+constexpr int kDigitBits = 11;
+constexpr size_t kBuckets = size_t{1} << kDigitBits;
+
+/**
+ * @brief Stable LSD radix sort of records by their key() bits
+ */
+template <typename Record, typename KeyOf>
+void radixSort(std::vector<Record>& records, KeyOf key) {
+    const size_t n = records.size();
+    std::vector<Record> scratch(n);
+    std::vector<size_t> counts(kBuckets);
+    for (int shift = 0; shift < 64; shift += kDigitBits) {
+        std::fill(counts.begin(), counts.end(), 0);
+        for (const auto& record : records) {
+            ++counts[(key(record) >> shift) & (kBuckets - 1)];
+        }
+        // Every key has the same digit: this pass would not move anything
+        if (counts[(key(records[0]) >> shift) & (kBuckets - 1)] == n) {
+            continue;
+        }
+        size_t offset = 0;
+        for (auto& count : counts) {
+            size_t bucket = count;
+            count = offset;
+            offset += bucket;
+        }
+        for (const auto& record : records) {
+            scratch[counts[(key(record) >> shift) & (kBuckets - 1)]++] = record;
+        }
+        records.swap(scratch);
+    }
+}
+
+/// Elements per block of the moment kernels; a block stays in L1 between its two sweeps
+constexpr size_t kMomentBlock = 256;
+
+#if defined(VELOX_KERNELS_SIMD)
+double reduceLanes(Lanes::V v) {
+    double lanes[Lanes::width];
+    Lanes::store(lanes, v);
+    double total = 0.0;
+    for (double lane : lanes) {
+        total += lane;
+    }
+    return total;
+}
+#endif
+
+/**
+ * @brief Sum of a block, with two independent vector accumulators
+ */
+double blockSum(const double* v, size_t n) {
+    size_t i = 0;
+    double total = 0.0;
+#if defined(VELOX_KERNELS_SIMD)
+    Lanes::V acc0 = Lanes::splat(0.0);
+    Lanes::V acc1 = Lanes::splat(0.0);
+    for (; i + 2 * Lanes::width <= n; i += 2 * Lanes::width) {
+        acc0 = Lanes::add(acc0, Lanes::load(v + i));
+        acc1 = Lanes::add(acc1, Lanes::load(v + i + Lanes::width));
+    }
+    total = reduceLanes(Lanes::add(acc0, acc1));
+#endif
+    for (; i < n; ++i) {
+        total += v[i];
+    }
+    return total;
+}
+
+/**
+ * @brief Sum of (v[i] - mean)^2 over a block
+ */
+double blockSquaredDeviations(const double* v, size_t n, double mean) {
+    size_t i = 0;
+    double total = 0.0;
+#if defined(VELOX_KERNELS_SIMD)
+    const Lanes::V vmean = Lanes::splat(mean);
+    Lanes::V acc0 = Lanes::splat(0.0);
+    Lanes::V acc1 = Lanes::splat(0.0);
+    for (; i + 2 * Lanes::width <= n; i += 2 * Lanes::width) {
+        Lanes::V d0 = Lanes::sub(Lanes::load(v + i), vmean);
+        Lanes::V d1 = Lanes::sub(Lanes::load(v + i + Lanes::width), vmean);
+        acc0 = Lanes::add(acc0, Lanes::mul(d0, d0));
+        acc1 = Lanes::add(acc1, Lanes::mul(d1, d1));
+    }
+    total = reduceLanes(Lanes::add(acc0, acc1));
+#endif
+    for (; i < n; ++i) {
+        const double d = v[i] - mean;
+        total += d * d;
+    }
+    return total;
+}
+
+/**
+ * @brief Sum of (x[i] - mean_x) * (y[i] - mean_y) over a block
+ */
+double blockCrossDeviations(const double* x, const double* y, size_t n, double mean_x,
+                            double mean_y) {
+    size_t i = 0;
+    double total = 0.0;
+#if defined(VELOX_KERNELS_SIMD)
+    const Lanes::V vmx = Lanes::splat(mean_x);
+    const Lanes::V vmy = Lanes::splat(mean_y);
+    Lanes::V acc = Lanes::splat(0.0);
+    for (; i + Lanes::width <= n; i += Lanes::width) {
+        acc = Lanes::add(acc, Lanes::mul(Lanes::sub(Lanes::load(x + i), vmx),
+                                         Lanes::sub(Lanes::load(y + i), vmy)));
+    }
+    total = reduceLanes(acc);
+#endif
+    for (; i < n; ++i) {
+        total += (x[i] - mean_x) * (y[i] - mean_y);
+    }
+    return total;
+}
+
+// Terms of the sum reductions, as scalar and lane functions of the element index
+
+struct ValueTerm {
+    const double* v;
+    double scalar(size_t i) const { return v[i]; }
+#if defined(VELOX_KERNELS_SIMD)
+    Lanes::V vec(size_t i) const { return Lanes::load(v + i); }
+#endif
+};
+
+struct SquareTerm {
+    const double* v;
+    double scalar(size_t i) const { return v[i] * v[i]; }
+#if defined(VELOX_KERNELS_SIMD)
+    Lanes::V vec(size_t i) const {
+        const Lanes::V x = Lanes::load(v + i);
+        return Lanes::mul(x, x);
+    }
+#endif
+};
+
+struct ProductTerm {
+    const double* a;
+    const double* b;
+    double scalar(size_t i) const { return a[i] * b[i]; }
+#if defined(VELOX_KERNELS_SIMD)
+    Lanes::V vec(size_t i) const { return Lanes::mul(Lanes::load(a + i), Lanes::load(b + i)); }
+#endif
+};
+
+template <PairTerm T>
+struct PairTermOf {
+    const double* x;
+    const double* y;
+    double scalar(size_t i) const {
+        if (T == PairTerm::X_MINUS_Y_SQUARED) {
+            const double d = x[i] - y[i];
+            return d * d;
+        }
+        const double x2 = x[i] * x[i];
+        const double y2 = y[i] * y[i];
+        return T == PairTerm::X2_MINUS_Y2 ? x2 - y2 : x2 + y2;
+    }
+#if defined(VELOX_KERNELS_SIMD)
+    Lanes::V vec(size_t i) const {
+        const Lanes::V vx = Lanes::load(x + i);
+        const Lanes::V vy = Lanes::load(y + i);
+        if (T == PairTerm::X_MINUS_Y_SQUARED) {
+            const Lanes::V d = Lanes::sub(vx, vy);
+            return Lanes::mul(d, d);
+        }
+        const Lanes::V x2 = Lanes::mul(vx, vx);
+        const Lanes::V y2 = Lanes::mul(vy, vy);
+        return T == PairTerm::X2_MINUS_Y2 ? Lanes::sub(x2, y2) : Lanes::add(x2, y2);
+    }
+#endif
+};
+
+/**
+ * @brief Sum of terms with four independent accumulators to hide add latency
+ */
+template <typename Term>
+double reduceFast(const Term& term, size_t n) {
+    size_t i = 0;
+    double total = 0.0;
+#if defined(VELOX_KERNELS_SIMD)
+    constexpr size_t w = Lanes::width;
+    Lanes::V acc0 = Lanes::splat(0.0);
+    Lanes::V acc1 = Lanes::splat(0.0);
+    Lanes::V acc2 = Lanes::splat(0.0);
+    Lanes::V acc3 = Lanes::splat(0.0);
+    for (; i + 4 * w <= n; i += 4 * w) {
+        acc0 = Lanes::add(acc0, term.vec(i));
+        acc1 = Lanes::add(acc1, term.vec(i + w));
+        acc2 = Lanes::add(acc2, term.vec(i + 2 * w));
+        acc3 = Lanes::add(acc3, term.vec(i + 3 * w));
+    }
+    total = reduceLanes(Lanes::add(Lanes::add(acc0, acc1), Lanes::add(acc2, acc3)));
+#else
+    double acc[4] = {0.0, 0.0, 0.0, 0.0};
+    for (; i + 4 <= n; i += 4) {
+        acc[0] += term.scalar(i);
+        acc[1] += term.scalar(i + 1);
+        acc[2] += term.scalar(i + 2);
+        acc[3] += term.scalar(i + 3);
+    }
+    total = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+#endif
+    for (; i < n; ++i) {
+        total += term.scalar(i);
+    }
+    return total;
+}
+
+/**
+ * @brief Knuth's TwoSum: adds t to sum and accumulates the exact rounding error
+ *
+ * Branch-free and valid for any magnitudes, so it vectorizes where Neumaier's
+ * magnitude test would not.
+ */
+inline void twoSum(double& sum, double& error, double t) {
+    const double s = sum + t;
+    const double virtual_b = s - sum;
+    error += (sum - (s - virtual_b)) + (t - virtual_b);
+    sum = s;
+}
+
+template <typename Term>
+double reduceCompensated(const Term& term, size_t n) {
+    size_t i = 0;
+    double sum = 0.0;
+    double error = 0.0;
+#if defined(VELOX_KERNELS_SIMD)
+    constexpr size_t w = Lanes::width;
+    Lanes::V sums[2] = {Lanes::splat(0.0), Lanes::splat(0.0)};
+    Lanes::V errors[2] = {Lanes::splat(0.0), Lanes::splat(0.0)};
+    for (; i + 2 * w <= n; i += 2 * w) {
+        for (size_t k = 0; k < 2; ++k) {
+            const Lanes::V t = term.vec(i + k * w);
+            const Lanes::V s = Lanes::add(sums[k], t);
+            const Lanes::V virtual_b = Lanes::sub(s, sums[k]);
+            errors[k] = Lanes::add(errors[k],
+                                   Lanes::add(Lanes::sub(sums[k], Lanes::sub(s, virtual_b)),
+                                              Lanes::sub(t, virtual_b)));
+            sums[k] = s;
+        }
+    }
+    // Fold the lane sums together without losing their errors
+    double lanes[2 * w];
+    Lanes::store(lanes, sums[0]);
+    Lanes::store(lanes + w, sums[1]);
+    for (double lane : lanes) {
+        twoSum(sum, error, lane);
+    }
+    error += reduceLanes(Lanes::add(errors[0], errors[1]));
+#endif
+    for (; i < n; ++i) {
+        twoSum(sum, error, term.scalar(i));
+    }
+    return sum + error;
+}
+
+template <typename Term>
+double reduce(const Term& term, size_t n, Summation mode) {
+    return mode == Summation::COMPENSATED ? reduceCompensated(term, n) : reduceFast(term, n);
+}
+
+}  // namespace
+
+Summation defaultSummation() {
+#if defined(VELOX_COMPENSATED_SUM)
+    return Summation::COMPENSATED;
+#else
+    return Summation::FAST;
+#endif
+}
+
+double sum(const double* values, size_t n, Summation mode) {
+    return reduce(ValueTerm{values}, n, mode);
+}
+
+double sumSquares(const double* values, size_t n, Summation mode) {
+    return reduce(SquareTerm{values}, n, mode);
+}
+
+double dotProduct(const double* a, const double* b, size_t n, Summation mode) {
+    return reduce(ProductTerm{a, b}, n, mode);
+}
+
+double sumPairs(const double* x, const double* y, size_t n, PairTerm term, Summation mode) {
+    switch (term) {
+        case PairTerm::X2_MINUS_Y2:
+            return reduce(PairTermOf<PairTerm::X2_MINUS_Y2>{x, y}, n, mode);
+        case PairTerm::X2_PLUS_Y2:
+            return reduce(PairTermOf<PairTerm::X2_PLUS_Y2>{x, y}, n, mode);
+        default:
+            return reduce(PairTermOf<PairTerm::X_MINUS_Y_SQUARED>{x, y}, n, mode);
+    }
+}
+
+void Moments::merge(const Moments& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    const double n_a = static_cast<double>(count);
+    const double n_b = static_cast<double>(other.count);
+    const double n = n_a + n_b;
+    const double delta = other.mean - mean;
+    mean += delta * (n_b / n);
+    m2 += other.m2 + delta * delta * (n_a * n_b / n);
+    count += other.count;
+}
+
+void CoMoments::merge(const CoMoments& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    const double n_a = static_cast<double>(count);
+    const double n_b = static_cast<double>(other.count);
+    const double n = n_a + n_b;
+    const double weight = n_a * n_b / n;
+    const double delta_x = other.mean_x - mean_x;
+    const double delta_y = other.mean_y - mean_y;
+    mean_x += delta_x * (n_b / n);
+    mean_y += delta_y * (n_b / n);
+    m2_x += other.m2_x + delta_x * delta_x * weight;
+    m2_y += other.m2_y + delta_y * delta_y * weight;
+    c_xy += other.c_xy + delta_x * delta_y * weight;
+    count += other.count;
+}
+
+Moments moments(const double* values, size_t n) {
+    Moments result;
+    for (size_t start = 0; start < n; start += kMomentBlock) {
+        const size_t length = std::min(kMomentBlock, n - start);
+        const double* block = values + start;
+        Moments part;
+        part.count = length;
+        part.mean = blockSum(block, length) / static_cast<double>(length);
+        part.m2 = blockSquaredDeviations(block, length, part.mean);
+        result.merge(part);
+    }
+    return result;
+}
+
+CoMoments coMoments(const double* x, const double* y, size_t n) {
+    CoMoments result;
+    for (size_t start = 0; start < n; start += kMomentBlock) {
+        const size_t length = std::min(kMomentBlock, n - start);
+        const double* bx = x + start;
+        const double* by = y + start;
+        CoMoments part;
+        part.count = length;
+        part.mean_x = blockSum(bx, length) / static_cast<double>(length);
+        part.mean_y = blockSum(by, length) / static_cast<double>(length);
+        part.m2_x = blockSquaredDeviations(bx, length, part.mean_x);
+        part.m2_y = blockSquaredDeviations(by, length, part.mean_y);
+        part.c_xy = blockCrossDeviations(bx, by, length, part.mean_x, part.mean_y);
+        result.merge(part);
+    }
+    return result;
+}
+
+bool hasNumericKernel(BinaryOpNode::Operator op) {
+    return op != Op::CONCAT;
+}
+
+bool isComparison(BinaryOpNode::Operator op) {
+    switch (op) {
+        case Op::EQUAL:
+        case Op::NOT_EQUAL:
+        case Op::LESS_THAN:
+        case Op::LESS_EQUAL:
+        case Op::GREATER_THAN:
+        case Op::GREATER_EQUAL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void binaryArrayArray(BinaryOpNode::Operator op, const double* a, const double* b, double* out,
+                      size_t n) {
+    if (op == Op::POWER) {
+        // No vector pow; the scalar loop is still free of Value boxing
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = std::pow(a[i], b[i]);
+        }
+        return;
+    }
+    withLaneOp(op, [&](auto lane_op) { loopArrayArray<decltype(lane_op)>(a, b, out, n); });
+}
+
+void binaryArrayScalar(BinaryOpNode::Operator op, const double* a, double b, double* out,
+                       size_t n) {
+    if (op == Op::POWER) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = std::pow(a[i], b);
+        }
+        return;
+    }
+    withLaneOp(op, [&](auto lane_op) { loopArrayScalar<decltype(lane_op)>(a, b, out, n); });
+}
+
+void binaryScalarArray(BinaryOpNode::Operator op, double a, const double* b, double* out,
+                       size_t n) {
+    if (op == Op::POWER) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = std::pow(a, b[i]);
+        }
+        return;
+    }
+    withLaneOp(op, [&](auto lane_op) { loopScalarArray<decltype(lane_op)>(a, b, out, n); });
+}
+
+void sortNumbers(double* values, size_t n, bool descending) {
+    if (n < kRadixThreshold) {
+        if (descending) {
+            std::stable_sort(values, values + n, [](double a, double b) { return a > b; });
+        } else {
+            std::stable_sort(values, values + n);
+        }
+        return;
+    }
+    std::vector<uint64_t> keys(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = orderedBits(values[i], false);
+    }
+    radixSort(keys, [](uint64_t key) { return key; });
+    // Undo the key mapping; equal keys are indistinguishable so order is free
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t bits = keys[descending ? n - 1 - i : i];
+        bits = (bits & 0x8000000000000000ULL) ? bits & ~0x8000000000000000ULL : ~bits;
+        std::memcpy(&values[i], &bits, sizeof(bits));
+    }
+}
+
+void sortOrder(const double* keys, size_t n, bool descending, std::vector<size_t>& order) {
+    order.resize(n);
+    std::iota(order.begin(), order.end(), size_t{0});
+    if (n < kRadixThreshold) {
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return descending ? keys[a] > keys[b] : keys[a] < keys[b];
+        });
+        return;
+    }
+
+    struct Record {
+        uint64_t key;
+        size_t index;
+    };
+    std::vector<Record> records(n);
+    for (size_t i = 0; i < n; ++i) {
+        records[i] = Record{orderedBits(keys[i], descending), i};
+    }
+    radixSort(records, [](const Record& record) { return record.key; });
+    for (size_t i = 0; i < n; ++i) {
+        order[i] = records[i].index;
+    }
+}
+
+size_t compactNumbers(const double* values, const uint64_t* mask, size_t n, double* out) {
+    size_t written = 0;
+    for (size_t base = 0; base < n; base += 64) {
+        const uint64_t word = mask[base / 64];
+        const size_t count = std::min<size_t>(64, n - base);
+        if (word == 0) {
+            continue;
+        }
+        if (count == 64 && word == ~uint64_t{0}) {
+            std::memcpy(out + written, values + base, 64 * sizeof(double));
+            written += 64;
+            continue;
+        }
+        // Branch-free: always store, advance only past kept elements
+        for (size_t j = 0; j < count; ++j) {
+            out[written] = values[base + j];
+            written += (word >> j) & 1u;
+        }
+    }
+    return written;
+}
+
+const char* simdTarget() {
+    return kTarget;
+}
+
+}  // namespace kernels
+}  // namespace xl_formula
@@ -1,6 +1,7 @@
 #include "velox/formulas/evaluator.h"
 #include <algorithm>
 #include <cmath>
+#include "velox/formulas/array_kernels.h"
 #include "velox/formulas/functions.h"
 #include "velox/formulas/parser.h"
 
@@ -17,16 +18,22 @@ bool FunctionRegistry::hasFunction(const std::string& name) const {
     std::string upper_name = name;
     std::transform(upper_name.begin(), upper_name.end(), upper_name.begin(), ::toupper);
 
-    // Check if it's a built-in function using perfect hash dispatcher
-    Value test_result = functions::dispatcher::dispatch_builtin_function(upper_name, {}, Context());
-    if (!test_result.isEmpty()) {
-        return true;  // Built-in function exists
+    if (isBuiltinFunction(upper_name)) {
+        return true;
     }
 
     // Check custom functions
     return functions_.find(upper_name) != functions_.end();
 }
 
+bool FunctionRegistry::isBuiltinFunction(const std::string& name) const {
+    std::string upper_name = name;
+    std::transform(upper_name.begin(), upper_name.end(), upper_name.begin(), ::toupper);
+
+    // Check if it's a built-in function using perfect hash dispatcher
+    return functions::dispatcher::is_builtin_function(upper_name);
+}
+
 Value FunctionRegistry::callFunction(const std::string& name, const std::vector<Value>& args,
                                      const Context& context) const {
     std::string upper_name = name;
@@ -86,8 +93,7 @@ EvaluationResult Evaluator::evaluate(const ASTNode& node) {
     trace_root_.reset();
 
     try {
-        // Use const_cast to work around visitor pattern const issues
-        const_cast<ASTNode&>(node).accept(*this);
+        evaluateNode(node);
 
         EvaluationResult result(result_, warnings_);
         return result;
@@ -116,6 +122,36 @@ EvaluationResult Evaluator::evaluateWithTrace(const ASTNode& node,
     }
 }
 
+void Evaluator::setSubexpressionPlan(const SubexpressionPlan* plan) {
+    plan_ = (plan && !plan->empty()) ? plan : nullptr;
+    clearSubexpressionCache();
+}
+
+void Evaluator::clearSubexpressionCache() {
+    size_t slots = plan_ ? plan_->getSlotCount() : 0;
+    memo_values_.assign(slots, Value::empty());
+    memo_ready_.assign(slots, false);
+}
+
+void Evaluator::evaluateNode(const ASTNode& node) {
+    // Shared subexpressions are computed once; tracing always walks the full tree
+    if (plan_ && !tracing_enabled_) {
+        long slot = plan_->slotFor(node);
+        if (slot >= 0) {
+            if (memo_ready_[slot]) {
+                result_ = memo_values_[slot];
+                return;
+            }
+            // Use const_cast to work around visitor pattern const issues
+            const_cast<ASTNode&>(node).accept(*this);
+            memo_values_[slot] = result_;
+            memo_ready_[slot] = true;
+            return;
+        }
+    }
+    const_cast<ASTNode&>(node).accept(*this);
+}
+
 TraceNode* Evaluator::beginTraceNode(const std::string& kind, const std::string& label) {
     if (!tracing_enabled_)
         return nullptr;
@@ -165,11 +201,11 @@ void Evaluator::visit(const VariableNode& node) {
 void Evaluator::visit(const BinaryOpNode& node) {
     TraceNode* t = beginTraceNode("BinaryOp", BinaryOpNode::operatorToString(node.getOperator()));
     // Evaluate left operand
-    const_cast<ASTNode&>(node.getLeft()).accept(*this);
+    evaluateNode(node.getLeft());
     Value left = result_;
 
     // Evaluate right operand
-    const_cast<ASTNode&>(node.getRight()).accept(*this);
+    evaluateNode(node.getRight());
     Value right = result_;
 
     result_ = performBinaryOperation(node.getOperator(), left, right);
@@ -180,7 +216,7 @@ void Evaluator::visit(const BinaryOpNode& node) {
 void Evaluator::visit(const UnaryOpNode& node) {
     std::string op = (node.getOperator() == UnaryOpNode::Operator::PLUS) ? "+" : "-";
     TraceNode* t = beginTraceNode("UnaryOp", op);
-    const_cast<ASTNode&>(node.getOperand()).accept(*this);
+    evaluateNode(node.getOperand());
     Value operand = result_;
 
     result_ = performUnaryOperation(node.getOperator(), operand);
@@ -197,7 +233,7 @@ void Evaluator::visit(const ArrayNode& node) {
     elements.reserve(node.getElements().size());
 
     for (const auto& element : node.getElements()) {
-        const_cast<ASTNode&>(*element).accept(*this);
+        evaluateNode(*element);
         elements.push_back(result_);
     }
 
@@ -214,7 +250,7 @@ void Evaluator::visit(const FunctionCallNode& node) {
 
     // Evaluate all arguments
     for (const auto& arg : node.getArguments()) {
-        const_cast<ASTNode&>(*arg).accept(*this);
+        evaluateNode(*arg);
         args.push_back(result_);
     }
 
@@ -232,17 +268,32 @@ Value Evaluator::performBinaryOperation(BinaryOpNode::Operator op, const Value&
     if (right.isError())
         return right;
 
+    // Element-wise broadcasting over array operands
+    if (left.isArray() || right.isArray()) {
+        return performArrayOperation(op, left, right);
+    }
+
     switch (op) {
         case BinaryOpNode::Operator::ADD: {
             if (left.canConvertToNumber() && right.canConvertToNumber()) {
-                return Value(left.toNumber() + right.toNumber());
+                double sum = left.toNumber() + right.toNumber();
+                // A date moved by a number of days is still a date
+                if (left.isDate() != right.isDate()) {
+                    return Value(Value::DateType(sum));
+                }
+                return Value(sum);
             }
             return Value::error(ErrorType::VALUE_ERROR);
         }
 
         case BinaryOpNode::Operator::SUBTRACT: {
             if (left.canConvertToNumber() && right.canConvertToNumber()) {
-                return Value(left.toNumber() - right.toNumber());
+                double difference = left.toNumber() - right.toNumber();
+                // date - days is a date; date - date is a number of days
+                if (left.isDate() && !right.isDate()) {
+                    return Value(Value::DateType(difference));
+                }
+                return Value(difference);
             }
             return Value::error(ErrorType::VALUE_ERROR);
         }
@@ -311,6 +362,90 @@ Value Evaluator::performBinaryOperation(BinaryOpNode::Operator op, const Value&
     }
 }
 
+Value Evaluator::performArrayOperation(BinaryOpNode::Operator op, const Value& left,
+                                       const Value& right) {
+    const ArrayData* left_data = left.isArray() ? &left.asArrayData() : nullptr;
+    const ArrayData* right_data = right.isArray() ? &right.asArrayData() : nullptr;
+    const size_t left_size = left_data ? left_data->size() : 1;
+    const size_t right_size = right_data ? right_data->size() : 1;
+    if (left_size == 0 || right_size == 0) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+
+    // Single-element arrays broadcast like scalars
+    const bool left_scalar = left_size == 1;
+    const bool right_scalar = right_size == 1;
+    const Value left_one = left_data ? left_data->at(0) : left;
+    const Value right_one = right_data ? right_data->at(0) : right;
+    const size_t size = std::max(left_size, right_size);
+
+    // Fast path: packed numeric operands run through the kernels without copying
+    const bool shapes_match = left_scalar || right_scalar || left_size == right_size;
+    const bool left_packed = left_scalar ? left_one.isNumber() : left_data->isNumeric();
+    const bool right_packed = right_scalar ? right_one.isNumber() : right_data->isNumeric();
+    if (kernels::hasNumericKernel(op) && shapes_match && size > 1 && left_packed && right_packed) {
+        std::vector<double> out(size);
+        NumberSpan a = left_scalar ? NumberSpan() : left_data->numbers();
+        NumberSpan b = right_scalar ? NumberSpan() : right_data->numbers();
+        if (left_scalar) {
+            kernels::binaryScalarArray(op, left_one.asNumber(), b.data(), out.data(), size);
+        } else if (right_scalar) {
+            kernels::binaryArrayScalar(op, a.data(), right_one.asNumber(), out.data(), size);
+        } else {
+            kernels::binaryArrayArray(op, a.data(), b.data(), out.data(), size);
+        }
+
+        if (kernels::isComparison(op)) {
+            std::vector<Value> results;
+            results.reserve(size);
+            for (double d : out) {
+                results.emplace_back(d != 0.0);
+            }
+            return Value::array(results);
+        }
+
+        // Map IEEE results back to formula errors; stay packed when there are none
+        auto is_error = [&](size_t i) {
+            if (op == BinaryOpNode::Operator::DIVIDE) {
+                return (right_scalar ? right_one.asNumber() : b[i]) == 0.0;
+            }
+            if (op == BinaryOpNode::Operator::POWER) {
+                return std::isnan(out[i]) || std::isinf(out[i]);
+            }
+            return false;
+        };
+        size_t first_error = 0;
+        while (first_error < size && !is_error(first_error)) {
+            ++first_error;
+        }
+        if (first_error == size) {
+            return Value::numberArray(std::move(out));
+        }
+        const ErrorType error = op == BinaryOpNode::Operator::DIVIDE ? ErrorType::DIV_ZERO
+                                                                     : ErrorType::NUM_ERROR;
+        std::vector<Value> results;
+        results.reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            results.push_back(i >= first_error && is_error(i) ? Value::error(error) : Value(out[i]));
+        }
+        return Value::array(results);
+    }
+
+    // Generic path: per-element scalar semantics; positions past the shorter array are #N/A
+    std::vector<Value> results;
+    results.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        if ((!left_scalar && i >= left_size) || (!right_scalar && i >= right_size)) {
+            results.push_back(Value::error(ErrorType::NA_ERROR));
+            continue;
+        }
+        Value l = left_scalar ? left_one : left_data->at(i);
+        Value r = right_scalar ? right_one : right_data->at(i);
+        results.push_back(performBinaryOperation(op, l, r));
+    }
+    return Value::array(results);
+}
+
 Value Evaluator::performUnaryOperation(UnaryOpNode::Operator op, const Value& operand) {
     if (operand.isError())
         return operand;
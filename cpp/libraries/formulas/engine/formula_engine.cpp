@@ -1,8 +1,69 @@
 #include "velox/formulas/evaluator.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <thread>
 #include "velox/formulas/parser.h"
 
 namespace xl_formula {
 
+namespace {
+
+/**
+ * @brief Numeric encoding of a value for the typed-array entry points
+ * @return false for values with no number (written as NaN)
+ */
+bool toColumnNumber(const Value& value, double& number) {
+    if (value.isNumber() || value.isDate() || value.isBoolean()) {
+        number = value.toNumber();
+        return true;
+    }
+    number = std::numeric_limits<double>::quiet_NaN();
+    return false;
+}
+
+/**
+ * @brief Evaluate rows [begin, end) of a column batch, binding the columns in context
+ * @return Number of rows written as NaN
+ */
+size_t evaluateRows(Context& context, const FunctionRegistry* registry,
+                    const PreparedFormula& prepared, const std::vector<std::string>& names,
+                    const std::vector<const double*>& columns, size_t begin, size_t end,
+                    double* out, ErrorType* errors) {
+    for (const auto& name : names) {
+        context.setVariable(name, Value(0.0));
+    }
+    // All columns are bound now, so their slots stay put and rows are assigned in place
+    std::vector<Value*> slots;
+    slots.reserve(names.size());
+    for (const auto& name : names) {
+        slots.push_back(context.findVariable(name));
+    }
+
+    Evaluator evaluator(context, registry);
+    evaluator.setSubexpressionPlan(prepared.getPlan());
+    size_t non_numeric = 0;
+    for (size_t row = begin; row < end; ++row) {
+        for (size_t c = 0; c < slots.size(); ++c) {
+            *slots[c] = Value(columns[c][row]);
+        }
+        // Shared subexpressions depend on the row's variables
+        evaluator.clearSubexpressionCache();
+        auto result = evaluator.evaluate(*prepared.getAST());
+        if (!result.isSuccess() || !toColumnNumber(result.getValue(), out[row])) {
+            out[row] = std::numeric_limits<double>::quiet_NaN();
+            ++non_numeric;
+        }
+        if (errors) {
+            const Value& value = result.getValue();
+            errors[row] = value.isError() ? value.asError() : ErrorType::NONE;
+        }
+    }
+    return non_numeric;
+}
+
+}  // anonymous namespace
+
 // FormulaEngine implementation
 FormulaEngine::FormulaEngine() {
     function_registry_ = FunctionRegistry::createDefault();
@@ -43,11 +104,11 @@ EvaluationResult FormulaEngine::evaluate(const std::string& formula,
 
     // Apply overrides into the engine context
     for (const auto& [name, val] : overrides) {
-        Value prior = context_.getVariable(name);
-        if (prior.isEmpty()) {
+        const Value* prior = context_.findVariable(name);
+        if (prior == nullptr || prior->isEmpty()) {
             keys_to_clear.push_back(name);
         } else {
-            original_values.emplace_back(name, prior);
+            original_values.emplace_back(name, *prior);
         }
         context_.setVariable(name, val);
     }
@@ -81,6 +142,157 @@ EvaluationResult FormulaEngine::evaluateWithTrace(const std::string& formula,
     return evaluator.evaluateWithTrace(*parse_result.getAST(), out_trace_root);
 }
 
+PreparedFormula FormulaEngine::prepare(const std::string& formula) const {
+    PreparedFormula prepared;
+    prepared.formula_ = formula;
+
+    Parser parser;
+    auto parse_result = parser.parse(formula);
+    if (!parse_result.isSuccess()) {
+        prepared.errors_ = parse_result.getErrors();
+        return prepared;
+    }
+
+    prepared.ast_ = foldConstants(*parse_result.getAST(), {}, *function_registry_);
+    prepared.references_ = FormulaReferences::collect(*prepared.ast_);
+    prepared.plan_ = std::make_shared<const SubexpressionPlan>(
+            SubexpressionPlan::build({prepared.ast_.get()}, *function_registry_));
+    return prepared;
+}
+
+PreparedFormula FormulaEngine::specialize(
+        const PreparedFormula& prepared,
+        const std::unordered_map<std::string, Value>& known_variables) const {
+    if (!prepared.isSuccess()) {
+        return prepared;
+    }
+
+    PreparedFormula specialized;
+    specialized.formula_ = prepared.formula_;
+    specialized.ast_ = foldConstants(*prepared.getAST(), known_variables, *function_registry_);
+    specialized.references_ = FormulaReferences::collect(*specialized.ast_);
+    specialized.plan_ = std::make_shared<const SubexpressionPlan>(
+            SubexpressionPlan::build({specialized.ast_.get()}, *function_registry_));
+    return specialized;
+}
+
+PreparedBatch FormulaEngine::prepareBatch(const std::vector<std::string>& formulas) const {
+    PreparedBatch batch;
+    batch.formulas_.reserve(formulas.size());
+
+    std::vector<const ASTNode*> roots;
+    roots.reserve(formulas.size());
+    for (const auto& formula : formulas) {
+        batch.formulas_.push_back(prepare(formula));
+        roots.push_back(batch.formulas_.back().getAST());
+    }
+
+    batch.plan_ = std::make_shared<const SubexpressionPlan>(
+            SubexpressionPlan::build(roots, *function_registry_));
+    return batch;
+}
+
+EvaluationResult FormulaEngine::evaluate(const PreparedFormula& prepared) {
+    if (!prepared.isSuccess()) {
+        return EvaluationResult::error(ErrorType::PARSE_ERROR);
+    }
+
+    Evaluator evaluator(context_, function_registry_.get());
+    evaluator.setSubexpressionPlan(prepared.getPlan());
+    return evaluator.evaluate(*prepared.getAST());
+}
+
+std::vector<EvaluationResult> FormulaEngine::evaluateBatch(const PreparedBatch& batch) {
+    std::vector<EvaluationResult> results;
+    results.reserve(batch.size());
+
+    // One evaluator for the whole batch so shared subexpressions are memoized across formulas
+    Evaluator evaluator(context_, function_registry_.get());
+    evaluator.setSubexpressionPlan(batch.getPlan());
+    for (const auto& prepared : batch.getFormulas()) {
+        if (!prepared.isSuccess()) {
+            results.push_back(EvaluationResult::error(ErrorType::PARSE_ERROR));
+            continue;
+        }
+        results.push_back(evaluator.evaluate(*prepared.getAST()));
+    }
+    return results;
+}
+
+size_t FormulaEngine::evaluateColumns(const PreparedFormula& prepared,
+                                      const std::vector<std::string>& names,
+                                      const std::vector<const double*>& columns, size_t rows,
+                                      double* out) {
+    return evaluateColumns(prepared, names, columns, rows, out, 1);
+}
+
+size_t FormulaEngine::evaluateColumns(const PreparedFormula& prepared,
+                                      const std::vector<std::string>& names,
+                                      const std::vector<const double*>& columns, size_t rows,
+                                      double* out, unsigned threads, ErrorType* errors) {
+    if (!prepared.isSuccess() || names.size() != columns.size()) {
+        std::fill(out, out + rows, std::numeric_limits<double>::quiet_NaN());
+        if (errors) {
+            std::fill(errors, errors + rows,
+                      prepared.isSuccess() ? ErrorType::VALUE_ERROR : ErrorType::PARSE_ERROR);
+        }
+        return rows;
+    }
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    threads = 1;
+#endif
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const size_t workers = std::min<size_t>(threads, rows / kMinRowsPerThread);
+    if (workers <= 1) {
+        // Snapshot the column variables so the context is left as it was found
+        std::vector<std::pair<std::string, Value>> original_values;
+        std::vector<std::string> keys_to_clear;
+        for (const auto& name : names) {
+            const Value* prior = context_.findVariable(name);
+            if (prior == nullptr || prior->isEmpty()) {
+                keys_to_clear.push_back(name);
+            } else {
+                original_values.emplace_back(name, *prior);
+            }
+        }
+        const size_t non_numeric = evaluateRows(context_, function_registry_.get(), prepared,
+                                                names, columns, 0, rows, out, errors);
+
+        for (const auto& [name, prior] : original_values) {
+            context_.setVariable(name, prior);
+        }
+        for (const auto& name : keys_to_clear) {
+            context_.removeVariable(name);
+        }
+        return non_numeric;
+    }
+
+    // Create the caches before copying the context so every worker shares them
+    context_.getLookupCache();
+    context_.getSortedArrayCache();
+    context_.getCalendarCache();
+
+    std::vector<size_t> non_numeric(workers, 0);
+    std::vector<std::thread> pool;
+    pool.reserve(workers);
+    for (size_t w = 0; w < workers; ++w) {
+        const size_t begin = rows * w / workers;
+        const size_t end = rows * (w + 1) / workers;
+        pool.emplace_back([&, w, begin, end] {
+            Context context = context_;
+            non_numeric[w] = evaluateRows(context, function_registry_.get(), prepared, names,
+                                          columns, begin, end, out, errors);
+        });
+    }
+    for (auto& worker : pool) {
+        worker.join();
+    }
+    return std::accumulate(non_numeric.begin(), non_numeric.end(), size_t{0});
+}
+
 void FormulaEngine::setVariable(const std::string& name, const Value& value) {
     context_.setVariable(name, value);
 }
@@ -89,6 +301,24 @@ Value FormulaEngine::getVariable(const std::string& name) const {
     return context_.getVariable(name);
 }
 
+const Value* FormulaEngine::findVariable(const std::string& name) const {
+    return context_.findVariable(name);
+}
+
+size_t FormulaEngine::getVariables(const std::vector<std::string>& names, double* out) const {
+    size_t non_numeric = 0;
+    for (size_t i = 0; i < names.size(); ++i) {
+        const Value* value = context_.findVariable(names[i]);
+        if (value == nullptr) {
+            out[i] = std::numeric_limits<double>::quiet_NaN();
+            ++non_numeric;
+        } else if (!toColumnNumber(*value, out[i])) {
+            ++non_numeric;
+        }
+    }
+    return non_numeric;
+}
+
 void FormulaEngine::registerFunction(const std::string& name, const FunctionImpl& impl) {
     function_registry_->registerFunction(name, impl);
 }
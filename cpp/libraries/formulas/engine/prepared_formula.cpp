@@ -0,0 +1,336 @@
+#include "velox/formulas/prepared.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include "velox/formulas/evaluator.h"
+#include "velox/formulas/functions.h"
+
+namespace xl_formula {
+
+namespace {
+
+/**
+ * @brief Structural key of a node: its own payload plus the canonical ids of its children
+ */
+struct NodeKey {
+    int kind = 0;
+    int tag = 0;  // operator, literal value type, ...
+    std::string text;
+    uint64_t bits = 0;
+    std::vector<size_t> children;
+
+    bool operator==(const NodeKey& other) const {
+        return kind == other.kind && tag == other.tag && bits == other.bits &&
+               text == other.text && children == other.children;
+    }
+};
+
+struct NodeKeyHash {
+    size_t operator()(const NodeKey& key) const {
+        size_t h = std::hash<std::string>{}(key.text);
+        auto mix = [&h](size_t v) { h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2); };
+        mix(static_cast<size_t>(key.kind));
+        mix(static_cast<size_t>(key.tag));
+        mix(static_cast<size_t>(key.bits));
+        for (size_t child : key.children) {
+            mix(child);
+        }
+        return h;
+    }
+};
+
+enum NodeKind { KIND_LITERAL, KIND_VARIABLE, KIND_BINARY, KIND_UNARY, KIND_ARRAY, KIND_CALL };
+
+bool isPureFunction(const FunctionRegistry& registry, const std::string& upper_name) {
+    return registry.isBuiltinFunction(upper_name) &&
+           !functions::dispatcher::is_volatile_function(upper_name);
+}
+
+uint64_t doubleBits(double d) {
+    if (d == 0.0)
+        d = 0.0;  // +0 and -0 compare equal
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    return bits;
+}
+
+/**
+ * @brief Hash-conses AST subtrees into canonical ids and tracks their purity and frequency
+ */
+class SubexpressionInterner : public ASTVisitor {
+  private:
+    const FunctionRegistry& registry_;
+    std::unordered_map<NodeKey, size_t, NodeKeyHash> ids_;
+    std::vector<size_t> counts_;
+    std::vector<bool> pure_;
+    std::vector<bool> leaf_;
+
+    // Result of the last visit
+    size_t id_ = 0;
+    bool is_pure_ = true;
+
+    void intern(NodeKey key, bool pure, bool leaf, const ASTNode& node) {
+        auto [it, inserted] = ids_.emplace(std::move(key), counts_.size());
+        if (inserted) {
+            counts_.push_back(0);
+            pure_.push_back(pure);
+            leaf_.push_back(leaf);
+        }
+        id_ = it->second;
+        is_pure_ = pure;
+        ++counts_[id_];
+        node_ids.emplace_back(&node, id_);
+    }
+
+    void internChildren(const std::vector<std::unique_ptr<ASTNode>>& children, NodeKey& key,
+                        bool& pure) {
+        key.children.reserve(children.size());
+        for (const auto& child : children) {
+            const_cast<ASTNode&>(*child).accept(*this);
+            key.children.push_back(id_);
+            pure = pure && is_pure_;
+        }
+    }
+
+  public:
+    std::vector<std::pair<const ASTNode*, size_t>> node_ids;
+
+    explicit SubexpressionInterner(const FunctionRegistry& registry) : registry_(registry) {}
+
+    bool isShareable(size_t id) const {
+        return counts_[id] > 1 && pure_[id] && !leaf_[id];
+    }
+    size_t idCount() const {
+        return counts_.size();
+    }
+
+    void visit(const LiteralNode& node) override {
+        NodeKey key;
+        key.kind = KIND_LITERAL;
+        const Value& value = node.getValue();
+        key.tag = static_cast<int>(value.getType());
+        switch (value.getType()) {
+            case ValueType::NUMBER:
+                key.bits = doubleBits(value.asNumber());
+                break;
+            case ValueType::BOOLEAN:
+                key.bits = value.asBoolean() ? 1 : 0;
+                break;
+            case ValueType::ERROR:
+                key.bits = static_cast<uint64_t>(value.asError());
+                break;
+            case ValueType::DATE:
+                key.bits = doubleBits(value.asDate().serial);
+                break;
+            case ValueType::ARRAY:
+                // Folded array literals are keyed by identity; toString() would round numbers
+                key.bits = reinterpret_cast<uintptr_t>(&value.asArrayData());
+                break;
+            default:
+                key.text = value.toString();
+                break;
+        }
+        intern(std::move(key), true, true, node);
+    }
+
+    void visit(const VariableNode& node) override {
+        NodeKey key;
+        key.kind = KIND_VARIABLE;
+        key.text = node.getName();
+        intern(std::move(key), true, true, node);
+    }
+
+    void visit(const BinaryOpNode& node) override {
+        NodeKey key;
+        key.kind = KIND_BINARY;
+        key.tag = static_cast<int>(node.getOperator());
+        const_cast<ASTNode&>(node.getLeft()).accept(*this);
+        key.children.push_back(id_);
+        bool pure = is_pure_;
+        const_cast<ASTNode&>(node.getRight()).accept(*this);
+        key.children.push_back(id_);
+        pure = pure && is_pure_;
+        intern(std::move(key), pure, false, node);
+    }
+
+    void visit(const UnaryOpNode& node) override {
+        NodeKey key;
+        key.kind = KIND_UNARY;
+        key.tag = static_cast<int>(node.getOperator());
+        const_cast<ASTNode&>(node.getOperand()).accept(*this);
+        key.children.push_back(id_);
+        intern(std::move(key), is_pure_, false, node);
+    }
+
+    void visit(const ArrayNode& node) override {
+        NodeKey key;
+        key.kind = KIND_ARRAY;
+        bool pure = true;
+        internChildren(node.getElements(), key, pure);
+        intern(std::move(key), pure, false, node);
+    }
+
+    void visit(const FunctionCallNode& node) override {
+        NodeKey key;
+        key.kind = KIND_CALL;
+        key.text = node.getName();
+        std::transform(key.text.begin(), key.text.end(), key.text.begin(), ::toupper);
+        bool pure = isPureFunction(registry_, key.text);
+        internChildren(node.getArguments(), key, pure);
+        intern(std::move(key), pure, false, node);
+    }
+};
+
+/**
+ * @brief Clones an AST, substituting known variables and folding pure constant subtrees
+ */
+class ConstantFolder : public ASTVisitor {
+  private:
+    const std::unordered_map<std::string, Value>& known_;
+    const FunctionRegistry& registry_;
+    Context empty_context_;
+    std::unique_ptr<ASTNode> result_;
+
+    std::unique_ptr<ASTNode> rewrite(const ASTNode& node) {
+        const_cast<ASTNode&>(node).accept(*this);
+        return std::move(result_);
+    }
+
+    static bool isLiteral(const ASTNode& node) {
+        return dynamic_cast<const LiteralNode*>(&node) != nullptr;
+    }
+
+    static bool allLiterals(const std::vector<std::unique_ptr<ASTNode>>& nodes) {
+        return std::all_of(nodes.begin(), nodes.end(),
+                           [](const std::unique_ptr<ASTNode>& n) { return isLiteral(*n); });
+    }
+
+    std::vector<std::unique_ptr<ASTNode>> rewriteAll(
+            const std::vector<std::unique_ptr<ASTNode>>& nodes) {
+        std::vector<std::unique_ptr<ASTNode>> out;
+        out.reserve(nodes.size());
+        for (const auto& n : nodes) {
+            out.push_back(rewrite(*n));
+        }
+        return out;
+    }
+
+    // Evaluate a node whose operands are all literals; keep it if evaluation aborts
+    void fold(std::unique_ptr<ASTNode> node) {
+        Evaluator evaluator(empty_context_, &registry_);
+        auto evaluated = evaluator.evaluate(*node);
+        if (evaluated.isSuccess()) {
+            result_ = std::make_unique<LiteralNode>(evaluated.getValue());
+        } else {
+            result_ = std::move(node);
+        }
+    }
+
+  public:
+    ConstantFolder(const std::unordered_map<std::string, Value>& known,
+                   const FunctionRegistry& registry)
+        : known_(known), registry_(registry) {}
+
+    std::unique_ptr<ASTNode> run(const ASTNode& node) {
+        return rewrite(node);
+    }
+
+    void visit(const LiteralNode& node) override {
+        result_ = std::make_unique<LiteralNode>(node.getValue());
+    }
+
+    void visit(const VariableNode& node) override {
+        auto it = known_.find(node.getName());
+        if (it == known_.end()) {
+            result_ = std::make_unique<VariableNode>(node.getName());
+        } else if (it->second.isEmpty()) {
+            // Matches the evaluator's treatment of unset variables
+            result_ = std::make_unique<LiteralNode>(Value::error(ErrorType::NAME_ERROR));
+        } else {
+            result_ = std::make_unique<LiteralNode>(it->second);
+        }
+    }
+
+    void visit(const BinaryOpNode& node) override {
+        auto left = rewrite(node.getLeft());
+        auto right = rewrite(node.getRight());
+        bool constant = isLiteral(*left) && isLiteral(*right);
+        auto rebuilt =
+                std::make_unique<BinaryOpNode>(node.getOperator(), std::move(left), std::move(right));
+        if (constant) {
+            fold(std::move(rebuilt));
+        } else {
+            result_ = std::move(rebuilt);
+        }
+    }
+
+    void visit(const UnaryOpNode& node) override {
+        auto operand = rewrite(node.getOperand());
+        bool constant = isLiteral(*operand);
+        auto rebuilt = std::make_unique<UnaryOpNode>(node.getOperator(), std::move(operand));
+        if (constant) {
+            fold(std::move(rebuilt));
+        } else {
+            result_ = std::move(rebuilt);
+        }
+    }
+
+    void visit(const ArrayNode& node) override {
+        auto elements = rewriteAll(node.getElements());
+        bool constant = allLiterals(elements);
+        auto rebuilt = std::make_unique<ArrayNode>(std::move(elements));
+        if (constant) {
+            fold(std::move(rebuilt));
+        } else {
+            result_ = std::move(rebuilt);
+        }
+    }
+
+    void visit(const FunctionCallNode& node) override {
+        auto args = rewriteAll(node.getArguments());
+        std::string upper_name = node.getName();
+        std::transform(upper_name.begin(), upper_name.end(), upper_name.begin(), ::toupper);
+        bool constant = allLiterals(args) && isPureFunction(registry_, upper_name);
+        auto rebuilt = std::make_unique<FunctionCallNode>(node.getName(), std::move(args));
+        if (constant) {
+            fold(std::move(rebuilt));
+        } else {
+            result_ = std::move(rebuilt);
+        }
+    }
+};
+
+}  // namespace
+
+std::unique_ptr<ASTNode> foldConstants(const ASTNode& ast,
+                                       const std::unordered_map<std::string, Value>& known_variables,
+                                       const FunctionRegistry& registry) {
+    ConstantFolder folder(known_variables, registry);
+    return folder.run(ast);
+}
+
+SubexpressionPlan SubexpressionPlan::build(const std::vector<const ASTNode*>& roots,
+                                           const FunctionRegistry& registry) {
+    SubexpressionInterner interner(registry);
+    for (const ASTNode* root : roots) {
+        if (root) {
+            const_cast<ASTNode*>(root)->accept(interner);
+        }
+    }
+
+    // Assign dense memo slots to shared canonical ids
+    SubexpressionPlan plan;
+    std::vector<long> slot_of_id(interner.idCount(), -1);
+    for (const auto& [node, id] : interner.node_ids) {
+        if (!interner.isShareable(id)) {
+            continue;
+        }
+        if (slot_of_id[id] < 0) {
+            slot_of_id[id] = static_cast<long>(plan.slot_count_++);
+        }
+        plan.slots_.emplace(node, static_cast<size_t>(slot_of_id[id]));
+    }
+    return plan;
+}
+
+}  // namespace xl_formula
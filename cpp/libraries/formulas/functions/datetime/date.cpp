@@ -1,5 +1,3 @@
-#include <chrono>
-#include <ctime>
 #include <sstream>
 #include "velox/formulas/functions.h"
 
@@ -31,25 +29,8 @@ Value date(const std::vector<Value>& args, const Context& context) {
                     throw std::runtime_error("Day out of range");
                 }
 
-                // Create tm structure
-                std::tm time_info = {};
-                time_info.tm_year = year - 1900;  // tm_year is years since 1900
-                time_info.tm_mon = month - 1;     // tm_mon is 0-based
-                time_info.tm_mday = day;
-                time_info.tm_hour = 0;
-                time_info.tm_min = 0;
-                time_info.tm_sec = 0;
-                time_info.tm_isdst = -1;  // Let mktime determine DST
-
-                // Convert to time_t
-                std::time_t time_val = std::mktime(&time_info);
-                if (time_val == -1) {
-                    throw std::runtime_error("Invalid date");
-                }
-
-                // Convert to system_clock::time_point
-                auto time_point = std::chrono::system_clock::from_time_t(time_val);
-                return Value(time_point);
+                // Days past the end of the month roll over into the next one
+                return Value(dates::makeDate(dates::daysFromCivil(year, month, day)));
             });
 }
 
@@ -77,27 +58,9 @@ Value edate(const std::vector<Value>& args, const Context& context) {
         return monthsV;
     int months = static_cast<int>(monthsV.asNumber());
 
-    auto tp = args[0].asDate();
-    std::time_t tt = std::chrono::system_clock::to_time_t(tp);
-    std::tm tmv = *std::localtime(&tt);
-    int y = tmv.tm_year + 1900;
-    int m = tmv.tm_mon + 1;
-    int d = tmv.tm_mday;
-    int total = y * 12 + (m - 1) + months;
-    int ny = total / 12;
-    int nm = total % 12 + 1;
-    // clamp day to last day of new month
-    static const int mdays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-    auto isLeap = [&](int Y) { return (Y % 4 == 0 && Y % 100 != 0) || (Y % 400 == 0); };
-    int last = mdays[nm - 1] + ((nm == 2 && isLeap(ny)) ? 1 : 0);
-    if (d > last)
-        d = last;
-    std::tm out{};
-    out.tm_year = ny - 1900;
-    out.tm_mon = nm - 1;
-    out.tm_mday = d;
-    auto out_tt = std::mktime(&out);
-    return Value(std::chrono::system_clock::from_time_t(out_tt));
+    // The day is clamped to the last day of the new month
+    auto start = dates::splitDate(args[0].asDate());
+    return Value(dates::makeDate(dates::addMonths(start.date, months, false)));
 }
 
 /**
@@ -124,23 +87,8 @@ Value eomonth(const std::vector<Value>& args, const Context& context) {
         return monthsV;
     int months = static_cast<int>(monthsV.asNumber());
 
-    auto tp = args[0].asDate();
-    std::time_t tt = std::chrono::system_clock::to_time_t(tp);
-    std::tm tmv = *std::localtime(&tt);
-    int y = tmv.tm_year + 1900;
-    int m = tmv.tm_mon + 1;
-    int total = y * 12 + (m - 1) + months;
-    int ny = total / 12;
-    int nm = total % 12 + 1;
-    static const int mdays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-    auto isLeap = [&](int Y) { return (Y % 4 == 0 && Y % 100 != 0) || (Y % 400 == 0); };
-    int last = mdays[nm - 1] + ((nm == 2 && isLeap(ny)) ? 1 : 0);
-    std::tm out{};
-    out.tm_year = ny - 1900;
-    out.tm_mon = nm - 1;
-    out.tm_mday = last;
-    auto out_tt = std::mktime(&out);
-    return Value(std::chrono::system_clock::from_time_t(out_tt));
+    auto start = dates::splitDate(args[0].asDate());
+    return Value(dates::makeDate(dates::addMonths(start.date, months, true)));
 }
 
 static inline std::string trim_copy(const std::string& input) {
@@ -222,18 +170,7 @@ Value datevalue(const std::vector<Value>& args, const Context& context) {
     }
     if (m < 1 || m > 12 || d < 1 || d > 31)
         return Value::error(ErrorType::VALUE_ERROR);
-    std::tm out{};
-    out.tm_year = y - 1900;
-    out.tm_mon = m - 1;
-    out.tm_mday = d;
-    out.tm_hour = 0;
-    out.tm_min = 0;
-    out.tm_sec = 0;
-    out.tm_isdst = -1;
-    auto out_tt = std::mktime(&out);
-    if (out_tt == -1)
-        return Value::error(ErrorType::VALUE_ERROR);
-    return Value(std::chrono::system_clock::from_time_t(out_tt));
+    return Value(dates::makeDate(dates::daysFromCivil(y, m, d)));
 }
 
 /**
@@ -255,10 +192,8 @@ Value timevalue(const std::vector<Value>& args, const Context& context) {
     if (!check.isEmpty())
         return check;
     if (args[0].isDate()) {
-        auto tp = args[0].asDate();
-        std::time_t tt = std::chrono::system_clock::to_time_t(tp);
-        std::tm tmv = *std::localtime(&tt);
-        double seconds = tmv.tm_hour * 3600.0 + tmv.tm_min * 60.0 + tmv.tm_sec;
+        auto fields = dates::splitDate(args[0].asDate());
+        double seconds = fields.hour * 3600.0 + fields.minute * 60.0 + fields.second;
         return Value(seconds / (24.0 * 3600.0));
     }
     std::string sraw = trim_copy(args[0].toString());
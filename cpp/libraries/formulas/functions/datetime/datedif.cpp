@@ -1,6 +1,4 @@
 #include <algorithm>
-#include <chrono>
-#include <ctime>
 #include <string>
 #include "velox/formulas/functions.h"
 
@@ -46,68 +44,47 @@ Value datedif(const std::vector<Value>& args, const Context& context) {
         // Convert to uppercase for comparison
         std::transform(unit.begin(), unit.end(), unit.begin(), ::toupper);
 
-        // Convert to time_t for easier manipulation
-        auto start_time_t = std::chrono::system_clock::to_time_t(start_date);
-        auto end_time_t = std::chrono::system_clock::to_time_t(end_date);
-        auto start_tm = *std::localtime(&start_time_t);
-        auto end_tm = *std::localtime(&end_time_t);
+        auto start = dates::splitDate(start_date);
+        auto end = dates::splitDate(end_date);
 
         // Swap if start > end
-        if (start_date > end_date) {
-            std::swap(start_tm, end_tm);
-            std::swap(start_time_t, end_time_t);
+        if (end_date < start_date) {
+            std::swap(start, end);
         }
+        const dates::CivilDate& from = start.date;
+        const dates::CivilDate& to = end.date;
 
         if (unit == "Y") {
             // Years
-            int years = end_tm.tm_year - start_tm.tm_year;
-            if (end_tm.tm_mon < start_tm.tm_mon ||
-                (end_tm.tm_mon == start_tm.tm_mon && end_tm.tm_mday < start_tm.tm_mday)) {
+            int64_t years = to.year - from.year;
+            if (to.month < from.month || (to.month == from.month && to.day < from.day)) {
                 years--;
             }
             return Value(static_cast<double>(years));
         } else if (unit == "M") {
             // Months
-            int months =
-                    (end_tm.tm_year - start_tm.tm_year) * 12 + (end_tm.tm_mon - start_tm.tm_mon);
-            if (end_tm.tm_mday < start_tm.tm_mday) {
+            int64_t months = (to.year - from.year) * 12 + (static_cast<int64_t>(to.month) -
+                                                           static_cast<int64_t>(from.month));
+            if (to.day < from.day) {
                 months--;
             }
             return Value(static_cast<double>(months));
         } else if (unit == "D") {
             // Days
-            auto duration = std::chrono::duration_cast<std::chrono::hours>(
-                    std::chrono::system_clock::from_time_t(end_time_t) -
-                    std::chrono::system_clock::from_time_t(start_time_t));
-            return Value(static_cast<double>(duration.count() / 24));
+            return Value(static_cast<double>(end.days - start.days));
         } else if (unit == "MD") {
             // Days ignoring months and years
-            int day_diff = end_tm.tm_mday - start_tm.tm_mday;
+            int64_t day_diff = static_cast<int64_t>(to.day) - static_cast<int64_t>(from.day);
             if (day_diff < 0) {
-                // Need to borrow from previous month
-                std::tm temp_tm = end_tm;
-                temp_tm.tm_mon--;
-                if (temp_tm.tm_mon < 0) {
-                    temp_tm.tm_mon = 11;
-                    temp_tm.tm_year--;
-                }
-                temp_tm.tm_mday = 1;
-                auto temp_time = std::mktime(&temp_tm);
-                temp_tm = *std::localtime(&temp_time);
-
-                // Days in previous month
-                temp_tm.tm_mon++;
-                temp_tm.tm_mday = 0;  // Last day of previous month
-                auto last_day_time = std::mktime(&temp_tm);
-                temp_tm = *std::localtime(&last_day_time);
-
-                day_diff = temp_tm.tm_mday - start_tm.tm_mday + end_tm.tm_mday;
+                // Borrow the length of the month before the end date
+                auto previous = dates::addMonths(to, -1, true);
+                day_diff += previous.day;
             }
             return Value(static_cast<double>(day_diff));
         } else if (unit == "YM") {
             // Months ignoring years
-            int month_diff = end_tm.tm_mon - start_tm.tm_mon;
-            if (end_tm.tm_mday < start_tm.tm_mday) {
+            int month_diff = static_cast<int>(to.month) - static_cast<int>(from.month);
+            if (to.day < from.day) {
                 month_diff--;
             }
             if (month_diff < 0) {
@@ -115,20 +92,12 @@ Value datedif(const std::vector<Value>& args, const Context& context) {
             }
             return Value(static_cast<double>(month_diff));
         } else if (unit == "YD") {
-            // Days ignoring years
-            std::tm temp_start = start_tm;
-            temp_start.tm_year = end_tm.tm_year;
-            auto temp_start_time = std::mktime(&temp_start);
-
-            if (temp_start_time > end_time_t) {
-                temp_start.tm_year--;
-                temp_start_time = std::mktime(&temp_start);
+            // Days ignoring years: from the last anniversary of the start date
+            int64_t anniversary = dates::daysFromCivil(to.year, from.month, from.day);
+            if (anniversary > end.days) {
+                anniversary = dates::daysFromCivil(to.year - 1, from.month, from.day);
             }
-
-            auto duration = std::chrono::duration_cast<std::chrono::hours>(
-                    std::chrono::system_clock::from_time_t(end_time_t) -
-                    std::chrono::system_clock::from_time_t(temp_start_time));
-            return Value(static_cast<double>(duration.count() / 24));
+            return Value(static_cast<double>(end.days - anniversary));
         } else {
             return Value::error(ErrorType::VALUE_ERROR);
         }
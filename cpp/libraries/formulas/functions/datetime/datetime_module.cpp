@@ -0,0 +1,71 @@
+#include "velox/formulas/functions.h"
+
+namespace xl_formula {
+namespace functions {
+namespace dispatcher {
+
+Value dispatch_datetime_function(const std::string& name, const std::vector<Value>& args,
+                                 const Context& context) {
+    switch (hash_function_name(name.c_str())) {
+        case hash_function_name("NOW"):
+            return builtin::now(args, context);
+        case hash_function_name("TODAY"):
+            return builtin::today(args, context);
+        case hash_function_name("DATE"):
+            return builtin::date(args, context);
+        case hash_function_name("TIME"):
+            return builtin::time_function(args, context);
+        case hash_function_name("YEAR"):
+            return builtin::year(args, context);
+        case hash_function_name("MONTH"):
+            return builtin::month(args, context);
+        case hash_function_name("DAY"):
+            return builtin::day(args, context);
+        case hash_function_name("HOUR"):
+            return builtin::hour(args, context);
+        case hash_function_name("MINUTE"):
+            return builtin::minute(args, context);
+        case hash_function_name("SECOND"):
+            return builtin::second(args, context);
+        case hash_function_name("WEEKDAY"):
+            return builtin::weekday(args, context);
+        case hash_function_name("DATEDIF"):
+            return builtin::datedif(args, context);
+        case hash_function_name("EDATE"):
+            return builtin::edate(args, context);
+        case hash_function_name("EOMONTH"):
+            return builtin::eomonth(args, context);
+        case hash_function_name("WORKDAY"):
+            return builtin::workday(args, context);
+        case hash_function_name("WORKDAY.INTL"):
+            return builtin::workday_intl(args, context);
+        case hash_function_name("NETWORKDAYS"):
+            return builtin::networkdays(args, context);
+        case hash_function_name("NETWORKDAYS.INTL"):
+            return builtin::networkdays_intl(args, context);
+        case hash_function_name("DATEVALUE"):
+            return builtin::datevalue(args, context);
+        case hash_function_name("TIMEVALUE"):
+            return builtin::timevalue(args, context);
+        case hash_function_name("NS_UNIXTIME"):
+            return builtin::ns_unixtime(args, context);
+        case hash_function_name("NS_NEARESTDATE"):
+            return builtin::ns_nearestdate(args, context);
+        case hash_function_name("NS_FURTHESTDATE"):
+            return builtin::ns_furthestdate(args, context);
+        default:
+            return Value();
+    }
+}
+
+#if defined(VELOX_SPLIT_FUNCTION_MODULES)
+namespace {
+// Loaded as a side module: make the functions reachable from the core's dispatcher
+[[maybe_unused]] const bool registered =
+        (register_function_module(FunctionModule::DATETIME, &dispatch_datetime_function), true);
+}  // anonymous namespace
+#endif
+
+}  // namespace dispatcher
+}  // namespace functions
+}  // namespace xl_formula
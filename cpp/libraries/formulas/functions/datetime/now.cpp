@@ -1,4 +1,3 @@
-#include <chrono>
 #include "velox/formulas/functions.h"
 
 namespace xl_formula {
@@ -13,8 +12,9 @@ namespace builtin {
  * @endcode
  */
 Value now(const std::vector<Value>& args, const Context& context) {
-    return templates::noArgFunction(args, context, "NOW",
-                                    []() { return Value(std::chrono::system_clock::now()); });
+    return templates::noArgFunction(args, context, "NOW", [&context]() {
+        return Value(dates::currentDateTime(context.getTimeZonePolicy()));
+    });
 }
 
 }  // namespace builtin
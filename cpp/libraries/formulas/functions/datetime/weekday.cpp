@@ -1,5 +1,3 @@
-#include <chrono>
-#include <ctime>
 #include "velox/formulas/functions.h"
 
 namespace xl_formula {
@@ -44,11 +42,9 @@ Value weekday(const std::vector<Value>& args, const Context& context) {
     }
 
     try {
-        auto date_val = args[0].asDate();
-        auto time_t = std::chrono::system_clock::to_time_t(date_val);
-        auto local_tm = *std::localtime(&time_t);
-
-        int weekday_val = local_tm.tm_wday;  // 0=Sunday, 1=Monday, ..., 6=Saturday
+        // 0=Sunday, 1=Monday, ..., 6=Saturday
+        int weekday_val = static_cast<int>(
+                dates::weekdayFromDays(dates::splitDate(args[0].asDate()).days));
 
         switch (return_type) {
             case 1:  // 1=Sunday, 2=Monday, ..., 7=Saturday
@@ -0,0 +1,221 @@
+#include <cmath>
+#include "velox/formulas/business_calendar.h"
+#include "velox/formulas/functions.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+namespace {
+
+/**
+ * @brief Whole day number of a date or serial number argument
+ */
+Value dayArgument(const Value& value, const std::string& name, int64_t& day) {
+    auto number = utils::toNumberSafe(value, name);
+    if (number.isError()) {
+        return number;
+    }
+    const double serial = number.asNumber();
+    if (!(serial >= 0.0 && serial < static_cast<double>(dates::kMaxSerial + 1))) {
+        return Value::error(ErrorType::NUM_ERROR);
+    }
+    day = static_cast<int64_t>(std::floor(serial)) - dates::kUnixEpochSerial;
+    return Value::empty();
+}
+
+/**
+ * @brief Weekend days of a WORKDAY.INTL / NETWORKDAYS.INTL weekend argument
+ *
+ * 1-7 are two-day weekends from Saturday-Sunday to Friday-Saturday, 11-17 single days
+ * from Sunday to Saturday, and a text of seven 0/1 flags marks weekend days from Monday
+ * to Sunday.
+ */
+Value weekendArgument(const Value& value, dates::WeekendMask& mask) {
+    if (value.isEmpty()) {
+        mask = dates::kSaturdaySunday;
+        return Value::empty();
+    }
+    if (value.isText()) {
+        const std::string& flags = value.asText();
+        if (flags.size() != 7) {
+            return Value::error(ErrorType::VALUE_ERROR);
+        }
+        mask = 0;
+        for (unsigned i = 0; i < 7; ++i) {
+            if (flags[i] == '1') {
+                mask |= static_cast<dates::WeekendMask>(1u << ((i + 1) % 7));
+            } else if (flags[i] != '0') {
+                return Value::error(ErrorType::VALUE_ERROR);
+            }
+        }
+        // A week without working days has no business days to count
+        return mask == 0x7F ? Value::error(ErrorType::VALUE_ERROR) : Value::empty();
+    }
+    auto number = utils::toNumberSafe(value, "WEEKEND");
+    if (number.isError()) {
+        return number;
+    }
+    const double code = number.asNumber();
+    if (code >= 1 && code <= 7 && code == std::trunc(code)) {
+        const unsigned first = (static_cast<unsigned>(code) + 5) % 7;
+        mask = static_cast<dates::WeekendMask>((1u << first) | (1u << ((first + 1) % 7)));
+        return Value::empty();
+    }
+    if (code >= 11 && code <= 17 && code == std::trunc(code)) {
+        mask = static_cast<dates::WeekendMask>(1u << (static_cast<unsigned>(code) - 11));
+        return Value::empty();
+    }
+    return Value::error(ErrorType::NUM_ERROR);
+}
+
+Value workdayImpl(const std::vector<Value>& args, const Context& context, const std::string& name,
+                  bool international) {
+    const size_t max_args = international ? 4 : 3;
+    if (args.size() < 2 || args.size() > max_args) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    auto error = utils::checkForErrors(args);
+    if (!error.isEmpty()) {
+        return error;
+    }
+
+    int64_t start = 0;
+    error = dayArgument(args[0], name, start);
+    if (!error.isEmpty()) {
+        return error;
+    }
+    auto days = utils::toNumberSafe(args[1], name);
+    if (days.isError()) {
+        return days;
+    }
+    if (std::fabs(days.asNumber()) > static_cast<double>(dates::kMaxSerial)) {
+        return Value::error(ErrorType::NUM_ERROR);
+    }
+
+    dates::WeekendMask weekend = dates::kSaturdaySunday;
+    if (international && args.size() >= 3) {
+        error = weekendArgument(args[2], weekend);
+        if (!error.isEmpty()) {
+            return error;
+        }
+    }
+    const size_t holidays_index = international ? 3 : 2;
+    const Value* holidays = args.size() > holidays_index ? &args[holidays_index] : nullptr;
+
+    std::shared_ptr<const dates::BusinessCalendar> calendar;
+    error = dates::getBusinessCalendar(context, weekend, holidays, calendar);
+    if (!error.isEmpty()) {
+        return error;
+    }
+
+    const int64_t result = calendar->advance(start, static_cast<int64_t>(days.asNumber()));
+    const int64_t serial = result + dates::kUnixEpochSerial;
+    if (serial < 0 || serial > dates::kMaxSerial) {
+        return Value::error(ErrorType::NUM_ERROR);
+    }
+    return Value(dates::makeDate(result));
+}
+
+Value networkdaysImpl(const std::vector<Value>& args, const Context& context,
+                      const std::string& name, bool international) {
+    const size_t max_args = international ? 4 : 3;
+    if (args.size() < 2 || args.size() > max_args) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    auto error = utils::checkForErrors(args);
+    if (!error.isEmpty()) {
+        return error;
+    }
+
+    int64_t start = 0;
+    int64_t end = 0;
+    error = dayArgument(args[0], name, start);
+    if (error.isEmpty()) {
+        error = dayArgument(args[1], name, end);
+    }
+    if (!error.isEmpty()) {
+        return error;
+    }
+
+    dates::WeekendMask weekend = dates::kSaturdaySunday;
+    if (international && args.size() >= 3) {
+        error = weekendArgument(args[2], weekend);
+        if (!error.isEmpty()) {
+            return error;
+        }
+    }
+    const size_t holidays_index = international ? 3 : 2;
+    const Value* holidays = args.size() > holidays_index ? &args[holidays_index] : nullptr;
+
+    std::shared_ptr<const dates::BusinessCalendar> calendar;
+    error = dates::getBusinessCalendar(context, weekend, holidays, calendar);
+    if (!error.isEmpty()) {
+        return error;
+    }
+    return Value(static_cast<double>(calendar->count(start, end)));
+}
+
+}  // anonymous namespace
+
+/**
+ * @brief Returns the date a number of working days before or after a start date
+ * @ingroup datetime
+ * @param start_date Starting date
+ * @param days Working days to move; negative moves backwards
+ * @param holidays Optional dates to skip besides Saturdays and Sundays
+ * @code
+ * WORKDAY(DATE(2024,1,5), 1) -> 2024-01-08 00:00:00
+ * @endcode
+ */
+Value workday(const std::vector<Value>& args, const Context& context) {
+    return workdayImpl(args, context, "WORKDAY", false);
+}
+
+/**
+ * @brief Returns the date a number of working days away, with a custom weekend
+ * @ingroup datetime
+ * @param start_date Starting date
+ * @param days Working days to move; negative moves backwards
+ * @param weekend Optional weekend code (1-7, 11-17) or seven 0/1 flags from Monday
+ * @param holidays Optional dates to skip
+ * @code
+ * WORKDAY.INTL(DATE(2024,1,4), 1, 7) -> 2024-01-07 00:00:00
+ * @endcode
+ */
+Value workday_intl(const std::vector<Value>& args, const Context& context) {
+    return workdayImpl(args, context, "WORKDAY.INTL", true);
+}
+
+/**
+ * @brief Returns the number of working days between two dates, both included
+ * @ingroup datetime
+ * @param start_date First date
+ * @param end_date Last date; before start_date the count is negative
+ * @param holidays Optional dates to skip besides Saturdays and Sundays
+ * @code
+ * NETWORKDAYS(DATE(2024,1,1), DATE(2024,1,31)) -> 23
+ * @endcode
+ */
+Value networkdays(const std::vector<Value>& args, const Context& context) {
+    return networkdaysImpl(args, context, "NETWORKDAYS", false);
+}
+
+/**
+ * @brief Returns the number of working days between two dates with a custom weekend
+ * @ingroup datetime
+ * @param start_date First date
+ * @param end_date Last date; before start_date the count is negative
+ * @param weekend Optional weekend code (1-7, 11-17) or seven 0/1 flags from Monday
+ * @param holidays Optional dates to skip
+ * @code
+ * NETWORKDAYS.INTL(DATE(2024,1,1), DATE(2024,1,31), 11) -> 27
+ * @endcode
+ */
+Value networkdays_intl(const std::vector<Value>& args, const Context& context) {
+    return networkdaysImpl(args, context, "NETWORKDAYS.INTL", true);
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
@@ -0,0 +1,59 @@
+#include "velox/formulas/functions.h"
+
+namespace xl_formula {
+namespace functions {
+namespace dispatcher {
+
+Value dispatch_engineering_function(const std::string& name, const std::vector<Value>& args,
+                                    const Context& context) {
+    switch (hash_function_name(name.c_str())) {
+        case hash_function_name("CONVERT"):
+            return builtin::convert(args, context);
+        case hash_function_name("HEX2DEC"):
+            return builtin::hex2dec(args, context);
+        case hash_function_name("DEC2HEX"):
+            return builtin::dec2hex(args, context);
+        case hash_function_name("BIN2DEC"):
+            return builtin::bin2dec(args, context);
+        case hash_function_name("DEC2BIN"):
+            return builtin::dec2bin(args, context);
+        case hash_function_name("BITAND"):
+            return builtin::bitand_function(args, context);
+        case hash_function_name("BITOR"):
+            return builtin::bitor_function(args, context);
+        case hash_function_name("BITXOR"):
+            return builtin::bitxor_function(args, context);
+        case hash_function_name("DEC2OCT"):
+            return builtin::dec2oct(args, context);
+        case hash_function_name("BIN2OCT"):
+            return builtin::bin2oct(args, context);
+        case hash_function_name("OCT2BIN"):
+            return builtin::oct2bin(args, context);
+        case hash_function_name("HEX2OCT"):
+            return builtin::hex2oct(args, context);
+        case hash_function_name("OCT2HEX"):
+            return builtin::oct2hex(args, context);
+        case hash_function_name("COMPLEX"):
+            return builtin::complex_function(args, context);
+        case hash_function_name("IMREAL"):
+            return builtin::imreal(args, context);
+        case hash_function_name("IMAGINARY"):
+            return builtin::imaginary(args, context);
+        default:
+            return Value();
+    }
+}
+
+#if defined(VELOX_SPLIT_FUNCTION_MODULES)
+namespace {
+// Loaded as a side module: make the functions reachable from the core's dispatcher
+[[maybe_unused]] const bool registered =
+        (register_function_module(FunctionModule::ENGINEERING,
+                                  &dispatch_engineering_function),
+         true);
+}  // anonymous namespace
+#endif
+
+}  // namespace dispatcher
+}  // namespace functions
+}  // namespace xl_formula
@@ -0,0 +1,43 @@
+#include "velox/formulas/functions.h"
+
+namespace xl_formula {
+namespace functions {
+namespace dispatcher {
+
+Value dispatch_financial_function(const std::string& name, const std::vector<Value>& args,
+                                  const Context& context) {
+    switch (hash_function_name(name.c_str())) {
+        case hash_function_name("PV"):
+            return builtin::pv(args, context);
+        case hash_function_name("FV"):
+            return builtin::fv(args, context);
+        case hash_function_name("PMT"):
+            return builtin::pmt(args, context);
+        case hash_function_name("RATE"):
+            return builtin::rate(args, context);
+        case hash_function_name("NPER"):
+            return builtin::nper(args, context);
+        case hash_function_name("NPV"):
+            return builtin::npv(args, context);
+        case hash_function_name("IRR"):
+            return builtin::irr(args, context);
+        case hash_function_name("XIRR"):
+            return builtin::xirr(args, context);
+        case hash_function_name("MIRR"):
+            return builtin::mirr(args, context);
+        default:
+            return Value();
+    }
+}
+
+#if defined(VELOX_SPLIT_FUNCTION_MODULES)
+namespace {
+// Loaded as a side module: make the functions reachable from the core's dispatcher
+[[maybe_unused]] const bool registered =
+        (register_function_module(FunctionModule::FINANCIAL, &dispatch_financial_function), true);
+}  // anonymous namespace
+#endif
+
+}  // namespace dispatcher
+}  // namespace functions
+}  // namespace xl_formula
@@ -1,4 +1,4 @@
-#include <cmath>
+#include "velox/formulas/financial_utils.h"
 #include "velox/formulas/functions.h"
 
 namespace xl_formula {
@@ -32,7 +32,10 @@ Value irr(const std::vector<Value>& args, const Context& context) {
 
     // First argument must be array of cash flows
     const auto& first_arg = args[0];
-    if (first_arg.isArray()) {
+    NumberSpan flows;
+    if (utils::numericArrayView(first_arg, flows)) {
+        // Packed numeric array: read the cash flows in place
+    } else if (first_arg.isArray()) {
         // Extract cash flows from array
         const auto& arr = first_arg.asArray();
         for (const auto& val : arr) {
@@ -72,6 +75,10 @@ Value irr(const std::vector<Value>& args, const Context& context) {
         }
     }
 
+    if (flows.empty()) {
+        flows = NumberSpan(cash_flows);
+    }
+
     // If we have 2 args and first is array, second is guess
     if (args.size() == 2 && first_arg.isArray()) {
         auto guess_val = utils::toNumberSafe(args[1], "IRR");
@@ -82,7 +89,7 @@ Value irr(const std::vector<Value>& args, const Context& context) {
 
     // Need at least one positive and one negative cash flow
     bool has_positive = false, has_negative = false;
-    for (double cf : cash_flows) {
+    for (double cf : flows) {
         if (cf > 0)
             has_positive = true;
         if (cf < 0)
@@ -93,50 +100,11 @@ Value irr(const std::vector<Value>& args, const Context& context) {
         return Value::error(ErrorType::VALUE_ERROR);
     }
 
-    // Newton-Raphson method to find IRR
-    double rate = guess;
-    const double tolerance = 1e-12;
-    const int max_iterations = 100;
-
-    for (int i = 0; i < max_iterations; i++) {
-        double npv = 0.0;
-        double dnpv_dr = 0.0;
-
-        // Calculate NPV and its derivative
-        for (size_t j = 0; j < cash_flows.size(); j++) {
-            double period = static_cast<double>(j);
-            double discount_factor = std::pow(1.0 + rate, period);
-
-            npv += cash_flows[j] / discount_factor;
-
-            if (period > 0) {
-                dnpv_dr -= cash_flows[j] * period / (discount_factor * (1.0 + rate));
-            }
-        }
-
-        // Check for convergence
-        if (std::abs(npv) < tolerance) {
-            return Value(rate);
-        }
-
-        // Check for zero derivative
-        if (std::abs(dnpv_dr) < tolerance) {
-            return Value::error(ErrorType::VALUE_ERROR);
-        }
-
-        // Newton-Raphson iteration
-        double new_rate = rate - npv / dnpv_dr;
-
-        // Bound the rate to reasonable values
-        if (new_rate < -0.99 || new_rate > 10.0) {
-            return Value::error(ErrorType::VALUE_ERROR);
-        }
-
-        rate = new_rate;
+    auto solved = financial::solveIrr(flows, guess);
+    if (!solved.converged) {
+        return Value::error(ErrorType::VALUE_ERROR);
     }
-
-    // If we didn't converge, return an error
-    return Value::error(ErrorType::VALUE_ERROR);
+    return Value(solved.rate);
 }
 
 }  // namespace builtin
@@ -29,18 +29,22 @@ Value mirr(const std::vector<Value>& args, const Context& context) {
     }
 
     std::vector<double> cash_flows;
+    NumberSpan flows;
     double finance_rate, reinvest_rate;
 
     if (args.size() == 3 && args[0].isArray()) {
         // Array syntax: MIRR({cash_flows}, finance_rate, reinvest_rate)
-        const auto& cash_flows_array = args[0].asArray();
-        for (const auto& val : cash_flows_array) {
-            if (val.isError())
-                return val;
-            auto num = utils::toNumberSafe(val, "MIRR");
-            if (num.isError())
-                return num;
-            cash_flows.push_back(num.asNumber());
+        if (!utils::numericArrayView(args[0], flows)) {
+            const auto& cash_flows_array = args[0].asArray();
+            for (const auto& val : cash_flows_array) {
+                if (val.isError())
+                    return val;
+                auto num = utils::toNumberSafe(val, "MIRR");
+                if (num.isError())
+                    return num;
+                cash_flows.push_back(num.asNumber());
+            }
+            flows = NumberSpan(cash_flows);
         }
 
         auto finance_rate_val = utils::toNumberSafe(args[1], "MIRR");
@@ -77,28 +81,29 @@ Value mirr(const std::vector<Value>& args, const Context& context) {
         if (reinvest_rate_val.isError())
             return reinvest_rate_val;
         reinvest_rate = reinvest_rate_val.asNumber();
+        flows = NumberSpan(cash_flows);
     }
 
-    if (cash_flows.empty()) {
+    if (flows.empty()) {
         return Value::error(ErrorType::VALUE_ERROR);
     }
 
-    size_t n = cash_flows.size();
+    size_t n = flows.size();
 
     // Calculate present value of negative cash flows (outflows)
     double pv_outflows = 0.0;
     for (size_t i = 0; i < n; i++) {
-        if (cash_flows[i] < 0) {
-            pv_outflows += cash_flows[i] / std::pow(1.0 + finance_rate, static_cast<double>(i));
+        if (flows[i] < 0) {
+            pv_outflows += flows[i] / std::pow(1.0 + finance_rate, static_cast<double>(i));
         }
     }
 
     // Calculate future value of positive cash flows (inflows)
     double fv_inflows = 0.0;
     for (size_t i = 0; i < n; i++) {
-        if (cash_flows[i] > 0) {
+        if (flows[i] > 0) {
             double periods_to_end = static_cast<double>(n - 1 - i);
-            fv_inflows += cash_flows[i] * std::pow(1.0 + reinvest_rate, periods_to_end);
+            fv_inflows += flows[i] * std::pow(1.0 + reinvest_rate, periods_to_end);
         }
     }
 
@@ -1,4 +1,4 @@
-#include <cmath>
+#include "velox/formulas/financial_utils.h"
 #include "velox/formulas/functions.h"
 
 namespace xl_formula {
@@ -35,8 +35,11 @@ Value npv(const std::vector<Value>& args, const Context& context) {
     double rate = rate_val.asNumber();
 
     std::vector<double> cash_flows;
+    NumberSpan flows;
 
-    if (args.size() == 2 && args[1].isArray()) {
+    if (args.size() == 2 && utils::numericArrayView(args[1], flows)) {
+        // Packed numeric array: read the cash flows in place
+    } else if (args.size() == 2 && args[1].isArray()) {
         // Array syntax: NPV(rate, {cash_flows})
         const auto& cash_flows_array = args[1].asArray();
         for (const auto& val : cash_flows_array) {
@@ -47,6 +50,7 @@ Value npv(const std::vector<Value>& args, const Context& context) {
                 return num;
             cash_flows.push_back(num.asNumber());
         }
+        flows = NumberSpan(cash_flows);
     } else {
         // Legacy syntax: NPV(rate, cf1, cf2, cf3, ...)
         for (size_t i = 1; i < args.size(); i++) {
@@ -55,21 +59,11 @@ Value npv(const std::vector<Value>& args, const Context& context) {
                 return num;
             cash_flows.push_back(num.asNumber());
         }
+        flows = NumberSpan(cash_flows);
     }
 
-    // Calculate NPV of cash flows
-    double npv_result = 0.0;
-
-    // Process each cash flow (starting from period 1)
-    for (size_t i = 0; i < cash_flows.size(); i++) {
-        double cash_flow = cash_flows[i];
-        double period = static_cast<double>(i + 1);  // Periods start from 1
-
-        // Add discounted cash flow to NPV
-        npv_result += cash_flow / std::pow(1.0 + rate, period);
-    }
-
-    return Value(npv_result);
+    // Periods start from 1
+    return Value(financial::presentValue(flows, rate));
 }
 
 }  // namespace builtin
@@ -0,0 +1,106 @@
+#include <cmath>
+#include "velox/formulas/financial_utils.h"
+#include "velox/formulas/functions.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+// Whole serial day of a date value or a serial number; the time of day is ignored
+static bool dayNumber(const Value& value, double& day) {
+    if (value.isDate() || value.isNumber()) {
+        day = std::floor(value.toNumber());
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Returns the internal rate of return for cash flows on arbitrary dates
+ * @ingroup financial
+ * @param values Cash flows (array)
+ * @param dates Date of each cash flow, as dates or day numbers (array)
+ * @param guess Initial guess for the rate (optional, default 0.1)
+ * @code
+ * XIRR({-10000,2750,4250,3250,2750}, {39448,39508,39751,39859,39904}) -> 0.3734
+ * @endcode
+ */
+Value xirr(const std::vector<Value>& args, const Context& context) {
+    (void)context;
+
+    if (args.size() < 2 || args.size() > 3) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    auto errorCheck = utils::checkForErrors(args);
+    if (!errorCheck.isEmpty()) {
+        return errorCheck;
+    }
+    if (!args[0].isArray() || !args[1].isArray()) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+
+    double guess = 0.1;
+    if (args.size() == 3) {
+        auto guess_val = utils::toNumberSafe(args[2], "XIRR");
+        if (guess_val.isError()) {
+            return guess_val;
+        }
+        guess = guess_val.asNumber();
+    }
+
+    const ArrayData& values = args[0].asArrayData();
+    const ArrayData& dates = args[1].asArrayData();
+    if (values.size() != dates.size() || values.size() < 2) {
+        return Value::error(ErrorType::NUM_ERROR);
+    }
+
+    std::vector<double> cash_flows;
+    NumberSpan flows = values.numbers();
+    if (!values.isNumeric()) {
+        cash_flows.reserve(values.size());
+        for (const auto& val : values.values()) {
+            if (val.isError()) {
+                return val;
+            }
+            if (!val.isNumber()) {
+                return Value::error(ErrorType::VALUE_ERROR);
+            }
+            cash_flows.push_back(val.asNumber());
+        }
+        flows = NumberSpan(cash_flows);
+    }
+
+    std::vector<double> days(dates.size());
+    for (size_t i = 0; i < dates.size(); ++i) {
+        Value date = dates.at(i);
+        if (date.isError()) {
+            return date;
+        }
+        if (!dayNumber(date, days[i])) {
+            return Value::error(ErrorType::VALUE_ERROR);
+        }
+        // No cash flow may precede the first one
+        if (days[i] < days[0]) {
+            return Value::error(ErrorType::NUM_ERROR);
+        }
+    }
+
+    bool has_positive = false, has_negative = false;
+    for (double cf : flows) {
+        has_positive = has_positive || cf > 0;
+        has_negative = has_negative || cf < 0;
+    }
+    if (!has_positive || !has_negative) {
+        return Value::error(ErrorType::NUM_ERROR);
+    }
+
+    auto solved = financial::solveXirr(flows, NumberSpan(days), guess);
+    if (!solved.converged) {
+        return Value::error(ErrorType::NUM_ERROR);
+    }
+    return Value(solved.rate);
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
@@ -67,8 +67,20 @@ Value dispatch_builtin_function(const std::string& name, const std::vector<Value
             return builtin::countif(args, context);
         case hash_function_name("MEDIAN"):
             return builtin::median(args, context);
+        case hash_function_name("PERCENTILE"):
+            return builtin::percentile(args, context);
+        case hash_function_name("QUARTILE"):
+            return builtin::quartile(args, context);
+        case hash_function_name("LARGE"):
+            return builtin::large(args, context);
+        case hash_function_name("SMALL"):
+            return builtin::small(args, context);
+        case hash_function_name("RANK"):
+            return builtin::rank(args, context);
         case hash_function_name("MODE"):
             return builtin::mode(args, context);
+        case hash_function_name("MODE.MULT"):
+            return builtin::mode_mult(args, context);
         case hash_function_name("STDEV"):
             return builtin::stdev(args, context);
         case hash_function_name("VAR"):
@@ -124,86 +136,6 @@ Value dispatch_builtin_function(const std::string& name, const std::vector<Value
         case hash_function_name("LOG10"):
             return builtin::log10_function(args, context);
 
-        // Text functions
-        case hash_function_name("CONCATENATE"):
-            return builtin::concatenate(args, context);
-        case hash_function_name("CONCAT"):
-            return builtin::concatenate(args, context);
-        case hash_function_name("TRIM"):
-            return builtin::trim(args, context);
-        case hash_function_name("LEN"):
-            return builtin::len(args, context);
-        case hash_function_name("LEFT"):
-            return builtin::left(args, context);
-        case hash_function_name("RIGHT"):
-            return builtin::right(args, context);
-        case hash_function_name("MID"):
-            return builtin::mid(args, context);
-        case hash_function_name("UPPER"):
-            return builtin::upper(args, context);
-        case hash_function_name("LOWER"):
-            return builtin::lower(args, context);
-        case hash_function_name("PROPER"):
-            return builtin::proper(args, context);
-        case hash_function_name("RPT"):
-            return builtin::rpt(args, context);
-        case hash_function_name("REPT"):
-            return builtin::rpt(args, context);
-        case hash_function_name("FIND"):
-            return builtin::find(args, context);
-        case hash_function_name("SEARCH"):
-            return builtin::search(args, context);
-        case hash_function_name("REPLACE"):
-            return builtin::replace(args, context);
-        case hash_function_name("SUBSTITUTE"):
-            return builtin::substitute(args, context);
-        case hash_function_name("TEXT"):
-            return builtin::text(args, context);
-        case hash_function_name("VALUE"):
-            return builtin::value(args, context);
-        case hash_function_name("T"):
-            return builtin::t_function(args, context);
-        case hash_function_name("TEXTJOIN"):
-            return builtin::textjoin(args, context);
-        case hash_function_name("UNICHAR"):
-            return builtin::unichar(args, context);
-        case hash_function_name("UNICODE"):
-            return builtin::unicode_function(args, context);
-
-        // Date & Time functions
-        case hash_function_name("NOW"):
-            return builtin::now(args, context);
-        case hash_function_name("TODAY"):
-            return builtin::today(args, context);
-        case hash_function_name("DATE"):
-            return builtin::date(args, context);
-        case hash_function_name("TIME"):
-            return builtin::time_function(args, context);
-        case hash_function_name("YEAR"):
-            return builtin::year(args, context);
-        case hash_function_name("MONTH"):
-            return builtin::month(args, context);
-        case hash_function_name("DAY"):
-            return builtin::day(args, context);
-        case hash_function_name("HOUR"):
-            return builtin::hour(args, context);
-        case hash_function_name("MINUTE"):
-            return builtin::minute(args, context);
-        case hash_function_name("SECOND"):
-            return builtin::second(args, context);
-        case hash_function_name("WEEKDAY"):
-            return builtin::weekday(args, context);
-        case hash_function_name("DATEDIF"):
-            return builtin::datedif(args, context);
-        case hash_function_name("EDATE"):
-            return builtin::edate(args, context);
-        case hash_function_name("EOMONTH"):
-            return builtin::eomonth(args, context);
-        case hash_function_name("DATEVALUE"):
-            return builtin::datevalue(args, context);
-        case hash_function_name("TIMEVALUE"):
-            return builtin::timevalue(args, context);
-
         // Logical functions
         case hash_function_name("TRUE"):
             return builtin::true_function(args, context);
@@ -236,58 +168,6 @@ Value dispatch_builtin_function(const std::string& name, const std::vector<Value
         case hash_function_name("IFS"):
             return builtin::ifs_function(args, context);
 
-        // Engineering functions
-        case hash_function_name("CONVERT"):
-            return builtin::convert(args, context);
-        case hash_function_name("HEX2DEC"):
-            return builtin::hex2dec(args, context);
-        case hash_function_name("DEC2HEX"):
-            return builtin::dec2hex(args, context);
-        case hash_function_name("BIN2DEC"):
-            return builtin::bin2dec(args, context);
-        case hash_function_name("DEC2BIN"):
-            return builtin::dec2bin(args, context);
-        case hash_function_name("BITAND"):
-            return builtin::bitand_function(args, context);
-        case hash_function_name("BITOR"):
-            return builtin::bitor_function(args, context);
-        case hash_function_name("BITXOR"):
-            return builtin::bitxor_function(args, context);
-        case hash_function_name("DEC2OCT"):
-            return builtin::dec2oct(args, context);
-        case hash_function_name("BIN2OCT"):
-            return builtin::bin2oct(args, context);
-        case hash_function_name("OCT2BIN"):
-            return builtin::oct2bin(args, context);
-        case hash_function_name("HEX2OCT"):
-            return builtin::hex2oct(args, context);
-        case hash_function_name("OCT2HEX"):
-            return builtin::oct2hex(args, context);
-        case hash_function_name("COMPLEX"):
-            return builtin::complex_function(args, context);
-        case hash_function_name("IMREAL"):
-            return builtin::imreal(args, context);
-        case hash_function_name("IMAGINARY"):
-            return builtin::imaginary(args, context);
-
-        // Financial functions
-        case hash_function_name("PV"):
-            return builtin::pv(args, context);
-        case hash_function_name("FV"):
-            return builtin::fv(args, context);
-        case hash_function_name("PMT"):
-            return builtin::pmt(args, context);
-        case hash_function_name("RATE"):
-            return builtin::rate(args, context);
-        case hash_function_name("NPER"):
-            return builtin::nper(args, context);
-        case hash_function_name("NPV"):
-            return builtin::npv(args, context);
-        case hash_function_name("IRR"):
-            return builtin::irr(args, context);
-        case hash_function_name("MIRR"):
-            return builtin::mirr(args, context);
-
         // Phase 11: Additional Math Functions
         case hash_function_name("GCD"):
             return builtin::gcd(args, context);
@@ -305,6 +185,10 @@ Value dispatch_builtin_function(const std::string& name, const std::vector<Value
             return builtin::sumif(args, context);
         case hash_function_name("SUMIFS"):
             return builtin::sumifs(args, context);
+        case hash_function_name("SEQUENCE"):
+            return builtin::sequence(args, context);
+        case hash_function_name("COUNTIFS"):
+            return builtin::countifs(args, context);
         case hash_function_name("SUMX2MY2"):
             return builtin::sumx2my2(args, context);
         case hash_function_name("SUMX2PY2"):
@@ -316,39 +200,9 @@ Value dispatch_builtin_function(const std::string& name, const std::vector<Value
         case hash_function_name("AVERAGEIFS"):
             return builtin::averageifs(args, context);
 
-        // Lookup & Reference
-        case hash_function_name("CHOOSE"):
-            return builtin::choose(args, context);
-        case hash_function_name("ROW"):
-            return builtin::row_function(args, context);
-        case hash_function_name("COLUMN"):
-            return builtin::column_function(args, context);
-
-        // Text additions
-        case hash_function_name("CHAR"):
-            return builtin::char_function(args, context);
-        case hash_function_name("CODE"):
-            return builtin::code_function(args, context);
-        case hash_function_name("CLEAN"):
-            return builtin::clean(args, context);
-        case hash_function_name("EXACT"):
-            return builtin::exact(args, context);
-        case hash_function_name("ROMAN"):
-            return builtin::roman(args, context);
-        case hash_function_name("ARABIC"):
-            return builtin::arabic(args, context);
-
-        // Non-standard namespace (NS_*)
-        case hash_function_name("NS_UNIXTIME"):
-            return builtin::ns_unixtime(args, context);
-        case hash_function_name("NS_NEARESTDATE"):
-            return builtin::ns_nearestdate(args, context);
-        case hash_function_name("NS_FURTHESTDATE"):
-            return builtin::ns_furthestdate(args, context);
-
         default:
-            // Not a built-in function - return empty Value to indicate fallback needed
-            return Value();
+            // Text, date, lookup, engineering and financial functions live in modules
+            return dispatch_module_function(hash, name, args, context);
     }
 }
 
@@ -356,9 +210,10 @@ std::vector<std::string> get_builtin_function_names() {
     return {// Math functions
             "SUM", "MAX", "MIN", "AVERAGE", "COUNT", "COUNTA", "ABS", "ROUND", "ROUNDUP",
             "ROUNDDOWN", "MROUND", "SQRT", "POWER", "MOD", "PI", "SIGN", "INT", "TRUNC", "CEILING",
-            "FLOOR", "RAND", "RANDBETWEEN", "COUNTIF", "MEDIAN", "MODE", "STDEV", "VAR", "GCD",
-            "LCM", "FACT", "COMBIN", "PERMUT", "SUMPRODUCT", "SUMIF", "SUMIFS", "AVERAGEIF",
-            "AVERAGEIFS", "SUMSQ", "QUOTIENT", "EVEN", "ODD",
+            "FLOOR", "RAND", "RANDBETWEEN", "COUNTIF", "MEDIAN", "MODE", "MODE.MULT", "STDEV",
+            "VAR", "GCD", "LCM", "FACT", "COMBIN", "PERMUT", "SUMPRODUCT", "SUMIF", "SUMIFS",
+            "AVERAGEIF", "AVERAGEIFS", "COUNTIFS", "SUMSQ", "QUOTIENT", "EVEN", "ODD", "SEQUENCE",
+            "PERCENTILE", "QUARTILE", "LARGE", "SMALL", "RANK",
 
             // Trigonometric functions
             "SIN", "COS", "TAN", "ASIN", "ACOS", "ATAN", "ATAN2", "SINH", "COSH", "TANH", "DEGREES",
@@ -378,10 +233,12 @@ std::vector<std::string> get_builtin_function_names() {
 
             // Date & Time functions
             "NOW", "TODAY", "DATE", "TIME", "YEAR", "MONTH", "DAY", "HOUR", "MINUTE", "SECOND",
-            "WEEKDAY", "DATEDIF", "EDATE", "EOMONTH", "DATEVALUE", "TIMEVALUE",
+            "WEEKDAY", "DATEDIF", "EDATE", "EOMONTH", "DATEVALUE", "TIMEVALUE", "WORKDAY",
+            "WORKDAY.INTL", "NETWORKDAYS", "NETWORKDAYS.INTL",
 
             // Lookup & Reference
-            "CHOOSE", "ROW", "COLUMN",
+            "CHOOSE", "ROW", "COLUMN", "VLOOKUP", "HLOOKUP", "INDEX", "MATCH", "XLOOKUP",
+            "SORT", "SORTBY", "FILTER", "UNIQUE",
 
             // Logical functions
             "TRUE", "FALSE", "IF", "AND", "OR", "NOT", "XOR", "IFERROR", "IFNA", "ISNUMBER",
@@ -392,7 +249,24 @@ std::vector<std::string> get_builtin_function_names() {
             "DEC2OCT", "BIN2OCT", "OCT2BIN", "HEX2OCT", "OCT2HEX", "COMPLEX", "IMREAL", "IMAGINARY",
 
             // Financial functions
-            "PV", "FV", "PMT", "RATE", "NPER", "NPV", "IRR", "MIRR"};
+            "PV", "FV", "PMT", "RATE", "NPER", "NPV", "IRR", "XIRR", "MIRR"};
+}
+
+bool is_builtin_function(const std::string& name) {
+    // Built-ins answer every call (arity errors included); only unknown names return empty
+    return !dispatch_builtin_function(name, {}, Context()).isEmpty();
+}
+
+bool is_volatile_function(const std::string& name) {
+    switch (hash_function_name(name.c_str())) {
+        case hash_function_name("RAND"):
+        case hash_function_name("RANDBETWEEN"):
+        case hash_function_name("NOW"):
+        case hash_function_name("TODAY"):
+            return true;
+        default:
+            return false;
+    }
 }
 
 }  // namespace dispatcher
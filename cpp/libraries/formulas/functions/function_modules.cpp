@@ -0,0 +1,181 @@
+#include <atomic>
+#include "velox/formulas/functions.h"
+
+namespace xl_formula {
+namespace functions {
+namespace dispatcher {
+
+namespace {
+
+/**
+ * @brief Module of a name outside the core, from its hash
+ *
+ * Must list the same names as the dispatch_<category>_function() switches; the function
+ * module tests check that each dispatcher answers exactly the names mapped to it here.
+ * @return false for core functions and unknown names
+ */
+bool module_of_hash(uint32_t hash, FunctionModule& module) {
+    switch (hash) {
+        case hash_function_name("CONCATENATE"):
+        case hash_function_name("CONCAT"):
+        case hash_function_name("TRIM"):
+        case hash_function_name("LEN"):
+        case hash_function_name("LEFT"):
+        case hash_function_name("RIGHT"):
+        case hash_function_name("MID"):
+        case hash_function_name("UPPER"):
+        case hash_function_name("LOWER"):
+        case hash_function_name("PROPER"):
+        case hash_function_name("RPT"):
+        case hash_function_name("REPT"):
+        case hash_function_name("FIND"):
+        case hash_function_name("SEARCH"):
+        case hash_function_name("REPLACE"):
+        case hash_function_name("SUBSTITUTE"):
+        case hash_function_name("TEXT"):
+        case hash_function_name("VALUE"):
+        case hash_function_name("T"):
+        case hash_function_name("TEXTJOIN"):
+        case hash_function_name("UNICHAR"):
+        case hash_function_name("UNICODE"):
+        case hash_function_name("CHAR"):
+        case hash_function_name("CODE"):
+        case hash_function_name("CLEAN"):
+        case hash_function_name("EXACT"):
+        case hash_function_name("ROMAN"):
+        case hash_function_name("ARABIC"):
+            module = FunctionModule::TEXT;
+            return true;
+
+        case hash_function_name("NOW"):
+        case hash_function_name("TODAY"):
+        case hash_function_name("DATE"):
+        case hash_function_name("TIME"):
+        case hash_function_name("YEAR"):
+        case hash_function_name("MONTH"):
+        case hash_function_name("DAY"):
+        case hash_function_name("HOUR"):
+        case hash_function_name("MINUTE"):
+        case hash_function_name("SECOND"):
+        case hash_function_name("WEEKDAY"):
+        case hash_function_name("DATEDIF"):
+        case hash_function_name("EDATE"):
+        case hash_function_name("EOMONTH"):
+        case hash_function_name("WORKDAY"):
+        case hash_function_name("WORKDAY.INTL"):
+        case hash_function_name("NETWORKDAYS"):
+        case hash_function_name("NETWORKDAYS.INTL"):
+        case hash_function_name("DATEVALUE"):
+        case hash_function_name("TIMEVALUE"):
+        case hash_function_name("NS_UNIXTIME"):
+        case hash_function_name("NS_NEARESTDATE"):
+        case hash_function_name("NS_FURTHESTDATE"):
+            module = FunctionModule::DATETIME;
+            return true;
+
+        case hash_function_name("CHOOSE"):
+        case hash_function_name("ROW"):
+        case hash_function_name("COLUMN"):
+        case hash_function_name("VLOOKUP"):
+        case hash_function_name("HLOOKUP"):
+        case hash_function_name("INDEX"):
+        case hash_function_name("MATCH"):
+        case hash_function_name("XLOOKUP"):
+        case hash_function_name("SORT"):
+        case hash_function_name("SORTBY"):
+        case hash_function_name("FILTER"):
+        case hash_function_name("UNIQUE"):
+            module = FunctionModule::LOOKUP;
+            return true;
+
+        case hash_function_name("CONVERT"):
+        case hash_function_name("HEX2DEC"):
+        case hash_function_name("DEC2HEX"):
+        case hash_function_name("BIN2DEC"):
+        case hash_function_name("DEC2BIN"):
+        case hash_function_name("BITAND"):
+        case hash_function_name("BITOR"):
+        case hash_function_name("BITXOR"):
+        case hash_function_name("DEC2OCT"):
+        case hash_function_name("BIN2OCT"):
+        case hash_function_name("OCT2BIN"):
+        case hash_function_name("HEX2OCT"):
+        case hash_function_name("OCT2HEX"):
+        case hash_function_name("COMPLEX"):
+        case hash_function_name("IMREAL"):
+        case hash_function_name("IMAGINARY"):
+            module = FunctionModule::ENGINEERING;
+            return true;
+
+        case hash_function_name("PV"):
+        case hash_function_name("FV"):
+        case hash_function_name("PMT"):
+        case hash_function_name("RATE"):
+        case hash_function_name("NPER"):
+        case hash_function_name("NPV"):
+        case hash_function_name("IRR"):
+        case hash_function_name("XIRR"):
+        case hash_function_name("MIRR"):
+            module = FunctionModule::FINANCIAL;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+#if defined(VELOX_SPLIT_FUNCTION_MODULES)
+// Filled in as side modules are loaded
+std::atomic<ModuleDispatch> module_dispatch[kFunctionModuleCount] = {};
+#else
+std::atomic<ModuleDispatch> module_dispatch[kFunctionModuleCount] = {
+        {&dispatch_text_function},        {&dispatch_datetime_function},
+        {&dispatch_lookup_function},      {&dispatch_engineering_function},
+        {&dispatch_financial_function}};
+#endif
+
+}  // anonymous namespace
+
+void register_function_module(FunctionModule module, ModuleDispatch dispatch) {
+    module_dispatch[static_cast<size_t>(module)].store(dispatch, std::memory_order_release);
+}
+
+Value dispatch_module_function(uint32_t hash, const std::string& name,
+                               const std::vector<Value>& args, const Context& context) {
+    FunctionModule module;
+    if (!module_of_hash(hash, module)) {
+        return Value();
+    }
+    ModuleDispatch dispatch =
+            module_dispatch[static_cast<size_t>(module)].load(std::memory_order_acquire);
+    return dispatch ? dispatch(name, args, context) : Value();
+}
+
+bool find_function_module(const std::string& name, FunctionModule& module) {
+    return module_of_hash(hash_function_name(name.c_str()), module);
+}
+
+const char* function_module_name(FunctionModule module) {
+    switch (module) {
+        case FunctionModule::TEXT:
+            return "text";
+        case FunctionModule::DATETIME:
+            return "datetime";
+        case FunctionModule::LOOKUP:
+            return "lookup";
+        case FunctionModule::ENGINEERING:
+            return "engineering";
+        case FunctionModule::FINANCIAL:
+            return "financial";
+    }
+    return "";
+}
+
+bool is_function_module_loaded(FunctionModule module) {
+    return module_dispatch[static_cast<size_t>(module)].load(std::memory_order_acquire) !=
+           nullptr;
+}
+
+}  // namespace dispatcher
+}  // namespace functions
+}  // namespace xl_formula
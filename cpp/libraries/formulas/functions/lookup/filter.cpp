@@ -0,0 +1,104 @@
+#include "velox/formulas/array_kernels.h"
+#include "velox/formulas/conditional_utils.h"
+#include "velox/formulas/functions.h"
+#include "velox/formulas/lookup_index.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+/**
+ * @brief Keeps the elements (or table rows) whose include flag is TRUE
+ * @name FILTER
+ * @category lookup
+ * @param array Flat array or table (array of rows) to filter
+ * @param include Flags, one per element (or row); nonzero numbers count as TRUE
+ * @param if_empty Value returned when nothing is kept (optional, default #N/A)
+ * @code
+ * FILTER({1,2,3,4},{1,2,3,4}>2) -> {3,4}
+ * FILTER({"a","b"},{FALSE,FALSE},"none") -> "none"
+ * @endcode
+ */
+// FILTER(array, include, [if_empty])
+Value filter(const std::vector<Value>& args, const Context& context) {
+    (void)context;
+    if (args.size() < 2 || args.size() > 3) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    if (args[0].isError()) {
+        return args[0];
+    }
+    if (args[1].isError()) {
+        return args[1];
+    }
+
+    lookup::TableShape shape;
+    auto shapeError = lookup::getTableShape(args[0], shape);
+    if (!shapeError.isEmpty()) {
+        return shapeError;
+    }
+    const size_t count = shape.rows;
+    if (!args[1].isArray() ? count != 1 : args[1].asArrayData().size() != count) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+
+    // Build the selection mask; comparisons over packed arrays arrive as packed 1.0 / 0.0
+    conditional::SelectionMask selection((count + 63) / 64, 0);
+    NumberSpan flags;
+    if (args[1].isArray() && utils::numericArrayView(args[1], flags)) {
+        for (size_t i = 0; i < count; ++i) {
+            selection[i / 64] |= uint64_t{flags[i] != 0.0} << (i % 64);
+        }
+    } else {
+        // Comparisons yield boolean arrays; test them without numeric conversion
+        const std::vector<Value> single = {args[1]};
+        const auto& values = args[1].isArray() ? args[1].asArrayData().values() : single;
+        for (size_t i = 0; i < count; ++i) {
+            const Value& flag = values[i];
+            bool keep = false;
+            if (flag.isBoolean()) {
+                keep = flag.asBoolean();
+            } else if (flag.isNumber()) {
+                keep = flag.asNumber() != 0.0;
+            } else if (flag.isError()) {
+                return flag;
+            } else if (!flag.isEmpty()) {
+                auto flagV = utils::toNumberSafe(flag, "FILTER");
+                if (flagV.isError()) {
+                    return flagV;
+                }
+                keep = flagV.asNumber() != 0.0;
+            }
+            selection[i / 64] |= uint64_t{keep} << (i % 64);
+        }
+    }
+
+    const size_t kept = conditional::countSelected(selection);
+    if (kept == 0) {
+        return args.size() > 2 ? args[2] : Value::error(ErrorType::NA_ERROR);
+    }
+    if (!args[0].isArray()) {
+        return args[0];
+    }
+
+    const ArrayData& data = args[0].asArrayData();
+    if (data.isNumeric()) {
+        std::vector<double> compacted(count);
+        compacted.resize(kernels::compactNumbers(data.numbers().data(), selection.data(), count,
+                                                 compacted.data()));
+        return Value::numberArray(std::move(compacted));
+    }
+
+    std::vector<Value> items;
+    items.reserve(kept);
+    for (size_t i = 0; i < count; ++i) {
+        if ((selection[i / 64] >> (i % 64)) & 1u) {
+            items.push_back(data.at(i));
+        }
+    }
+    return Value::array(items);
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
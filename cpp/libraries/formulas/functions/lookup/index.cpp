@@ -0,0 +1,92 @@
+#include "velox/formulas/functions.h"
+#include "velox/formulas/lookup_index.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+namespace {
+
+/**
+ * @brief One row or column of a table as an array
+ */
+Value tableSlice(const Value& table, const lookup::TableShape& shape, size_t index, bool row) {
+    const size_t length = row ? shape.cols : shape.rows;
+    std::vector<Value> slice;
+    slice.reserve(length);
+    for (size_t i = 0; i < length; ++i) {
+        slice.push_back(row ? lookup::tableCell(table, shape, index, i)
+                            : lookup::tableCell(table, shape, i, index));
+    }
+    return Value::array(slice);
+}
+
+}  // anonymous namespace
+
+/**
+ * @brief Returns the value at a given row and column of a table
+ * @name INDEX
+ * @category lookup
+ * @param array Table as an array of rows, or a flat array
+ * @param row_num 1-based row (0 selects the whole column)
+ * @param column_num 1-based column (optional, 0 selects the whole row)
+ * @code
+ * INDEX({10,20,30},2) -> 20
+ * INDEX({{1,2},{3,4}},2,1) -> 3
+ * @endcode
+ */
+// INDEX(array, row_num, [column_num])
+Value index_function(const std::vector<Value>& args, const Context& context) {
+    (void)context;
+    if (args.size() < 2 || args.size() > 3) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    if (args[0].isError()) {
+        return args[0];
+    }
+
+    std::vector<size_t> indexes;
+    for (size_t i = 1; i < args.size(); ++i) {
+        auto numV = utils::toNumberSafe(args[i], "INDEX");
+        if (numV.isError()) {
+            return numV;
+        }
+        if (numV.asNumber() < 0.0) {
+            return Value::error(ErrorType::VALUE_ERROR);
+        }
+        indexes.push_back(static_cast<size_t>(numV.asNumber()));
+    }
+
+    lookup::TableShape shape;
+    auto shapeError = lookup::getTableShape(args[0], shape);
+    if (!shapeError.isEmpty()) {
+        return shapeError;
+    }
+
+    size_t row = indexes[0];
+    size_t col = indexes.size() > 1 ? indexes[1] : 1;
+    if (indexes.size() == 1 && shape.rows == 1 && shape.cols > 1) {
+        // A single index into a one-row table selects a column
+        std::swap(row, col);
+    }
+    if (row > shape.rows || col > shape.cols) {
+        return Value::error(ErrorType::REF_ERROR);
+    }
+
+    if (row == 0 && col == 0) {
+        return args[0];
+    }
+    if (row == 0) {
+        return shape.rows == 1 ? lookup::tableCell(args[0], shape, 0, col - 1)
+                               : tableSlice(args[0], shape, col - 1, false);
+    }
+    if (col == 0) {
+        return shape.cols == 1 ? lookup::tableCell(args[0], shape, row - 1, 0)
+                               : tableSlice(args[0], shape, row - 1, true);
+    }
+    return lookup::tableCell(args[0], shape, row - 1, col - 1);
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
@@ -0,0 +1,49 @@
+#include "velox/formulas/functions.h"
+
+namespace xl_formula {
+namespace functions {
+namespace dispatcher {
+
+Value dispatch_lookup_function(const std::string& name, const std::vector<Value>& args,
+                               const Context& context) {
+    switch (hash_function_name(name.c_str())) {
+        case hash_function_name("CHOOSE"):
+            return builtin::choose(args, context);
+        case hash_function_name("ROW"):
+            return builtin::row_function(args, context);
+        case hash_function_name("COLUMN"):
+            return builtin::column_function(args, context);
+        case hash_function_name("VLOOKUP"):
+            return builtin::vlookup(args, context);
+        case hash_function_name("HLOOKUP"):
+            return builtin::hlookup(args, context);
+        case hash_function_name("INDEX"):
+            return builtin::index_function(args, context);
+        case hash_function_name("MATCH"):
+            return builtin::match(args, context);
+        case hash_function_name("XLOOKUP"):
+            return builtin::xlookup(args, context);
+        case hash_function_name("SORT"):
+            return builtin::sort(args, context);
+        case hash_function_name("SORTBY"):
+            return builtin::sortby(args, context);
+        case hash_function_name("FILTER"):
+            return builtin::filter(args, context);
+        case hash_function_name("UNIQUE"):
+            return builtin::unique(args, context);
+        default:
+            return Value();
+    }
+}
+
+#if defined(VELOX_SPLIT_FUNCTION_MODULES)
+namespace {
+// Loaded as a side module: make the functions reachable from the core's dispatcher
+[[maybe_unused]] const bool registered =
+        (register_function_module(FunctionModule::LOOKUP, &dispatch_lookup_function), true);
+}  // anonymous namespace
+#endif
+
+}  // namespace dispatcher
+}  // namespace functions
+}  // namespace xl_formula
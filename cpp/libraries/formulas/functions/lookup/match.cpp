@@ -0,0 +1,59 @@
+#include "velox/formulas/functions.h"
+#include "velox/formulas/lookup_index.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+/**
+ * @brief Returns the position of a value in a one-row or one-column array
+ * @name MATCH
+ * @category lookup
+ * @param lookup_value Value to find
+ * @param lookup_array Array to search
+ * @param match_type 1 (default) largest value <= lookup_value, 0 exact (wildcards allowed),
+ * -1 smallest value >= lookup_value
+ * @code
+ * MATCH(25,{10,20,30}) -> 2
+ * MATCH("b*",{"apple","banana"},0) -> 2
+ * @endcode
+ */
+// MATCH(lookup_value, lookup_array, [match_type])
+Value match(const std::vector<Value>& args, const Context& context) {
+    if (args.size() < 2 || args.size() > 3) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    if (args[0].isError()) {
+        return args[0];
+    }
+
+    lookup::MatchMode mode = lookup::MatchMode::FLOOR;
+    if (args.size() == 3) {
+        auto typeV = utils::toNumberSafe(args[2], "MATCH");
+        if (typeV.isError()) {
+            return typeV;
+        }
+        if (typeV.asNumber() == 0.0) {
+            mode = lookup::MatchMode::WILDCARD;
+        } else if (typeV.asNumber() < 0.0) {
+            mode = lookup::MatchMode::CEIL;
+        }
+    }
+
+    lookup::TableShape shape;
+    auto shapeError = lookup::getTableShape(args[1], shape);
+    if (!shapeError.isEmpty()) {
+        return shapeError;
+    }
+
+    size_t position =
+            lookup::findPosition(context, args[0], args[1], shape, lookup::Axis::VECTOR, mode);
+    if (position == lookup::npos) {
+        return Value::error(ErrorType::NA_ERROR);
+    }
+    return Value(static_cast<double>(position + 1));
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
@@ -0,0 +1,294 @@
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+#include "velox/formulas/array_kernels.h"
+#include "velox/formulas/functions.h"
+#include "velox/formulas/lookup_index.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+namespace {
+
+int sortRank(const Value& value) {
+    switch (value.getType()) {
+        case ValueType::NUMBER:
+            return 0;
+        case ValueType::TEXT:
+            return 1;
+        case ValueType::BOOLEAN:
+            return 2;
+        case ValueType::EMPTY:
+            return 3;
+        default:
+            return 4;
+    }
+}
+
+/**
+ * @brief Excel sort order: numbers < text (case-insensitive) < logicals < blanks < errors
+ */
+int compareSortKeys(const Value& a, const Value& b) {
+    const int rank_a = sortRank(a);
+    const int rank_b = sortRank(b);
+    if (rank_a != rank_b) {
+        return rank_a < rank_b ? -1 : 1;
+    }
+    switch (rank_a) {
+        case 0:
+            return a.asNumber() < b.asNumber() ? -1 : (b.asNumber() < a.asNumber() ? 1 : 0);
+        case 1: {
+            const std::string& x = a.asText();
+            const std::string& y = b.asText();
+            for (size_t i = 0; i < x.size() && i < y.size(); ++i) {
+                int cx = std::tolower(static_cast<unsigned char>(x[i]));
+                int cy = std::tolower(static_cast<unsigned char>(y[i]));
+                if (cx != cy) {
+                    return cx < cy ? -1 : 1;
+                }
+            }
+            return x.size() < y.size() ? -1 : (x.size() > y.size() ? 1 : 0);
+        }
+        case 2:
+            return static_cast<int>(a.asBoolean()) - static_cast<int>(b.asBoolean());
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Stable sort of item positions by one key per item
+ * @param keys Key of each item, indexed by item position
+ * @param descending Largest key first
+ * @param order Current order of the items, re-sorted in place
+ */
+void sortPositions(const std::vector<Value>& keys, bool descending, std::vector<size_t>& order) {
+    const bool numeric =
+            std::all_of(keys.begin(), keys.end(), [](const Value& key) { return key.isNumber(); });
+    if (numeric) {
+        // Packed keys go through the radix sort kernel
+        std::vector<double> gathered(order.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            gathered[i] = keys[order[i]].asNumber();
+        }
+        std::vector<size_t> permutation;
+        kernels::sortOrder(gathered.data(), gathered.size(), descending, permutation);
+        std::vector<size_t> sorted(order.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            sorted[i] = order[permutation[i]];
+        }
+        order.swap(sorted);
+        return;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return descending ? compareSortKeys(keys[b], keys[a]) < 0
+                          : compareSortKeys(keys[a], keys[b]) < 0;
+    });
+}
+
+/**
+ * @brief Items in the given order: elements of a flat array or rows of a table
+ */
+Value gatherItems(const ArrayData& data, const std::vector<size_t>& order) {
+    std::vector<Value> items;
+    items.reserve(order.size());
+    for (size_t position : order) {
+        items.push_back(data.at(position));
+    }
+    return Value::array(items);
+}
+
+/**
+ * @brief Key of each item: the element itself, or one column of each table row
+ */
+std::vector<Value> itemKeys(const Value& table, const lookup::TableShape& shape, size_t column) {
+    std::vector<Value> keys;
+    keys.reserve(shape.rows);
+    for (size_t row = 0; row < shape.rows; ++row) {
+        keys.push_back(lookup::tableCell(table, shape, row, column));
+    }
+    return keys;
+}
+
+Value parseSortOrder(const Value& arg, const char* name, bool& descending) {
+    auto orderV = utils::toNumberSafe(arg, name);
+    if (orderV.isError()) {
+        return orderV;
+    }
+    if (orderV.asNumber() != 1.0 && orderV.asNumber() != -1.0) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    descending = orderV.asNumber() < 0.0;
+    return Value::empty();
+}
+
+}  // anonymous namespace
+
+/**
+ * @brief Sorts the elements of an array or the rows of a table
+ * @name SORT
+ * @category lookup
+ * @param array Flat array or table (array of rows) to sort
+ * @param sort_index 1-based column (row when by_col) to sort by (optional, default 1)
+ * @param sort_order 1 ascending (default) or -1 descending
+ * @param by_col TRUE to sort the columns of a table instead of its rows (optional)
+ * @code
+ * SORT({3,1,2}) -> {1,2,3}
+ * SORT({{2,"b"},{1,"a"}}) -> {{1,"a"},{2,"b"}}
+ * @endcode
+ */
+// SORT(array, [sort_index], [sort_order], [by_col])
+Value sort(const std::vector<Value>& args, const Context& context) {
+    (void)context;
+    if (args.empty() || args.size() > 4) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    if (args[0].isError()) {
+        return args[0];
+    }
+
+    size_t sort_index = 1;
+    bool descending = false;
+    bool by_col = false;
+    if (args.size() > 1) {
+        auto indexV = utils::toNumberSafe(args[1], "SORT");
+        if (indexV.isError()) {
+            return indexV;
+        }
+        if (indexV.asNumber() < 1.0) {
+            return Value::error(ErrorType::VALUE_ERROR);
+        }
+        sort_index = static_cast<size_t>(indexV.asNumber());
+    }
+    if (args.size() > 2) {
+        auto orderError = parseSortOrder(args[2], "SORT", descending);
+        if (!orderError.isEmpty()) {
+            return orderError;
+        }
+    }
+    if (args.size() > 3) {
+        auto byColV = utils::toNumberSafe(args[3], "SORT");
+        if (byColV.isError()) {
+            return byColV;
+        }
+        by_col = byColV.asNumber() != 0.0;
+    }
+
+    if (!args[0].isArray()) {
+        return sort_index == 1 ? args[0] : Value::error(ErrorType::VALUE_ERROR);
+    }
+
+    lookup::TableShape shape;
+    auto shapeError = lookup::getTableShape(args[0], shape);
+    if (!shapeError.isEmpty()) {
+        return shapeError;
+    }
+
+    Value table = args[0];
+    if (by_col && shape.nested) {
+        table = lookup::transposeTable(args[0], shape);
+        lookup::getTableShape(table, shape);
+    }
+    if (sort_index > shape.cols) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+
+    const ArrayData& data = table.asArrayData();
+    if (data.isNumeric()) {
+        NumberSpan numbers = data.numbers();
+        std::vector<double> sorted(numbers.begin(), numbers.end());
+        kernels::sortNumbers(sorted.data(), sorted.size(), descending);
+        return Value::numberArray(std::move(sorted));
+    }
+
+    std::vector<size_t> order(shape.rows);
+    std::iota(order.begin(), order.end(), size_t{0});
+    sortPositions(itemKeys(table, shape, sort_index - 1), descending, order);
+    Value result = gatherItems(data, order);
+    if (by_col && shape.nested) {
+        lookup::getTableShape(result, shape);
+        return lookup::transposeTable(result, shape);
+    }
+    return result;
+}
+
+/**
+ * @brief Sorts an array or table by the values of other arrays
+ * @name SORTBY
+ * @category lookup
+ * @param array Flat array or table (array of rows) to sort
+ * @param by_array1 Keys, one per element (or row) of array
+ * @param sort_order1 1 ascending (default) or -1 descending
+ * @param by_array2 Further keys and orders that break ties (optional, variadic)
+ * @code
+ * SORTBY({"a","b","c"},{3,1,2}) -> {"b","c","a"}
+ * SORTBY({"a","b","c"},{1,2,1},-1) -> {"b","a","c"}
+ * @endcode
+ */
+// SORTBY(array, by_array1, [sort_order1], [by_array2, sort_order2], ...)
+Value sortby(const std::vector<Value>& args, const Context& context) {
+    (void)context;
+    if (args.size() < 2) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    auto errorCheck = utils::checkForErrors(args);
+    if (!errorCheck.isEmpty()) {
+        return errorCheck;
+    }
+
+    lookup::TableShape shape;
+    auto shapeError = lookup::getTableShape(args[0], shape);
+    if (!shapeError.isEmpty()) {
+        return shapeError;
+    }
+
+    // Each by_array is optionally followed by a scalar sort order
+    std::vector<std::vector<Value>> keys;
+    std::vector<bool> descending;
+    for (size_t i = 1; i < args.size();) {
+        lookup::TableShape by_shape;
+        auto byError = lookup::getTableShape(args[i], by_shape);
+        if (!byError.isEmpty()) {
+            return byError;
+        }
+        const bool row = by_shape.rows == 1 && by_shape.cols > 1;
+        if ((row ? by_shape.cols : (by_shape.cols == 1 ? by_shape.rows : 0)) != shape.rows) {
+            return Value::error(ErrorType::VALUE_ERROR);
+        }
+        keys.emplace_back();
+        for (size_t k = 0; k < shape.rows; ++k) {
+            keys.back().push_back(row ? lookup::tableCell(args[i], by_shape, 0, k)
+                                      : lookup::tableCell(args[i], by_shape, k, 0));
+        }
+
+        bool desc = false;
+        if (i + 1 < args.size() && !args[i + 1].isArray()) {
+            auto orderError = parseSortOrder(args[i + 1], "SORTBY", desc);
+            if (!orderError.isEmpty()) {
+                return orderError;
+            }
+            i += 2;
+        } else {
+            i += 1;
+        }
+        descending.push_back(desc);
+    }
+
+    if (!args[0].isArray()) {
+        return args[0];
+    }
+
+    // Stable sorts from the last key to the first leave ties ordered by later keys
+    std::vector<size_t> order(shape.rows);
+    std::iota(order.begin(), order.end(), size_t{0});
+    for (size_t k = keys.size(); k-- > 0;) {
+        sortPositions(keys[k], descending[k], order);
+    }
+    return gatherItems(args[0].asArrayData(), order);
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
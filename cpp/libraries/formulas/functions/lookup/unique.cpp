@@ -0,0 +1,167 @@
+#include <cctype>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include "velox/formulas/functions.h"
+#include "velox/formulas/lookup_index.h"
+#include "velox/formulas/number_table.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+namespace {
+
+/**
+ * @brief Append a hashable encoding of a value; text is case-folded like Excel's UNIQUE
+ */
+void appendKey(const Value& value, std::string& key) {
+    switch (value.getType()) {
+        case ValueType::NUMBER: {
+            double number = value.asNumber() == 0.0 ? 0.0 : value.asNumber();
+            char bytes[sizeof(double)];
+            std::memcpy(bytes, &number, sizeof(double));
+            key.push_back('n');
+            key.append(bytes, sizeof(bytes));
+            break;
+        }
+        case ValueType::TEXT: {
+            const std::string text = value.asText();
+            key.push_back('t');
+            key.append(std::to_string(text.size()));
+            key.push_back(':');
+            for (char c : text) {
+                key.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+            }
+            break;
+        }
+        case ValueType::BOOLEAN:
+            key.push_back(value.asBoolean() ? 'T' : 'F');
+            break;
+        case ValueType::ERROR:
+            key.push_back('x');
+            key.push_back(static_cast<char>('0' + static_cast<int>(value.asError())));
+            break;
+        default:
+            key.push_back('e');
+            break;
+    }
+}
+
+}  // anonymous namespace
+
+/**
+ * @brief Returns the distinct elements of an array or the distinct rows of a table
+ * @name UNIQUE
+ * @category lookup
+ * @param array Flat array or table (array of rows)
+ * @param by_col TRUE to compare the columns of a table instead of its rows (optional)
+ * @param exactly_once TRUE to keep only items that occur exactly once (optional)
+ * @code
+ * UNIQUE({1,2,2,3,1}) -> {1,2,3}
+ * UNIQUE({"a","A","b"},FALSE,TRUE) -> {"b"}
+ * @endcode
+ */
+// UNIQUE(array, [by_col], [exactly_once])
+Value unique(const std::vector<Value>& args, const Context& context) {
+    (void)context;
+    if (args.empty() || args.size() > 3) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    if (args[0].isError()) {
+        return args[0];
+    }
+
+    bool flags[2] = {false, false};
+    for (size_t i = 1; i < args.size(); ++i) {
+        auto flagV = utils::toNumberSafe(args[i], "UNIQUE");
+        if (flagV.isError()) {
+            return flagV;
+        }
+        flags[i - 1] = flagV.asNumber() != 0.0;
+    }
+    const bool by_col = flags[0];
+    const bool exactly_once = flags[1];
+
+    if (!args[0].isArray()) {
+        return args[0];
+    }
+
+    lookup::TableShape shape;
+    auto shapeError = lookup::getTableShape(args[0], shape);
+    if (!shapeError.isEmpty()) {
+        return shapeError;
+    }
+    Value table = args[0];
+    const bool transposed = by_col && shape.nested;
+    if (transposed) {
+        table = lookup::transposeTable(args[0], shape);
+    }
+    const ArrayData& data = table.asArrayData();
+
+    if (data.isNumeric()) {
+        // Packed numbers: one pass through an open-addressing table
+        NumberSpan numbers = data.numbers();
+        NumberTable table_counts(numbers.size());
+        for (size_t i = 0; i < numbers.size(); ++i) {
+            table_counts.add(numbers[i], i);
+        }
+        std::vector<double> distinct;
+        distinct.reserve(table_counts.size());
+        for (const auto& entry : table_counts.entries()) {
+            if (!exactly_once || entry.count == 1) {
+                distinct.push_back(entry.key);
+            }
+        }
+        if (distinct.empty()) {
+            return Value::error(ErrorType::NA_ERROR);
+        }
+        return Value::numberArray(std::move(distinct));
+    }
+
+    struct Seen {
+        size_t count;
+        size_t first;
+    };
+    const auto& items = data.values();
+    std::unordered_map<std::string, Seen> seen;
+    seen.reserve(items.size());
+    std::vector<const Seen*> first_seen;
+    std::string key;
+    for (size_t i = 0; i < items.size(); ++i) {
+        key.clear();
+        if (items[i].isArray()) {
+            for (const auto& cell : items[i].asArrayData().values()) {
+                appendKey(cell, key);
+            }
+        } else {
+            appendKey(items[i], key);
+        }
+        auto inserted = seen.emplace(key, Seen{0, i});
+        if (inserted.second) {
+            first_seen.push_back(&inserted.first->second);
+        }
+        ++inserted.first->second.count;
+    }
+
+    std::vector<Value> result;
+    for (const Seen* entry : first_seen) {
+        if (!exactly_once || entry->count == 1) {
+            result.push_back(items[entry->first]);
+        }
+    }
+    if (result.empty()) {
+        return Value::error(ErrorType::NA_ERROR);
+    }
+
+    Value distinct = Value::array(result);
+    if (transposed) {
+        lookup::getTableShape(distinct, shape);
+        return lookup::transposeTable(distinct, shape);
+    }
+    return distinct;
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
@@ -0,0 +1,105 @@
+#include "velox/formulas/functions.h"
+#include "velox/formulas/lookup_index.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+namespace {
+
+/**
+ * @brief Shared implementation of VLOOKUP (vertical) and HLOOKUP (horizontal)
+ */
+Value tableLookup(const std::vector<Value>& args, const Context& context, bool vertical,
+                  const char* name) {
+    if (args.size() < 3 || args.size() > 4) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    if (args[0].isError()) {
+        return args[0];
+    }
+
+    auto indexV = utils::toNumberSafe(args[2], name);
+    if (indexV.isError()) {
+        return indexV;
+    }
+    bool approximate = true;
+    if (args.size() == 4) {
+        auto rangeV = utils::toNumberSafe(args[3], name);
+        if (rangeV.isError()) {
+            return rangeV;
+        }
+        approximate = rangeV.asNumber() != 0.0;
+    }
+
+    lookup::TableShape shape;
+    auto shapeError = lookup::getTableShape(args[1], shape);
+    if (!shapeError.isEmpty()) {
+        return shapeError;
+    }
+    if (!vertical && !shape.nested) {
+        // A flat array is a single row for HLOOKUP
+        std::swap(shape.rows, shape.cols);
+    }
+
+    int index = static_cast<int>(indexV.asNumber());
+    const size_t extent = vertical ? shape.cols : shape.rows;
+    if (index < 1) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    if (static_cast<size_t>(index) > extent) {
+        return Value::error(ErrorType::REF_ERROR);
+    }
+
+    const auto axis = vertical ? lookup::Axis::FIRST_COLUMN : lookup::Axis::FIRST_ROW;
+    const auto mode = approximate ? lookup::MatchMode::FLOOR : lookup::MatchMode::WILDCARD;
+    size_t position = lookup::findPosition(context, args[0], args[1], shape, axis, mode);
+    if (position == lookup::npos) {
+        return Value::error(ErrorType::NA_ERROR);
+    }
+
+    const size_t offset = static_cast<size_t>(index - 1);
+    return vertical ? lookup::tableCell(args[1], shape, position, offset)
+                    : lookup::tableCell(args[1], shape, offset, position);
+}
+
+}  // anonymous namespace
+
+/**
+ * @brief Looks up a value in the first column of a table and returns a value in the same row
+ * @name VLOOKUP
+ * @category lookup
+ * @param lookup_value Value to find in the first column
+ * @param table_array Table as an array of rows
+ * @param col_index_num 1-based column of the value to return
+ * @param range_lookup TRUE (default) for the nearest smaller match, FALSE for an exact match
+ * @code
+ * VLOOKUP(2,{{1,"a"},{2,"b"},{3,"c"}},2,FALSE) -> "b"
+ * VLOOKUP(2.5,{{1,"a"},{2,"b"},{3,"c"}},2) -> "b"
+ * @endcode
+ */
+// VLOOKUP(lookup_value, table_array, col_index_num, [range_lookup])
+Value vlookup(const std::vector<Value>& args, const Context& context) {
+    return tableLookup(args, context, true, "VLOOKUP");
+}
+
+/**
+ * @brief Looks up a value in the first row of a table and returns a value in the same column
+ * @name HLOOKUP
+ * @category lookup
+ * @param lookup_value Value to find in the first row
+ * @param table_array Table as an array of rows
+ * @param row_index_num 1-based row of the value to return
+ * @param range_lookup TRUE (default) for the nearest smaller match, FALSE for an exact match
+ * @code
+ * HLOOKUP("b",{{"a","b","c"},{1,2,3}},2,FALSE) -> 2
+ * @endcode
+ */
+// HLOOKUP(lookup_value, table_array, row_index_num, [range_lookup])
+Value hlookup(const std::vector<Value>& args, const Context& context) {
+    return tableLookup(args, context, false, "HLOOKUP");
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
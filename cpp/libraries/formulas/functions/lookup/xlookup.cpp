@@ -0,0 +1,111 @@
+#include "velox/formulas/functions.h"
+#include "velox/formulas/lookup_index.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+/**
+ * @brief Searches an array and returns the matching item from another array
+ * @name XLOOKUP
+ * @category lookup
+ * @param lookup_value Value to find
+ * @param lookup_array One-row or one-column array to search
+ * @param return_array Array of the same length, or a table with one row (or column) per key
+ * @param if_not_found Value returned when nothing matches (optional, default #N/A)
+ * @param match_mode 0 exact (default), -1 exact or next smaller, 1 exact or next larger,
+ * 2 wildcard
+ * @param search_mode 1 first-to-last (default), -1 last-to-first, 2 / -2 binary search
+ * @code
+ * XLOOKUP("b",{"a","b","c"},{1,2,3}) -> 2
+ * XLOOKUP(25,{10,20,30},{"x","y","z"},"none",1) -> "z"
+ * @endcode
+ */
+// XLOOKUP(lookup_value, lookup_array, return_array, [if_not_found], [match_mode], [search_mode])
+Value xlookup(const std::vector<Value>& args, const Context& context) {
+    if (args.size() < 3 || args.size() > 6) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    if (args[0].isError()) {
+        return args[0];
+    }
+
+    int modes[2] = {0, 1};
+    for (size_t i = 4; i < args.size(); ++i) {
+        auto modeV = utils::toNumberSafe(args[i], "XLOOKUP");
+        if (modeV.isError()) {
+            return modeV;
+        }
+        modes[i - 4] = static_cast<int>(modeV.asNumber());
+    }
+
+    lookup::MatchMode mode;
+    switch (modes[0]) {
+        case 0:
+            mode = lookup::MatchMode::EXACT;
+            break;
+        case -1:
+            mode = lookup::MatchMode::EXACT_OR_SMALLER;
+            break;
+        case 1:
+            mode = lookup::MatchMode::EXACT_OR_LARGER;
+            break;
+        case 2:
+            mode = lookup::MatchMode::WILDCARD;
+            break;
+        default:
+            return Value::error(ErrorType::VALUE_ERROR);
+    }
+    // Binary search modes give the same result as a full search over sorted data
+    if (modes[1] != 1 && modes[1] != -1 && modes[1] != 2 && modes[1] != -2) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+
+    lookup::TableShape keys;
+    lookup::TableShape results;
+    auto shapeError = lookup::getTableShape(args[1], keys);
+    if (shapeError.isEmpty()) {
+        shapeError = lookup::getTableShape(args[2], results);
+    }
+    if (!shapeError.isEmpty()) {
+        return shapeError;
+    }
+
+    // Keys run down a column unless lookup_array is a single row
+    const bool horizontal = keys.rows == 1 && keys.cols > 1;
+    const size_t count = horizontal ? keys.cols : keys.rows;
+    // A flat return_array fits either orientation
+    const bool flat = !results.nested;
+    if ((horizontal && !flat ? results.cols : results.rows) != count) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+
+    size_t position = lookup::findPosition(context, args[0], args[1], keys, lookup::Axis::VECTOR,
+                                           mode, modes[1] == -1);
+    if (position == lookup::npos) {
+        return args.size() > 3 ? args[3] : Value::error(ErrorType::NA_ERROR);
+    }
+
+    if (flat) {
+        return lookup::tableCell(args[2], results, position, 0);
+    }
+    if (horizontal) {
+        if (results.rows == 1) {
+            return lookup::tableCell(args[2], results, 0, position);
+        }
+        std::vector<Value> column;
+        column.reserve(results.rows);
+        for (size_t row = 0; row < results.rows; ++row) {
+            column.push_back(lookup::tableCell(args[2], results, row, position));
+        }
+        return Value::array(column);
+    }
+    if (results.cols == 1) {
+        return lookup::tableCell(args[2], results, position, 0);
+    }
+    return args[2].asArrayData().at(position);
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
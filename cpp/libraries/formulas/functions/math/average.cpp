@@ -1,5 +1,5 @@
 #include <velox/formulas/functions.h>
-#include <numeric>
+#include <velox/formulas/statistical_utils.h>
 
 namespace xl_formula {
 namespace functions {
@@ -8,29 +8,34 @@ namespace builtin {
 /**
  * @brief Returns the average (arithmetic mean) of the arguments
  * @ingroup math
- * @param number1 First number (optional)
- * @param number2 Additional numbers (variadic)
+ * @param number1 First number or array (optional)
+ * @param number2 Additional numbers or arrays (variadic)
  * @code
  * AVERAGE(1,2,3,4,5) -> 3
+ * AVERAGE({2,4},6) -> 4
  * @endcode
  */
 Value average(const std::vector<Value>& args, const Context& context) {
+    (void)context;  // Unused parameter
+
     // AVERAGE requires at least one argument
     auto validation = utils::validateMinArgs(args, 1, "AVERAGE");
     if (!validation.isEmpty()) {
         return validation;
     }
 
-    return templates::multiNumericFunction(
-            args, context, "AVERAGE", [](const std::vector<double>& nums) {
-                if (nums.empty()) {
-                    throw std::runtime_error("AVERAGE: No numeric values found");
-                }
-                double sum = std::accumulate(nums.begin(), nums.end(), 0.0);
-                return sum / nums.size();
-            });
+    kernels::SumAccumulator total;
+    size_t count = 0;
+    auto error = statistics::accumulateSum(args, total, count);
+    if (!error.isEmpty()) {
+        return error;
+    }
+    if (count == 0) {
+        return Value::error(ErrorType::DIV_ZERO);
+    }
+    return Value(total.total() / static_cast<double>(count));
 }
 
 }  // namespace builtin
 }  // namespace functions
-}  // namespace xl_formula
\ No newline at end of file
+}  // namespace xl_formula
@@ -14,6 +14,7 @@ namespace builtin {
  * @param average_range Values to average (optional)
  * @code
  * AVERAGEIF(3, "=3", 5) -> 5
+ * AVERAGEIF({1,5,10}, ">=5") -> 7.5
  * @endcode
  */
 Value averageif(const std::vector<Value>& args, const Context& context) {
@@ -35,11 +36,33 @@ Value averageif(const std::vector<Value>& args, const Context& context) {
         if (averageRangeArg.isError())
             return averageRangeArg;
 
+        auto criteria = conditional::CompiledCriteria::cached(criteriaArg);
+
+        // Range form: average the average_range entries whose range entry matches
+        if (rangeArg.isArray()) {
+            const ArrayData& range = rangeArg.asArrayData();
+            if (!averageRangeArg.isArray() ||
+                averageRangeArg.asArrayData().size() != range.size()) {
+                return Value::error(ErrorType::VALUE_ERROR);
+            }
+            conditional::SelectionMask selection;
+            criteria->select(range, selection);
+            size_t counted = 0;
+            Value total = conditional::maskedSum(averageRangeArg.asArrayData(), selection, counted);
+            if (total.isError()) {
+                return total;
+            }
+            if (counted == 0) {
+                return Value::error(ErrorType::DIV_ZERO);
+            }
+            return Value(total.asNumber() / static_cast<double>(counted));
+        }
+
         double sum = 0.0;
         int count = 0;
 
-        // Simple implementation: check if single value meets criteria
-        if (::xl_formula::conditional::evaluateCriteria(rangeArg, criteriaArg)) {
+        // Single value: check if it meets the criteria
+        if (criteria->matches(rangeArg)) {
             auto numValue = utils::toNumberSafe(averageRangeArg, "AVERAGEIF");
             if (numValue.isError()) {
                 return numValue;
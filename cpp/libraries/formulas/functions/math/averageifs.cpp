@@ -16,6 +16,7 @@ namespace builtin {
  * @param criteria2 Additional conditions (optional, variadic)
  * @code
  * AVERAGEIFS(5, 3, "=3") -> 5
+ * AVERAGEIFS({10,20,30}, {1,2,3}, ">1") -> 25
  * @endcode
  */
 Value averageifs(const std::vector<Value>& args, const Context& context) {
@@ -34,6 +35,25 @@ Value averageifs(const std::vector<Value>& args, const Context& context) {
             return averageRangeArg;
         }
 
+        // Range form: one bitmap per criteria range, ANDed, then a masked average
+        if (averageRangeArg.isArray()) {
+            conditional::SelectionMask selection;
+            Value status = conditional::selectAllCriteria(
+                    args, 1, averageRangeArg.asArrayData().size(), selection);
+            if (!status.isEmpty()) {
+                return status;
+            }
+            size_t counted = 0;
+            Value total = conditional::maskedSum(averageRangeArg.asArrayData(), selection, counted);
+            if (total.isError()) {
+                return total;
+            }
+            if (counted == 0) {
+                return Value::error(ErrorType::DIV_ZERO);
+            }
+            return Value(total.asNumber() / static_cast<double>(counted));
+        }
+
         double sum = 0.0;
         int count = 0;
         bool matchesAllCriteria = true;
@@ -48,8 +68,8 @@ Value averageifs(const std::vector<Value>& args, const Context& context) {
             if (criteria.isError())
                 return criteria;
 
-            // Simple implementation: check if single value meets criteria
-            if (!::xl_formula::conditional::evaluateCriteria(criteriaRange, criteria)) {
+            // Single values: check if each meets its criteria
+            if (!conditional::CompiledCriteria::cached(criteria)->matches(criteriaRange)) {
                 matchesAllCriteria = false;
                 break;
             }
@@ -1,10 +1,23 @@
 #include <cmath>
 #include "velox/formulas/functions.h"
+#include "velox/formulas/statistical_utils.h"
 
 namespace xl_formula {
 namespace functions {
 namespace builtin {
 
+// Paired moments of (x, y) in one pass; fails with #DIV/0! for fewer than two pairs
+static Value pairedMoments(const std::vector<Value>& args, kernels::CoMoments& moments) {
+    if (args.size() < 2)
+        return Value::error(ErrorType::VALUE_ERROR);
+    auto error = statistics::accumulateCoMoments(args, moments);
+    if (!error.isEmpty())
+        return error;
+    if (moments.count < 2)
+        return Value::error(ErrorType::DIV_ZERO);
+    return Value::empty();
+}
+
 /**
  * @brief Pearson correlation coefficient between two data sets
  * @ingroup math
@@ -21,56 +34,14 @@ namespace builtin {
 Value correl(const std::vector<Value>& args, const Context& context) {
     (void)context;
 
-    if (args.size() < 2) {
-        return Value::error(ErrorType::VALUE_ERROR);
-    }
-
-    // Flatten numeric values and split into two vectors
-    std::vector<double> x, y;
-    if (args.size() == 2 && args[0].isArray() && args[1].isArray()) {
-        for (const auto& v : args[0].asArray())
-            if (v.canConvertToNumber())
-                x.push_back(v.toNumber());
-        for (const auto& v : args[1].asArray())
-            if (v.canConvertToNumber())
-                y.push_back(v.toNumber());
-    } else {
-        // Split list in half
-        size_t mid = args.size() / 2;
-        for (size_t i = 0; i < mid; ++i)
-            if (args[i].canConvertToNumber())
-                x.push_back(args[i].toNumber());
-        for (size_t i = mid; i < args.size(); ++i)
-            if (args[i].canConvertToNumber())
-                y.push_back(args[i].toNumber());
-    }
+    kernels::CoMoments m;
+    auto error = pairedMoments(args, m);
+    if (!error.isEmpty())
+        return error;
 
-    size_t n = std::min(x.size(), y.size());
-    if (n < 2)
+    if (m.m2_x == 0.0 || m.m2_y == 0.0)
         return Value::error(ErrorType::DIV_ZERO);
-
-    // Compute means
-    double sx = 0.0, sy = 0.0;
-    for (size_t i = 0; i < n; ++i) {
-        sx += x[i];
-        sy += y[i];
-    }
-    double mx = sx / static_cast<double>(n);
-    double my = sy / static_cast<double>(n);
-
-    // Compute covariance and variances
-    double sxy = 0.0, sxx = 0.0, syy = 0.0;
-    for (size_t i = 0; i < n; ++i) {
-        double dx = x[i] - mx;
-        double dy = y[i] - my;
-        sxy += dx * dy;
-        sxx += dx * dx;
-        syy += dy * dy;
-    }
-
-    if (sxx == 0.0 || syy == 0.0)
-        return Value::error(ErrorType::DIV_ZERO);
-    double r = sxy / std::sqrt(sxx * syy);
+    double r = m.c_xy / std::sqrt(m.m2_x * m.m2_y);
     return Value(r);
 }
 
@@ -93,31 +64,6 @@ Value rsq(const std::vector<Value>& args, const Context& context) {
     return Value(v * v);
 }
 
-// Helpers for regression
-static bool extractXY(const std::vector<Value>& args, std::vector<double>& x,
-                      std::vector<double>& y) {
-    if (args.size() == 2 && args[0].isArray() && args[1].isArray()) {
-        for (const auto& v : args[0].asArray())
-            if (v.canConvertToNumber())
-                x.push_back(v.toNumber());
-        for (const auto& v : args[1].asArray())
-            if (v.canConvertToNumber())
-                y.push_back(v.toNumber());
-    } else {
-        size_t mid = args.size() / 2;
-        for (size_t i = 0; i < mid; ++i)
-            if (args[i].canConvertToNumber())
-                x.push_back(args[i].toNumber());
-        for (size_t i = mid; i < args.size(); ++i)
-            if (args[i].canConvertToNumber())
-                y.push_back(args[i].toNumber());
-    }
-    size_t n = std::min(x.size(), y.size());
-    x.resize(n);
-    y.resize(n);
-    return n >= 2;
-}
-
 /**
  * @brief Returns the slope of the linear regression line through data points
  * @ingroup math
@@ -132,22 +78,13 @@ Value slope(const std::vector<Value>& args, const Context& context) {
     if (args.size() < 2)
         return Value::error(ErrorType::VALUE_ERROR);
     // Excel signature: SLOPE(known_y’s, known_x’s)
-    std::vector<double> y, x;
-    if (!extractXY({args[1], args[0]}, x, y))
+    kernels::CoMoments m;
+    auto error = pairedMoments({args[1], args[0]}, m);
+    if (!error.isEmpty())
+        return error;
+    if (m.m2_x == 0.0)
         return Value::error(ErrorType::DIV_ZERO);
-    size_t n = x.size();
-    double sx = 0, sy = 0, sxx = 0, sxy = 0;
-    for (size_t i = 0; i < n; ++i) {
-        sx += x[i];
-        sy += y[i];
-        sxx += x[i] * x[i];
-        sxy += x[i] * y[i];
-    }
-    double denom = n * sxx - sx * sx;
-    if (denom == 0.0)
-        return Value::error(ErrorType::DIV_ZERO);
-    double m = (n * sxy - sx * sy) / denom;
-    return Value(m);
+    return Value(m.c_xy / m.m2_x);
 }
 
 /**
@@ -164,25 +101,14 @@ Value intercept(const std::vector<Value>& args, const Context& context) {
     if (args.size() < 2)
         return Value::error(ErrorType::VALUE_ERROR);
     // Excel signature: INTERCEPT(known_y’s, known_x’s)
-    std::vector<double> y, x;
-    if (!extractXY({args[1], args[0]}, x, y))
-        return Value::error(ErrorType::DIV_ZERO);
-    size_t n = x.size();
-    double sx = 0, sy = 0, sxx = 0, sxy = 0;
-    for (size_t i = 0; i < n; ++i) {
-        sx += x[i];
-        sy += y[i];
-        sxx += x[i] * x[i];
-        sxy += x[i] * y[i];
-    }
-    double denom = n * sxx - sx * sx;
-    if (denom == 0.0)
+    kernels::CoMoments m;
+    auto error = pairedMoments({args[1], args[0]}, m);
+    if (!error.isEmpty())
+        return error;
+    if (m.m2_x == 0.0)
         return Value::error(ErrorType::DIV_ZERO);
-    double m = (n * sxy - sx * sy) / denom;
-    double bx = sx / static_cast<double>(n);
-    double by = sy / static_cast<double>(n);
-    double b = by - m * bx;
-    return Value(b);
+    double slope_value = m.c_xy / m.m2_x;
+    return Value(m.mean_y - slope_value * m.mean_x);
 }
 
 /**
@@ -199,27 +125,12 @@ Value intercept(const std::vector<Value>& args, const Context& context) {
 // COVAR: historical covariance (population denominator N)
 static Value covarianceImpl(const std::vector<Value>& args, const Context& context, bool sample) {
     (void)context;
-    if (args.size() < 2)
-        return Value::error(ErrorType::VALUE_ERROR);
-    std::vector<double> x, y;
-    if (!extractXY(args, x, y))
-        return Value::error(ErrorType::DIV_ZERO);
-    size_t n = x.size();
-    double sx = 0, sy = 0;
-    for (size_t i = 0; i < n; ++i) {
-        sx += x[i];
-        sy += y[i];
-    }
-    double mx = sx / static_cast<double>(n);
-    double my = sy / static_cast<double>(n);
-    double sxy = 0.0;
-    for (size_t i = 0; i < n; ++i) {
-        sxy += (x[i] - mx) * (y[i] - my);
-    }
-    double denom = sample ? (static_cast<double>(n) - 1.0) : static_cast<double>(n);
-    if (denom == 0.0)
-        return Value::error(ErrorType::DIV_ZERO);
-    return Value(sxy / denom);
+    kernels::CoMoments m;
+    auto error = pairedMoments(args, m);
+    if (!error.isEmpty())
+        return error;
+    double denom = sample ? (static_cast<double>(m.count) - 1.0) : static_cast<double>(m.count);
+    return Value(m.c_xy / denom);
 }
 
 /**
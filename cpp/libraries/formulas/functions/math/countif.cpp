@@ -28,14 +28,14 @@ Value countif(const std::vector<Value>& args, const Context& context) {
         return Value::error(ErrorType::VALUE_ERROR);
     }
 
-    // Last argument is criteria, all others are values to test
-    Value criteria = args.back();
+    // Last argument is criteria, all others are values (or arrays) to test
+    auto criteria = conditional::CompiledCriteria::cached(args.back());
 
-    int count = 0;
-
-    // Test each value against criteria
+    size_t count = 0;
     for (size_t i = 0; i < args.size() - 1; ++i) {
-        if (::xl_formula::conditional::evaluateCriteria(args[i], criteria)) {
+        if (args[i].isArray()) {
+            count += criteria->countMatches(args[i].asArrayData());
+        } else if (criteria->matches(args[i])) {
             count++;
         }
     }
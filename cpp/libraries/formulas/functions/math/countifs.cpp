@@ -0,0 +1,53 @@
+#include "velox/formulas/functions.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+/**
+ * @brief Counts the values that meet multiple conditions
+ * @ingroup math
+ * @param criteria_range1 First range to test
+ * @param criteria1 First condition
+ * @param criteria_range2 Additional ranges (optional, variadic)
+ * @param criteria2 Additional conditions (optional, variadic)
+ * @code
+ * COUNTIFS({1,2,3,4}, ">1", {"a","b","a","a"}, "a") -> 2
+ * @endcode
+ */
+Value countifs(const std::vector<Value>& args, const Context& context) {
+    (void)context;  // Suppress unused parameter warning
+
+    // COUNTIFS requires criteria_range/criteria pairs
+    if (args.size() < 2 || args.size() % 2 != 0) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+
+    // Range form: one bitmap per criteria range, ANDed, then counted
+    if (args[0].isArray()) {
+        conditional::SelectionMask selection;
+        Value status =
+                conditional::selectAllCriteria(args, 0, args[0].asArrayData().size(), selection);
+        if (!status.isEmpty()) {
+            return status;
+        }
+        return Value(static_cast<double>(conditional::countSelected(selection)));
+    }
+
+    // Single values: counts 1 when every value meets its criteria
+    for (size_t i = 0; i < args.size(); i += 2) {
+        if (args[i].isError())
+            return args[i];
+        if (args[i + 1].isError())
+            return args[i + 1];
+        if (args[i].isArray() ||
+            !conditional::CompiledCriteria::cached(args[i + 1])->matches(args[i])) {
+            return Value(0.0);
+        }
+    }
+    return Value(1.0);
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
@@ -0,0 +1,46 @@
+#include <cmath>
+#include <vector>
+#include "velox/formulas/functions.h"
+#include "velox/formulas/statistical_utils.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+/**
+ * @brief Returns the k-th largest value in a data set
+ * @ingroup math
+ * @param array Numbers or array of numbers
+ * @param k Position from the largest (1-based; fractions are rounded up)
+ * @code
+ * LARGE({3,5,3,5,4}, 1) -> 5
+ * LARGE({3,5,3,5,4}, 3) -> 4
+ * @endcode
+ */
+Value large(const std::vector<Value>& args, const Context& context) {
+    auto validation = utils::validateArgCount(args, 2, "LARGE");
+    if (!validation.isEmpty()) {
+        return validation;
+    }
+
+    auto kV = utils::toNumberSafe(args[1], "LARGE");
+    if (kV.isError()) {
+        return kV;
+    }
+    const double k = std::ceil(kV.asNumber());
+
+    statistics::OrderStatistics data;
+    auto loadError = data.load(context, {args[0]});
+    if (!loadError.isEmpty()) {
+        return loadError;
+    }
+    if (k < 1.0 || k > static_cast<double>(data.size())) {
+        return Value::error(ErrorType::NUM_ERROR);
+    }
+
+    return Value(data.kthLargest(static_cast<size_t>(k) - 1));
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
@@ -1,6 +1,6 @@
-#include <algorithm>
 #include <vector>
 #include "velox/formulas/functions.h"
+#include "velox/formulas/statistical_utils.h"
 
 namespace xl_formula {
 namespace functions {
@@ -9,15 +9,14 @@ namespace builtin {
 /**
  * @brief Returns the median (middle value) of the arguments
  * @ingroup math
- * @param number1 First number
- * @param number2 Additional numbers (optional, variadic)
+ * @param number1 First number or array
+ * @param number2 Additional numbers or arrays (optional, variadic)
  * @code
  * MEDIAN(1, 2, 3, 4) -> 2.5
+ * MEDIAN({5, 1, 3}) -> 3
  * @endcode
  */
 Value median(const std::vector<Value>& args, const Context& context) {
-    (void)context;  // Unused parameter
-
     // MEDIAN requires at least one argument
     auto error = utils::validateMinArgs(args, 1, "MEDIAN");
     if (!error.isEmpty()) {
@@ -30,41 +29,22 @@ Value median(const std::vector<Value>& args, const Context& context) {
         return errorCheck;
     }
 
-    std::vector<double> numbers;
-
-    // Collect all numeric values
-    for (const auto& arg : args) {
-        if (arg.isEmpty()) {
-            continue;  // Skip empty values
-        }
-
-        if (arg.canConvertToNumber()) {
-            numbers.push_back(arg.toNumber());
-        }
-        // Non-numeric values are ignored in MEDIAN (Excel behavior)
+    // Selects the middle element(s) instead of sorting; arrays seen before are
+    // answered from their cached sorted copy
+    statistics::OrderStatistics data;
+    auto loadError = data.load(context, args);
+    if (!loadError.isEmpty()) {
+        return loadError;
     }
 
     // If no numeric values found, return error
-    if (numbers.empty()) {
+    if (data.empty()) {
         return Value::error(ErrorType::DIV_ZERO);
     }
 
-    // Sort the numbers
-    std::sort(numbers.begin(), numbers.end());
-
-    // Calculate median
-    size_t size = numbers.size();
-    if (size % 2 == 0) {
-        // Even number of elements - average of two middle values
-        double mid1 = numbers[size / 2 - 1];
-        double mid2 = numbers[size / 2];
-        return Value((mid1 + mid2) / 2.0);
-    } else {
-        // Odd number of elements - middle value
-        return Value(numbers[size / 2]);
-    }
+    return Value(data.percentile(0.5));
 }
 
 }  // namespace builtin
 }  // namespace functions
-}  // namespace xl_formula
\ No newline at end of file
+}  // namespace xl_formula
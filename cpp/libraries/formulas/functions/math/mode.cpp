@@ -1,7 +1,8 @@
 #include <algorithm>
-#include <unordered_map>
 #include <vector>
 #include "velox/formulas/functions.h"
+#include "velox/formulas/number_table.h"
+#include "velox/formulas/statistical_utils.h"
 
 namespace xl_formula {
 namespace functions {
@@ -10,10 +11,11 @@ namespace builtin {
 /**
  * @brief Returns the most frequently occurring value
  * @ingroup math
- * @param number1 First number
- * @param number2 Additional numbers (optional, variadic)
+ * @param number1 First number or array
+ * @param number2 Additional numbers or arrays (optional, variadic)
  * @code
  * MODE(1,2,2,3) -> 2
+ * MODE({4,5,5,4}) -> 4
  * @endcode
  */
 Value mode(const std::vector<Value>& args, const Context& context) {
@@ -25,66 +27,70 @@ Value mode(const std::vector<Value>& args, const Context& context) {
         return error;
     }
 
-    // Check for errors first
-    auto errorCheck = utils::checkForErrors(args);
-    if (!errorCheck.isEmpty()) {
-        return errorCheck;
-    }
-
-    std::vector<double> numbers;
-
-    // Collect all numeric values
-    for (const auto& arg : args) {
-        if (arg.isEmpty()) {
-            continue;  // Skip empty values
-        }
-
-        if (arg.canConvertToNumber()) {
-            numbers.push_back(arg.toNumber());
-        }
-        // Non-numeric values are ignored in MODE (Excel behavior)
+    NumberTable frequency;
+    error = statistics::tallyNumbers(args, frequency);
+    if (!error.isEmpty()) {
+        return error;
     }
 
     // If no numeric values found, return error
-    if (numbers.empty()) {
+    if (frequency.size() == 0) {
         return Value::error(ErrorType::DIV_ZERO);
     }
 
-    // Count frequency of each number
-    std::unordered_map<double, int> frequency;
-    for (double num : numbers) {
-        frequency[num]++;
+    // Entries are in first-seen order, so ties go to the value that occurred first; when
+    // all numbers appear only once this is the first number (Excel behavior)
+    const NumberTable::Entry* best = &frequency.entries().front();
+    for (const auto& entry : frequency.entries()) {
+        if (entry.count > best->count) {
+            best = &entry;
+        }
     }
+    return Value(best->key);
+}
 
-    // Find the number with highest frequency
-    double mode_value = numbers[0];
-    int max_frequency = 1;
+/**
+ * @brief Returns all most frequently occurring values, in order of first occurrence
+ * @ingroup math
+ * @param number1 First number or array
+ * @param number2 Additional numbers or arrays (optional, variadic)
+ * @code
+ * MODE.MULT(1,2,2,3,3) -> {2,3}
+ * MODE.MULT(1,2,3) -> #N/A
+ * @endcode
+ */
+Value mode_mult(const std::vector<Value>& args, const Context& context) {
+    (void)context;  // Unused parameter
 
-    for (const auto& pair : frequency) {
-        if (pair.second > max_frequency) {
-            max_frequency = pair.second;
-            mode_value = pair.first;
-        }
+    auto error = utils::validateMinArgs(args, 1, "MODE.MULT");
+    if (!error.isEmpty()) {
+        return error;
     }
 
-    // If multiple numbers have the same frequency, return the first one in original order
-    if (max_frequency > 1) {
-        for (double num : numbers) {
-            if (frequency[num] == max_frequency) {
-                mode_value = num;
-                break;
-            }
-        }
+    NumberTable frequency;
+    error = statistics::tallyNumbers(args, frequency);
+    if (!error.isEmpty()) {
+        return error;
     }
 
-    // If all numbers appear only once, return the first number (Excel behavior)
-    if (max_frequency == 1) {
-        return Value(numbers[0]);
+    size_t max_count = 0;
+    for (const auto& entry : frequency.entries()) {
+        max_count = std::max(max_count, entry.count);
+    }
+    // No value repeats: there is no mode
+    if (max_count < 2) {
+        return Value::error(ErrorType::NA_ERROR);
     }
 
-    return Value(mode_value);
+    std::vector<double> modes;
+    for (const auto& entry : frequency.entries()) {
+        if (entry.count == max_count) {
+            modes.push_back(entry.key);
+        }
+    }
+    return Value::numberArray(std::move(modes));
 }
 
 }  // namespace builtin
 }  // namespace functions
-}  // namespace xl_formula
\ No newline at end of file
+}  // namespace xl_formula
@@ -0,0 +1,45 @@
+#include <vector>
+#include "velox/formulas/functions.h"
+#include "velox/formulas/statistical_utils.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+/**
+ * @brief Returns the k-th percentile of a data set, interpolating between neighbours
+ * @ingroup math
+ * @param array Numbers or array of numbers
+ * @param k Percentile as a fraction between 0 and 1
+ * @code
+ * PERCENTILE({1,2,3,4}, 0.25) -> 1.75
+ * PERCENTILE({10,20,30}, 1) -> 30
+ * @endcode
+ */
+Value percentile(const std::vector<Value>& args, const Context& context) {
+    auto validation = utils::validateArgCount(args, 2, "PERCENTILE");
+    if (!validation.isEmpty()) {
+        return validation;
+    }
+
+    auto kV = utils::toNumberSafe(args[1], "PERCENTILE");
+    if (kV.isError()) {
+        return kV;
+    }
+    const double k = kV.asNumber();
+
+    statistics::OrderStatistics data;
+    auto loadError = data.load(context, {args[0]});
+    if (!loadError.isEmpty()) {
+        return loadError;
+    }
+    if (data.empty() || k < 0.0 || k > 1.0) {
+        return Value::error(ErrorType::NUM_ERROR);
+    }
+
+    return Value(data.percentile(k));
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
@@ -0,0 +1,46 @@
+#include <cmath>
+#include <vector>
+#include "velox/formulas/functions.h"
+#include "velox/formulas/statistical_utils.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+/**
+ * @brief Returns a quartile of a data set
+ * @ingroup math
+ * @param array Numbers or array of numbers
+ * @param quart 0 minimum, 1 first quartile, 2 median, 3 third quartile, 4 maximum
+ * @code
+ * QUARTILE({1,2,3,4,5}, 1) -> 2
+ * QUARTILE({1,2,3,4}, 3) -> 3.25
+ * @endcode
+ */
+Value quartile(const std::vector<Value>& args, const Context& context) {
+    auto validation = utils::validateArgCount(args, 2, "QUARTILE");
+    if (!validation.isEmpty()) {
+        return validation;
+    }
+
+    auto quartV = utils::toNumberSafe(args[1], "QUARTILE");
+    if (quartV.isError()) {
+        return quartV;
+    }
+    const double quart = std::trunc(quartV.asNumber());
+
+    statistics::OrderStatistics data;
+    auto loadError = data.load(context, {args[0]});
+    if (!loadError.isEmpty()) {
+        return loadError;
+    }
+    if (data.empty() || quart < 0.0 || quart > 4.0) {
+        return Value::error(ErrorType::NUM_ERROR);
+    }
+
+    return Value(data.percentile(quart / 4.0));
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
@@ -20,10 +20,10 @@ Value rand_function(const std::vector<Value>& args, const Context& context) {
         return Value::error(ErrorType::VALUE_ERROR);
     }
 
-    // Create random number generator
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<double> dis(0.0, 1.0);
+    // One generator per thread, so batches evaluated in parallel don't race on it
+    thread_local std::random_device rd;
+    thread_local std::mt19937 gen(rd());
+    std::uniform_real_distribution<double> dis(0.0, 1.0);
 
     return Value(dis(gen));
 }
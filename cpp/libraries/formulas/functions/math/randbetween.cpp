@@ -47,9 +47,9 @@ Value randbetween(const std::vector<Value>& args, const Context& context) {
         return Value::error(ErrorType::NUM_ERROR);
     }
 
-    // Create random number generator
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    // One generator per thread, so batches evaluated in parallel don't race on it
+    thread_local std::random_device rd;
+    thread_local std::mt19937 gen(rd());
     std::uniform_int_distribution<int> dis(bottom, top);
 
     return Value(static_cast<double>(dis(gen)));
@@ -0,0 +1,59 @@
+#include <vector>
+#include "velox/formulas/functions.h"
+#include "velox/formulas/statistical_utils.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+/**
+ * @brief Returns the rank of a number within a list of numbers; ties share the best rank
+ * @ingroup math
+ * @param number Number to rank
+ * @param ref Array of numbers to rank against
+ * @param order 0 or omitted ranks the largest first, nonzero ranks the smallest first
+ * @code
+ * RANK(3, {7,3,5,3}) -> 3
+ * RANK(3, {7,3,5,3}, 1) -> 1
+ * @endcode
+ */
+Value rank(const std::vector<Value>& args, const Context& context) {
+    auto validation = utils::validateMinArgs(args, 2, "RANK");
+    if (!validation.isEmpty()) {
+        return validation;
+    }
+    if (args.size() > 3) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+
+    auto numberV = utils::toNumberSafe(args[0], "RANK");
+    if (numberV.isError()) {
+        return numberV;
+    }
+    const double number = numberV.asNumber();
+
+    bool ascending = false;
+    if (args.size() > 2) {
+        auto orderV = utils::toNumberSafe(args[2], "RANK");
+        if (orderV.isError()) {
+            return orderV;
+        }
+        ascending = orderV.asNumber() != 0.0;
+    }
+
+    // Ranking every element of a column against it reuses one sorted copy of ref
+    statistics::OrderStatistics data;
+    auto loadError = data.load(context, {args[1]});
+    if (!loadError.isEmpty()) {
+        return loadError;
+    }
+    if (!data.contains(number)) {
+        return Value::error(ErrorType::NA_ERROR);
+    }
+
+    return Value(static_cast<double>(data.countBeyond(number, !ascending) + 1));
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
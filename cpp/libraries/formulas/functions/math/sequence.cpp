@@ -0,0 +1,85 @@
+#include <cmath>
+#include <vector>
+#include "velox/formulas/functions.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+namespace {
+
+// Largest array SEQUENCE builds: 32 MiB of packed doubles
+constexpr double kMaxElements = 4194304.0;
+
+}  // anonymous namespace
+
+/**
+ * @brief Generates a sequence of numbers as an array (one row array per row when columns > 1)
+ * @ingroup math
+ * @param rows Number of rows
+ * @param columns Number of columns (optional, default 1)
+ * @param start First number (optional, default 1)
+ * @param step Increment (optional, default 1)
+ * @code
+ * SEQUENCE(4) -> {1,2,3,4}
+ * SEQUENCE(2,2,0,10) -> {{0,10},{20,30}}
+ * @endcode
+ */
+Value sequence(const std::vector<Value>& args, const Context& context) {
+    (void)context;  // Unused parameter
+
+    auto error = utils::validateMinArgs(args, 1, "SEQUENCE");
+    if (!error.isEmpty()) {
+        return error;
+    }
+    if (args.size() > 4) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+
+    double params[4] = {0.0, 1.0, 1.0, 1.0};
+    for (size_t i = 0; i < args.size(); ++i) {
+        auto numV = utils::toNumberSafe(args[i], "SEQUENCE");
+        if (numV.isError()) {
+            return numV;
+        }
+        params[i] = numV.asNumber();
+    }
+
+    const double rows = std::trunc(params[0]);
+    const double columns = std::trunc(params[1]);
+    if (rows < 1.0 || columns < 1.0) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    // Same limits as an Excel worksheet, and at most kMaxElements numbers in all
+    if (rows > 1048576.0 || columns > 16384.0 || rows * columns > kMaxElements) {
+        return Value::error(ErrorType::NUM_ERROR);
+    }
+
+    const size_t row_count = static_cast<size_t>(rows);
+    const size_t column_count = static_cast<size_t>(columns);
+    const double start = params[2];
+    const double step = params[3];
+
+    if (row_count == 1 || column_count == 1) {
+        std::vector<double> numbers(row_count * column_count);
+        for (size_t i = 0; i < numbers.size(); ++i) {
+            numbers[i] = start + step * static_cast<double>(i);
+        }
+        return Value::numberArray(std::move(numbers));
+    }
+
+    std::vector<Value> table;
+    table.reserve(row_count);
+    for (size_t r = 0; r < row_count; ++r) {
+        std::vector<double> row(column_count);
+        for (size_t c = 0; c < column_count; ++c) {
+            row[c] = start + step * static_cast<double>(r * column_count + c);
+        }
+        table.push_back(Value::numberArray(std::move(row)));
+    }
+    return Value::array(table);
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
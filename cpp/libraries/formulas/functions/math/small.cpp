@@ -0,0 +1,46 @@
+#include <cmath>
+#include <vector>
+#include "velox/formulas/functions.h"
+#include "velox/formulas/statistical_utils.h"
+
+namespace xl_formula {
+namespace functions {
+namespace builtin {
+
+/**
+ * @brief Returns the k-th smallest value in a data set
+ * @ingroup math
+ * @param array Numbers or array of numbers
+ * @param k Position from the smallest (1-based; fractions are rounded up)
+ * @code
+ * SMALL({3,5,3,5,4}, 1) -> 3
+ * SMALL({3,5,3,5,4}, 4) -> 5
+ * @endcode
+ */
+Value small(const std::vector<Value>& args, const Context& context) {
+    auto validation = utils::validateArgCount(args, 2, "SMALL");
+    if (!validation.isEmpty()) {
+        return validation;
+    }
+
+    auto kV = utils::toNumberSafe(args[1], "SMALL");
+    if (kV.isError()) {
+        return kV;
+    }
+    const double k = std::ceil(kV.asNumber());
+
+    statistics::OrderStatistics data;
+    auto loadError = data.load(context, {args[0]});
+    if (!loadError.isEmpty()) {
+        return loadError;
+    }
+    if (k < 1.0 || k > static_cast<double>(data.size())) {
+        return Value::error(ErrorType::NUM_ERROR);
+    }
+
+    return Value(data.kthSmallest(static_cast<size_t>(k) - 1));
+}
+
+}  // namespace builtin
+}  // namespace functions
+}  // namespace xl_formula
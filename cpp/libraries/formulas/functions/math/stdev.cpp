@@ -1,6 +1,7 @@
 #include <cmath>
 #include <vector>
 #include "velox/formulas/functions.h"
+#include "velox/formulas/statistical_utils.h"
 
 namespace xl_formula {
 namespace functions {
@@ -9,8 +10,8 @@ namespace builtin {
 /**
  * @brief Returns the standard deviation of a sample
  * @ingroup math
- * @param number1 First number
- * @param number2 Additional numbers (optional, variadic)
+ * @param number1 First number or array
+ * @param number2 Additional numbers or arrays (optional, variadic)
  * @code
  * STDEV(1,2,3) -> 1
  * @endcode
@@ -30,49 +31,19 @@ Value stdev(const std::vector<Value>& args, const Context& context) {
         return errorCheck;
     }
 
-    std::vector<double> numbers;
-
-    // Collect all numeric values
-    for (const auto& arg : args) {
-        if (arg.isEmpty()) {
-            continue;  // Skip empty values
-        }
-
-        if (arg.canConvertToNumber()) {
-            numbers.push_back(arg.toNumber());
-        }
-        // Non-numeric values are ignored in STDEV (Excel behavior)
-    }
-
-    // If no numeric values found, return error
-    if (numbers.empty()) {
-        return Value::error(ErrorType::DIV_ZERO);
+    // Count, mean and M2 in one pass; packed arrays are streamed without copying
+    kernels::Moments moments;
+    auto dataError = statistics::accumulateMoments(args, moments);
+    if (!dataError.isEmpty()) {
+        return dataError;
     }
 
-    // If only one value, return error (Excel behavior)
-    if (numbers.size() == 1) {
+    // Excel needs at least two values for a sample standard deviation
+    if (moments.count < 2) {
         return Value::error(ErrorType::DIV_ZERO);
     }
 
-    // Calculate mean
-    double sum = 0.0;
-    for (double num : numbers) {
-        sum += num;
-    }
-    double mean = sum / numbers.size();
-
-    // Calculate sum of squared differences
-    double sum_squared_diff = 0.0;
-    for (double num : numbers) {
-        double diff = num - mean;
-        sum_squared_diff += diff * diff;
-    }
-
-    // Calculate standard deviation (sample standard deviation)
-    double variance = sum_squared_diff / (numbers.size() - 1);
-    double stdev_value = std::sqrt(variance);
-
-    return Value(stdev_value);
+    return Value(std::sqrt(moments.m2 / static_cast<double>(moments.count - 1)));
 }
 
 }  // namespace builtin
@@ -1,5 +1,5 @@
-#include <numeric>
 #include "velox/formulas/functions.h"
+#include "velox/formulas/statistical_utils.h"
 
 namespace xl_formula {
 namespace functions {
@@ -8,22 +8,25 @@ namespace builtin {
 /**
  * @brief Adds all numeric arguments
  * @ingroup math
- * @param number1 First number (optional)
- * @param number2 Additional numbers (variadic)
+ * @param number1 First number or array (optional)
+ * @param number2 Additional numbers or arrays (variadic)
  * @code
  * SUM(1,2,3) -> 6
+ * SUM({1,2,3},4) -> 10
  * @endcode
  */
 Value sum(const std::vector<Value>& args, const Context& context) {
-    return templates::multiNumericFunction(
-            args, context, "SUM", [](const std::vector<double>& nums) {
-                if (nums.empty()) {
-                    return 0.0;
-                }
-                return std::accumulate(nums.begin(), nums.end(), 0.0);
-            });
+    (void)context;  // Unused parameter
+
+    kernels::SumAccumulator total;
+    size_t count = 0;
+    auto error = statistics::accumulateSum(args, total, count);
+    if (!error.isEmpty()) {
+        return error;
+    }
+    return Value(total.total());
 }
 
 }  // namespace builtin
 }  // namespace functions
-}  // namespace xl_formula
\ No newline at end of file
+}  // namespace xl_formula
@@ -4,20 +4,6 @@ namespace xl_formula {
 namespace functions {
 namespace builtin {
 
-/**
- * @brief Helper function to evaluate criteria without regex (avoiding bloat)
- * @param value The value to test
- * @param criteria The criteria string or value
- * @return true if value matches criteria
- * @deprecated Use utils::evaluateCriteria instead
- */
-bool evaluateCriteriaCustom(const Value& value, const Value& criteria) {
-    // Delegate to shared utility
-    return ::xl_formula::conditional::evaluateCriteria(value, criteria);
-}
-
-
-
 /**
  * @brief Sums values that meet a condition
  * @ingroup math
@@ -26,6 +12,7 @@ bool evaluateCriteriaCustom(const Value& value, const Value& criteria) {
  * @param sum_range Values to sum (optional; defaults to range)
  * @code
  * SUMIF(3, "=3", 5) -> 5
+ * SUMIF({1,5,10}, ">=5") -> 15
  * @endcode
  */
 Value sumif(const std::vector<Value>& args, const Context& context) {
@@ -47,10 +34,24 @@ Value sumif(const std::vector<Value>& args, const Context& context) {
         if (sumRangeArg.isError())
             return sumRangeArg;
 
+        auto criteria = conditional::CompiledCriteria::cached(criteriaArg);
+
+        // Range form: sum the sum_range entries whose range entry matches
+        if (rangeArg.isArray()) {
+            const ArrayData& range = rangeArg.asArrayData();
+            if (!sumRangeArg.isArray() || sumRangeArg.asArrayData().size() != range.size()) {
+                return Value::error(ErrorType::VALUE_ERROR);
+            }
+            conditional::SelectionMask selection;
+            criteria->select(range, selection);
+            size_t counted = 0;
+            return conditional::maskedSum(sumRangeArg.asArrayData(), selection, counted);
+        }
+
         double sum = 0.0;
 
-        // Simple implementation: check if single value meets criteria
-        if (evaluateCriteriaCustom(rangeArg, criteriaArg)) {
+        // Single value: check if it meets the criteria
+        if (criteria->matches(rangeArg)) {
             auto numValue = utils::toNumberSafe(sumRangeArg, "SUMIF");
             if (numValue.isError()) {
                 return numValue;
@@ -16,6 +16,7 @@ namespace builtin {
  * @param criteria2 Additional conditions (optional, variadic)
  * @code
  * SUMIFS(5, 3, "=3") -> 5
+ * SUMIFS({10,20,30}, {"a","b","a"}, "a", {1,2,3}, ">1") -> 30
  * @endcode
  */
 Value sumifs(const std::vector<Value>& args, const Context& context) {
@@ -34,6 +35,18 @@ Value sumifs(const std::vector<Value>& args, const Context& context) {
             return sumRangeArg;
         }
 
+        // Range form: one bitmap per criteria range, ANDed, then a masked sum
+        if (sumRangeArg.isArray()) {
+            conditional::SelectionMask selection;
+            Value status = conditional::selectAllCriteria(
+                    args, 1, sumRangeArg.asArrayData().size(), selection);
+            if (!status.isEmpty()) {
+                return status;
+            }
+            size_t counted = 0;
+            return conditional::maskedSum(sumRangeArg.asArrayData(), selection, counted);
+        }
+
         double sum = 0.0;
         bool matchesAllCriteria = true;
 
@@ -47,8 +60,8 @@ Value sumifs(const std::vector<Value>& args, const Context& context) {
             if (criteria.isError())
                 return criteria;
 
-            // Simple implementation: check if single value meets criteria
-            if (!::xl_formula::conditional::evaluateCriteria(criteriaRange, criteria)) {
+            // Single values: check if each meets its criteria
+            if (!conditional::CompiledCriteria::cached(criteria)->matches(criteriaRange)) {
                 matchesAllCriteria = false;
                 break;
             }
@@ -1,9 +1,66 @@
+#include <algorithm>
+#include "velox/formulas/array_kernels.h"
 #include "velox/formulas/functions.h"
 
 namespace xl_formula {
 namespace functions {
 namespace builtin {
 
+// SUMPRODUCT({...}, {...}, ...): element-wise products summed over equally sized arrays
+static Value sumproductArrays(const std::vector<Value>& args) {
+    const size_t size = args[0].asArrayData().size();
+    std::vector<NumberSpan> packed(args.size());
+    bool all_packed = true;
+    for (size_t a = 0; a < args.size(); ++a) {
+        if (!args[a].isArray() || args[a].asArrayData().size() != size) {
+            return Value::error(ErrorType::VALUE_ERROR);
+        }
+        all_packed = utils::numericArrayView(args[a], packed[a]) && all_packed;
+    }
+
+    const kernels::Summation mode = kernels::defaultSummation();
+    if (all_packed && packed.size() == 1) {
+        return Value(kernels::sum(packed[0].data(), size, mode));
+    }
+    if (all_packed && packed.size() == 2) {
+        return Value(kernels::dotProduct(packed[0].data(), packed[1].data(), size, mode));
+    }
+
+    double sum = 0.0;
+    if (all_packed) {
+        // Multiply all but the last array a block at a time, then dot with the last one
+        constexpr size_t kBlock = 1024;
+        double products[kBlock];
+        kernels::SumAccumulator total(mode);
+        const double* last = packed.back().data();
+        for (size_t start = 0; start < size; start += kBlock) {
+            const size_t count = std::min(kBlock, size - start);
+            kernels::binaryArrayArray(BinaryOpNode::Operator::MULTIPLY, packed[0].data() + start,
+                                      packed[1].data() + start, products, count);
+            for (size_t a = 2; a + 1 < packed.size(); ++a) {
+                kernels::binaryArrayArray(BinaryOpNode::Operator::MULTIPLY, products,
+                                          packed[a].data() + start, products, count);
+            }
+            total.add(kernels::dotProduct(products, last + start, count, mode));
+        }
+        return Value(total.total());
+    }
+
+    // Errors propagate; other non-numeric entries count as zero
+    for (size_t i = 0; i < size; ++i) {
+        double product = 1.0;
+        for (const auto& arg : args) {
+            Value element = arg.asArrayData().at(i);
+            if (element.isError()) {
+                return element;
+            }
+            product *= element.isNumber() ? element.asNumber() : 0.0;
+        }
+        sum += product;
+    }
+    return Value(sum);
+}
+
 /**
  * @brief Returns the sum of the products of corresponding values
  * @ingroup math
@@ -11,6 +68,7 @@ namespace builtin {
  * @param array2 Second array or value (optional, variadic)
  * @code
  * SUMPRODUCT(2,3,4) -> 24
+ * SUMPRODUCT({1,2,3},{4,5,6}) -> 32
  * @endcode
  */
 Value sumproduct(const std::vector<Value>& args, const Context& context) {
@@ -20,6 +78,10 @@ Value sumproduct(const std::vector<Value>& args, const Context& context) {
         return Value::error(ErrorType::VALUE_ERROR);
     }
 
+    if (args[0].isArray()) {
+        return sumproductArrays(args);
+    }
+
     try {
         // Convert all arguments to numeric values, treating arrays as single values for now
         // In a full implementation, this would handle ranges/arrays properly
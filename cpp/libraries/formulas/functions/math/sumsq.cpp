@@ -1,3 +1,4 @@
+#include "velox/formulas/array_kernels.h"
 #include "velox/formulas/functions.h"
 
 namespace xl_formula {
@@ -15,7 +16,7 @@ namespace builtin {
  *
  * The function:
  * - Accepts any number of arguments (at least 1 required)
- * - Squares each numeric value and sums them
+ * - Squares each numeric value and sums them; packed arrays go through the SIMD kernel
  * - Ignores text, logical values, and empty cells
  * - Returns 0 if no numeric arguments are provided
  */
@@ -34,18 +35,33 @@ Value sumsq(const std::vector<Value>& args, const Context& context) {
         return errorCheck;
     }
 
-    double sum = 0.0;
+    kernels::SumAccumulator sum;
 
     for (const Value& arg : args) {
         if (arg.isNumber()) {
             double num = arg.asNumber();
-            sum += num * num;  // Square the number and add to sum
+            sum.add(num * num);  // Square the number and add to sum
+        } else if (arg.isArray()) {
+            const ArrayData& data = arg.asArrayData();
+            if (data.isNumeric()) {
+                NumberSpan packed = data.numbers();
+                sum.add(kernels::sumSquares(packed.data(), packed.size(), sum.mode()));
+                continue;
+            }
+            for (const auto& item : data.values()) {
+                if (item.isError()) {
+                    return item;
+                }
+                if (item.isNumber()) {
+                    sum.add(item.asNumber() * item.asNumber());
+                }
+            }
         }
         // Ignore non-numeric values (text, boolean, empty)
         // This matches Excel's behavior for SUMSQ
     }
 
-    return Value(sum);
+    return Value(sum.total());
 }
 
 }  // namespace builtin
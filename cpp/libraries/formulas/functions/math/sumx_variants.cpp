@@ -1,3 +1,4 @@
+#include "velox/formulas/array_kernels.h"
 #include "velox/formulas/functions.h"
 
 namespace xl_formula {
@@ -5,15 +6,22 @@ namespace functions {
 namespace builtin {
 
 // Helpers to accumulate from either arrays or flat inputs
+static void collectArray(const Value& array, std::vector<double>& out) {
+    NumberSpan packed;
+    if (utils::numericArrayView(array, packed)) {
+        out.assign(packed.begin(), packed.end());
+        return;
+    }
+    for (const auto& v : array.asArray())
+        if (v.canConvertToNumber())
+            out.push_back(v.toNumber());
+}
+
 static void collectTwoSeries(const std::vector<Value>& args, std::vector<double>& a,
                              std::vector<double>& b) {
     if (args.size() == 2 && args[0].isArray() && args[1].isArray()) {
-        for (const auto& v : args[0].asArray())
-            if (v.canConvertToNumber())
-                a.push_back(v.toNumber());
-        for (const auto& v : args[1].asArray())
-            if (v.canConvertToNumber())
-                b.push_back(v.toNumber());
+        collectArray(args[0], a);
+        collectArray(args[1], b);
     } else {
         size_t mid = args.size() / 2;
         for (size_t i = 0; i < mid; ++i)
@@ -25,6 +33,22 @@ static void collectTwoSeries(const std::vector<Value>& args, std::vector<double>
     }
 }
 
+// Sum a pair term over both series; two packed arrays are read in place
+static Value sumPairTerms(const std::vector<Value>& args, kernels::PairTerm term) {
+    if (args.size() < 2)
+        return Value::error(ErrorType::VALUE_ERROR);
+    const kernels::Summation mode = kernels::defaultSummation();
+    NumberSpan xs, ys;
+    if (args.size() == 2 && utils::numericArrayView(args[0], xs) &&
+        utils::numericArrayView(args[1], ys)) {
+        return Value(kernels::sumPairs(xs.data(), ys.data(), std::min(xs.size(), ys.size()), term,
+                                       mode));
+    }
+    std::vector<double> x, y;
+    collectTwoSeries(args, x, y);
+    return Value(kernels::sumPairs(x.data(), y.data(), std::min(x.size(), y.size()), term, mode));
+}
+
 /**
  * @brief Sum of the difference of squares of corresponding values: Σ(x^2 − y^2)
  * @ingroup math
@@ -36,15 +60,7 @@ static void collectTwoSeries(const std::vector<Value>& args, std::vector<double>
  */
 Value sumx2my2(const std::vector<Value>& args, const Context& context) {
     (void)context;
-    if (args.size() < 2)
-        return Value::error(ErrorType::VALUE_ERROR);
-    std::vector<double> x, y;
-    collectTwoSeries(args, x, y);
-    size_t n = std::min(x.size(), y.size());
-    double s = 0.0;
-    for (size_t i = 0; i < n; ++i)
-        s += (x[i] * x[i] - y[i] * y[i]);
-    return Value(s);
+    return sumPairTerms(args, kernels::PairTerm::X2_MINUS_Y2);
 }
 
 /**
@@ -58,15 +74,7 @@ Value sumx2my2(const std::vector<Value>& args, const Context& context) {
  */
 Value sumx2py2(const std::vector<Value>& args, const Context& context) {
     (void)context;
-    if (args.size() < 2)
-        return Value::error(ErrorType::VALUE_ERROR);
-    std::vector<double> x, y;
-    collectTwoSeries(args, x, y);
-    size_t n = std::min(x.size(), y.size());
-    double s = 0.0;
-    for (size_t i = 0; i < n; ++i)
-        s += (x[i] * x[i] + y[i] * y[i]);
-    return Value(s);
+    return sumPairTerms(args, kernels::PairTerm::X2_PLUS_Y2);
 }
 
 /**
@@ -80,17 +88,7 @@ Value sumx2py2(const std::vector<Value>& args, const Context& context) {
  */
 Value sumxmy2(const std::vector<Value>& args, const Context& context) {
     (void)context;
-    if (args.size() < 2)
-        return Value::error(ErrorType::VALUE_ERROR);
-    std::vector<double> x, y;
-    collectTwoSeries(args, x, y);
-    size_t n = std::min(x.size(), y.size());
-    double s = 0.0;
-    for (size_t i = 0; i < n; ++i) {
-        double d = x[i] - y[i];
-        s += d * d;
-    }
-    return Value(s);
+    return sumPairTerms(args, kernels::PairTerm::X_MINUS_Y_SQUARED);
 }
 
 }  // namespace builtin
@@ -1,4 +1,3 @@
-#include <chrono>
 #include <cmath>
 #include <limits>
 #include "velox/formulas/functions.h"
@@ -30,16 +29,13 @@ static void forEachDateCandidate(const std::vector<Value>& args, const std::func
  * @endcode
  */
 Value ns_unixtime(const std::vector<Value>& args, const Context& context) {
-    (void)context;
     // Expect exactly one argument
     auto check = utils::validateArgCount(args, 1, "NS_UNIXTIME");
     if (check.isError()) return check;
     const Value& v = args[0];
     if (v.isError()) return v;
     if (!v.isDate()) return Value::error(ErrorType::VALUE_ERROR);
-    using namespace std::chrono;
-    auto tp = v.asDate();
-    auto secs = duration_cast<seconds>(tp.time_since_epoch()).count();
+    auto secs = dates::toUnixSeconds(v.asDate(), context.getTimeZonePolicy());
     return Value(static_cast<double>(secs));
 }
 
@@ -54,28 +50,25 @@ Value ns_unixtime(const std::vector<Value>& args, const Context& context) {
  * @endcode
  */
 Value ns_nearestdate(const std::vector<Value>& args, const Context& context) {
-    (void)context;
-    using namespace std::chrono;
-    const auto now = system_clock::now();
+    const double now = dates::currentDateTime(context.getTimeZonePolicy()).serial;
     bool found = false;
-    system_clock::time_point best_tp{};
-    auto best_dist = std::numeric_limits<long double>::infinity();
+    Value::DateType best_date;
+    double best_dist = std::numeric_limits<double>::infinity();
 
     forEachDateCandidate(args, [&](const Value& v) {
         if (v.isError()) return;  // skip
         if (!v.isDate()) return;
-        auto tp = v.asDate();
-        auto dist = std::chrono::duration<long double>(tp - now);
-        long double ad = std::fabsl(dist.count());
+        auto date = v.asDate();
+        double ad = std::fabs(date.serial - now);
         if (!found || ad < best_dist) {
             found = true;
             best_dist = ad;
-            best_tp = tp;
+            best_date = date;
         }
     });
 
     if (!found) return Value::error(ErrorType::NA_ERROR);
-    return Value(best_tp);
+    return Value(best_date);
 }
 
 /**
@@ -89,28 +82,25 @@ Value ns_nearestdate(const std::vector<Value>& args, const Context& context) {
  * @endcode
  */
 Value ns_furthestdate(const std::vector<Value>& args, const Context& context) {
-    (void)context;
-    using namespace std::chrono;
-    const auto now = system_clock::now();
+    const double now = dates::currentDateTime(context.getTimeZonePolicy()).serial;
     bool found = false;
-    system_clock::time_point best_tp{};
-    long double best_dist = -1.0L;
+    Value::DateType best_date;
+    double best_dist = -1.0;
 
     forEachDateCandidate(args, [&](const Value& v) {
         if (v.isError()) return;  // skip
         if (!v.isDate()) return;
-        auto tp = v.asDate();
-        auto dist = std::chrono::duration<long double>(tp - now);
-        long double ad = std::fabsl(dist.count());
+        auto date = v.asDate();
+        double ad = std::fabs(date.serial - now);
         if (!found || ad > best_dist) {
             found = true;
             best_dist = ad;
-            best_tp = tp;
+            best_date = date;
         }
     });
 
     if (!found) return Value::error(ErrorType::NA_ERROR);
-    return Value(best_tp);
+    return Value(best_date);
 }
 
 }  // namespace builtin
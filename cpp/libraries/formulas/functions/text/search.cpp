@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <cctype>
 #include "velox/formulas/functions.h"
+#include "velox/formulas/wildcard.h"
 
 namespace xl_formula {
 namespace functions {
@@ -9,11 +10,12 @@ namespace builtin {
 /**
  * @brief Finds one text string within another (case-insensitive)
  * @ingroup text
- * @param find_text Substring to find
+ * @param find_text Substring to find; * and ? are wildcards, ~ matches them literally
  * @param within_text Text to search within
  * @param start_num Starting position (optional)
  * @code
  * SEARCH("LO", "Hello") -> 4
+ * SEARCH("l?o", "Hello") -> 3
  * @endcode
  */
 Value search(const std::vector<Value>& args, const Context& context) {
@@ -71,6 +73,15 @@ Value search(const std::vector<Value>& args, const Context& context) {
     // Convert to 0-based indexing for std::string::find
     size_t start_pos = static_cast<size_t>(start_num - 1);
 
+    // Wildcard patterns go through the compiled matcher (already case-insensitive)
+    if (WildcardPattern::hasWildcardSyntax(find_text)) {
+        size_t found_pos = WildcardPattern::compile(find_text).find(within_text, start_pos);
+        if (found_pos == std::string::npos) {
+            return Value::error(ErrorType::VALUE_ERROR);
+        }
+        return Value(static_cast<double>(found_pos + 1));
+    }
+
     // Convert both strings to lowercase for case-insensitive search
     std::string find_text_lower = find_text;
     std::string within_text_lower = within_text;
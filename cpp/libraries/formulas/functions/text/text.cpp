@@ -1,8 +1,6 @@
-#include <algorithm>
-#include <cctype>
-#include <iomanip>
-#include <sstream>
+#include <string>
 #include "velox/formulas/functions.h"
+#include "velox/formulas/number_format.h"
 
 namespace xl_formula {
 namespace functions {
@@ -11,10 +9,12 @@ namespace builtin {
 /**
  * @brief Formats a number as text according to a specified format
  * @ingroup text
- * @param value Number to format
- * @param format_text Format pattern (e.g., 0.00, 0%)
+ * @param value Number, date or text to format
+ * @param format_text Excel number format (e.g., 0.00, #,##0, 0%, 0.00E+00, yyyy-mm-dd)
  * @code
  * TEXT(123.456, "0.00") -> "123.46"
+ * TEXT(1234567, "#,##0") -> "1,234,567"
+ * TEXT(45000, "yyyy-mm-dd") -> "2023-03-15"
  * @endcode
  */
 Value text(const std::vector<Value>& args, const Context& context) {
@@ -32,60 +32,45 @@ Value text(const std::vector<Value>& args, const Context& context) {
         return errorCheck;
     }
 
-    // First argument should be a number or convertible to number
-    if (!args[0].isNumber() && !args[0].canConvertToNumber()) {
-        return Value::error(ErrorType::VALUE_ERROR);
-    }
-
-    double value = args[0].isNumber() ? args[0].asNumber() : args[0].toNumber();
     std::string format_text = args[1].toString();
-
-    // Basic format implementation - supports common Excel formats
-    // This is a simplified version; full Excel format support would be much more complex
-
     if (format_text.empty()) {
         return Value::error(ErrorType::VALUE_ERROR);
     }
 
-    // Convert format_text to uppercase for easier parsing
-    std::string format_upper = format_text;
-    std::transform(format_upper.begin(), format_upper.end(), format_upper.begin(), ::toupper);
-
-    std::ostringstream oss;
+    auto format = format::NumberFormat::cached(format_text);
+    if (!format->isValid()) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
 
-    // Handle common format patterns
-    if (format_upper == "0" || format_upper == "#") {
-        // Integer format
-        oss << std::fixed << std::setprecision(0) << value;
-    } else if (format_upper == "0.00" || format_upper == "#.##") {
-        // Decimal format
-        oss << std::fixed << std::setprecision(2) << value;
-    } else if (format_upper == "0%" || format_upper == "#%") {
-        // Percentage format
-        oss << std::fixed << std::setprecision(0) << (value * 100) << "%";
-    } else if (format_upper == "0.00%" || format_upper == "#.##%") {
-        // Percentage with decimals
-        oss << std::fixed << std::setprecision(2) << (value * 100) << "%";
-    } else if (format_upper == "$#,##0.00" || format_upper == "$0.00") {
-        // Currency format
-        oss << "$" << std::fixed << std::setprecision(2) << value;
-    } else if (format_upper == "MM/DD/YYYY" || format_upper == "M/D/YYYY") {
-        // Date format (simplified - assumes value is days since 1900)
-        // This is a very basic implementation
-        int days = static_cast<int>(value);
-        int year = 1900 + (days / 365);
-        int month = 1 + ((days % 365) / 30);
-        int day = 1 + ((days % 365) % 30);
-        oss << std::setfill('0') << std::setw(2) << month << "/" << std::setw(2) << day << "/"
-            << std::setw(4) << year;
+    // Most results fit on the stack; longer ones are formatted a second time into a string
+    char buffer[128];
+    size_t length;
+    if (args[0].canConvertToNumber()) {
+        const double value = args[0].toNumber();
+        length = format->format(value, buffer, sizeof(buffer));
+        if (length != format::NumberFormat::npos && length > sizeof(buffer)) {
+            std::string result(length, '\0');
+            format->format(value, result.data(), result.size());
+            return Value(std::move(result));
+        }
+    } else if (args[0].isText()) {
+        const std::string& value = args[0].asText();
+        length = format->formatText(value, buffer, sizeof(buffer));
+        if (length != format::NumberFormat::npos && length > sizeof(buffer)) {
+            std::string result(length, '\0');
+            format->formatText(value, result.data(), result.size());
+            return Value(std::move(result));
+        }
     } else {
-        // Default format - just convert to string
-        oss << std::fixed << std::setprecision(6) << value;
+        return Value::error(ErrorType::VALUE_ERROR);
     }
 
-    return Value(oss.str());
+    if (length == format::NumberFormat::npos) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    return Value(std::string(buffer, length));
 }
 
 }  // namespace builtin
 }  // namespace functions
-}  // namespace xl_formula
\ No newline at end of file
+}  // namespace xl_formula
@@ -0,0 +1,81 @@
+#include "velox/formulas/functions.h"
+
+namespace xl_formula {
+namespace functions {
+namespace dispatcher {
+
+Value dispatch_text_function(const std::string& name, const std::vector<Value>& args,
+                             const Context& context) {
+    switch (hash_function_name(name.c_str())) {
+        case hash_function_name("CONCATENATE"):
+            return builtin::concatenate(args, context);
+        case hash_function_name("CONCAT"):
+            return builtin::concatenate(args, context);
+        case hash_function_name("TRIM"):
+            return builtin::trim(args, context);
+        case hash_function_name("LEN"):
+            return builtin::len(args, context);
+        case hash_function_name("LEFT"):
+            return builtin::left(args, context);
+        case hash_function_name("RIGHT"):
+            return builtin::right(args, context);
+        case hash_function_name("MID"):
+            return builtin::mid(args, context);
+        case hash_function_name("UPPER"):
+            return builtin::upper(args, context);
+        case hash_function_name("LOWER"):
+            return builtin::lower(args, context);
+        case hash_function_name("PROPER"):
+            return builtin::proper(args, context);
+        case hash_function_name("RPT"):
+            return builtin::rpt(args, context);
+        case hash_function_name("REPT"):
+            return builtin::rpt(args, context);
+        case hash_function_name("FIND"):
+            return builtin::find(args, context);
+        case hash_function_name("SEARCH"):
+            return builtin::search(args, context);
+        case hash_function_name("REPLACE"):
+            return builtin::replace(args, context);
+        case hash_function_name("SUBSTITUTE"):
+            return builtin::substitute(args, context);
+        case hash_function_name("TEXT"):
+            return builtin::text(args, context);
+        case hash_function_name("VALUE"):
+            return builtin::value(args, context);
+        case hash_function_name("T"):
+            return builtin::t_function(args, context);
+        case hash_function_name("TEXTJOIN"):
+            return builtin::textjoin(args, context);
+        case hash_function_name("UNICHAR"):
+            return builtin::unichar(args, context);
+        case hash_function_name("UNICODE"):
+            return builtin::unicode_function(args, context);
+        case hash_function_name("CHAR"):
+            return builtin::char_function(args, context);
+        case hash_function_name("CODE"):
+            return builtin::code_function(args, context);
+        case hash_function_name("CLEAN"):
+            return builtin::clean(args, context);
+        case hash_function_name("EXACT"):
+            return builtin::exact(args, context);
+        case hash_function_name("ROMAN"):
+            return builtin::roman(args, context);
+        case hash_function_name("ARABIC"):
+            return builtin::arabic(args, context);
+        default:
+            return Value();
+    }
+}
+
+#if defined(VELOX_SPLIT_FUNCTION_MODULES)
+namespace {
+// Loaded as a side module: make the functions reachable from the core's dispatcher
+[[maybe_unused]] const bool registered =
+        (register_function_module(FunctionModule::TEXT, &dispatch_text_function), true);
+}  // anonymous namespace
+#endif
+
+}  // namespace dispatcher
+}  // namespace functions
+}  // namespace xl_formula
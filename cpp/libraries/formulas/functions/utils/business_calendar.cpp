@@ -0,0 +1,233 @@
+#include "velox/formulas/business_calendar.h"
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <iterator>
+#include "velox/formulas/civil_date.h"
+
+namespace xl_formula {
+namespace dates {
+
+namespace {
+
+/**
+ * @brief Append the day numbers of a holidays argument
+ * @return Empty value, or the error the argument produces
+ */
+Value collectHolidays(const Value& value, std::vector<int64_t>& days) {
+    auto add = [&days](double serial) {
+        if (!(serial >= 0.0 && serial < static_cast<double>(kMaxSerial + 1))) {
+            return false;
+        }
+        days.push_back(static_cast<int64_t>(std::floor(serial)) - kUnixEpochSerial);
+        return true;
+    };
+
+    if (value.isArray()) {
+        const ArrayData& array = *value.asArrayPtr();
+        if (array.isNumeric()) {
+            for (double serial : array.numbers()) {
+                if (!add(serial)) {
+                    return Value::error(ErrorType::NUM_ERROR);
+                }
+            }
+            return Value::empty();
+        }
+        for (size_t i = 0; i < array.size(); ++i) {
+            Value result = collectHolidays(array.at(i), days);
+            if (!result.isEmpty()) {
+                return result;
+            }
+        }
+        return Value::empty();
+    }
+    if (value.isEmpty()) {
+        return Value::empty();
+    }
+    if (value.isError()) {
+        return value;
+    }
+    if (!value.isNumber() && !value.isDate()) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    return add(value.toNumber()) ? Value::empty() : Value::error(ErrorType::NUM_ERROR);
+}
+
+}  // anonymous namespace
+
+BusinessCalendar::BusinessCalendar(WeekendMask weekend, std::vector<int64_t> holidays)
+    : weekend_(weekend) {
+    // Day 0 of a week is a Thursday, as 1970-01-01 was
+    for (int64_t i = 0; i < 7; ++i) {
+        const bool working = !((weekend_ >> weekdayFromDays(i)) & 1u);
+        week_prefix_[i + 1] = week_prefix_[i] + (working ? 1 : 0);
+    }
+    workdays_per_week_ = week_prefix_[7];
+
+    if (holidays.empty()) {
+        return;
+    }
+    std::sort(holidays.begin(), holidays.end());
+    holidays.erase(std::unique(holidays.begin(), holidays.end()), holidays.end());
+
+    begin_ = daysFromCivil(civilFromDays(holidays.front()).year, 1, 1);
+    end_ = daysFromCivil(civilFromDays(holidays.back()).year + 1, 1, 1);
+    const int64_t span = end_ - begin_;
+    bits_.assign(static_cast<size_t>((span + 63) / 64), 0);
+    for (int64_t offset = 0; offset < span; ++offset) {
+        if (!((weekend_ >> weekdayFromDays(begin_ + offset)) & 1u)) {
+            bits_[offset / 64] |= uint64_t{1} << (offset % 64);
+        }
+    }
+    for (int64_t day : holidays) {
+        const int64_t offset = day - begin_;
+        uint64_t& word = bits_[offset / 64];
+        const uint64_t bit = uint64_t{1} << (offset % 64);
+        if (word & bit) {
+            word &= ~bit;
+            ++holidays_;
+        }
+    }
+
+    word_prefix_.resize(bits_.size());
+    int64_t running = 0;
+    for (size_t i = 0; i < bits_.size(); ++i) {
+        word_prefix_[i] = running;
+        running += static_cast<int64_t>(std::bitset<64>(bits_[i]).count());
+    }
+}
+
+int64_t BusinessCalendar::weeklyBefore(int64_t day) const {
+    const int64_t weeks = floorDiv(day, 7);
+    return weeks * workdays_per_week_ + week_prefix_[day - weeks * 7];
+}
+
+bool BusinessCalendar::isBusinessDay(int64_t day) const {
+    if (day >= begin_ && day < end_) {
+        const int64_t offset = day - begin_;
+        return (bits_[offset / 64] >> (offset % 64)) & 1u;
+    }
+    return !((weekend_ >> weekdayFromDays(day)) & 1u);
+}
+
+int64_t BusinessCalendar::countBefore(int64_t day) const {
+    if (bits_.empty() || day <= begin_) {
+        return weeklyBefore(day);
+    }
+    if (day >= end_) {
+        return weeklyBefore(day) - holidays_;
+    }
+    const int64_t offset = day - begin_;
+    const uint64_t below = (uint64_t{1} << (offset % 64)) - 1;
+    return weeklyBefore(begin_) + word_prefix_[offset / 64] +
+           static_cast<int64_t>(std::bitset<64>(bits_[offset / 64] & below).count());
+}
+
+int64_t BusinessCalendar::count(int64_t start, int64_t end) const {
+    if (end < start) {
+        return -(countBefore(start + 1) - countBefore(end));
+    }
+    return countBefore(end + 1) - countBefore(start);
+}
+
+int64_t BusinessCalendar::advance(int64_t start, int64_t days) const {
+    if (days == 0) {
+        return start;
+    }
+    // Each week holds workdays_per_week_ business days, less any holidays in it
+    const int64_t steps = days < 0 ? -days : days;
+    const int64_t reach = ((steps + holidays_) / workdays_per_week_ + 2) * 7;
+
+    if (days > 0) {
+        // First day d after start with steps business days in (start, d]
+        const int64_t target = countBefore(start + 1) + steps;
+        int64_t low = start + 1;
+        int64_t high = start + reach;
+        while (low < high) {
+            const int64_t mid = low + (high - low) / 2;
+            if (countBefore(mid + 1) >= target) {
+                high = mid;
+            } else {
+                low = mid + 1;
+            }
+        }
+        return low;
+    }
+
+    // Last day d before start with steps business days in [d, start)
+    const int64_t target = countBefore(start) - steps;
+    int64_t low = start - reach;
+    int64_t high = start - 1;
+    while (low < high) {
+        const int64_t mid = high - (high - low) / 2;
+        if (countBefore(mid) <= target) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return low;
+}
+
+std::shared_ptr<const BusinessCalendar> BusinessCalendarCache::find(
+        const Value::ArrayType& holidays, WeekendMask weekend) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(Key{holidays.get(), weekend});
+    if (it != entries_.end() && it->second.owner.lock() == holidays) {
+        return it->second.calendar;
+    }
+    return nullptr;
+}
+
+void BusinessCalendarCache::store(const Value::ArrayType& holidays,
+                                  std::shared_ptr<const BusinessCalendar> calendar) {
+    const Key key{holidays.get(), calendar->weekend()};
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= kMaxEntries && entries_.find(key) == entries_.end()) {
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            it = it->second.owner.expired() ? entries_.erase(it) : std::next(it);
+        }
+        if (entries_.size() >= kMaxEntries) {
+            entries_.clear();
+        }
+    }
+    entries_[key] = Entry{holidays, std::move(calendar)};
+}
+
+size_t BusinessCalendarCache::size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void BusinessCalendarCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+Value getBusinessCalendar(const Context& context, WeekendMask weekend, const Value* holidays,
+                          std::shared_ptr<const BusinessCalendar>& calendar) {
+    const bool cacheable = holidays != nullptr && holidays->isArray();
+    if (cacheable) {
+        calendar = context.getCalendarCache().find(holidays->asArrayPtr(), weekend);
+        if (calendar) {
+            return Value::empty();
+        }
+    }
+
+    // Build outside the cache lock; a concurrent build of the same array just wins or loses
+    std::vector<int64_t> days;
+    if (holidays != nullptr) {
+        Value error = collectHolidays(*holidays, days);
+        if (!error.isEmpty()) {
+            return error;
+        }
+    }
+    calendar = std::make_shared<const BusinessCalendar>(weekend, std::move(days));
+    if (cacheable) {
+        context.getCalendarCache().store(holidays->asArrayPtr(), calendar);
+    }
+    return Value::empty();
+}
+
+}  // namespace dates
+}  // namespace xl_formula
@@ -0,0 +1,65 @@
+#include "velox/formulas/civil_date.h"
+#include <chrono>
+
+namespace xl_formula {
+namespace dates {
+
+namespace {
+
+/**
+ * @brief Offset of the host's local time from UTC at an instant, in seconds
+ *
+ * Uses the reentrant localtime variants, so it is safe to call from several threads.
+ */
+int64_t localOffset(std::time_t instant) {
+    std::tm local{};
+#if defined(_WIN32)
+    localtime_s(&local, &instant);
+#else
+    localtime_r(&instant, &local);
+#endif
+    const int64_t local_seconds =
+            daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday) *
+                    kSecondsPerDay +
+            local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec;
+    return local_seconds - static_cast<int64_t>(instant);
+}
+
+}  // anonymous namespace
+
+std::tm toTm(const Value::DateType& date) {
+    const DateTime fields = splitDate(date);
+    std::tm tm{};
+    tm.tm_year = static_cast<int>(fields.date.year - 1900);
+    tm.tm_mon = static_cast<int>(fields.date.month - 1);
+    tm.tm_mday = static_cast<int>(fields.date.day);
+    tm.tm_hour = static_cast<int>(fields.hour);
+    tm.tm_min = static_cast<int>(fields.minute);
+    tm.tm_sec = static_cast<int>(fields.second);
+    tm.tm_wday = static_cast<int>(weekdayFromDays(fields.days));
+    tm.tm_yday = static_cast<int>(fields.days - daysFromCivil(fields.date.year, 1, 1));
+    tm.tm_isdst = 0;
+    return tm;
+}
+
+Value::DateType currentDateTime(TimeZonePolicy policy) {
+    const auto now = std::chrono::system_clock::now();
+    double seconds = std::chrono::duration<double>(now.time_since_epoch()).count();
+    if (policy == TimeZonePolicy::LOCAL) {
+        seconds += static_cast<double>(localOffset(std::chrono::system_clock::to_time_t(now)));
+    }
+    return Value::DateType(seconds / kSecondsPerDay + kUnixEpochSerial);
+}
+
+int64_t toUnixSeconds(const Value::DateType& date, TimeZonePolicy policy) {
+    const int64_t seconds = std::llround((date.serial - kUnixEpochSerial) * kSecondsPerDay);
+    if (policy == TimeZonePolicy::UTC) {
+        return seconds;
+    }
+    // The offset depends on the instant; one refinement settles it outside DST gaps
+    const int64_t guess = seconds - localOffset(static_cast<std::time_t>(seconds));
+    return seconds - localOffset(static_cast<std::time_t>(guess));
+}
+
+}  // namespace dates
+}  // namespace xl_formula
@@ -1,58 +1,15 @@
 #include "velox/formulas/conditional_utils.h"
 #include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
 #include <string>
+#include "velox/formulas/array_kernels.h"
+#include "velox/formulas/compile_cache.h"
 #include "velox/formulas/functions.h"
 
-// Local implementation of simpleWildcardMatch to avoid external dependency
-namespace {
-/**
- * @brief Simple wildcard matching without regex
- * @param text The text to match
- * @param pattern Pattern with * and ? wildcards
- * @return true if text matches pattern
- */
-bool simpleWildcardMatch(const std::string& text, const std::string& pattern) {
-    size_t textPos = 0;
-    size_t patternPos = 0;
-
-    while (textPos < text.length() && patternPos < pattern.length()) {
-        if (pattern[patternPos] == '*') {
-            // Skip consecutive asterisks
-            while (patternPos < pattern.length() && pattern[patternPos] == '*') {
-                patternPos++;
-            }
-
-            // If pattern ends with *, match rest of text
-            if (patternPos >= pattern.length()) {
-                return true;
-            }
-
-            // Find next matching character
-            char nextChar = pattern[patternPos];
-            while (textPos < text.length() && text[textPos] != nextChar) {
-                textPos++;
-            }
-
-            if (textPos >= text.length()) {
-                return false;
-            }
-        } else if (pattern[patternPos] == '?' || pattern[patternPos] == text[textPos]) {
-            patternPos++;
-            textPos++;
-        } else {
-            return false;
-        }
-    }
-
-    // Handle remaining asterisks at end of pattern
-    while (patternPos < pattern.length() && pattern[patternPos] == '*') {
-        patternPos++;
-    }
-
-    return textPos == text.length() && patternPos == pattern.length();
-}
-}  // anonymous namespace
-
 namespace xl_formula {
 namespace conditional {
 
@@ -67,130 +24,323 @@ bool toBooleanExcel(const Value& value) {
     return false;
 }
 
-bool evaluateCriteria(const Value& value, const Value& criteria) {
-    // If criteria is a number, do direct comparison
-    if (criteria.isNumber()) {
-        if (!value.isNumber()) {
+namespace {
+
+using Op = BinaryOpNode::Operator;
+
+// Same acceptance rules as std::stod (leading whitespace, trailing junk), without throwing
+bool parseNumber(const std::string& text, double& out) {
+    const char* begin = text.c_str();
+    char* end = nullptr;
+    errno = 0;
+    double parsed = std::strtod(begin, &end);
+    if (end == begin || errno == ERANGE) {
+        return false;
+    }
+    out = parsed;
+    return true;
+}
+
+template <typename T>
+bool compareWith(Op op, const T& lhs, const T& rhs) {
+    switch (op) {
+        case Op::EQUAL:
+            return lhs == rhs;
+        case Op::NOT_EQUAL:
+            return lhs != rhs;
+        case Op::LESS_THAN:
+            return lhs < rhs;
+        case Op::LESS_EQUAL:
+            return lhs <= rhs;
+        case Op::GREATER_THAN:
+            return lhs > rhs;
+        case Op::GREATER_EQUAL:
+            return lhs >= rhs;
+        default:
             return false;
+    }
+}
+
+char foldCase(char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+std::string foldCase(const std::string& text) {
+    std::string folded(text);
+    std::transform(folded.begin(), folded.end(), folded.begin(),
+                   [](char c) { return foldCase(c); });
+    return folded;
+}
+
+/**
+ * @brief Three-way comparison of text against already case-folded text, ignoring case
+ * @return Negative, zero or positive as text sorts before, equal to or after folded
+ */
+int compareFolded(const std::string& text, const std::string& folded) {
+    const size_t common = std::min(text.size(), folded.size());
+    for (size_t i = 0; i < common; ++i) {
+        const auto lhs = static_cast<unsigned char>(foldCase(text[i]));
+        const auto rhs = static_cast<unsigned char>(folded[i]);
+        if (lhs != rhs) {
+            return lhs < rhs ? -1 : 1;
         }
-        return std::abs(value.asNumber() - criteria.asNumber()) < 1e-10;
     }
+    return text.size() < folded.size() ? -1 : (text.size() > folded.size() ? 1 : 0);
+}
 
-    // If criteria is a boolean, do direct comparison
+void setBit(SelectionMask& selection, size_t index) {
+    selection[index / 64] |= uint64_t{1} << (index % 64);
+}
+
+bool testBit(const SelectionMask& selection, size_t index) {
+    return (selection[index / 64] >> (index % 64)) & 1u;
+}
+
+}  // namespace
+
+CompiledCriteria CompiledCriteria::compile(const Value& criteria) {
+    CompiledCriteria compiled;
+    if (criteria.isNumber()) {
+        compiled.kind_ = Kind::NUMBER;
+        compiled.number_ = criteria.asNumber();
+        return compiled;
+    }
     if (criteria.isBoolean()) {
-        if (!value.isBoolean()) {
-            return false;
-        }
-        return value.asBoolean() == criteria.asBoolean();
+        compiled.kind_ = Kind::BOOLEAN;
+        compiled.boolean_ = criteria.asBoolean();
+        return compiled;
+    }
+    if (!criteria.isText()) {
+        return compiled;
     }
 
-    // If criteria is text, parse for operators
-    if (criteria.isText()) {
-        std::string criteriaStr = criteria.asText();
+    const std::string text = criteria.asText();
+    if (text.empty()) {
+        compiled.kind_ = Kind::BLANK;
+        return compiled;
+    }
 
-        // Handle empty criteria
-        if (criteriaStr.empty()) {
-            return value.isEmpty() || (value.isText() && value.asText().empty());
+    // Comparison prefix: >=, <=, <>, then >, <, =
+    size_t prefix = 0;
+    if (text.compare(0, 2, ">=") == 0) {
+        compiled.op_ = Op::GREATER_EQUAL;
+        prefix = 2;
+    } else if (text.compare(0, 2, "<=") == 0) {
+        compiled.op_ = Op::LESS_EQUAL;
+        prefix = 2;
+    } else if (text.compare(0, 2, "<>") == 0) {
+        compiled.op_ = Op::NOT_EQUAL;
+        prefix = 2;
+    } else if (text[0] == '>') {
+        compiled.op_ = Op::GREATER_THAN;
+        prefix = 1;
+    } else if (text[0] == '<') {
+        compiled.op_ = Op::LESS_THAN;
+        prefix = 1;
+    } else if (text[0] == '=') {
+        compiled.op_ = Op::EQUAL;
+        prefix = 1;
+    }
+
+    if (prefix > 0) {
+        compiled.text_ = text.substr(prefix);
+        if (parseNumber(compiled.text_, compiled.number_)) {
+            compiled.kind_ = Kind::NUMBER_COMPARE;
+        } else {
+            compiled.kind_ = Kind::TEXT_COMPARE;
+            compiled.text_ = foldCase(compiled.text_);
         }
+        return compiled;
+    }
 
-        // Check for comparison operators (>=, <=, <>, >, <, =)
-        if (criteriaStr.size() >= 2) {
-            std::string op = criteriaStr.substr(0, 2);
-            if (op == ">=" || op == "<=" || op == "<>") {
-                std::string valueStr = criteriaStr.substr(2);
-                double criteriaVal;
-                try {
-                    criteriaVal = std::stod(valueStr);
-                } catch (...) {
-                    // Text comparison
-                    if (!value.isText()) {
-                        return false;
-                    }
-                    std::string valueText = value.asText();
-                    if (op == ">=")
-                        return valueText >= valueStr;
-                    if (op == "<=")
-                        return valueText <= valueStr;
-                    if (op == "<>")
-                        return valueText != valueStr;
-                    return false;
-                }
+    compiled.text_ = text;
+    if (WildcardPattern::hasWildcardSyntax(text)) {
+        compiled.kind_ = Kind::WILDCARD;
+        compiled.pattern_ = WildcardPattern::compile(text);
+    } else {
+        compiled.kind_ = Kind::TEXT_EQUAL;
+        compiled.has_number_ = parseNumber(text, compiled.number_);
+        compiled.text_ = foldCase(text);
+    }
+    return compiled;
+}
 
-                if (!value.isNumber()) {
-                    return false;
-                }
-                double val = value.asNumber();
-                if (op == ">=")
-                    return val >= criteriaVal;
-                if (op == "<=")
-                    return val <= criteriaVal;
-                if (op == "<>")
-                    return val != criteriaVal;
+std::shared_ptr<const CompiledCriteria> CompiledCriteria::cached(const Value& criteria) {
+    if (!criteria.isText()) {
+        return std::make_shared<const CompiledCriteria>(compile(criteria));
+    }
+
+    // Literal criteria repeat across evaluations of the same formula
+    thread_local CompileCache<CompiledCriteria> cache;
+    return cache.get(criteria.asText(), [&criteria]() { return compile(criteria); });
+}
+
+bool CompiledCriteria::matches(const Value& value) const {
+    switch (kind_) {
+        case Kind::NUMBER:
+            return value.isNumber() && std::abs(value.asNumber() - number_) < 1e-10;
+        case Kind::BOOLEAN:
+            return value.isBoolean() && value.asBoolean() == boolean_;
+        case Kind::BLANK:
+            return value.isEmpty() || (value.isText() && value.asText().empty());
+        case Kind::NUMBER_COMPARE:
+            return value.isNumber() && compareWith(op_, value.asNumber(), number_);
+        case Kind::TEXT_COMPARE:
+            return value.isText() && compareWith(op_, compareFolded(value.asText(), text_), 0);
+        case Kind::WILDCARD:
+            return value.isText() && pattern_.matches(value.asText());
+        case Kind::TEXT_EQUAL:
+            if (value.isText()) {
+                return value.asText().size() == text_.size() &&
+                       compareFolded(value.asText(), text_) == 0;
             }
-        }
+            return has_number_ && value.isNumber() && value.asNumber() == number_;
+        default:
+            return false;
+    }
+}
 
-        // Single character operators
-        if (criteriaStr.size() >= 1) {
-            char op = criteriaStr[0];
-            if (op == '>' || op == '<' || op == '=') {
-                std::string valueStr = criteriaStr.substr(1);
-                double criteriaVal;
-                try {
-                    criteriaVal = std::stod(valueStr);
-                } catch (...) {
-                    // Text comparison
-                    if (!value.isText()) {
-                        return false;
-                    }
-                    std::string valueText = value.asText();
-                    if (op == '>')
-                        return valueText > valueStr;
-                    if (op == '<')
-                        return valueText < valueStr;
-                    if (op == '=')
-                        return valueText == valueStr;
-                    return false;
-                }
+void CompiledCriteria::select(const ArrayData& range, SelectionMask& selection) const {
+    const size_t size = range.size();
+    selection.assign((size + 63) / 64, 0);
 
-                if (!value.isNumber()) {
-                    return false;
+    if (!range.isNumeric()) {
+        if (range.getStorage() == ArrayData::Storage::GENERIC) {
+            const auto& values = range.values();
+            for (size_t i = 0; i < size; ++i) {
+                if (matches(values[i])) {
+                    setBit(selection, i);
+                }
+            }
+        } else {
+            for (size_t i = 0; i < size; ++i) {
+                if (matches(range.at(i))) {
+                    setBit(selection, i);
                 }
-                double val = value.asNumber();
-                if (op == '>')
-                    return val > criteriaVal;
-                if (op == '<')
-                    return val < criteriaVal;
-                if (op == '=')
-                    return val == criteriaVal;
             }
         }
+        return;
+    }
 
-        // Handle wildcards (* and ?) using simpleWildcardMatch
-        if (criteriaStr.find('*') != std::string::npos ||
-            criteriaStr.find('?') != std::string::npos) {
-            if (!value.isText()) {
-                return false;
+    // Packed numbers: only numeric criteria can match
+    NumberSpan numbers = range.numbers();
+    if (kind_ == Kind::NUMBER) {
+        for (size_t word = 0; word < selection.size(); ++word) {
+            uint64_t bits = 0;
+            const size_t base = word * 64;
+            const size_t count = std::min<size_t>(64, size - base);
+            for (size_t j = 0; j < count; ++j) {
+                bits |= uint64_t{std::abs(numbers[base + j] - number_) < 1e-10} << j;
             }
-            return simpleWildcardMatch(value.asText(), criteriaStr);
+            selection[word] = bits;
+        }
+        return;
+    }
+
+    Op op = op_;
+    if (kind_ == Kind::TEXT_EQUAL && has_number_) {
+        op = Op::EQUAL;
+    } else if (kind_ != Kind::NUMBER_COMPARE) {
+        return;
+    }
+
+    // Compare 64 elements at a time through the SIMD kernels, then pack to bits
+    double flags[64];
+    for (size_t word = 0; word < selection.size(); ++word) {
+        const size_t base = word * 64;
+        const size_t count = std::min<size_t>(64, size - base);
+        kernels::binaryArrayScalar(op, numbers.data() + base, number_, flags, count);
+        uint64_t bits = 0;
+        for (size_t j = 0; j < count; ++j) {
+            bits |= uint64_t{flags[j] != 0.0} << j;
         }
+        selection[word] = bits;
+    }
+}
 
-        // Direct text comparison
-        if (value.isText()) {
-            return value.asText() == criteriaStr;
+size_t CompiledCriteria::countMatches(const ArrayData& range) const {
+    SelectionMask selection;
+    select(range, selection);
+    return countSelected(selection);
+}
+
+size_t countSelected(const SelectionMask& selection) {
+    size_t count = 0;
+    for (uint64_t word : selection) {
+        count += static_cast<size_t>(std::bitset<64>(word).count());
+    }
+    return count;
+}
+
+Value selectAllCriteria(const std::vector<Value>& args, size_t start_index, size_t size,
+                        SelectionMask& selection) {
+    // Validate every pair before scanning anything
+    for (size_t i = start_index; i + 1 < args.size(); i += 2) {
+        if (args[i].isError())
+            return args[i];
+        if (args[i + 1].isError())
+            return args[i + 1];
+        if (!args[i].isArray() || args[i].asArrayData().size() != size) {
+            return Value::error(ErrorType::VALUE_ERROR);
         }
+    }
+
+    selection.assign((size + 63) / 64, ~uint64_t{0});
+    if (size % 64 != 0) {
+        selection.back() = (uint64_t{1} << (size % 64)) - 1;
+    }
 
-        // Try to convert text criteria to number and compare
-        try {
-            double criteriaVal = std::stod(criteriaStr);
-            if (value.isNumber()) {
-                return value.asNumber() == criteriaVal;
+    SelectionMask scratch;
+    for (size_t i = start_index; i + 1 < args.size(); i += 2) {
+        CompiledCriteria::cached(args[i + 1])->select(args[i].asArrayData(), scratch);
+        uint64_t any = 0;
+        for (size_t w = 0; w < selection.size(); ++w) {
+            selection[w] &= scratch[w];
+            any |= selection[w];
+        }
+        if (any == 0) {
+            break;  // Nothing left to narrow down
+        }
+    }
+    return Value::empty();
+}
+
+Value maskedSum(const ArrayData& values, const SelectionMask& selection, size_t& counted) {
+    double sum = 0.0;
+    counted = 0;
+    if (values.isNumeric()) {
+        NumberSpan numbers = values.numbers();
+        for (size_t word = 0; word < selection.size(); ++word) {
+            uint64_t bits = selection[word];
+            for (size_t j = word * 64; bits != 0; ++j, bits >>= 1) {
+                if (bits & 1u) {
+                    sum += numbers[j];
+                    ++counted;
+                }
             }
-        } catch (...) {
-            // Not a number, fall through
         }
+        return Value(sum);
     }
 
-    return false;
+    // Excel skips text and booleans in the summed range but propagates errors
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!testBit(selection, i)) {
+            continue;
+        }
+        Value element = values.at(i);
+        if (element.isError()) {
+            return element;
+        }
+        if (element.isNumber()) {
+            sum += element.asNumber();
+            ++counted;
+        }
+    }
+    return Value(sum);
+}
+
+bool evaluateCriteria(const Value& value, const Value& criteria) {
+    return CompiledCriteria::compile(criteria).matches(value);
 }
 
 bool evaluateAllCriteria(const std::vector<Value>& args, size_t start_index) {
@@ -0,0 +1,314 @@
+#include "velox/formulas/financial_utils.h"
+#include <algorithm>
+#include <cmath>
+
+namespace xl_formula {
+namespace financial {
+
+namespace {
+
+constexpr int kNewtonIterations = 50;
+constexpr int kBrentIterations = 200;
+constexpr double kRateTolerance = 1e-12;
+
+// Rates probed for a sign change when Newton fails, in ascending order
+constexpr double kScanRates[] = {-0.99, -0.9, -0.75, -0.5, -0.25, -0.1, 0.0,  0.05, 0.1,  0.2,
+                                 0.35,  0.5,  0.75,  1.0,  1.5,   2.5,  5.0, 10.0, 25.0, 100.0};
+
+double tolerance(double rate) {
+    return kRateTolerance * std::max(1.0, std::fabs(rate));
+}
+
+/**
+ * @brief Most recent rates seen with a positive and a negative objective
+ */
+struct SignChange {
+    double positive = 0.0;
+    double negative = 0.0;
+    bool has_positive = false;
+    bool has_negative = false;
+
+    void add(double rate, double f) {
+        if (f > 0.0) {
+            positive = rate;
+            has_positive = true;
+        } else {
+            negative = rate;
+            has_negative = true;
+        }
+    }
+
+    bool bracketed() const {
+        return has_positive && has_negative;
+    }
+
+    double lo() const {
+        return std::min(positive, negative);
+    }
+
+    double hi() const {
+        return std::max(positive, negative);
+    }
+};
+
+/**
+ * @brief Find the sign change among the scan rates closest to the guess
+ */
+template <typename Objective>
+bool scanForBracket(const Objective& objective, double guess, double& lo, double& hi,
+                    int& evaluations) {
+    double previous_rate = 0.0;
+    double previous_f = 0.0;
+    bool has_previous = false;
+    double best_distance = HUGE_VAL;
+    for (double rate : kScanRates) {
+        double f;
+        double df;
+        objective(rate, f, df);
+        ++evaluations;
+        if (!std::isfinite(f)) {
+            has_previous = false;
+            continue;
+        }
+        if (has_previous && (f == 0.0 || (f > 0.0) != (previous_f > 0.0))) {
+            const double distance = guess < previous_rate ? previous_rate - guess
+                                    : guess > rate        ? guess - rate
+                                                          : 0.0;
+            if (distance < best_distance) {
+                best_distance = distance;
+                lo = previous_rate;
+                hi = rate;
+            }
+        }
+        previous_rate = rate;
+        previous_f = f;
+        has_previous = true;
+    }
+    return best_distance != HUGE_VAL;
+}
+
+/**
+ * @brief Brent's method on a bracketing interval
+ */
+template <typename Objective>
+RateResult brent(const Objective& objective, double lo, double hi, int evaluations) {
+    RateResult result;
+    double a = lo;
+    double b = hi;
+    double fa;
+    double fb;
+    double unused;
+    objective(a, fa, unused);
+    objective(b, fb, unused);
+    evaluations += 2;
+    double c = b;
+    double fc = fb;
+    double d = b - a;
+    double e = d;
+
+    for (int i = 0; i < kBrentIterations; ++i) {
+        if ((fb > 0.0) == (fc > 0.0)) {
+            c = a;
+            fc = fa;
+            d = b - a;
+            e = d;
+        }
+        if (std::fabs(fc) < std::fabs(fb)) {
+            a = b;
+            b = c;
+            c = a;
+            fa = fb;
+            fb = fc;
+            fc = fa;
+        }
+        const double tol = tolerance(b);
+        const double mid = 0.5 * (c - b);
+        if (std::fabs(mid) <= tol || fb == 0.0) {
+            result.rate = b;
+            result.converged = true;
+            break;
+        }
+        if (std::fabs(e) >= tol && std::fabs(fa) > std::fabs(fb)) {
+            // Inverse quadratic interpolation, or secant when only two points are distinct
+            const double s = fb / fa;
+            double p;
+            double q;
+            if (a == c) {
+                p = 2.0 * mid * s;
+                q = 1.0 - s;
+            } else {
+                const double qa = fa / fc;
+                const double r = fb / fc;
+                p = s * (2.0 * mid * qa * (qa - r) - (b - a) * (r - 1.0));
+                q = (qa - 1.0) * (r - 1.0) * (s - 1.0);
+            }
+            if (p > 0.0) {
+                q = -q;
+            }
+            p = std::fabs(p);
+            if (2.0 * p < std::min(3.0 * mid * q - std::fabs(tol * q), std::fabs(e * q))) {
+                e = d;
+                d = p / q;
+            } else {
+                d = mid;
+                e = d;
+            }
+        } else {
+            d = mid;
+            e = d;
+        }
+        a = b;
+        fa = fb;
+        b += std::fabs(d) > tol ? d : std::copysign(tol, mid);
+        objective(b, fb, unused);
+        ++evaluations;
+        if (!std::isfinite(fb)) {
+            break;
+        }
+    }
+    result.iterations = evaluations;
+    return result;
+}
+
+/**
+ * @brief Newton iterations with a bracketing fallback
+ * @param objective Sets f and df/drate at a rate above -1
+ */
+template <typename Objective>
+RateResult solve(const Objective& objective, double guess) {
+    RateResult result;
+    SignChange signs;
+    double rate = guess > -1.0 && std::isfinite(guess) ? guess : 0.1;
+
+    for (int i = 0; i < kNewtonIterations; ++i) {
+        double f;
+        double df;
+        objective(rate, f, df);
+        ++result.iterations;
+        if (!std::isfinite(f)) {
+            break;
+        }
+        if (f == 0.0) {
+            result.rate = rate;
+            result.converged = true;
+            return result;
+        }
+        signs.add(rate, f);
+        if (!std::isfinite(df) || df == 0.0) {
+            break;
+        }
+        double next = rate - f / df;
+        if (signs.bracketed() && !(next > signs.lo() && next < signs.hi())) {
+            break;  // Newton left the known root interval; Brent takes over
+        }
+        if (next <= -1.0) {
+            rate = 0.5 * (rate - 1.0);  // Stay inside the domain, halfway to -1
+            continue;
+        }
+        if (std::fabs(next - rate) <= tolerance(next)) {
+            result.rate = next;
+            result.converged = true;
+            return result;
+        }
+        rate = next;
+    }
+
+    double lo;
+    double hi;
+    if (signs.bracketed()) {
+        lo = signs.lo();
+        hi = signs.hi();
+    } else if (!scanForBracket(objective, guess, lo, hi, result.iterations)) {
+        result.rate = rate;
+        return result;
+    }
+    return brent(objective, lo, hi, result.iterations);
+}
+
+}  // anonymous namespace
+
+double presentValue(NumberSpan flows, double rate) {
+    const double x = 1.0 / (1.0 + rate);
+    double sum = 0.0;
+    for (size_t i = flows.size(); i-- > 0;) {
+        sum = sum * x + flows[i];
+    }
+    return sum * x;
+}
+
+RateResult solveIrr(NumberSpan flows, double guess) {
+    // NPV is a polynomial in x = 1 / (1 + rate); Horner yields it and its derivative
+    auto objective = [flows](double rate, double& f, double& df) {
+        const double x = 1.0 / (1.0 + rate);
+        double p = 0.0;
+        double dp = 0.0;
+        for (size_t i = flows.size(); i-- > 0;) {
+            dp = dp * x + p;
+            p = p * x + flows[i];
+        }
+        f = p;
+        df = -dp * x * x;  // dx/drate = -x^2
+    };
+    return solve(objective, guess);
+}
+
+RateResult solveXirr(NumberSpan flows, NumberSpan days, double guess) {
+    const size_t n = std::min(flows.size(), days.size());
+    std::vector<double> years(n);
+    for (size_t i = 0; i < n; ++i) {
+        years[i] = (days[i] - days[0]) / 365.0;
+    }
+    auto objective = [&](double rate, double& f, double& df) {
+        const double log_growth = std::log1p(rate);
+        f = 0.0;
+        df = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            const double term = flows[i] * std::exp(-years[i] * log_growth);
+            f += term;
+            df -= years[i] * term;
+        }
+        df /= 1.0 + rate;
+    };
+    return solve(objective, guess);
+}
+
+RateResult solveAnnuityRate(double nper, double pmt, double pv, double fv, double type,
+                            double guess) {
+    auto objective = [=](double rate, double& f, double& df) {
+        if (std::fabs(rate) < 1e-10) {
+            // Limits as rate -> 0, where (growth - 1) / rate -> nper
+            f = fv + pv + pmt * nper;
+            df = pv * nper + pmt * (type * nper + nper * (nper - 1.0) / 2.0);
+            return;
+        }
+        const double growth = std::pow(1.0 + rate, nper);
+        const double d_growth = nper * growth / (1.0 + rate);
+        const double annuity = (growth - 1.0) / rate;
+        const double d_annuity = (d_growth * rate - (growth - 1.0)) / (rate * rate);
+        const double timing = 1.0 + rate * type;
+        f = fv + pv * growth + pmt * timing * annuity;
+        df = pv * d_growth + pmt * (type * annuity + timing * d_annuity);
+    };
+    return solve(objective, guess);
+}
+
+std::vector<RateResult> solveIrrBatch(const std::vector<NumberSpan>& flows, double guess,
+                                      bool warm_start) {
+    std::vector<RateResult> results;
+    results.reserve(flows.size());
+    double start = guess;
+    for (const auto& vector : flows) {
+        RateResult result = solveIrr(vector, start);
+        if (!result.converged && start != guess) {
+            result = solveIrr(vector, guess);
+        }
+        if (warm_start && result.converged) {
+            start = result.rate;
+        }
+        results.push_back(result);
+    }
+    return results;
+}
+
+}  // namespace financial
+}  // namespace xl_formula
@@ -0,0 +1,430 @@
+#include "velox/formulas/lookup_index.h"
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include "velox/formulas/wildcard.h"
+
+namespace xl_formula {
+namespace lookup {
+
+namespace {
+
+enum class KeyType { NONE, NUMBER, TEXT, BOOLEAN };
+
+std::string toLower(const std::string& text) {
+    std::string lowered = text;
+    std::transform(lowered.begin(), lowered.end(), lowered.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return lowered;
+}
+
+/**
+ * @brief Normalize a key: numbers and date serials (with -0 folded into 0), lowercased text
+ * or booleans
+ */
+KeyType classify(const Value& value, double& number, std::string& text) {
+    if (value.isNumber() || value.isDate()) {
+        number = value.toNumber() == 0.0 ? 0.0 : value.toNumber();
+        return number == number ? KeyType::NUMBER : KeyType::NONE;
+    }
+    if (value.isText()) {
+        text = toLower(value.asText());
+        return KeyType::TEXT;
+    }
+    if (value.isBoolean()) {
+        number = value.asBoolean() ? 1.0 : 0.0;
+        return KeyType::BOOLEAN;
+    }
+    return KeyType::NONE;
+}
+
+/**
+ * @brief Normalized lookup value compared against keys one at a time
+ */
+class Probe {
+  private:
+    double number_ = 0.0;
+    std::string text_;
+    KeyType type_;  // declared last: classify() fills number_ / text_ first
+
+  public:
+    explicit Probe(const Value& value) : type_(classify(value, number_, text_)) {}
+
+    /**
+     * @brief Order of key relative to the probe: -1, 0 or 1, or 2 if not comparable
+     */
+    int compare(const Value& key) const {
+        if (type_ == KeyType::NONE) {
+            return 2;
+        }
+        double number = 0.0;
+        std::string text;
+        if (classify(key, number, text) != type_) {
+            return 2;
+        }
+        if (type_ == KeyType::TEXT) {
+            int order = text.compare(text_);
+            return order < 0 ? -1 : (order > 0 ? 1 : 0);
+        }
+        return number < number_ ? -1 : (number > number_ ? 1 : 0);
+    }
+};
+
+size_t axisLength(const TableShape& shape, Axis axis) {
+    switch (axis) {
+        case Axis::FIRST_COLUMN:
+            return shape.cols > 0 ? shape.rows : 0;
+        case Axis::FIRST_ROW:
+            return shape.rows > 0 ? shape.cols : 0;
+        case Axis::VECTOR:
+        default:
+            if (shape.rows == 1) {
+                return shape.cols;
+            }
+            return shape.cols == 1 ? shape.rows : 0;
+    }
+}
+
+Value keyAt(const Value& table, const TableShape& shape, Axis axis, size_t i) {
+    if (axis == Axis::FIRST_ROW || (axis == Axis::VECTOR && shape.rows == 1)) {
+        return tableCell(table, shape, 0, i);
+    }
+    return tableCell(table, shape, i, 0);
+}
+
+size_t findExactLinear(const Value& table, const TableShape& shape, Axis axis, size_t n,
+                       const Probe& probe, bool last) {
+    for (size_t step = 0; step < n; ++step) {
+        size_t i = last ? n - 1 - step : step;
+        if (probe.compare(keyAt(table, shape, axis, i)) == 0) {
+            return i;
+        }
+    }
+    return npos;
+}
+
+size_t findNearestLinear(const Value& table, const TableShape& shape, Axis axis, size_t n,
+                         const Value& value, bool below, bool inclusive, bool last) {
+    const Probe probe(value);
+    size_t best = npos;
+    Value best_key;
+    for (size_t i = 0; i < n; ++i) {
+        Value key = keyAt(table, shape, axis, i);
+        int order = probe.compare(key);
+        if (order == 2 || (order == 0 && !inclusive) || (order != 0 && (order < 0) != below)) {
+            continue;
+        }
+        if (best == npos) {
+            best = i;
+            best_key = key;
+            continue;
+        }
+        // Compare the candidate against the best key found so far
+        int versus_best = Probe(best_key).compare(key);
+        bool closer = below ? versus_best > 0 : versus_best < 0;
+        if (closer || (versus_best == 0 && last)) {
+            best = i;
+            best_key = key;
+        }
+    }
+    return best;
+}
+
+}  // anonymous namespace
+
+Value getTableShape(const Value& table, TableShape& shape) {
+    shape = TableShape{};
+    if (!table.isArray()) {
+        shape.rows = 1;
+        shape.cols = 1;
+        return Value::empty();
+    }
+
+    const ArrayData& data = table.asArrayData();
+    if (data.size() == 0) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    if (data.getStorage() != ArrayData::Storage::GENERIC) {
+        shape.rows = data.size();
+        shape.cols = 1;
+        return Value::empty();
+    }
+
+    const auto& rows = data.values();
+    shape.nested = rows[0].isArray();
+    shape.rows = rows.size();
+    shape.cols = shape.nested ? rows[0].asArrayData().size() : 1;
+    for (const auto& row : rows) {
+        // Every row must be an array of the same width, or none may be an array
+        if (row.isArray() != shape.nested ||
+            (shape.nested && row.asArrayData().size() != shape.cols)) {
+            return Value::error(ErrorType::VALUE_ERROR);
+        }
+    }
+    if (shape.cols == 0) {
+        return Value::error(ErrorType::VALUE_ERROR);
+    }
+    return Value::empty();
+}
+
+Value tableCell(const Value& table, const TableShape& shape, size_t row, size_t col) {
+    if (!table.isArray()) {
+        return table;
+    }
+    const ArrayData& data = table.asArrayData();
+    if (shape.nested) {
+        return data.values()[row].asArrayData().at(col);
+    }
+    // Flat tables are a single row or column; only one index can be non-zero
+    return data.at(row + col);
+}
+
+Value transposeTable(const Value& table, const TableShape& shape) {
+    std::vector<Value> rows;
+    rows.reserve(shape.cols);
+    std::vector<Value> row(shape.rows);
+    for (size_t c = 0; c < shape.cols; ++c) {
+        for (size_t r = 0; r < shape.rows; ++r) {
+            row[r] = tableCell(table, shape, r, c);
+        }
+        rows.push_back(Value::array(row));
+    }
+    return Value::array(rows);
+}
+
+LookupIndex::LookupIndex(const std::vector<Value>& keys, bool sorted) : sorted_(sorted) {
+    double number = 0.0;
+    std::string text;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        Positions* positions = nullptr;
+        switch (classify(keys[i], number, text)) {
+            case KeyType::NUMBER:
+                positions = &numbers_.emplace(number, Positions{i, i}).first->second;
+                if (sorted) {
+                    sorted_numbers_.emplace_back(number, i);
+                }
+                break;
+            case KeyType::TEXT:
+                if (sorted) {
+                    sorted_texts_.emplace_back(text, i);
+                }
+                positions = &texts_.emplace(std::move(text), Positions{i, i}).first->second;
+                break;
+            case KeyType::BOOLEAN:
+                positions = &booleans_[number != 0.0 ? 1 : 0];
+                if (positions->first == npos) {
+                    positions->first = i;
+                }
+                break;
+            default:
+                break;
+        }
+        if (positions) {
+            positions->last = i;
+        }
+    }
+
+    if (sorted) {
+        // Position is the tie-breaker, so equal keys stay in table order
+        std::sort(sorted_numbers_.begin(), sorted_numbers_.end());
+        std::sort(sorted_texts_.begin(), sorted_texts_.end());
+    }
+}
+
+size_t LookupIndex::findExact(const Value& value, bool last) const {
+    double number = 0.0;
+    std::string text;
+    const Positions* positions = nullptr;
+    switch (classify(value, number, text)) {
+        case KeyType::NUMBER: {
+            auto it = numbers_.find(number);
+            positions = it != numbers_.end() ? &it->second : nullptr;
+            break;
+        }
+        case KeyType::TEXT: {
+            auto it = texts_.find(text);
+            positions = it != texts_.end() ? &it->second : nullptr;
+            break;
+        }
+        case KeyType::BOOLEAN:
+            positions = &booleans_[number != 0.0 ? 1 : 0];
+            break;
+        default:
+            break;
+    }
+    if (!positions) {
+        return npos;
+    }
+    return last ? positions->last : positions->first;
+}
+
+template <typename Key>
+size_t LookupIndex::findNearest(const std::vector<std::pair<Key, size_t>>& sorted, const Key& key,
+                                bool below, bool inclusive, bool last) {
+    auto byKey = [](const std::pair<Key, size_t>& entry, const Key& k) { return entry.first < k; };
+    auto keyBefore = [](const Key& k, const std::pair<Key, size_t>& entry) {
+        return k < entry.first;
+    };
+
+    // Locate one entry holding the nearest key, then the first or last of its run
+    typename std::vector<std::pair<Key, size_t>>::const_iterator nearest;
+    if (below) {
+        auto it = inclusive ? std::upper_bound(sorted.begin(), sorted.end(), key, keyBefore)
+                            : std::lower_bound(sorted.begin(), sorted.end(), key, byKey);
+        if (it == sorted.begin()) {
+            return npos;
+        }
+        nearest = std::prev(it);
+    } else {
+        nearest = inclusive ? std::lower_bound(sorted.begin(), sorted.end(), key, byKey)
+                            : std::upper_bound(sorted.begin(), sorted.end(), key, keyBefore);
+        if (nearest == sorted.end()) {
+            return npos;
+        }
+    }
+
+    const Key& found = nearest->first;
+    if (last) {
+        return std::prev(std::upper_bound(sorted.begin(), sorted.end(), found, keyBefore))->second;
+    }
+    return std::lower_bound(sorted.begin(), sorted.end(), found, byKey)->second;
+}
+
+size_t LookupIndex::findNearest(const Value& value, bool below, bool inclusive, bool last) const {
+    double number = 0.0;
+    std::string text;
+    switch (classify(value, number, text)) {
+        case KeyType::NUMBER:
+            return findNearest(sorted_numbers_, number, below, inclusive, last);
+        case KeyType::TEXT:
+            return findNearest(sorted_texts_, text, below, inclusive, last);
+        case KeyType::BOOLEAN: {
+            // Only two possible keys: FALSE < TRUE
+            const bool probe = number != 0.0;
+            const Positions& same = booleans_[probe ? 1 : 0];
+            if (inclusive && same.first != npos) {
+                return last ? same.last : same.first;
+            }
+            const Positions& other = booleans_[probe ? 0 : 1];
+            if (other.first != npos && below == probe) {
+                return last ? other.last : other.first;
+            }
+            return npos;
+        }
+        default:
+            return npos;
+    }
+}
+
+std::shared_ptr<const LookupIndex> LookupIndexCache::get(
+        const Value::ArrayType& table, Axis axis, bool sorted,
+        const std::function<std::vector<Value>()>& keys) {
+    const Key key{table.get(), axis};
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end() && it->second.owner.lock() == table &&
+            (!sorted || it->second.index->hasSortedProjection())) {
+            return it->second.index;
+        }
+    }
+
+    // Build outside the lock; a concurrent build of the same table just wins or loses
+    auto index = std::make_shared<const LookupIndex>(keys(), sorted);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= kMaxEntries && entries_.find(key) == entries_.end()) {
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            it = it->second.owner.expired() ? entries_.erase(it) : std::next(it);
+        }
+        if (entries_.size() >= kMaxEntries) {
+            entries_.clear();
+        }
+    }
+    entries_[key] = Entry{table, index};
+    return index;
+}
+
+size_t LookupIndexCache::size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void LookupIndexCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+size_t findPosition(const Context& context, const Value& lookup_value, const Value& table,
+                    const TableShape& shape, Axis axis, MatchMode mode, bool reverse) {
+    const size_t n = axisLength(shape, axis);
+    if (n == 0 || lookup_value.isError() || lookup_value.isArray()) {
+        return npos;
+    }
+
+    if (mode == MatchMode::WILDCARD && lookup_value.isText() &&
+        WildcardPattern::hasWildcardSyntax(lookup_value.asText())) {
+        // Patterns can't be hashed; scan text keys with the compiled matcher
+        const WildcardPattern pattern = WildcardPattern::compile(lookup_value.asText());
+        for (size_t step = 0; step < n; ++step) {
+            size_t i = reverse ? n - 1 - step : step;
+            Value key = keyAt(table, shape, axis, i);
+            if (key.isText() && pattern.matches(key.asText())) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    const bool approximate = mode != MatchMode::EXACT && mode != MatchMode::WILDCARD;
+    if (table.isArray() && n >= kIndexThreshold) {
+        auto index = context.getLookupCache().get(table.asArrayPtr(), axis, approximate, [&]() {
+            std::vector<Value> keys;
+            keys.reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                keys.push_back(keyAt(table, shape, axis, i));
+            }
+            return keys;
+        });
+
+        switch (mode) {
+            case MatchMode::FLOOR:
+                return index->findNearest(lookup_value, true, true, true);
+            case MatchMode::CEIL:
+                return index->findNearest(lookup_value, false, true, false);
+            case MatchMode::EXACT_OR_SMALLER:
+            case MatchMode::EXACT_OR_LARGER: {
+                size_t exact = index->findExact(lookup_value, reverse);
+                if (exact != npos) {
+                    return exact;
+                }
+                return index->findNearest(lookup_value, mode == MatchMode::EXACT_OR_SMALLER,
+                                          false, reverse);
+            }
+            default:
+                return index->findExact(lookup_value, reverse);
+        }
+    }
+
+    // Small tables: a linear scan is cheaper than building an index
+    switch (mode) {
+        case MatchMode::FLOOR:
+            return findNearestLinear(table, shape, axis, n, lookup_value, true, true, true);
+        case MatchMode::CEIL:
+            return findNearestLinear(table, shape, axis, n, lookup_value, false, true, false);
+        case MatchMode::EXACT_OR_SMALLER:
+        case MatchMode::EXACT_OR_LARGER: {
+            size_t exact = findExactLinear(table, shape, axis, n, Probe(lookup_value), reverse);
+            if (exact != npos) {
+                return exact;
+            }
+            return findNearestLinear(table, shape, axis, n, lookup_value,
+                                     mode == MatchMode::EXACT_OR_SMALLER, false, reverse);
+        }
+        default:
+            return findExactLinear(table, shape, axis, n, Probe(lookup_value), reverse);
+    }
+}
+
+}  // namespace lookup
+}  // namespace xl_formula
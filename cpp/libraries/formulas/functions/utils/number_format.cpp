@@ -0,0 +1,793 @@
+#include "velox/formulas/number_format.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include "velox/formulas/civil_date.h"
+#include "velox/formulas/compile_cache.h"
+
+namespace xl_formula {
+namespace format {
+
+namespace {
+
+using Code = FormatToken::Code;
+using Part = FormatToken::Part;
+using Kind = FormatSection::Kind;
+
+constexpr int kMaxFractionDigits = 30;
+constexpr int kSignificantDigits = 15;
+
+constexpr const char* kMonthNames[12] = {"January", "February", "March",     "April",
+                                         "May",     "June",     "July",      "August",
+                                         "September", "October", "November", "December"};
+constexpr const char* kDayNames[7] = {"Sunday",   "Monday", "Tuesday", "Wednesday",
+                                      "Thursday", "Friday", "Saturday"};
+
+char lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool isLetter(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool isDigitPlaceholder(char c) {
+    return c == '0' || c == '#' || c == '?';
+}
+
+bool startsWithIgnoreCase(std::string_view text, size_t at, std::string_view prefix) {
+    if (text.size() - at < prefix.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < prefix.size(); ++i) {
+        if (lower(text[at + i]) != lower(prefix[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool isDateCode(Code code) {
+    return code >= Code::YEAR;
+}
+
+/**
+ * @brief Bounded output that keeps counting past the end of the buffer
+ */
+class Writer {
+  private:
+    char* out_;
+    size_t capacity_;
+    size_t length_ = 0;
+
+  public:
+    Writer(char* out, size_t capacity) : out_(out), capacity_(capacity) {}
+
+    void put(char c) {
+        if (length_ < capacity_) {
+            out_[length_] = c;
+        }
+        ++length_;
+    }
+
+    void put(std::string_view text) {
+        for (char c : text) {
+            put(c);
+        }
+    }
+
+    void putNumber(uint64_t value, int min_width) {
+        char digits[24];
+        auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+        for (int pad = min_width - static_cast<int>(end - digits); pad > 0; --pad) {
+            put('0');
+        }
+        put(std::string_view(digits, static_cast<size_t>(end - digits)));
+    }
+
+    size_t length() const {
+        return length_;
+    }
+};
+
+/**
+ * @brief Decimal digits of a positive double, limited to 15 significant digits
+ *
+ * digit(p) is the digit of 10^p. round() rounds half away from zero, on the decimal
+ * digits rather than the binary value, which is how Excel displays numbers.
+ */
+class Decimal {
+  private:
+    char digits_[kSignificantDigits + 1];
+    int count_ = 0;     ///< Significant digits kept
+    int exponent_ = 0;  ///< Power of ten of the first digit
+
+  public:
+    explicit Decimal(double value) {
+        if (value == 0.0) {
+            return;
+        }
+        char text[32];
+        auto end = std::to_chars(text, text + sizeof(text), value, std::chars_format::scientific,
+                                 kSignificantDigits - 1)
+                           .ptr;
+        // d.ddddddddddddddde±xx
+        digits_[0] = text[0];
+        std::memcpy(digits_ + 1, text + 2, kSignificantDigits - 1);
+        count_ = kSignificantDigits;
+        const char* e = std::find(text, end, 'e');
+        int exponent = 0;
+        std::from_chars(e + (e[1] == '+' ? 2 : 1), end, exponent);
+        exponent_ = exponent;
+        trim();
+    }
+
+    bool isZero() const {
+        return count_ == 0;
+    }
+
+    int exponent() const {
+        return exponent_;
+    }
+
+    char digit(int power) const {
+        const int index = exponent_ - power;
+        return index >= 0 && index < count_ ? digits_[index] : '0';
+    }
+
+    /// Shift the decimal point: the value is multiplied by 10^-shift
+    void shift(int shift) {
+        exponent_ -= shift;
+    }
+
+    /// Round to the given number of decimal places
+    void round(int decimals) {
+        const int keep = exponent_ + decimals + 1;
+        if (count_ == 0 || keep >= count_) {
+            return;
+        }
+        if (keep < 0) {
+            count_ = 0;
+            return;
+        }
+        const bool up = digits_[keep] >= '5';
+        count_ = keep;
+        if (!up) {
+            trim();
+            return;
+        }
+        int i = keep - 1;
+        while (i >= 0 && digits_[i] == '9') {
+            --i;
+        }
+        if (i < 0) {
+            // 9.96 -> 10.0, and 0.006 -> 0.01: one unit of the next higher power
+            digits_[0] = '1';
+            count_ = 1;
+            ++exponent_;
+            return;
+        }
+        ++digits_[i];
+        count_ = i + 1;
+    }
+
+    /// Integer digits, most significant first; empty when the integer part is zero
+    int integerDigits(char* out) const {
+        if (count_ == 0 || exponent_ < 0) {
+            return 0;
+        }
+        for (int p = exponent_; p >= 0; --p) {
+            out[exponent_ - p] = digit(p);
+        }
+        return exponent_ + 1;
+    }
+
+  private:
+    void trim() {
+        while (count_ > 0 && digits_[count_ - 1] == '0') {
+            --count_;
+        }
+    }
+};
+
+/**
+ * @brief General format: integers in full, otherwise up to 10 significant digits
+ */
+void writeGeneral(double value, Writer& out) {
+    char text[32];
+    char* end;
+    if (value == std::trunc(value) && std::fabs(value) < 1e15) {
+        end = std::to_chars(text, text + sizeof(text), static_cast<int64_t>(value)).ptr;
+    } else {
+        end = std::to_chars(text, text + sizeof(text), value, std::chars_format::general, 10).ptr;
+    }
+    for (char* c = text; c != end; ++c) {
+        out.put(*c == 'e' ? 'E' : *c);
+    }
+}
+
+/**
+ * @brief Write one integer-part digit placeholder
+ * @param digits Integer digits, most significant first
+ * @param count Number of integer digits
+ * @param places Number of integer placeholders in the section
+ */
+void writeIntegerPlaceholder(const FormatToken& token, const char* digits, int count, int places,
+                             bool thousands, Writer& out) {
+    auto emit = [&](int position, char c) {
+        out.put(c);
+        if (thousands && position > 0 && position % 3 == 0) {
+            out.put(',');
+        }
+    };
+    if (token.position == places - 1) {
+        // Digits beyond the placeholders all go to the leftmost one
+        for (int position = count - 1; position >= places; --position) {
+            emit(position, digits[count - 1 - position]);
+        }
+    }
+    if (token.position < count) {
+        emit(token.position, digits[count - 1 - token.position]);
+    } else if (token.placeholder == '0') {
+        emit(token.position, '0');
+    } else if (token.placeholder == '?') {
+        out.put(' ');
+    }
+}
+
+bool writeNumber(const FormatSection& section, double value, bool negative, Writer& out) {
+    for (int i = 0; i < section.percent; ++i) {
+        value *= 100.0;
+    }
+    for (int i = 0; i < section.thousands_scale; ++i) {
+        value /= 1000.0;
+    }
+    if (!std::isfinite(value)) {
+        return false;
+    }
+
+    Decimal decimal(value);
+    int exponent = 0;
+    if (section.has_exponent && !decimal.isZero()) {
+        // The mantissa fills the integer placeholders (or, for ##0.0E+0, the exponent is
+        // a multiple of their count); rounding 9.99 up to 10.0 takes a second pass
+        const int places = std::max(section.integer_digits, 1);
+        const int magnitude = decimal.exponent();
+        for (int carry = 0; carry < 2; ++carry) {
+            exponent = section.grouped_exponent
+                               ? dates::floorDiv(magnitude + carry, places) * places
+                               : magnitude + carry - (places - 1);
+            decimal = Decimal(value);
+            decimal.shift(exponent);
+            decimal.round(section.fraction_digits);
+            if (decimal.exponent() < places) {
+                break;
+            }
+        }
+    } else {
+        decimal.round(section.fraction_digits);
+    }
+
+    char integer[330];
+    const int integer_count = decimal.integerDigits(integer);
+    char fraction[kMaxFractionDigits];
+    int significant_fraction = 0;
+    for (int i = 0; i < section.fraction_digits; ++i) {
+        fraction[i] = decimal.digit(-1 - i);
+        if (fraction[i] != '0') {
+            significant_fraction = i + 1;
+        }
+    }
+
+    char exponent_digits[8];
+    int exponent_count = 0;
+    if (section.has_exponent) {
+        auto end = std::to_chars(exponent_digits, exponent_digits + sizeof(exponent_digits),
+                                 std::abs(exponent))
+                           .ptr;
+        exponent_count = static_cast<int>(end - exponent_digits);
+    }
+
+    if (negative && !decimal.isZero()) {
+        out.put('-');
+    }
+    for (const auto& token : section.tokens) {
+        switch (token.code) {
+            case Code::LITERAL:
+                out.put(token.text);
+                break;
+            case Code::DECIMAL:
+                if (section.integer_digits == 0) {
+                    for (int i = 0; i < integer_count; ++i) {
+                        out.put(integer[i]);
+                    }
+                }
+                out.put('.');
+                break;
+            case Code::DIGIT:
+                if (token.part == Part::INTEGER) {
+                    writeIntegerPlaceholder(token, integer, integer_count, section.integer_digits,
+                                            section.thousands, out);
+                } else if (token.part == Part::FRACTION) {
+                    if (token.position < significant_fraction || token.placeholder == '0') {
+                        out.put(fraction[token.position]);
+                    } else if (token.placeholder == '?') {
+                        out.put(' ');
+                    }
+                } else {
+                    writeIntegerPlaceholder(token, exponent_digits, exponent_count,
+                                            section.exponent_digits, false, out);
+                }
+                break;
+            case Code::EXPONENT:
+                out.put(token.placeholder);
+                if (exponent < 0) {
+                    out.put('-');
+                } else if (token.plus) {
+                    out.put('+');
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+bool writeDate(const FormatSection& section, double serial, Writer& out) {
+    if (serial < 0.0 || !std::isfinite(serial) ||
+        serial >= static_cast<double>(dates::kMaxSerial + 1)) {
+        return false;
+    }
+    int64_t unit = 1;
+    for (int i = 0; i < section.subsecond_digits; ++i) {
+        unit *= 10;
+    }
+    const int64_t ticks = std::llround(serial * dates::kSecondsPerDay * unit);
+    const int64_t seconds = ticks / unit;
+    const int64_t subsecond = ticks % unit;
+    const int64_t serial_day = seconds / dates::kSecondsPerDay;
+    const int64_t second_of_day = seconds % dates::kSecondsPerDay;
+    const int64_t days = serial_day - dates::kUnixEpochSerial;
+    const dates::CivilDate date = dates::civilFromDays(days);
+    const unsigned hour = static_cast<unsigned>(second_of_day / 3600);
+
+    for (const auto& token : section.tokens) {
+        switch (token.code) {
+            case Code::LITERAL:
+                out.put(token.text);
+                break;
+            case Code::YEAR:
+                if (token.width <= 2) {
+                    out.putNumber(static_cast<uint64_t>(date.year % 100), 2);
+                } else {
+                    out.putNumber(static_cast<uint64_t>(date.year), 4);
+                }
+                break;
+            case Code::MONTH:
+                out.putNumber(date.month, token.width);
+                break;
+            case Code::MONTH_NAME: {
+                std::string_view name = kMonthNames[date.month - 1];
+                out.put(token.width == 3 ? name.substr(0, 3)
+                                         : token.width == 4 ? name : name.substr(0, 1));
+                break;
+            }
+            case Code::DAY:
+                out.putNumber(date.day, token.width);
+                break;
+            case Code::WEEKDAY: {
+                std::string_view name = kDayNames[dates::weekdayFromDays(days)];
+                out.put(token.width == 3 ? name.substr(0, 3) : name);
+                break;
+            }
+            case Code::HOUR: {
+                unsigned shown = hour;
+                if (section.twelve_hour) {
+                    shown = hour % 12 == 0 ? 12 : hour % 12;
+                }
+                out.putNumber(shown, token.width);
+                break;
+            }
+            case Code::MINUTE:
+                out.putNumber(static_cast<uint64_t>(second_of_day / 60 % 60), token.width);
+                break;
+            case Code::SECOND:
+                out.putNumber(static_cast<uint64_t>(second_of_day % 60), token.width);
+                break;
+            case Code::SUBSECOND:
+                out.put('.');
+                out.putNumber(static_cast<uint64_t>(subsecond), token.width);
+                break;
+            case Code::AM_PM: {
+                const char* designator = hour < 12 ? "AM" : "PM";
+                out.put(token.lower ? lower(designator[0]) : designator[0]);
+                if (token.width == 2) {
+                    out.put(token.lower ? 'm' : 'M');
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+void writeGeneralSection(const FormatSection& section, double value, Writer& out) {
+    for (const auto& token : section.tokens) {
+        if (token.code == Code::LITERAL) {
+            out.put(token.text);
+        } else {
+            writeGeneral(value, out);
+        }
+    }
+}
+
+void addLiteral(FormatSection& section, std::string_view text) {
+    if (!section.tokens.empty() && section.tokens.back().code == Code::LITERAL) {
+        section.tokens.back().text.append(text);
+        return;
+    }
+    FormatToken token;
+    token.code = Code::LITERAL;
+    token.text = std::string(text);
+    section.tokens.push_back(std::move(token));
+}
+
+void addToken(FormatSection& section, Code code, uint8_t width = 0) {
+    FormatToken token;
+    token.code = code;
+    token.width = width;
+    section.tokens.push_back(std::move(token));
+}
+
+/**
+ * @brief Handle a bracketed tag: [$symbol-locale] is a literal, colors are ignored
+ */
+bool parseBracket(std::string_view tag, FormatSection& section) {
+    if (!tag.empty() && tag[0] == '$') {
+        addLiteral(section, tag.substr(1, tag.find('-') == std::string_view::npos
+                                                  ? std::string_view::npos
+                                                  : tag.find('-') - 1));
+        return true;
+    }
+    static constexpr std::string_view kColors[] = {"black", "blue",    "cyan",  "green",
+                                                   "magenta", "red",   "white", "yellow"};
+    for (auto color : kColors) {
+        if (tag.size() == color.size() && startsWithIgnoreCase(tag, 0, color)) {
+            return true;
+        }
+    }
+    return startsWithIgnoreCase(tag, 0, "color") && tag.size() > 5;
+}
+
+/**
+ * @brief Parse one section into tokens
+ */
+bool parseSection(std::string_view text, FormatSection& section) {
+    bool seen_digit = false;
+    bool seen_decimal = false;
+    bool seen_exponent = false;
+
+    for (size_t i = 0; i < text.size(); ++i) {
+        const char c = text[i];
+        const char l = lower(c);
+        if (c == '"') {
+            const size_t close = text.find('"', i + 1);
+            if (close == std::string_view::npos) {
+                return false;
+            }
+            addLiteral(section, text.substr(i + 1, close - i - 1));
+            i = close;
+        } else if (c == '\\') {
+            if (i + 1 < text.size()) {
+                addLiteral(section, text.substr(++i, 1));
+            }
+        } else if (c == '_') {
+            ++i;  // Space as wide as the next character
+            addLiteral(section, " ");
+        } else if (c == '*') {
+            ++i;  // Repeat-to-fill has no cell width to fill
+        } else if (c == '[') {
+            const size_t close = text.find(']', i);
+            if (close == std::string_view::npos ||
+                !parseBracket(text.substr(i + 1, close - i - 1), section)) {
+                return false;
+            }
+            i = close;
+        } else if (isDigitPlaceholder(c)) {
+            FormatToken token;
+            token.code = Code::DIGIT;
+            token.placeholder = c;
+            token.part = seen_exponent ? Part::EXPONENT
+                         : seen_decimal ? Part::FRACTION
+                                        : Part::INTEGER;
+            section.tokens.push_back(std::move(token));
+            seen_digit = true;
+        } else if (c == '.') {
+            if (!section.tokens.empty() && section.tokens.back().code == Code::SECOND &&
+                i + 1 < text.size() && text[i + 1] == '0') {
+                uint8_t width = 0;
+                while (i + 1 < text.size() && text[i + 1] == '0' && width < 3) {
+                    ++i;
+                    ++width;
+                }
+                addToken(section, Code::SUBSECOND, width);
+                section.subsecond_digits = width;
+            } else if (!seen_decimal && !seen_exponent) {
+                addToken(section, Code::DECIMAL);
+                seen_decimal = true;
+            } else {
+                addLiteral(section, ".");
+            }
+        } else if (c == ',') {
+            const bool after_digit = !section.tokens.empty() &&
+                                     section.tokens.back().code == Code::DIGIT &&
+                                     section.tokens.back().part != Part::EXPONENT;
+            size_t j = i;
+            while (j < text.size() && text[j] == ',') {
+                ++j;
+            }
+            if (after_digit && j < text.size() && isDigitPlaceholder(text[j])) {
+                section.thousands = section.thousands || !seen_decimal;
+                i = j - 1;
+            } else if (after_digit) {
+                section.thousands_scale += static_cast<int>(j - i);
+                i = j - 1;
+            } else {
+                addLiteral(section, ",");
+            }
+        } else if (c == '%') {
+            addLiteral(section, "%");
+            ++section.percent;
+        } else if (l == 'e' && seen_digit && !seen_exponent && i + 1 < text.size() &&
+                   (text[i + 1] == '+' || text[i + 1] == '-')) {
+            FormatToken token;
+            token.code = Code::EXPONENT;
+            token.placeholder = c;
+            token.plus = text[i + 1] == '+';
+            section.tokens.push_back(std::move(token));
+            seen_exponent = true;
+            ++i;
+        } else if (c == '@') {
+            addToken(section, Code::TEXT);
+        } else if (startsWithIgnoreCase(text, i, "general")) {
+            addToken(section, Code::GENERAL);
+            i += 6;
+        } else if (startsWithIgnoreCase(text, i, "am/pm") || startsWithIgnoreCase(text, i, "a/p")) {
+            const bool full = startsWithIgnoreCase(text, i, "am/pm");
+            addToken(section, Code::AM_PM, full ? 2 : 1);
+            section.tokens.back().lower = c == 'a';
+            section.twelve_hour = true;
+            i += full ? 4 : 2;
+        } else if (l == 'y' || l == 'm' || l == 'd' || l == 'h' || l == 's') {
+            size_t j = i;
+            while (j < text.size() && lower(text[j]) == l) {
+                ++j;
+            }
+            const uint8_t width = static_cast<uint8_t>(std::min<size_t>(j - i, 5));
+            switch (l) {
+                case 'y':
+                    addToken(section, Code::YEAR, width <= 2 ? 2 : 4);
+                    break;
+                case 'm':
+                    addToken(section, width <= 2 ? Code::MONTH : Code::MONTH_NAME, width);
+                    break;
+                case 'd':
+                    addToken(section, width <= 2 ? Code::DAY : Code::WEEKDAY,
+                             std::min<uint8_t>(width, 4));
+                    break;
+                case 'h':
+                    addToken(section, Code::HOUR, std::min<uint8_t>(width, 2));
+                    break;
+                default:
+                    addToken(section, Code::SECOND, std::min<uint8_t>(width, 2));
+                    break;
+            }
+            i = j - 1;
+        } else if (isLetter(c)) {
+            return false;  // Unknown code
+        } else {
+            addLiteral(section, text.substr(i, 1));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Resolve m/mm to minutes, classify the section and number the digit placeholders
+ */
+bool finishSection(FormatSection& section) {
+    auto& tokens = section.tokens;
+    bool has_date = false;
+    bool has_digits = false;
+    bool has_text = false;
+    bool has_general = false;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        if (tokens[i].code == Code::MONTH) {
+            // m is minutes right after hours or right before seconds
+            size_t prev = i;
+            while (prev > 0 && tokens[prev - 1].code == Code::LITERAL) {
+                --prev;
+            }
+            size_t next = i + 1;
+            while (next < tokens.size() && tokens[next].code == Code::LITERAL) {
+                ++next;
+            }
+            if ((prev > 0 && tokens[prev - 1].code == Code::HOUR) ||
+                (next < tokens.size() && tokens[next].code == Code::SECOND)) {
+                tokens[i].code = Code::MINUTE;
+            }
+        }
+        has_date = has_date || isDateCode(tokens[i].code);
+        has_digits = has_digits || tokens[i].code == Code::DIGIT;
+        has_text = has_text || tokens[i].code == Code::TEXT;
+        has_general = has_general || tokens[i].code == Code::GENERAL;
+    }
+    if (has_date + has_digits + has_text + has_general > 1) {
+        return false;
+    }
+    if (!has_digits) {
+        // Without digit placeholders a '.' is plain text, as in yyyy.mm.dd
+        for (auto& token : tokens) {
+            if (token.code == Code::DECIMAL) {
+                token.code = Code::LITERAL;
+                token.text = ".";
+            }
+        }
+    }
+    section.kind = has_date      ? Kind::DATE
+                   : has_text    ? Kind::TEXT
+                   : has_general ? Kind::GENERAL
+                                 : Kind::NUMBER;
+
+    bool integer_hash = false;
+    for (auto& token : tokens) {
+        if (token.code == Code::EXPONENT) {
+            section.has_exponent = true;
+        }
+        if (token.code != Code::DIGIT) {
+            continue;
+        }
+        switch (token.part) {
+            case Part::INTEGER:
+                token.position = section.integer_digits++;
+                integer_hash = integer_hash || token.placeholder == '#';
+                break;
+            case Part::FRACTION:
+                token.position = section.fraction_digits++;
+                break;
+            case Part::EXPONENT:
+                token.position = section.exponent_digits++;
+                break;
+        }
+    }
+    // Integer and exponent positions count from the right
+    for (auto& token : tokens) {
+        if (token.code == Code::DIGIT && token.part == Part::INTEGER) {
+            token.position = section.integer_digits - 1 - token.position;
+        } else if (token.code == Code::DIGIT && token.part == Part::EXPONENT) {
+            token.position = section.exponent_digits - 1 - token.position;
+        }
+    }
+    section.grouped_exponent = section.has_exponent && integer_hash && section.integer_digits > 1;
+    return section.fraction_digits <= kMaxFractionDigits;
+}
+
+}  // anonymous namespace
+
+NumberFormat NumberFormat::compile(std::string_view pattern) {
+    NumberFormat result;
+    std::vector<std::string_view> parts;
+    size_t start = 0;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        const char c = pattern[i];
+        if (c == '"') {
+            i = pattern.find('"', i + 1);
+            if (i == std::string_view::npos) {
+                return result;
+            }
+        } else if (c == '\\' || c == '_' || c == '*') {
+            ++i;
+        } else if (c == '[') {
+            i = pattern.find(']', i);
+            if (i == std::string_view::npos) {
+                return result;
+            }
+        } else if (c == ';') {
+            parts.push_back(pattern.substr(start, i - start));
+            start = i + 1;
+        }
+    }
+    parts.push_back(pattern.substr(std::min(start, pattern.size())));
+    if (parts.size() > 4) {
+        return result;
+    }
+
+    for (auto part : parts) {
+        FormatSection section;
+        if (!parseSection(part, section) || !finishSection(section)) {
+            return result;
+        }
+        result.sections_.push_back(std::move(section));
+    }
+    result.valid_ = true;
+    return result;
+}
+
+std::shared_ptr<const NumberFormat> NumberFormat::cached(const std::string& pattern) {
+    // Report formats repeat across millions of cells
+    thread_local CompileCache<NumberFormat> cache;
+    return cache.get(pattern, [&pattern]() { return compile(pattern); });
+}
+
+size_t NumberFormat::format(double value, char* buffer, size_t capacity) const {
+    if (!valid_ || sections_.empty() || std::isnan(value)) {
+        return npos;
+    }
+    // Positive; negative; zero; text. A negative value shown through its own section
+    // loses its sign, which the section spells out itself if it wants one
+    size_t index = 0;
+    if (value < 0.0 && sections_.size() >= 2) {
+        index = 1;
+    } else if (value == 0.0 && sections_.size() >= 3) {
+        index = 2;
+    }
+    const FormatSection& section = sections_[index];
+    const bool negative = value < 0.0 && index == 0;
+    const double magnitude = std::fabs(value);
+
+    Writer out(buffer, capacity);
+    switch (section.kind) {
+        case Kind::NUMBER:
+            if (!writeNumber(section, magnitude, negative, out)) {
+                return npos;
+            }
+            break;
+        case Kind::DATE:
+            if (negative || !writeDate(section, magnitude, out)) {
+                return npos;
+            }
+            break;
+        case Kind::TEXT:
+        case Kind::GENERAL:
+            writeGeneralSection(section, negative ? value : magnitude, out);
+            break;
+    }
+    return out.length();
+}
+
+size_t NumberFormat::formatText(std::string_view text, char* buffer, size_t capacity) const {
+    if (!valid_) {
+        return npos;
+    }
+    const FormatSection* section = nullptr;
+    if (sections_.size() == 4) {
+        section = &sections_[3];
+    } else if (sections_[0].kind == Kind::TEXT) {
+        section = &sections_[0];
+    }
+    if (section != nullptr && section->kind != Kind::TEXT && section->kind != Kind::NUMBER) {
+        return npos;
+    }
+
+    Writer out(buffer, capacity);
+    if (section == nullptr) {
+        // As in Excel, numeric formats show text unchanged
+        out.put(text);
+        return out.length();
+    }
+    for (const auto& token : section->tokens) {
+        if (token.code == Code::LITERAL) {
+            out.put(token.text);
+        } else if (token.code == Code::TEXT) {
+            out.put(text);
+        }
+    }
+    return out.length();
+}
+
+}  // namespace format
+}  // namespace xl_formula
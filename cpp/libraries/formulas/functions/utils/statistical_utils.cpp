@@ -0,0 +1,391 @@
+#include "velox/formulas/statistical_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace xl_formula {
+namespace statistics {
+
+namespace {
+
+/**
+ * @brief Append the numbers inside an array, recursing into table rows
+ * @return Empty value, or the first error element
+ */
+Value appendArrayNumbers(const ArrayData& data, std::vector<double>& numbers) {
+    NumberSpan packed = data.numbers();
+    if (data.isNumeric()) {
+        numbers.insert(numbers.end(), packed.begin(), packed.end());
+        return Value::empty();
+    }
+    for (const auto& item : data.values()) {
+        if (item.isNumber()) {
+            numbers.push_back(item.asNumber());
+        } else if (item.isError()) {
+            return item;
+        } else if (item.isArray()) {
+            auto error = appendArrayNumbers(item.asArrayData(), numbers);
+            if (!error.isEmpty()) {
+                return error;
+            }
+        }
+    }
+    return Value::empty();
+}
+
+/**
+ * @brief Add the numbers inside an array, recursing into table rows
+ * @return Empty value, or the first error element
+ */
+Value addArrayNumbers(const ArrayData& data, kernels::SumAccumulator& sum, size_t& count) {
+    if (data.isNumeric()) {
+        NumberSpan packed = data.numbers();
+        sum.add(kernels::sum(packed.data(), packed.size(), sum.mode()));
+        count += packed.size();
+        return Value::empty();
+    }
+    for (const auto& item : data.values()) {
+        if (item.isNumber()) {
+            sum.add(item.asNumber());
+            ++count;
+        } else if (item.isError()) {
+            return item;
+        } else if (item.isArray()) {
+            auto error = addArrayNumbers(item.asArrayData(), sum, count);
+            if (!error.isEmpty()) {
+                return error;
+            }
+        }
+    }
+    return Value::empty();
+}
+
+/**
+ * @brief Count the numbers inside an array, recursing into table rows
+ * @return Empty value, or the first error element
+ */
+Value tallyArrayNumbers(const ArrayData& data, NumberTable& table, size_t& position) {
+    if (data.isNumeric()) {
+        for (double number : data.numbers()) {
+            table.add(number, position++);
+        }
+        return Value::empty();
+    }
+    for (const auto& item : data.values()) {
+        if (item.isNumber()) {
+            table.add(item.asNumber(), position++);
+        } else if (item.isError()) {
+            return item;
+        } else if (item.isArray()) {
+            auto error = tallyArrayNumbers(item.asArrayData(), table, position);
+            if (!error.isEmpty()) {
+                return error;
+            }
+        }
+    }
+    return Value::empty();
+}
+
+/**
+ * @brief Number of a scalar data argument, following the aggregate functions' rules
+ */
+bool scalarNumber(const Value& value, double& number) {
+    if (value.isEmpty() || !value.canConvertToNumber()) {
+        return false;
+    }
+    number = value.toNumber();
+    return true;
+}
+
+}  // anonymous namespace
+
+std::shared_ptr<const std::vector<double>> SortedArrayCache::get(const Value::ArrayType& array,
+                                                                 NumberSpan numbers) {
+    const ArrayData* key = array.get();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it == entries_.end() || it->second.owner.lock() != array) {
+            // First request: register the array and let the caller select
+            if (entries_.size() >= kMaxEntries && it == entries_.end()) {
+                for (auto stale = entries_.begin(); stale != entries_.end();) {
+                    stale = stale->second.owner.expired() ? entries_.erase(stale)
+                                                          : std::next(stale);
+                }
+                if (entries_.size() >= kMaxEntries) {
+                    entries_.clear();
+                }
+            }
+            entries_[key] = Entry{array, nullptr};
+            return nullptr;
+        }
+        if (it->second.sorted) {
+            return it->second.sorted;
+        }
+    }
+
+    // Sort outside the lock; a concurrent sort of the same array just wins or loses
+    auto sorted = std::make_shared<std::vector<double>>(numbers.begin(), numbers.end());
+    std::sort(sorted->begin(), sorted->end());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end() && it->second.owner.lock() == array) {
+        it->second.sorted = sorted;
+    }
+    return sorted;
+}
+
+size_t SortedArrayCache::size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void SortedArrayCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+Value OrderStatistics::load(const Context& context, const std::vector<Value>& args,
+                            bool use_cache) {
+    owned_.clear();
+    sorted_.reset();
+    numbers_ = NumberSpan();
+
+    if (args.size() == 1 && args[0].isArray()) {
+        const ArrayData& data = args[0].asArrayData();
+        NumberSpan span = data.numbers();
+        if (!data.isNumeric()) {
+            auto error = appendArrayNumbers(data, owned_);
+            if (!error.isEmpty()) {
+                return error;
+            }
+            span = NumberSpan(owned_);
+        }
+        if (use_cache && span.size() >= kSortedCacheThreshold) {
+            sorted_ = context.getSortedArrayCache().get(args[0].asArrayPtr(), span);
+            if (sorted_) {
+                owned_.clear();
+                span = NumberSpan(*sorted_);
+            }
+        }
+        numbers_ = span;
+        return Value::empty();
+    }
+
+    for (const auto& arg : args) {
+        if (arg.isError()) {
+            return arg;
+        }
+        if (arg.isArray()) {
+            auto error = appendArrayNumbers(arg.asArrayData(), owned_);
+            if (!error.isEmpty()) {
+                return error;
+            }
+        } else {
+            double number;
+            if (scalarNumber(arg, number)) {
+                owned_.push_back(number);
+            }
+        }
+    }
+    numbers_ = NumberSpan(owned_);
+    return Value::empty();
+}
+
+double OrderStatistics::kthSmallest(size_t k) const {
+    if (sorted_) {
+        return numbers_[k];
+    }
+    if (k < kPartialSortLimit) {
+        // Partial sort into k + 1 slots: one pass, no copy of the whole data
+        std::vector<double> smallest(k + 1);
+        std::partial_sort_copy(numbers_.begin(), numbers_.end(), smallest.begin(),
+                               smallest.end());
+        return smallest[k];
+    }
+    std::vector<double> copy(numbers_.begin(), numbers_.end());
+    std::nth_element(copy.begin(), copy.begin() + static_cast<std::ptrdiff_t>(k), copy.end());
+    return copy[k];
+}
+
+double OrderStatistics::kthLargest(size_t k) const {
+    if (!sorted_ && k < kPartialSortLimit) {
+        std::vector<double> largest(k + 1);
+        std::partial_sort_copy(numbers_.begin(), numbers_.end(), largest.begin(), largest.end(),
+                               std::greater<double>());
+        return largest[k];
+    }
+    return kthSmallest(numbers_.size() - 1 - k);
+}
+
+double OrderStatistics::percentile(double p) const {
+    const double rank = p * static_cast<double>(numbers_.size() - 1);
+    const size_t lower = static_cast<size_t>(std::floor(rank));
+    const double fraction = rank - static_cast<double>(lower);
+
+    if (sorted_) {
+        const double low = numbers_[lower];
+        return fraction > 0.0 ? low + fraction * (numbers_[lower + 1] - low) : low;
+    }
+
+    // Select the lower neighbour; the upper one is the minimum of the partition above it
+    std::vector<double> copy(numbers_.begin(), numbers_.end());
+    auto nth = copy.begin() + static_cast<std::ptrdiff_t>(lower);
+    std::nth_element(copy.begin(), nth, copy.end());
+    const double low = *nth;
+    if (fraction > 0.0 && lower + 1 < copy.size()) {
+        const double high = *std::min_element(nth + 1, copy.end());
+        return low + fraction * (high - low);
+    }
+    return low;
+}
+
+size_t OrderStatistics::countBeyond(double value, bool above) const {
+    if (sorted_) {
+        if (above) {
+            auto first = std::upper_bound(numbers_.begin(), numbers_.end(), value);
+            return static_cast<size_t>(numbers_.end() - first);
+        }
+        auto last = std::lower_bound(numbers_.begin(), numbers_.end(), value);
+        return static_cast<size_t>(last - numbers_.begin());
+    }
+    size_t count = 0;
+    for (double number : numbers_) {
+        count += above ? number > value : number < value;
+    }
+    return count;
+}
+
+bool OrderStatistics::contains(double value) const {
+    if (sorted_) {
+        return std::binary_search(numbers_.begin(), numbers_.end(), value);
+    }
+    return std::find(numbers_.begin(), numbers_.end(), value) != numbers_.end();
+}
+
+Value accumulateSum(const std::vector<Value>& args, kernels::SumAccumulator& sum, size_t& count) {
+    count = 0;
+    for (const auto& arg : args) {
+        if (arg.isError()) {
+            return arg;
+        }
+        if (arg.isArray()) {
+            auto error = addArrayNumbers(arg.asArrayData(), sum, count);
+            if (!error.isEmpty()) {
+                return error;
+            }
+        } else {
+            double number;
+            if (scalarNumber(arg, number)) {
+                sum.add(number);
+                ++count;
+            }
+        }
+    }
+    return Value::empty();
+}
+
+Value tallyNumbers(const std::vector<Value>& args, NumberTable& table) {
+    size_t position = 0;
+    for (const auto& arg : args) {
+        if (arg.isError()) {
+            return arg;
+        }
+        if (arg.isArray()) {
+            auto error = tallyArrayNumbers(arg.asArrayData(), table, position);
+            if (!error.isEmpty()) {
+                return error;
+            }
+        } else {
+            double number;
+            if (scalarNumber(arg, number)) {
+                table.add(number, position++);
+            }
+        }
+    }
+    return Value::empty();
+}
+
+Value accumulateMoments(const std::vector<Value>& args, kernels::Moments& moments) {
+    moments = kernels::Moments();
+    std::vector<double> buffered;
+    for (const auto& arg : args) {
+        if (arg.isError()) {
+            return arg;
+        }
+        if (arg.isArray()) {
+            const ArrayData& data = arg.asArrayData();
+            if (data.isNumeric()) {
+                NumberSpan numbers = data.numbers();
+                moments.merge(kernels::moments(numbers.data(), numbers.size()));
+                continue;
+            }
+            auto error = appendArrayNumbers(data, buffered);
+            if (!error.isEmpty()) {
+                return error;
+            }
+        } else {
+            double number;
+            if (scalarNumber(arg, number)) {
+                buffered.push_back(number);
+            }
+        }
+    }
+    moments.merge(kernels::moments(buffered.data(), buffered.size()));
+    return Value::empty();
+}
+
+Value accumulateCoMoments(const std::vector<Value>& args, kernels::CoMoments& moments) {
+    moments = kernels::CoMoments();
+    std::vector<double> x;
+    std::vector<double> y;
+
+    if (args.size() == 2 && args[0].isArray() && args[1].isArray()) {
+        const ArrayData& xs = args[0].asArrayData();
+        const ArrayData& ys = args[1].asArrayData();
+        const size_t n = std::min(xs.size(), ys.size());
+        if (xs.isNumeric() && ys.isNumeric()) {
+            moments = kernels::coMoments(xs.numbers().data(), ys.numbers().data(), n);
+            return Value::empty();
+        }
+        x.reserve(n);
+        y.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            Value xv = xs.at(i);
+            Value yv = ys.at(i);
+            if (xv.isError()) {
+                return xv;
+            }
+            if (yv.isError()) {
+                return yv;
+            }
+            if (xv.isNumber() && yv.isNumber()) {
+                x.push_back(xv.asNumber());
+                y.push_back(yv.asNumber());
+            }
+        }
+    } else {
+        const size_t mid = args.size() / 2;
+        x.reserve(mid);
+        y.reserve(args.size() - mid);
+        for (size_t i = 0; i < args.size(); ++i) {
+            if (args[i].isError()) {
+                return args[i];
+            }
+            double number;
+            if (scalarNumber(args[i], number)) {
+                (i < mid ? x : y).push_back(number);
+            }
+        }
+        const size_t n = std::min(x.size(), y.size());
+        x.resize(n);
+        y.resize(n);
+    }
+
+    moments = kernels::coMoments(x.data(), y.data(), x.size());
+    return Value::empty();
+}
+
+}  // namespace statistics
+}  // namespace xl_formula
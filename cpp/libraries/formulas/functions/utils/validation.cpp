@@ -51,6 +51,14 @@ Value toNumberSafe(const Value& value, const std::string& function_name) {
     }
 }
 
+bool numericArrayView(const Value& value, NumberSpan& numbers) {
+    if (!value.isArray() || !value.asArrayData().isNumeric()) {
+        return false;
+    }
+    numbers = value.asArrayData().numbers();
+    return true;
+}
+
 }  // namespace utils
 }  // namespace functions
 }  // namespace xl_formula
\ No newline at end of file
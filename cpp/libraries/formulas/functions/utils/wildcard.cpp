@@ -0,0 +1,206 @@
+#include "velox/formulas/wildcard.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace xl_formula {
+
+namespace {
+
+char lower(char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+/**
+ * @brief Position of the next occurrence of c (either letter case) at or after from
+ * @param lowered Lowercased character to look for
+ */
+size_t findFolded(const std::string& text, size_t from, char lowered) {
+    if (from >= text.size()) {
+        return std::string::npos;
+    }
+    const char* base = text.data();
+    const size_t length = text.size() - from;
+    const char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(lowered)));
+
+    const void* hit = std::memchr(base + from, lowered, length);
+    size_t pos = hit ? static_cast<size_t>(static_cast<const char*>(hit) - base)
+                     : std::string::npos;
+    if (upper != lowered) {
+        // Only the stretch before the lowercase hit can hold an earlier uppercase one
+        const size_t limit = hit ? pos - from : length;
+        const void* upper_hit = std::memchr(base + from, upper, limit);
+        if (upper_hit) {
+            pos = static_cast<size_t>(static_cast<const char*>(upper_hit) - base);
+        }
+    }
+    return pos;
+}
+
+}  // anonymous namespace
+
+WildcardPattern WildcardPattern::compile(const std::string& pattern) {
+    WildcardPattern compiled;
+    compiled.tokens_.reserve(pattern.size());
+    compiled.chars_.reserve(pattern.size());
+
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        const char c = pattern[i];
+        if (c == '~' && i + 1 < pattern.size() &&
+            (pattern[i + 1] == '*' || pattern[i + 1] == '?' || pattern[i + 1] == '~')) {
+            // Escaped wildcard or tilde is a literal; a lone '~' stays literal too
+            compiled.tokens_.push_back(Token::LITERAL);
+            compiled.chars_.push_back(pattern[++i]);
+        } else if (c == '*') {
+            // Consecutive '*' are equivalent to one
+            if (compiled.tokens_.empty() || compiled.tokens_.back() != Token::ANY_RUN) {
+                compiled.tokens_.push_back(Token::ANY_RUN);
+                compiled.chars_.push_back('\0');
+            }
+            compiled.has_wildcards_ = true;
+        } else if (c == '?') {
+            compiled.tokens_.push_back(Token::ANY_ONE);
+            compiled.chars_.push_back('\0');
+            compiled.has_wildcards_ = true;
+        } else {
+            compiled.tokens_.push_back(Token::LITERAL);
+            compiled.chars_.push_back(lower(c));
+        }
+    }
+    return compiled;
+}
+
+bool WildcardPattern::hasWildcardSyntax(const std::string& pattern) {
+    return pattern.find_first_of("*?~") != std::string::npos;
+}
+
+bool WildcardPattern::prefilter(const std::string& text) const {
+    // Every token except '*' consumes exactly one character
+    const size_t runs = static_cast<size_t>(std::count(tokens_.begin(), tokens_.end(), Token::ANY_RUN));
+    if (tokens_.size() - runs > text.size()) {
+        return false;
+    }
+
+    // Anchored literal prefix must match as-is
+    size_t i = 0;
+    for (; i < tokens_.size() && tokens_[i] == Token::LITERAL; ++i) {
+        if (lower(text[i]) != chars_[i]) {
+            return false;
+        }
+    }
+
+    // The first literal after a wildcard must occur somewhere after the prefix
+    size_t offset = i;
+    for (; i < tokens_.size() && tokens_[i] != Token::LITERAL; ++i) {
+        if (tokens_[i] == Token::ANY_ONE) {
+            ++offset;
+        }
+    }
+    return i == tokens_.size() || findFolded(text, offset, chars_[i]) != std::string::npos;
+}
+
+bool WildcardPattern::matches(const std::string& text) const {
+    if (!prefilter(text)) {
+        return false;
+    }
+
+    // Greedy scan that restarts after the most recent '*' on mismatch. Each restart
+    // advances the text mark by one, bounding the work at O(n·m).
+    const size_t m = tokens_.size();
+    size_t t = 0;
+    size_t p = 0;
+    size_t star = std::string::npos;
+    size_t mark = 0;
+
+    while (t < text.size()) {
+        if (p < m && tokens_[p] == Token::ANY_RUN) {
+            star = p++;
+            mark = t;
+        } else if (p < m && (tokens_[p] == Token::ANY_ONE || lower(text[t]) == chars_[p])) {
+            ++p;
+            ++t;
+        } else if (star != std::string::npos) {
+            p = star + 1;
+            t = ++mark;
+        } else {
+            return false;
+        }
+    }
+
+    while (p < m && tokens_[p] == Token::ANY_RUN) {
+        ++p;
+    }
+    return p == m;
+}
+
+size_t WildcardPattern::find(const std::string& text, size_t start) const {
+    constexpr size_t npos = std::string::npos;
+    if (start > text.size()) {
+        return npos;
+    }
+    const size_t m = tokens_.size();
+    if (m == 0) {
+        return start;
+    }
+
+    // NFA simulation: origin[s] is the smallest start position from which the first
+    // s tokens match the text consumed so far (npos when state s is inactive)
+    std::vector<size_t> origin(m + 1, npos);
+    std::vector<size_t> next(m + 1, npos);
+    size_t best = npos;
+    bool active = false;
+
+    auto closeOverRuns = [&](std::vector<size_t>& states) {
+        for (size_t s = 0; s < m; ++s) {
+            if (tokens_[s] == Token::ANY_RUN && states[s] < states[s + 1]) {
+                states[s + 1] = states[s];
+            }
+        }
+    };
+
+    for (size_t pos = start;; ++pos) {
+        if (best == npos) {
+            if (!active && tokens_[0] == Token::LITERAL) {
+                // Nothing in flight: skip straight to the next candidate start
+                pos = findFolded(text, pos, chars_[0]);
+                if (pos == npos) {
+                    return npos;
+                }
+            }
+            origin[0] = std::min(origin[0], pos);
+        }
+        closeOverRuns(origin);
+        best = std::min(best, origin[m]);
+
+        // Stop once no in-flight match can start before the best one found
+        bool pending = false;
+        for (size_t s = 0; s < m; ++s) {
+            if (origin[s] < best) {
+                pending = true;
+                break;
+            }
+        }
+        if (!pending || pos >= text.size()) {
+            return best;
+        }
+
+        const char c = lower(text[pos]);
+        std::fill(next.begin(), next.end(), npos);
+        active = false;
+        for (size_t s = 0; s < m; ++s) {
+            if (origin[s] == npos) {
+                continue;
+            }
+            if (tokens_[s] == Token::ANY_RUN) {
+                next[s] = std::min(next[s], origin[s]);
+                active = true;
+            } else if (tokens_[s] == Token::ANY_ONE || chars_[s] == c) {
+                next[s + 1] = std::min(next[s + 1], origin[s]);
+                active = true;
+            }
+        }
+        origin.swap(next);
+    }
+}
+
+}  // namespace xl_formula
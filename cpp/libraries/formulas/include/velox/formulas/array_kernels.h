@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ast.h"
+
+namespace xl_formula {
+
+/**
+ * @brief Element-wise numeric kernels over packed double buffers
+ *
+ * Kernels are explicitly vectorized with AVX (when built with VELOX_ENABLE_AVX),
+ * SSE2 on x86-64, or simd128 on WebAssembly, and fall back to scalar loops elsewhere.
+ * They compute raw IEEE results; callers map division by zero and non-finite
+ * powers to formula errors.
+ */
+namespace kernels {
+
+/**
+ * @brief Check if an operator has a packed-double kernel
+ * @param op Binary operator
+ * @return true for + - * / ^ and the six comparisons (not &)
+ */
+bool hasNumericKernel(BinaryOpNode::Operator op);
+
+/**
+ * @brief Check if an operator is a comparison (its kernel yields 1.0 / 0.0)
+ */
+bool isComparison(BinaryOpNode::Operator op);
+
+/**
+ * @brief out[i] = a[i] op b[i]
+ */
+void binaryArrayArray(BinaryOpNode::Operator op, const double* a, const double* b, double* out,
+                      size_t n);
+
+/**
+ * @brief out[i] = a[i] op b
+ */
+void binaryArrayScalar(BinaryOpNode::Operator op, const double* a, double b, double* out,
+                       size_t n);
+
+/**
+ * @brief out[i] = a op b[i]
+ */
+void binaryScalarArray(BinaryOpNode::Operator op, double a, const double* b, double* out,
+                       size_t n);
+
+/**
+ * @brief Sort numbers in place
+ *
+ * Stable LSD radix sort over the IEEE bit patterns (11-bit digits, skipping digits
+ * all keys share); short inputs fall back to std::stable_sort.
+ * @param descending Largest first
+ */
+void sortNumbers(double* values, size_t n, bool descending);
+
+/**
+ * @brief Stable sort permutation of numeric keys
+ * @param keys Keys to order
+ * @param n Number of keys
+ * @param descending Largest first; equal keys keep their relative order either way
+ * @param order Receives n indexes into keys, in sorted order
+ */
+void sortOrder(const double* keys, size_t n, bool descending, std::vector<size_t>& order);
+
+/**
+ * @brief Copy the elements whose mask bit is set, preserving their order
+ * @param values Input elements
+ * @param mask One bit per element (bit i of word i / 64)
+ * @param n Number of elements
+ * @param out Output buffer with room for n elements
+ * @return Number of elements written
+ */
+size_t compactNumbers(const double* values, const uint64_t* mask, size_t n, double* out);
+
+/**
+ * @brief Floating-point strategy of the sum reductions
+ */
+enum class Summation : uint8_t {
+    FAST,        ///< Independent vector accumulators; rounding error grows with the input size
+    COMPENSATED  ///< Per-lane TwoSum error terms; accurate to about one rounding, ~2x the work
+};
+
+/**
+ * @brief Summation used by SUM and related functions
+ * @return COMPENSATED when the library is built with VELOX_COMPENSATED_SUM, FAST otherwise
+ */
+Summation defaultSummation();
+
+/**
+ * @brief Sum of values[i]
+ */
+double sum(const double* values, size_t n, Summation mode);
+
+/**
+ * @brief Sum of values[i]^2
+ */
+double sumSquares(const double* values, size_t n, Summation mode);
+
+/**
+ * @brief Sum of a[i] * b[i]
+ */
+double dotProduct(const double* a, const double* b, size_t n, Summation mode);
+
+/**
+ * @brief Per-pair term summed by sumPairs()
+ */
+enum class PairTerm : uint8_t {
+    X2_MINUS_Y2,       ///< x^2 - y^2 (SUMX2MY2)
+    X2_PLUS_Y2,        ///< x^2 + y^2 (SUMX2PY2)
+    X_MINUS_Y_SQUARED  ///< (x - y)^2 (SUMXMY2)
+};
+
+/**
+ * @brief Sum of term(x[i], y[i])
+ */
+double sumPairs(const double* x, const double* y, size_t n, PairTerm term, Summation mode);
+
+/**
+ * @brief Running total of scalars and kernel partial sums
+ *
+ * Lets aggregate functions stream over their arguments without collecting them into a
+ * vector first; in COMPENSATED mode additions use Neumaier's correction.
+ */
+class SumAccumulator {
+  private:
+    double sum_ = 0.0;
+    double compensation_ = 0.0;
+    Summation mode_;
+
+  public:
+    explicit SumAccumulator(Summation mode = defaultSummation()) : mode_(mode) {}
+
+    Summation mode() const {
+        return mode_;
+    }
+
+    void add(double value) {
+        if (mode_ == Summation::FAST) {
+            sum_ += value;
+            return;
+        }
+        const double t = sum_ + value;
+        if (std::fabs(sum_) >= std::fabs(value)) {
+            compensation_ += (sum_ - t) + value;
+        } else {
+            compensation_ += (value - t) + sum_;
+        }
+        sum_ = t;
+    }
+
+    double total() const {
+        return sum_ + compensation_;
+    }
+};
+
+/**
+ * @brief Count, mean and sum of squared deviations (M2) of a sample
+ */
+struct Moments {
+    size_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    /**
+     * @brief Fold in the moments of another sample (Chan et al. pairwise update)
+     */
+    void merge(const Moments& other);
+};
+
+/**
+ * @brief Moments of paired samples, with the co-moment sum((x - mean_x) * (y - mean_y))
+ */
+struct CoMoments {
+    size_t count = 0;
+    double mean_x = 0.0;
+    double mean_y = 0.0;
+    double m2_x = 0.0;
+    double m2_y = 0.0;
+    double c_xy = 0.0;
+
+    /**
+     * @brief Fold in the moments of other pairs (Chan et al. pairwise update)
+     */
+    void merge(const CoMoments& other);
+};
+
+/**
+ * @brief Moments of a buffer in a single pass over memory
+ *
+ * Works through cache-resident blocks: a vectorized sum gives the block mean, a second
+ * vectorized sweep of the same block its squared deviations, and blocks are merged
+ * pairwise. This keeps the accuracy of the two-pass algorithm without re-reading the
+ * input.
+ * @param values Sample
+ * @param n Number of values
+ */
+Moments moments(const double* values, size_t n);
+
+/**
+ * @brief Moments and co-moment of paired buffers, computed like moments()
+ * @param x First sample
+ * @param y Second sample, paired element-wise with x
+ * @param n Number of pairs
+ */
+CoMoments coMoments(const double* x, const double* y, size_t n);
+
+/**
+ * @brief Name of the instruction set the kernels were compiled for ("avx", "sse2",
+ * "simd128" or "scalar")
+ */
+const char* simdTarget();
+
+}  // namespace kernels
+}  // namespace xl_formula
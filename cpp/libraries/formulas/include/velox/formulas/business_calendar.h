@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "types.h"
+
+namespace xl_formula {
+namespace dates {
+
+/**
+ * @brief Weekend days as a bit mask: bit 0 is Sunday ... bit 6 is Saturday
+ *
+ * Bits follow weekdayFromDays(), so a day is a weekend day if
+ * (mask >> weekdayFromDays(days)) & 1.
+ */
+using WeekendMask = uint8_t;
+
+/// Saturday and Sunday, the weekend of WORKDAY and NETWORKDAYS
+constexpr WeekendMask kSaturdaySunday = 0x41;
+
+/**
+ * @brief Working days of a week pattern minus a list of holidays
+ *
+ * Outside the years the holidays fall in, business days are counted arithmetically from
+ * whole weeks. Those years are covered by a bitmap with one bit per day, set for business
+ * days, and the running number of business days before each 64-day word. Counting the
+ * business days before any day is then O(1): whole weeks, or a prefix count plus the
+ * popcount of part of one word. NETWORKDAYS is a difference of two such counts and
+ * WORKDAY a binary search over them, whatever the span and the number of holidays.
+ *
+ * Day numbers are days since 1970-01-01, as in splitDate(). Calendars are immutable once
+ * built, so one can be shared by concurrent evaluations.
+ */
+class BusinessCalendar {
+  private:
+    WeekendMask weekend_;
+    int64_t workdays_per_week_ = 0;
+    int64_t week_prefix_[8] = {};  ///< Business days among the first i days of a week
+    int64_t begin_ = 0;            ///< First day covered by the bitmap (a January 1st)
+    int64_t end_ = 0;              ///< One past the last covered day
+    int64_t holidays_ = 0;         ///< Holidays that fall on working days
+    std::vector<uint64_t> bits_;
+    std::vector<int64_t> word_prefix_;
+
+    /// Business days in [0, day) by the week pattern alone (negative before day 0)
+    int64_t weeklyBefore(int64_t day) const;
+
+  public:
+    /**
+     * @brief Build a calendar
+     * @param weekend Weekend days; must leave at least one working day
+     * @param holidays Day numbers of holidays, in any order and possibly repeated
+     */
+    BusinessCalendar(WeekendMask weekend, std::vector<int64_t> holidays);
+
+    WeekendMask weekend() const {
+        return weekend_;
+    }
+
+    bool isBusinessDay(int64_t day) const;
+
+    /**
+     * @brief Business days before a day, counted from a fixed origin
+     *
+     * Only differences are meaningful: the business days in [first, last) are
+     * countBefore(last) - countBefore(first).
+     */
+    int64_t countBefore(int64_t day) const;
+
+    /**
+     * @brief Business days from start to end, both included (NETWORKDAYS)
+     * @return The count, negated when end is before start
+     */
+    int64_t count(int64_t start, int64_t end) const;
+
+    /**
+     * @brief The business day a number of business days after start (WORKDAY)
+     *
+     * start itself is not counted, so advance(d, 1) is the next business day after d
+     * and advance(d, 0) is d. Negative counts move backwards.
+     */
+    int64_t advance(int64_t start, int64_t days) const;
+};
+
+/**
+ * @brief Per-engine cache of calendars keyed by holiday array identity and weekend
+ *
+ * Arrays are immutable and shared, so a calendar stays valid for as long as its holiday
+ * array is alive; entries hold a weak reference to the array to detect reuse of its
+ * address. Owned by Context, so every FormulaEngine has its own cache.
+ */
+class BusinessCalendarCache {
+  private:
+    struct Key {
+        const ArrayData* holidays;
+        WeekendMask weekend;
+        bool operator==(const Key& other) const {
+            return holidays == other.holidays && weekend == other.weekend;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return std::hash<const void*>()(key.holidays) ^ static_cast<size_t>(key.weekend);
+        }
+    };
+    struct Entry {
+        std::weak_ptr<const ArrayData> owner;
+        std::shared_ptr<const BusinessCalendar> calendar;
+    };
+
+    std::unordered_map<Key, Entry, KeyHash> entries_;
+    std::mutex mutex_;
+
+  public:
+    /// Maximum number of cached calendars before stale entries are evicted
+    static constexpr size_t kMaxEntries = 64;
+
+    /**
+     * @brief Look up the calendar of a holiday array and weekend
+     * @return Cached calendar, or nullptr if none has been stored
+     */
+    std::shared_ptr<const BusinessCalendar> find(const Value::ArrayType& holidays,
+                                                 WeekendMask weekend);
+
+    /**
+     * @brief Store the calendar built from a holiday array and weekend
+     */
+    void store(const Value::ArrayType& holidays,
+               std::shared_ptr<const BusinessCalendar> calendar);
+
+    /**
+     * @brief Number of cached calendars
+     */
+    size_t size();
+
+    /**
+     * @brief Drop all cached calendars
+     */
+    void clear();
+};
+
+/**
+ * @brief Calendar for a weekend and a holidays argument, through the context's cache
+ *
+ * Holidays are dates or serial numbers, alone or in (nested) arrays; empty values are
+ * skipped and times of day ignored. Calendars built from an array are cached, so a
+ * holiday table passed to many calls is only scanned once.
+ * @param context Context owning the cache
+ * @param weekend Weekend days
+ * @param holidays Holidays argument, or nullptr for none
+ * @param calendar Receives the calendar
+ * @return Empty value on success, the first error in the holidays, #VALUE! for text or
+ * #NUM! for a date outside the serial range
+ */
+Value getBusinessCalendar(const Context& context, WeekendMask weekend, const Value* holidays,
+                          std::shared_ptr<const BusinessCalendar>& calendar);
+
+}  // namespace dates
+}  // namespace xl_formula
@@ -0,0 +1,136 @@
+#pragma once
+
+/**
+ * @file c_api.h
+ * @brief Stable C interface to the formula engine, for FFI bindings (ctypes, N-API, JNI)
+ *
+ * Engines and prepared formulas are opaque handles, strings are NUL-terminated UTF-8, and
+ * no C++ type or exception crosses the interface. Batch entry points read caller-owned
+ * double columns and write results and status codes into caller-owned buffers, so a
+ * binding evaluates a whole batch in one call without marshaling rows.
+ *
+ * An engine is not safe for concurrent use; use one engine per thread, or the threads
+ * argument of velox_evaluate_columns(). A prepared formula is immutable and may be
+ * evaluated by any engine, from any thread.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Version of this interface; bumped only on incompatible changes */
+#define VELOX_C_API_VERSION 1
+
+typedef struct velox_engine velox_engine;
+typedef struct velox_prepared velox_prepared;
+
+/**
+ * @brief Status of a call, or of one evaluated row
+ *
+ * Values are fixed; new codes are only ever appended.
+ */
+typedef int32_t velox_status;
+
+#define VELOX_OK 0               /**< Number, date (serial number) or boolean (1/0) */
+#define VELOX_DIV_ZERO 1         /**< #DIV/0! */
+#define VELOX_VALUE_ERROR 2      /**< #VALUE! */
+#define VELOX_REF_ERROR 3        /**< #REF! */
+#define VELOX_NAME_ERROR 4       /**< #NAME? */
+#define VELOX_NUM_ERROR 5        /**< #NUM! */
+#define VELOX_NA_ERROR 6         /**< #N/A */
+#define VELOX_PARSE_ERROR 7      /**< The formula failed to parse */
+#define VELOX_NOT_NUMBER 8       /**< Text, empty or array result, written as NaN */
+#define VELOX_INVALID_ARGUMENT 9 /**< Null handle or buffer, or mismatched arguments */
+#define VELOX_INTERNAL_ERROR 10  /**< Unexpected failure, such as out of memory */
+
+/** @brief VELOX_C_API_VERSION of the linked library */
+uint32_t velox_api_version(void);
+
+/**
+ * @brief Create an engine with the default functions and no variables
+ * @return New engine, or NULL on failure; release with velox_engine_destroy()
+ */
+velox_engine* velox_engine_create(void);
+
+/** @brief Destroy an engine (NULL is ignored) */
+void velox_engine_destroy(velox_engine* engine);
+
+/** @brief Set a numeric variable */
+velox_status velox_engine_set_number(velox_engine* engine, const char* name, double value);
+
+/** @brief Set a text variable */
+velox_status velox_engine_set_text(velox_engine* engine, const char* name, const char* value);
+
+/** @brief Set a boolean variable (non-zero is TRUE) */
+velox_status velox_engine_set_boolean(velox_engine* engine, const char* name, int value);
+
+/** @brief Remove a variable */
+velox_status velox_engine_remove(velox_engine* engine, const char* name);
+
+/**
+ * @brief Read variables as numbers
+ *
+ * Numbers, dates and booleans are written to out[i] for names[i]; missing variables and
+ * other values are written as NaN.
+ * @param codes Optional buffer of count entries receiving VELOX_OK, VELOX_NOT_NUMBER or
+ * the variable's error
+ * @return Number of entries written as NaN, or count if an argument is invalid
+ */
+size_t velox_engine_get_numbers(const velox_engine* engine, const char* const* names,
+                                size_t count, double* out, velox_status* codes);
+
+/**
+ * @brief Parse and analyse a formula once for repeated evaluation
+ *
+ * A formula that fails to parse still yields a handle: velox_prepared_status() reports
+ * VELOX_PARSE_ERROR and every evaluation of it does too.
+ * @return New prepared formula, or NULL on failure; release with velox_prepared_destroy()
+ */
+velox_prepared* velox_prepare(const velox_engine* engine, const char* formula);
+
+/** @brief Destroy a prepared formula (NULL is ignored) */
+void velox_prepared_destroy(velox_prepared* prepared);
+
+/** @brief VELOX_OK, or VELOX_PARSE_ERROR for a formula that failed to parse */
+velox_status velox_prepared_status(const velox_prepared* prepared);
+
+/** @brief Number of distinct variables the formula reads */
+size_t velox_prepared_variable_count(const velox_prepared* prepared);
+
+/**
+ * @brief Name of a variable the formula reads, in order of first use
+ * @return Name valid for the lifetime of the prepared formula, or NULL if out of range
+ */
+const char* velox_prepared_variable_name(const velox_prepared* prepared, size_t index);
+
+/**
+ * @brief Evaluate a prepared formula against the engine's variables
+ * @param out Receives the result as a number (NaN unless the status is VELOX_OK)
+ * @return Status of the result
+ */
+velox_status velox_evaluate(velox_engine* engine, const velox_prepared* prepared, double* out);
+
+/**
+ * @brief Evaluate a prepared formula once per row of numeric columns
+ *
+ * Row i binds names[c] to columns[c][i] for each of the column_count columns; other
+ * variables come from the engine, whose variables are left unchanged.
+ * @param rows Number of rows; every column, out and codes hold at least rows entries
+ * @param out Receives one number per row (NaN unless the row's code is VELOX_OK)
+ * @param codes Optional buffer receiving each row's status
+ * @param threads Maximum number of worker threads; 1 evaluates on the calling thread, 0
+ * uses one per hardware thread. Small batches are always evaluated on the calling thread.
+ * @return Number of rows whose status is not VELOX_OK, or rows if an argument is invalid
+ * (out and codes are then filled with NaN and VELOX_INVALID_ARGUMENT where given)
+ */
+size_t velox_evaluate_columns(velox_engine* engine, const velox_prepared* prepared,
+                              const char* const* names, const double* const* columns,
+                              size_t column_count, size_t rows, double* out,
+                              velox_status* codes, unsigned threads);
+
+#ifdef __cplusplus
+}
+#endif
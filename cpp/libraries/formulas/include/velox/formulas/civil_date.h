@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include "types.h"
+
+namespace xl_formula {
+
+/**
+ * @brief Calendar arithmetic for date values
+ *
+ * Date values are Excel serial numbers of floating calendar times: the serial names the date
+ * and time shown on the calendar, not an instant. Splitting a date into fields or building
+ * one from fields is therefore pure integer arithmetic on the proleptic Gregorian calendar
+ * (H. Hinnant's days_from_civil / civil_from_days), with no time zone, DST rule or global C
+ * library state involved. Only the functions that read the wall clock or convert to real
+ * instants consult a TimeZonePolicy.
+ */
+namespace dates {
+
+constexpr int64_t kSecondsPerDay = 86400;
+
+/// Serial number of 1970-01-01, the origin of the day numbers below
+constexpr int64_t kUnixEpochSerial = 25569;
+
+/// Serial number of 9999-12-31, the last date Excel can show
+constexpr int64_t kMaxSerial = 2958465;
+
+/**
+ * @brief A day of the proleptic Gregorian calendar
+ */
+struct CivilDate {
+    int64_t year;
+    unsigned month;  ///< 1-12
+    unsigned day;    ///< 1-31
+};
+
+/**
+ * @brief Floor division, rounding toward negative infinity
+ */
+constexpr int64_t floorDiv(int64_t a, int64_t b) noexcept {
+    return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+}
+
+/**
+ * @brief Days since 1970-01-01 of a calendar date
+ *
+ * Linear in day, so out-of-range days roll over like mktime: 2024-02-30 is 2024-03-01.
+ */
+constexpr int64_t daysFromCivil(int64_t year, int64_t month, int64_t day) noexcept {
+    year -= month <= 2;
+    const int64_t era = floorDiv(year, 400);
+    const int64_t year_of_era = year - era * 400;
+    const int64_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const int64_t day_of_era =
+            year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+/**
+ * @brief Calendar date of a day number (days since 1970-01-01)
+ */
+constexpr CivilDate civilFromDays(int64_t days) noexcept {
+    days += 719468;
+    const int64_t era = floorDiv(days, 146097);
+    const int64_t day_of_era = days - era * 146097;
+    const int64_t year_of_era =
+            (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const int64_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 -
+                                              year_of_era / 100);
+    const int64_t shifted_month = (5 * day_of_year + 2) / 153;
+    const int64_t day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+    const int64_t month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+    return CivilDate{year_of_era + era * 400 + (month <= 2), static_cast<unsigned>(month),
+                     static_cast<unsigned>(day)};
+}
+
+constexpr bool isLeapYear(int64_t year) noexcept {
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+constexpr unsigned daysInMonth(int64_t year, unsigned month) noexcept {
+    constexpr unsigned kDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && isLeapYear(year) ? 29 : kDays[month - 1];
+}
+
+/**
+ * @brief Day of the week of a day number, 0 = Sunday ... 6 = Saturday
+ */
+constexpr unsigned weekdayFromDays(int64_t days) noexcept {
+    return static_cast<unsigned>(days - floorDiv(days + 4, 7) * 7 + 4);  // 1970-01-01: Thursday
+}
+
+/**
+ * @brief Move a date by whole months (EDATE, EOMONTH)
+ * @param end_of_month Return the last day of the target month instead of the same day
+ * @return Target date; a day past the end of the target month is clamped to its last day
+ */
+constexpr CivilDate addMonths(CivilDate date, int64_t months, bool end_of_month) noexcept {
+    const int64_t total = date.year * 12 + (date.month - 1) + months;
+    const int64_t year = floorDiv(total, 12);
+    const unsigned month = static_cast<unsigned>(total - year * 12 + 1);
+    const unsigned last = daysInMonth(year, month);
+    return CivilDate{year, month, end_of_month || date.day > last ? last : date.day};
+}
+
+/**
+ * @brief Calendar fields of a date value
+ */
+struct DateTime {
+    int64_t days;  ///< Days since 1970-01-01
+    CivilDate date;
+    unsigned hour;
+    unsigned minute;
+    unsigned second;
+};
+
+/**
+ * @brief Split a date value into calendar fields
+ *
+ * The time of day is rounded to the nearest second, so a serial such as 0.75 that is not
+ * exact in binary still reads 18:00:00.
+ */
+inline DateTime splitDate(const Value::DateType& date) {
+    const int64_t seconds = std::llround(date.serial * kSecondsPerDay);
+    const int64_t serial_day = floorDiv(seconds, kSecondsPerDay);
+    const int64_t second_of_day = seconds - serial_day * kSecondsPerDay;
+    const int64_t days = serial_day - kUnixEpochSerial;
+    return DateTime{days, civilFromDays(days), static_cast<unsigned>(second_of_day / 3600),
+                    static_cast<unsigned>(second_of_day / 60 % 60),
+                    static_cast<unsigned>(second_of_day % 60)};
+}
+
+/**
+ * @brief Date value of a day number plus a time of day
+ */
+constexpr Value::DateType makeDate(int64_t days, int64_t second_of_day = 0) {
+    return Value::DateType(static_cast<double>(days + kUnixEpochSerial) +
+                           static_cast<double>(second_of_day) / kSecondsPerDay);
+}
+
+constexpr Value::DateType makeDate(const CivilDate& date) {
+    return makeDate(daysFromCivil(date.year, date.month, date.day));
+}
+
+/**
+ * @brief Calendar fields of a date value as a std::tm, without localtime()
+ */
+std::tm toTm(const Value::DateType& date);
+
+/**
+ * @brief Current date and time on the wall clock selected by the policy
+ */
+Value::DateType currentDateTime(TimeZonePolicy policy);
+
+/**
+ * @brief Seconds since the Unix epoch of the instant a date value denotes in a zone
+ */
+int64_t toUnixSeconds(const Value::DateType& date, TimeZonePolicy policy);
+
+}  // namespace dates
+}  // namespace xl_formula
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace xl_formula {
+
+/**
+ * @brief Bounded cache of objects compiled from text, such as criteria or number formats
+ *
+ * Holds up to MaxEntries objects by key and starts over when full, so a workload with
+ * unbounded distinct keys cannot grow it. Not synchronized: keep one per thread.
+ */
+template <typename T, size_t MaxEntries = 256>
+class CompileCache {
+  private:
+    std::unordered_map<std::string, std::shared_ptr<const T>> entries_;
+
+  public:
+    /**
+     * @brief Object cached for a key, compiled by compile() on a miss
+     */
+    template <typename Compile>
+    std::shared_ptr<const T> get(const std::string& key, Compile&& compile) {
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            return it->second;
+        }
+        if (entries_.size() >= MaxEntries) {
+            entries_.clear();
+        }
+        auto compiled = std::make_shared<const T>(compile());
+        entries_.emplace(key, compiled);
+        return compiled;
+    }
+};
+
+}  // namespace xl_formula
@@ -1,13 +1,12 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ast.h"
 #include "types.h"
-
-// Forward declaration
-namespace xl_formula {
-namespace functions {
-bool simpleWildcardMatch(const std::string& text, const std::string& pattern);
-}
-}  // namespace xl_formula
+#include "wildcard.h"
 
 namespace xl_formula {
 namespace conditional {
@@ -51,6 +50,107 @@ Value conditionalOnError(const Value& value, const Value& value_if_condition,
  */
 bool evaluateCriteria(const Value& value, const Value& criteria);
 
+/**
+ * @brief One bit per range element; bit i of word i / 64 is set when element i is selected
+ */
+using SelectionMask = std::vector<uint64_t>;
+
+/**
+ * @brief Criteria parsed once into an operator, a typed operand and a match program
+ *
+ * Matches exactly what evaluateCriteria() does, but the criteria string is parsed
+ * (operator prefix, number conversion, wildcard scan) once instead of per element.
+ * Numeric comparisons over packed arrays run through the SIMD array kernels.
+ */
+class CompiledCriteria {
+  public:
+    enum class Kind {
+        NEVER,           ///< Criteria type that matches nothing (dates, arrays, empty)
+        NUMBER,          ///< Numeric criteria: numbers within 1e-10
+        BOOLEAN,         ///< Boolean criteria: equal booleans
+        BLANK,           ///< "": empty values or empty text
+        NUMBER_COMPARE,  ///< "<op><number>", e.g. ">=100"
+        TEXT_COMPARE,    ///< "<op><text>", e.g. "<>done", compared case-insensitively
+        WILDCARD,        ///< Text containing * ? or ~, matched case-insensitively
+        TEXT_EQUAL       ///< Plain text: equal text ignoring case, or an equal number if it
+                         ///< parses as one
+    };
+
+  private:
+    Kind kind_ = Kind::NEVER;
+    BinaryOpNode::Operator op_ = BinaryOpNode::Operator::EQUAL;
+    double number_ = 0.0;
+    bool has_number_ = false;
+    bool boolean_ = false;
+    std::string text_;
+    WildcardPattern pattern_;
+
+  public:
+    /**
+     * @brief Parse a criteria value
+     * @param criteria Criteria argument of a *IF function
+     * @return Compiled criteria
+     */
+    static CompiledCriteria compile(const Value& criteria);
+
+    /**
+     * @brief Compiled criteria shared through a small per-thread cache
+     * @param criteria Criteria argument of a *IF function
+     * @return Compiled criteria; literal criteria text is parsed once across evaluations
+     */
+    static std::shared_ptr<const CompiledCriteria> cached(const Value& criteria);
+
+    Kind getKind() const {
+        return kind_;
+    }
+
+    /**
+     * @brief Test a single value
+     */
+    bool matches(const Value& value) const;
+
+    /**
+     * @brief Select the matching elements of a range
+     * @param range Range to test
+     * @param selection Receives one bit per element (resized to fit the range)
+     */
+    void select(const ArrayData& range, SelectionMask& selection) const;
+
+    /**
+     * @brief Count the matching elements of a range
+     */
+    size_t countMatches(const ArrayData& range) const;
+};
+
+/**
+ * @brief Number of selected positions
+ */
+size_t countSelected(const SelectionMask& selection);
+
+/**
+ * @brief Select the rows that satisfy every (criteria_range, criteria) pair
+ * @param args Function arguments
+ * @param start_index Index of the first criteria range
+ * @param size Length every criteria range must have
+ * @param selection Receives the rows matching all criteria
+ * @return Empty value on success, the criteria error, or #VALUE! if a range is not an
+ * array of the given size
+ *
+ * Each criteria range is scanned once into its own bitmap, and the bitmaps are
+ * combined word by word with AND.
+ */
+Value selectAllCriteria(const std::vector<Value>& args, size_t start_index, size_t size,
+                        SelectionMask& selection);
+
+/**
+ * @brief Sum the numbers of a range at the selected positions
+ * @param values Range to sum (same length as the selection)
+ * @param selection Selected positions
+ * @param counted Receives the number of numeric values summed
+ * @return Sum, or the first error found at a selected position
+ */
+Value maskedSum(const ArrayData& values, const SelectionMask& selection, size_t& counted);
+
 /**
  * @brief Template for single-criteria functions (SUMIF, COUNTIF, AVERAGEIF)
  * @param args Function arguments
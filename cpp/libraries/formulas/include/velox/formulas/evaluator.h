@@ -6,6 +6,7 @@
 #include <unordered_map>
 #include <vector>
 #include "ast.h"
+#include "prepared.h"
 #include "types.h"
 
 namespace xl_formula {
@@ -41,6 +42,13 @@ class FunctionRegistry {
      */
     bool hasFunction(const std::string& name) const;
 
+    /**
+     * @brief Check if a name refers to a built-in function
+     * @param name Function name (case-insensitive)
+     * @return true if the name is dispatched to a built-in implementation
+     */
+    bool isBuiltinFunction(const std::string& name) const;
+
     /**
      * @brief Call a function (built-in or custom)
      * @param name Function name
@@ -128,7 +136,15 @@ class Evaluator : public ASTVisitor {
     std::vector<TraceNode*> trace_stack_;
     std::unique_ptr<TraceNode> trace_root_;
 
+    // Shared-subexpression memo (enabled only when a plan is attached)
+    const SubexpressionPlan* plan_ = nullptr;
+    std::vector<Value> memo_values_;
+    std::vector<bool> memo_ready_;
+
+    void evaluateNode(const ASTNode& node);
+
     Value performBinaryOperation(BinaryOpNode::Operator op, const Value& left, const Value& right);
+    Value performArrayOperation(BinaryOpNode::Operator op, const Value& left, const Value& right);
     Value performUnaryOperation(UnaryOpNode::Operator op, const Value& operand);
 
     // Helper to create and push a trace node
@@ -159,6 +175,21 @@ class Evaluator : public ASTVisitor {
     EvaluationResult evaluateWithTrace(const ASTNode& node,
                                        std::unique_ptr<TraceNode>& out_trace_root);
 
+    /**
+     * @brief Attach a shared-subexpression plan
+     * @param plan Plan produced at prepare time (may be null to disable memoization)
+     *
+     * Memoized results persist across evaluate() calls until the plan is replaced or
+     * clearSubexpressionCache() is called, so a batch of formulas evaluated against the
+     * same context computes each shared subexpression once.
+     */
+    void setSubexpressionPlan(const SubexpressionPlan* plan);
+
+    /**
+     * @brief Drop memoized subexpression results (call after the context changes)
+     */
+    void clearSubexpressionCache();
+
     // Visitor pattern implementation
     void visit(const LiteralNode& node) override;
     void visit(const VariableNode& node) override;
@@ -220,6 +251,86 @@ class FormulaEngine {
     EvaluationResult evaluateWithTrace(const std::string& formula,
                                        std::unique_ptr<TraceNode>& out_trace_root);
 
+    /**
+     * @brief Parse and analyse a formula once for repeated evaluation
+     * @param formula Formula text to prepare
+     * @return Prepared formula (check isSuccess() for parse errors)
+     *
+     * Constant subexpressions are folded, and structurally identical pure
+     * subexpressions are hash-consed so that each is computed once per evaluation.
+     */
+    PreparedFormula prepare(const std::string& formula) const;
+
+    /**
+     * @brief Specialize a prepared formula against variables fixed for its lifetime
+     * @param prepared Formula returned by prepare()
+     * @param known_variables Values substituted for the matching VariableNodes
+     * @return Residual formula with substituted values folded into literals
+     *
+     * Only the remaining (unknown) variables are looked up when the residual
+     * formula is evaluated. Volatile and custom functions are never folded.
+     */
+    PreparedFormula specialize(const PreparedFormula& prepared,
+                               const std::unordered_map<std::string, Value>& known_variables) const;
+
+    /**
+     * @brief Prepare several formulas that will be evaluated together
+     * @param formulas Formula texts to prepare
+     * @return Batch sharing repeated pure subexpressions across all members
+     */
+    PreparedBatch prepareBatch(const std::vector<std::string>& formulas) const;
+
+    /**
+     * @brief Evaluate a prepared formula against the engine context
+     * @param prepared Formula returned by prepare()
+     * @return Evaluation result
+     */
+    EvaluationResult evaluate(const PreparedFormula& prepared);
+
+    /**
+     * @brief Evaluate every formula of a batch against the engine context
+     * @param batch Batch returned by prepareBatch()
+     * @return One result per formula, in batch order
+     */
+    std::vector<EvaluationResult> evaluateBatch(const PreparedBatch& batch);
+
+    /**
+     * @brief Evaluate a prepared formula once per row of numeric columns
+     * @param prepared Formula returned by prepare()
+     * @param names Variable bound to each column
+     * @param columns One buffer of rows doubles per name
+     * @param rows Number of rows
+     * @param out Receives one number per row: dates as serial numbers, booleans as 1 or 0,
+     * and NaN for text, errors and empty results
+     * @return Number of rows whose result was not a number, date or boolean
+     *
+     * Row i binds names[c] to columns[c][i]. Column variables are restored to their
+     * previous values afterwards, as for evaluate() with overrides.
+     */
+    size_t evaluateColumns(const PreparedFormula& prepared, const std::vector<std::string>& names,
+                           const std::vector<const double*>& columns, size_t rows, double* out);
+
+    /**
+     * @brief evaluateColumns() with the rows split across worker threads
+     *
+     * Each worker evaluates a contiguous block of rows against its own copy of the context,
+     * so the engine's variables are never modified; the lookup, sorted-copy and calendar
+     * caches are shared by all workers. Blocks are at least kMinRowsPerThread rows, and
+     * builds without thread support (such as the baseline WebAssembly module) evaluate on
+     * the calling thread. Results are identical to the single-threaded overload, except
+     * for volatile functions.
+     * @param threads Maximum number of workers; 0 for std::thread::hardware_concurrency()
+     * @param errors Optional buffer of rows entries receiving each row's error: the error
+     * of an error result, PARSE_ERROR for every row of a formula that failed to parse, and
+     * NONE otherwise (a NaN out[i] with NONE is a text or empty result)
+     */
+    size_t evaluateColumns(const PreparedFormula& prepared, const std::vector<std::string>& names,
+                           const std::vector<const double*>& columns, size_t rows, double* out,
+                           unsigned threads, ErrorType* errors = nullptr);
+
+    /// Fewest rows evaluateColumns() hands to one worker thread
+    static constexpr size_t kMinRowsPerThread = 1024;
+
     /**
      * @brief Get the evaluation context
      * @return Reference to context
@@ -256,6 +367,25 @@ class FormulaEngine {
      */
     Value getVariable(const std::string& name) const;
 
+    /**
+     * @brief Look up a variable without copying it
+     * @param name Variable name
+     * @return Stored value, or nullptr if not found (see Context::findVariable)
+     */
+    const Value* findVariable(const std::string& name) const;
+
+    /**
+     * @brief Read many variables as numbers in one call
+     *
+     * Numbers, dates (serial numbers) and booleans (1/0) are written to out[i] for
+     * names[i]; missing variables and other values are written as NaN, as in
+     * evaluateColumns().
+     * @param names Variable names
+     * @param out Receives names.size() numbers
+     * @return Number of entries written as NaN
+     */
+    size_t getVariables(const std::vector<std::string>& names, double* out) const;
+
     /**
      * @brief Register a custom function
      * @param name Function name
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "types.h"
+
+namespace xl_formula {
+namespace financial {
+
+/**
+ * @brief Outcome of a rate solve
+ */
+struct RateResult {
+    double rate = 0.0;
+    bool converged = false;
+    int iterations = 0;  ///< Objective evaluations spent
+};
+
+/**
+ * @brief Net present value of periodic cash flows, the first one discounted by one period
+ *
+ * Evaluated with Horner's scheme in 1 / (1 + rate), so it costs one multiply-add per
+ * flow instead of a pow.
+ */
+double presentValue(NumberSpan flows, double rate);
+
+/**
+ * @brief Rate at which periodic cash flows have zero net present value (IRR)
+ *
+ * Newton iterations from the guess evaluate the NPV and its derivative in one Horner
+ * pass. When Newton leaves the bracket it has found, stalls, or overflows, the solver
+ * falls back to Brent's method on a sign change, searching for one near the guess if
+ * none is known yet.
+ * @param flows Cash flows, the first one at period 0
+ * @param guess Starting rate, e.g. a previous solution of a similar problem
+ */
+RateResult solveIrr(NumberSpan flows, double guess);
+
+/**
+ * @brief Rate at which dated cash flows have zero net present value (XIRR)
+ * @param flows Cash flows
+ * @param days Day number of each flow; years are counted as (day - days[0]) / 365
+ * @param guess Starting rate
+ */
+RateResult solveXirr(NumberSpan flows, NumberSpan days, double guess);
+
+/**
+ * @brief Interest rate per period of an annuity (RATE)
+ * @param nper Number of periods
+ * @param pmt Payment per period
+ * @param pv Present value
+ * @param fv Future value
+ * @param type 1 when payments are due at the beginning of each period, else 0
+ * @param guess Starting rate
+ */
+RateResult solveAnnuityRate(double nper, double pmt, double pv, double fv, double type,
+                            double guess);
+
+/**
+ * @brief Solve the IRR of many cash-flow vectors
+ *
+ * With warm_start, each solve starts from the previous converged rate, which usually
+ * saves most Newton iterations on related vectors such as the positions of a portfolio;
+ * a solve that fails from the warm start is retried from guess.
+ * @param flows Cash-flow vectors, possibly of different lengths
+ * @param guess Starting rate of the first solve
+ * @param warm_start Start each solve from the previous solution
+ * @return One result per vector
+ */
+std::vector<RateResult> solveIrrBatch(const std::vector<NumberSpan>& flows, double guess,
+                                      bool warm_start = true);
+
+}  // namespace financial
+}  // namespace xl_formula
@@ -3,6 +3,7 @@
 #include <cmath>
 #include <stdexcept>
 #include <vector>
+#include "civil_date.h"
 #include "conditional_utils.h"
 #include "evaluator.h"
 #include "types.h"
@@ -282,6 +283,79 @@ Value choose(const std::vector<Value>& args, const Context& context);
 Value row_function(const std::vector<Value>& args, const Context& context);
 Value column_function(const std::vector<Value>& args, const Context& context);
 
+/**
+ * @brief VLOOKUP function - finds a value in the first column of a table
+ * @param args Function arguments (lookup_value, table_array, col_index_num, [range_lookup])
+ * @param context Evaluation context (owns the lookup-index cache)
+ * @return Value from the matching row, #N/A if not found
+ */
+Value vlookup(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief HLOOKUP function - finds a value in the first row of a table
+ * @param args Function arguments (lookup_value, table_array, row_index_num, [range_lookup])
+ * @param context Evaluation context (owns the lookup-index cache)
+ * @return Value from the matching column, #N/A if not found
+ */
+Value hlookup(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief INDEX function - returns a value (or row/column) at a position in a table
+ * @param args Function arguments (array, row_num, [column_num])
+ * @param context Evaluation context (unused for INDEX)
+ * @return Selected value, #REF! if out of range
+ */
+Value index_function(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief MATCH function - returns the 1-based position of a value in an array
+ * @param args Function arguments (lookup_value, lookup_array, [match_type])
+ * @param context Evaluation context (owns the lookup-index cache)
+ * @return Position, #N/A if not found
+ */
+Value match(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief XLOOKUP function - finds a value and returns the corresponding item of another array
+ * @param args Function arguments (lookup_value, lookup_array, return_array, [if_not_found],
+ * [match_mode], [search_mode])
+ * @param context Evaluation context (owns the lookup-index cache)
+ * @return Matching item, if_not_found or #N/A
+ */
+Value xlookup(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief SORT function - sorts the elements of an array or the rows of a table
+ * @param args Function arguments (array, [sort_index], [sort_order], [by_col])
+ * @param context Evaluation context (unused for SORT)
+ * @return Sorted array
+ */
+Value sort(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief SORTBY function - sorts an array or table by one or more key arrays
+ * @param args Function arguments (array, by_array1, [sort_order1], ...)
+ * @param context Evaluation context (unused for SORTBY)
+ * @return Sorted array
+ */
+Value sortby(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief FILTER function - keeps the elements or rows whose include flag is TRUE
+ * @param args Function arguments (array, include, [if_empty])
+ * @param context Evaluation context (unused for FILTER)
+ * @return Filtered array, if_empty or #N/A when nothing is kept
+ */
+Value filter(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief UNIQUE function - returns the distinct elements or rows of an array
+ * @param args Function arguments (array, [by_col], [exactly_once])
+ * @param context Evaluation context (unused for UNIQUE)
+ * @return Distinct items in first-seen order
+ */
+Value unique(const std::vector<Value>& args, const Context& context);
+
 /**
  * @brief ABS function - returns absolute value
  * @param args Function arguments (expects 1 numeric argument)
@@ -484,12 +558,52 @@ Value countif(const std::vector<Value>& args, const Context& context);
 
 /**
  * @brief MEDIAN function - returns the median of a set of numbers
- * @param args Function arguments (expects 1+ numeric arguments)
- * @param context Evaluation context (unused for MEDIAN)
+ * @param args Function arguments (expects 1+ numbers or arrays)
+ * @param context Evaluation context (holds the sorted-copy cache)
  * @return Median value of the arguments
  */
 Value median(const std::vector<Value>& args, const Context& context);
 
+/**
+ * @brief PERCENTILE function - returns the k-th percentile of a data set
+ * @param args Function arguments (array, k)
+ * @param context Evaluation context (holds the sorted-copy cache)
+ * @return Interpolated percentile
+ */
+Value percentile(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief QUARTILE function - returns a quartile of a data set
+ * @param args Function arguments (array, quart)
+ * @param context Evaluation context (holds the sorted-copy cache)
+ * @return Quartile value
+ */
+Value quartile(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief LARGE function - returns the k-th largest value of a data set
+ * @param args Function arguments (array, k)
+ * @param context Evaluation context (holds the sorted-copy cache)
+ * @return k-th largest value
+ */
+Value large(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief SMALL function - returns the k-th smallest value of a data set
+ * @param args Function arguments (array, k)
+ * @param context Evaluation context (holds the sorted-copy cache)
+ * @return k-th smallest value
+ */
+Value small(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief RANK function - returns the rank of a number within a list
+ * @param args Function arguments (number, ref, [order])
+ * @param context Evaluation context (holds the sorted-copy cache)
+ * @return 1-based rank, or #N/A when number is not in ref
+ */
+Value rank(const std::vector<Value>& args, const Context& context);
+
 /**
  * @brief MODE function - returns the most frequently occurring value
  * @param args Function arguments (expects 1+ numeric arguments)
@@ -498,6 +612,14 @@ Value median(const std::vector<Value>& args, const Context& context);
  */
 Value mode(const std::vector<Value>& args, const Context& context);
 
+/**
+ * @brief MODE.MULT function - returns every most frequently occurring value
+ * @param args Function arguments (expects 1+ numbers or arrays)
+ * @param context Evaluation context (unused for MODE.MULT)
+ * @return Array of the modes in order of first occurrence, #N/A when no value repeats
+ */
+Value mode_mult(const std::vector<Value>& args, const Context& context);
+
 /**
  * @brief STDEV function - returns the standard deviation of a set of numbers
  * @param args Function arguments (expects 1+ numeric arguments)
@@ -807,6 +929,26 @@ Value edate(const std::vector<Value>& args, const Context& context);
  */
 Value eomonth(const std::vector<Value>& args, const Context& context);
 
+/**
+ * @brief WORKDAY function - returns the date a number of working days from a start date
+ */
+Value workday(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief WORKDAY.INTL function - WORKDAY with a custom weekend
+ */
+Value workday_intl(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief NETWORKDAYS function - counts the working days between two dates
+ */
+Value networkdays(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief NETWORKDAYS.INTL function - NETWORKDAYS with a custom weekend
+ */
+Value networkdays_intl(const std::vector<Value>& args, const Context& context);
+
 /**
  * @brief DATEVALUE function - converts a date in text to a date value
  */
@@ -1005,6 +1147,14 @@ Value npv(const std::vector<Value>& args, const Context& context);
  */
 Value irr(const std::vector<Value>& args, const Context& context);
 
+/**
+ * @brief XIRR function - calculates internal rate of return of dated cash flows
+ * @param args Function arguments (values, dates, [guess])
+ * @param context Evaluation context (unused for XIRR)
+ * @return Annual internal rate of return
+ */
+Value xirr(const std::vector<Value>& args, const Context& context);
+
 /**
  * @brief MIRR function - calculates modified internal rate of return
  * @param args Function arguments (values, finance_rate, reinvest_rate)
@@ -1077,6 +1227,22 @@ Value sumif(const std::vector<Value>& args, const Context& context);
  */
 Value sumifs(const std::vector<Value>& args, const Context& context);
 
+/**
+ * @brief SEQUENCE function - generates an array of evenly spaced numbers
+ * @param args Function arguments (rows, [columns], [start], [step])
+ * @param context Evaluation context (unused for SEQUENCE)
+ * @return Flat array, or a table of row arrays when rows and columns are both > 1
+ */
+Value sequence(const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief COUNTIFS function - counts values that meet multiple criteria
+ * @param args Function arguments (criteria_range1, criteria1, ...)
+ * @param context Evaluation context
+ * @return Number of rows meeting all criteria
+ */
+Value countifs(const std::vector<Value>& args, const Context& context);
+
 /**
  * @brief AVERAGEIF function - averages values that meet a criterion
  * @param args Function arguments (range, criteria, [average_range])
@@ -1098,14 +1264,6 @@ Value sumx2my2(const std::vector<Value>& args, const Context& context);
 Value sumx2py2(const std::vector<Value>& args, const Context& context);
 Value sumxmy2(const std::vector<Value>& args, const Context& context);
 
-/**
- * @brief Helper function for simple wildcard matching without regex
- * @param text The text to match
- * @param pattern Pattern with * and ? wildcards
- * @return true if text matches pattern
- */
-bool simpleWildcardMatch(const std::string& text, const std::string& pattern);
-
 }  // namespace builtin
 
 /**
@@ -1136,12 +1294,91 @@ constexpr uint32_t hash_function_name(const char* str) {
 Value dispatch_builtin_function(const std::string& name, const std::vector<Value>& args,
                                 const Context& context);
 
+/**
+ * @brief Category modules holding the built-ins outside the core (math and logical)
+ *
+ * Native and single-file WASM builds link every module into the library. Split WASM builds
+ * (VELOX_SPLIT_FUNCTION_MODULES) leave them out of the core and load each one as a side
+ * module on first use; a loaded module registers its dispatcher with
+ * register_function_module().
+ */
+enum class FunctionModule { TEXT, DATETIME, LOOKUP, ENGINEERING, FINANCIAL };
+
+/// Number of FunctionModule values
+constexpr size_t kFunctionModuleCount = 5;
+
+/// Dispatcher of one module: the function's result, or an empty Value if not in the module
+using ModuleDispatch = Value (*)(const std::string& name, const std::vector<Value>& args,
+                                 const Context& context);
+
+Value dispatch_text_function(const std::string& name, const std::vector<Value>& args,
+                             const Context& context);
+Value dispatch_datetime_function(const std::string& name, const std::vector<Value>& args,
+                                 const Context& context);
+Value dispatch_lookup_function(const std::string& name, const std::vector<Value>& args,
+                               const Context& context);
+Value dispatch_engineering_function(const std::string& name, const std::vector<Value>& args,
+                                    const Context& context);
+Value dispatch_financial_function(const std::string& name, const std::vector<Value>& args,
+                                  const Context& context);
+
+/**
+ * @brief Make a module's functions reachable from dispatch_builtin_function()
+ * @param module Module being registered
+ * @param dispatch Its dispatcher
+ */
+void register_function_module(FunctionModule module, ModuleDispatch dispatch);
+
+/**
+ * @brief Dispatch a name outside the core to its module
+ * @param hash hash_function_name() of the name
+ * @param name Function name (must be uppercase)
+ * @param args Function arguments
+ * @param context Evaluation context
+ * @return Function result, or an empty Value if the name belongs to no module or its
+ * module is not loaded
+ */
+Value dispatch_module_function(uint32_t hash, const std::string& name,
+                               const std::vector<Value>& args, const Context& context);
+
+/**
+ * @brief Module a built-in function lives in
+ * @param name Function name (must be uppercase)
+ * @param module Receives the module
+ * @return false for core functions and unknown names
+ */
+bool find_function_module(const std::string& name, FunctionModule& module);
+
+/**
+ * @brief Lowercase name of a module ("text", "datetime", ...), as in formulas-<name>.wasm
+ */
+const char* function_module_name(FunctionModule module);
+
+/**
+ * @brief Check if a module's dispatcher has been registered
+ */
+bool is_function_module_loaded(FunctionModule module);
+
 /**
  * @brief Get list of all built-in function names
  * @return Vector of all built-in function names (uppercase)
  */
 std::vector<std::string> get_builtin_function_names();
 
+/**
+ * @brief Check if a name is dispatched to a built-in implementation
+ * @param name Function name (must be uppercase)
+ * @return true if the name is a built-in function
+ */
+bool is_builtin_function(const std::string& name);
+
+/**
+ * @brief Check if a built-in function is volatile (result may change between calls)
+ * @param name Function name (must be uppercase)
+ * @return true for RAND, RANDBETWEEN, NOW, TODAY
+ */
+bool is_volatile_function(const std::string& name);
+
 }  // namespace dispatcher
 
 /**
@@ -1184,6 +1421,14 @@ Value checkForErrors(const std::vector<Value>& args);
  */
 Value toNumberSafe(const Value& value, const std::string& function_name);
 
+/**
+ * @brief Zero-copy view of an array argument whose elements are all numbers
+ * @param value Value to inspect
+ * @param numbers Receives the packed doubles on success
+ * @return true if value is a packed numeric array, false otherwise
+ */
+bool numericArrayView(const Value& value, NumberSpan& numbers);
+
 }  // namespace utils
 
 // Template function declarations for common patterns
@@ -1221,44 +1466,6 @@ Value singleNumericFunction(const std::vector<Value>& args, const Context& conte
     }
 }
 
-/**
- * @brief Template for multi-argument numeric functions
- * @param args Function arguments
- * @param context Evaluation context
- * @param name Function name for error messages
- * @param operation The numeric operation to perform
- * @return Result of the operation
- */
-template <typename Func>
-Value multiNumericFunction(const std::vector<Value>& args, const Context& context,
-                           const std::string& name, Func operation) {
-    (void)context;  // Unused parameter
-    (void)name;     // Unused parameter
-
-    // Allow empty arguments for functions like SUM
-    auto errorCheck = utils::checkForErrors(args);
-    if (!errorCheck.isEmpty()) {
-        return errorCheck;
-    }
-
-    std::vector<double> numbers;
-    numbers.reserve(args.size());
-
-    for (const auto& arg : args) {
-        if (!arg.isEmpty() && arg.canConvertToNumber()) {
-            numbers.push_back(arg.toNumber());
-        }
-    }
-
-    try {
-        return Value(operation(numbers));
-    } catch (const std::runtime_error&) {
-        return Value::error(ErrorType::DIV_ZERO);
-    } catch (...) {
-        return Value::error(ErrorType::VALUE_ERROR);
-    }
-}
-
 /**
  * @brief Template for min/max functions
  * @param args Function arguments
@@ -1555,11 +1762,7 @@ Value singleDateFunction(const std::vector<Value>& args, const Context& context,
     }
 
     try {
-        auto date_val = args[0].asDate();
-        auto time_t = std::chrono::system_clock::to_time_t(date_val);
-        auto local_tm = *std::localtime(&time_t);
-
-        return Value(static_cast<double>(operation(local_tm)));
+        return Value(static_cast<double>(operation(dates::toTm(args[0].asDate()))));
     } catch (...) {
         return Value::error(ErrorType::VALUE_ERROR);
     }
@@ -1593,11 +1796,7 @@ Value dateTimeExtractionFunction(const std::vector<Value>& args, const Context&
     if (args[0].isDate()) {
         // Handle date value
         try {
-            auto date_val = args[0].asDate();
-            auto time_t = std::chrono::system_clock::to_time_t(date_val);
-            auto local_tm = *std::localtime(&time_t);
-
-            return Value(static_cast<double>(dateOperation(local_tm)));
+            return Value(static_cast<double>(dateOperation(dates::toTm(args[0].asDate()))));
         } catch (...) {
             return Value::error(ErrorType::VALUE_ERROR);
         }
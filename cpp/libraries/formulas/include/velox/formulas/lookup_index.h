@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "types.h"
+
+namespace xl_formula {
+namespace lookup {
+
+constexpr size_t npos = static_cast<size_t>(-1);
+
+/**
+ * @brief Which keys of a table a lookup searches
+ */
+enum class Axis : uint8_t {
+    VECTOR,        ///< A one-row or one-column table (MATCH, XLOOKUP)
+    FIRST_COLUMN,  ///< First column of each row (VLOOKUP)
+    FIRST_ROW      ///< First row (HLOOKUP)
+};
+
+/**
+ * @brief How keys are compared to the lookup value
+ *
+ * Approximate modes compare only values of the same type (numbers with numbers, text
+ * with text case-insensitively) and find the true nearest key, so they give Excel's
+ * result on sorted data and a well-defined one on unsorted data.
+ */
+enum class MatchMode : uint8_t {
+    EXACT,             ///< Equal key; text is case-insensitive
+    WILDCARD,          ///< EXACT, but text lookup values may use * ? and ~
+    FLOOR,             ///< Largest key <= value, last of equal keys (VLOOKUP TRUE, MATCH 1)
+    CEIL,              ///< Smallest key >= value, first of equal keys (MATCH -1)
+    EXACT_OR_SMALLER,  ///< EXACT, else the largest smaller key (XLOOKUP -1)
+    EXACT_OR_LARGER    ///< EXACT, else the smallest larger key (XLOOKUP 1)
+};
+
+/**
+ * @brief Dimensions of a lookup table
+ *
+ * A table is an array of equally sized row arrays, e.g. {{1, "a"}, {2, "b"}}. A flat
+ * array is a single column (or a single row for HLOOKUP) and a non-array value is a
+ * 1x1 table.
+ */
+struct TableShape {
+    size_t rows = 0;
+    size_t cols = 0;
+    bool nested = false;
+};
+
+/**
+ * @brief Determine the shape of a table argument
+ * @param table Table argument
+ * @param shape Receives the dimensions
+ * @return Empty value on success, #VALUE! for ragged or partially nested tables
+ */
+Value getTableShape(const Value& table, TableShape& shape);
+
+/**
+ * @brief Value at a 0-based row and column of a table
+ */
+Value tableCell(const Value& table, const TableShape& shape, size_t row, size_t col);
+
+/**
+ * @brief Swap the rows and columns of a table
+ * @return Table with shape.cols rows of shape.rows elements
+ */
+Value transposeTable(const Value& table, const TableShape& shape);
+
+/**
+ * @brief Keys of a table searched along an axis, indexed for repeated lookups
+ *
+ * Exact lookups go through hash maps holding the first and last position of each
+ * key; approximate lookups binary-search sorted (key, position) projections.
+ */
+class LookupIndex {
+  private:
+    struct Positions {
+        size_t first;
+        size_t last;
+    };
+
+    std::unordered_map<double, Positions> numbers_;
+    std::unordered_map<std::string, Positions> texts_;
+    Positions booleans_[2] = {{npos, npos}, {npos, npos}};
+    bool sorted_ = false;
+    std::vector<std::pair<double, size_t>> sorted_numbers_;
+    std::vector<std::pair<std::string, size_t>> sorted_texts_;
+
+    template <typename Key>
+    static size_t findNearest(const std::vector<std::pair<Key, size_t>>& sorted, const Key& key,
+                              bool below, bool inclusive, bool last);
+
+  public:
+    /**
+     * @brief Index a sequence of keys
+     * @param keys Keys in table order
+     * @param sorted Also build the projections needed by approximate lookups
+     */
+    LookupIndex(const std::vector<Value>& keys, bool sorted);
+
+    bool hasSortedProjection() const {
+        return sorted_;
+    }
+
+    /**
+     * @brief Position of a key equal to value
+     * @param last Return the last equal key instead of the first
+     */
+    size_t findExact(const Value& value, bool last) const;
+
+    /**
+     * @brief Position of the nearest key of the same type on one side of value
+     * @param below Search keys below value (otherwise above)
+     * @param inclusive Accept a key equal to value
+     * @param last Among equal nearest keys, return the last one instead of the first
+     */
+    size_t findNearest(const Value& value, bool below, bool inclusive, bool last) const;
+};
+
+/**
+ * @brief Per-engine cache of lookup indexes keyed by table identity and axis
+ *
+ * Arrays are immutable and shared, so an index stays valid for as long as its table
+ * is alive; entries hold a weak reference to the table to detect reuse of its
+ * address. Owned by Context, so every FormulaEngine has its own cache.
+ */
+class LookupIndexCache {
+  private:
+    struct Key {
+        const ArrayData* table;
+        Axis axis;
+        bool operator==(const Key& other) const {
+            return table == other.table && axis == other.axis;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return std::hash<const void*>()(key.table) ^ static_cast<size_t>(key.axis);
+        }
+    };
+    struct Entry {
+        std::weak_ptr<const ArrayData> owner;
+        std::shared_ptr<const LookupIndex> index;
+    };
+
+    std::unordered_map<Key, Entry, KeyHash> entries_;
+    std::mutex mutex_;
+
+  public:
+    /// Maximum number of cached indexes before stale entries are evicted
+    static constexpr size_t kMaxEntries = 64;
+
+    /**
+     * @brief Get the index for a table axis, building it on first use
+     * @param table Table the keys come from
+     * @param axis Axis the keys were taken along
+     * @param sorted Whether approximate lookups will be made
+     * @param keys Produces the keys when the index has to be built
+     * @return Shared index
+     */
+    std::shared_ptr<const LookupIndex> get(const Value::ArrayType& table, Axis axis, bool sorted,
+                                           const std::function<std::vector<Value>()>& keys);
+
+    /**
+     * @brief Number of cached indexes
+     */
+    size_t size();
+
+    /**
+     * @brief Drop all cached indexes
+     */
+    void clear();
+};
+
+/**
+ * @brief Tables with at least this many keys are searched through the index cache
+ */
+constexpr size_t kIndexThreshold = 16;
+
+/**
+ * @brief Find a lookup value along an axis of a table
+ * @param context Context owning the index cache
+ * @param lookup_value Value to find
+ * @param table Table to search
+ * @param shape Shape of the table
+ * @param axis Keys to search
+ * @param mode Match mode
+ * @param reverse Prefer the last matching position (XLOOKUP search_mode -1)
+ * @return 0-based position along the axis, or npos when not found
+ */
+size_t findPosition(const Context& context, const Value& lookup_value, const Value& table,
+                    const TableShape& shape, Axis axis, MatchMode mode, bool reverse = false);
+
+}  // namespace lookup
+}  // namespace xl_formula
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace xl_formula {
+namespace format {
+
+/**
+ * @brief One element of a compiled format section
+ */
+struct FormatToken {
+    enum class Code : uint8_t {
+        LITERAL,     ///< Fixed text
+        DIGIT,       ///< Digit placeholder 0, # or ?
+        DECIMAL,     ///< Decimal point
+        EXPONENT,    ///< E+ / E- of scientific notation
+        TEXT,        ///< @, the text argument
+        GENERAL,     ///< General number format
+        YEAR,        ///< yy / yyyy
+        MONTH,       ///< m / mm
+        MONTH_NAME,  ///< mmm / mmmm / mmmmm
+        DAY,         ///< d / dd
+        WEEKDAY,     ///< ddd / dddd
+        HOUR,        ///< h / hh
+        MINUTE,      ///< m / mm next to h or s
+        SECOND,      ///< s / ss
+        SUBSECOND,   ///< .0, .00 or .000 after seconds
+        AM_PM        ///< AM/PM or A/P; switches hours to a 12-hour clock
+    };
+    enum class Part : uint8_t { INTEGER, FRACTION, EXPONENT };
+
+    Code code = Code::LITERAL;
+    Part part = Part::INTEGER;  ///< Digit placeholders: which part of the number
+    char placeholder = '0';     ///< Digit placeholders: 0, # or ?; E / e for EXPONENT
+    uint8_t width = 0;          ///< Repeat count of a date code, or digits of SUBSECOND
+    bool plus = false;          ///< EXPONENT: always show the sign
+    bool lower = false;         ///< AM_PM: lower-case designators
+    int position = 0;           ///< Digit placeholders: digit index within their part
+    std::string text;           ///< LITERAL text
+};
+
+/**
+ * @brief One ';'-separated section of a format
+ */
+struct FormatSection {
+    enum class Kind : uint8_t { NUMBER, DATE, TEXT, GENERAL };
+
+    Kind kind = Kind::NUMBER;
+    std::vector<FormatToken> tokens;
+    int integer_digits = 0;
+    int fraction_digits = 0;
+    int exponent_digits = 0;
+    int percent = 0;               ///< Each % multiplies by 100
+    int thousands_scale = 0;       ///< Each trailing comma divides by 1000
+    int subsecond_digits = 0;
+    bool thousands = false;        ///< Group integer digits with commas
+    bool has_exponent = false;
+    bool grouped_exponent = false;  ///< Exponent is a multiple of the integer digits (##0.0E+0)
+    bool twelve_hour = false;
+};
+
+/**
+ * @brief A compiled Excel number format
+ *
+ * Compiling parses the format once into per-section token programs: sections for
+ * positive, negative, zero and text values, digit placeholders (0 # ?) with thousands
+ * separators, decimal places, percent and thousands scaling, scientific notation, quoted
+ * and escaped literals, [$currency] and color tags, General, and date/time codes on the
+ * value's serial number. Formatting then only walks the tokens and writes digits obtained
+ * with std::to_chars into the caller's buffer; it does not allocate.
+ *
+ * Numbers are rounded half away from zero on their 15 significant digits, as Excel
+ * displays them, so TEXT(1.005, "0.00") is "1.01".
+ */
+class NumberFormat {
+  private:
+    std::vector<FormatSection> sections_;
+    bool valid_ = false;
+
+  public:
+    /// Returned by the formatting functions when the value cannot be shown
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * @brief Compile a format string
+     * @return The compiled format; isValid() is false if the format cannot be parsed
+     */
+    static NumberFormat compile(std::string_view pattern);
+
+    /**
+     * @brief Compiled format shared through a small per-thread cache
+     * @param pattern Format string
+     * @return Compiled format; each distinct format string is compiled once per thread
+     */
+    static std::shared_ptr<const NumberFormat> cached(const std::string& pattern);
+
+    bool isValid() const {
+        return valid_;
+    }
+
+    /**
+     * @brief Format a number (or a date serial) into a caller buffer
+     * @param value Value to format
+     * @param buffer Output buffer; not NUL-terminated
+     * @param capacity Size of the buffer
+     * @return Length of the formatted text, which was only written in full if it does not
+     * exceed capacity, or npos if the value cannot be shown (a negative date)
+     */
+    size_t format(double value, char* buffer, size_t capacity) const;
+
+    /**
+     * @brief Format a text value through the text section
+     *
+     * Formats without a text section show the text unchanged.
+     * @return Length of the formatted text as for format(), or npos if the fourth section
+     * cannot hold text
+     */
+    size_t formatText(std::string_view text, char* buffer, size_t capacity) const;
+};
+
+}  // namespace format
+}  // namespace xl_formula
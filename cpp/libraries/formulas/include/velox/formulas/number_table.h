@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace xl_formula {
+
+/**
+ * @brief Open-addressing hash table counting distinct doubles
+ *
+ * Keys are hashed by bit pattern (with -0 folded into 0) and probed linearly in a
+ * power-of-two table, so counting n numbers is a single pass over flat memory with
+ * no per-key allocation. Each slot records how often its key was seen and where it
+ * was first seen, in first-seen order through entries(). Shared by UNIQUE, MODE and
+ * MODE.MULT, and usable for any equality tally over numbers.
+ */
+class NumberTable {
+  public:
+    struct Entry {
+        double key;
+        size_t count;
+        size_t first;  ///< Position of the first insert of this key
+    };
+
+  private:
+    std::vector<uint32_t> slots_;  // 0 = empty, otherwise entries_ index + 1
+    std::vector<Entry> entries_;
+    size_t mask_ = 0;
+
+    static uint64_t bits(double key) {
+        uint64_t value;
+        std::memcpy(&value, &key, sizeof(value));
+        return value;
+    }
+
+    static size_t hash(uint64_t value) {
+        // splitmix64 finalizer
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9ULL;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111ebULL;
+        value ^= value >> 31;
+        return static_cast<size_t>(value);
+    }
+
+    void grow() {
+        std::vector<uint32_t> old = std::move(slots_);
+        slots_.assign(old.empty() ? 16 : old.size() * 2, 0);
+        mask_ = slots_.size() - 1;
+        for (uint32_t slot : old) {
+            if (slot != 0) {
+                size_t i = hash(bits(entries_[slot - 1].key)) & mask_;
+                while (slots_[i] != 0) {
+                    i = (i + 1) & mask_;
+                }
+                slots_[i] = slot;
+            }
+        }
+    }
+
+    // Slot holding key, or the empty slot where it would be inserted
+    size_t probe(double key) const {
+        const uint64_t key_bits = bits(key == 0.0 ? 0.0 : key);
+        size_t i = hash(key_bits) & mask_;
+        while (slots_[i] != 0 && bits(entries_[slots_[i] - 1].key) != key_bits) {
+            i = (i + 1) & mask_;
+        }
+        return i;
+    }
+
+  public:
+    /**
+     * @brief Create a table sized for an expected number of distinct keys
+     */
+    explicit NumberTable(size_t expected = 0) {
+        size_t capacity = 16;
+        while (capacity < expected * 2) {
+            capacity *= 2;
+        }
+        slots_.assign(capacity, 0);
+        mask_ = capacity - 1;
+        entries_.reserve(expected);
+    }
+
+    /**
+     * @brief Count one occurrence of key
+     * @param key Number to count
+     * @param position Position of this occurrence (kept for the first one)
+     * @return Entry for the key
+     */
+    const Entry& add(double key, size_t position) {
+        if ((entries_.size() + 1) * 2 > slots_.size()) {
+            grow();
+        }
+        size_t i = probe(key);
+        if (slots_[i] != 0) {
+            Entry& entry = entries_[slots_[i] - 1];
+            ++entry.count;
+            return entry;
+        }
+        if (key == 0.0) {
+            key = 0.0;  // -0 and 0 are the same key
+        }
+        entries_.push_back(Entry{key, 1, position});
+        slots_[i] = static_cast<uint32_t>(entries_.size());
+        return entries_.back();
+    }
+
+    /**
+     * @brief Entry of a key
+     * @return The entry, or nullptr when key was never added
+     */
+    const Entry* find(double key) const {
+        const uint32_t slot = slots_[probe(key)];
+        return slot == 0 ? nullptr : &entries_[slot - 1];
+    }
+
+    /**
+     * @brief Distinct keys in first-seen order
+     */
+    const std::vector<Entry>& entries() const {
+        return entries_;
+    }
+
+    size_t size() const {
+        return entries_.size();
+    }
+};
+
+}  // namespace xl_formula
@@ -72,6 +72,28 @@ struct ParseError {
         : message(msg), position(pos), length(len) {}
 };
 
+/**
+ * @brief Names and flags a formula depends on, collected in one walk of the AST
+ */
+struct FormulaReferences {
+    std::vector<std::string> variables;  ///< Referenced variable names, in first-use order
+    std::vector<std::string> functions;  ///< Called function names (uppercase), first-use order
+    bool is_volatile = false;            ///< Calls RAND, RANDBETWEEN, NOW or TODAY
+    bool is_pure = true;                 ///< Calls only non-volatile built-in functions
+
+    /**
+     * @brief Collect references from an AST
+     * @param ast Root node to analyse
+     * @return Referenced variables, functions and purity flags
+     *
+     * Unknown names are treated as custom functions, which are assumed impure.
+     */
+    static FormulaReferences collect(const ASTNode& ast);
+
+    bool referencesVariable(const std::string& name) const;
+    bool callsFunction(const std::string& name) const;
+};
+
 /**
  * @brief Result of parsing operation
  */
@@ -79,11 +101,15 @@ class ParseResult {
   private:
     std::unique_ptr<ASTNode> ast_;
     std::vector<ParseError> errors_;
+    FormulaReferences references_;
     bool success_;
 
   public:
     ParseResult() : success_(false) {}
-    ParseResult(std::unique_ptr<ASTNode> ast) : ast_(std::move(ast)), success_(true) {}
+    ParseResult(std::unique_ptr<ASTNode> ast)
+        : ast_(std::move(ast)),
+          references_(ast_ ? FormulaReferences::collect(*ast_) : FormulaReferences()),
+          success_(true) {}
     ParseResult(const std::vector<ParseError>& errors) : errors_(errors), success_(false) {}
 
     bool isSuccess() const {
@@ -104,6 +130,13 @@ class ParseResult {
         return errors_;
     }
 
+    /**
+     * @brief Variables, functions and volatility of the parsed formula
+     */
+    const FormulaReferences& getReferences() const {
+        return references_;
+    }
+
     void addError(const ParseError& error) {
         errors_.push_back(error);
         success_ = false;
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ast.h"
+#include "parser.h"
+#include "types.h"
+
+namespace xl_formula {
+
+class FunctionRegistry;
+
+/**
+ * @brief Shared-subexpression plan computed at prepare time
+ *
+ * Subtrees are hash-consed: structurally identical subtrees receive the same
+ * canonical id. Pure, non-leaf subtrees that occur more than once (within one
+ * formula or across a batch) are assigned a memo slot so the evaluator computes
+ * them once per evaluation.
+ */
+class SubexpressionPlan {
+  private:
+    std::unordered_map<const ASTNode*, size_t> slots_;
+    size_t slot_count_ = 0;
+
+  public:
+    /**
+     * @brief Build a plan over one or more AST roots
+     * @param roots AST roots sharing one evaluation context
+     * @param registry Registry used to tell built-in (pure) functions from custom ones
+     * @return Plan mapping repeated pure subtrees to memo slots
+     */
+    static SubexpressionPlan build(const std::vector<const ASTNode*>& roots,
+                                   const FunctionRegistry& registry);
+
+    /**
+     * @brief Find the memo slot assigned to a node
+     * @param node AST node
+     * @return Slot index, or -1 if the node is not shared
+     */
+    long slotFor(const ASTNode& node) const {
+        auto it = slots_.find(&node);
+        return it == slots_.end() ? -1 : static_cast<long>(it->second);
+    }
+
+    /**
+     * @brief Number of distinct shared subexpressions
+     */
+    size_t getSlotCount() const {
+        return slot_count_;
+    }
+
+    bool empty() const {
+        return slot_count_ == 0;
+    }
+};
+
+/**
+ * @brief Rewrite an AST with known variables substituted and constant subtrees folded
+ * @param ast AST to rewrite (left untouched)
+ * @param known_variables Variables whose values are fixed; others stay as VariableNode
+ * @param registry Registry used to tell built-in (pure) functions from custom ones
+ * @return New AST in which every pure subtree without free variables is a LiteralNode
+ */
+std::unique_ptr<ASTNode> foldConstants(const ASTNode& ast,
+                                       const std::unordered_map<std::string, Value>& known_variables,
+                                       const FunctionRegistry& registry);
+
+/**
+ * @brief A formula parsed once and analysed for repeated evaluation
+ *
+ * Created by FormulaEngine::prepare() (constant subtrees already folded) or
+ * FormulaEngine::specialize(). Copies are cheap and share the AST.
+ */
+class PreparedFormula {
+  private:
+    friend class FormulaEngine;
+
+    std::string formula_;
+    std::shared_ptr<const ASTNode> ast_;
+    std::vector<ParseError> errors_;
+    FormulaReferences references_;
+    std::shared_ptr<const SubexpressionPlan> plan_;
+
+  public:
+    PreparedFormula() = default;
+
+    bool isSuccess() const {
+        return ast_ != nullptr;
+    }
+    const std::string& getFormula() const {
+        return formula_;
+    }
+    const ASTNode* getAST() const {
+        return ast_.get();
+    }
+    const std::vector<ParseError>& getErrors() const {
+        return errors_;
+    }
+
+    /**
+     * @brief Variables and functions the prepared (folded) formula still depends on
+     */
+    const FormulaReferences& getReferences() const {
+        return references_;
+    }
+
+    /**
+     * @brief Check if the formula folded down to a single literal
+     */
+    bool isConstant() const {
+        return dynamic_cast<const LiteralNode*>(ast_.get()) != nullptr;
+    }
+
+    /**
+     * @brief Subexpression plan for evaluating this formula on its own
+     */
+    const SubexpressionPlan* getPlan() const {
+        return plan_.get();
+    }
+
+    /**
+     * @brief Number of repeated pure subexpressions computed once per evaluation
+     */
+    size_t getSharedSubexpressionCount() const {
+        return plan_ ? plan_->getSlotCount() : 0;
+    }
+};
+
+/**
+ * @brief A group of prepared formulas evaluated together against one context
+ *
+ * Created by FormulaEngine::prepareBatch(). Subexpressions repeated across
+ * members of the batch are computed once per FormulaEngine::evaluateBatch() call.
+ */
+class PreparedBatch {
+  private:
+    friend class FormulaEngine;
+
+    std::vector<PreparedFormula> formulas_;
+    std::shared_ptr<const SubexpressionPlan> plan_;
+
+  public:
+    size_t size() const {
+        return formulas_.size();
+    }
+    const PreparedFormula& operator[](size_t index) const {
+        return formulas_[index];
+    }
+    const std::vector<PreparedFormula>& getFormulas() const {
+        return formulas_;
+    }
+    const SubexpressionPlan* getPlan() const {
+        return plan_.get();
+    }
+
+    /**
+     * @brief Number of repeated pure subexpressions shared across the whole batch
+     */
+    size_t getSharedSubexpressionCount() const {
+        return plan_ ? plan_->getSlotCount() : 0;
+    }
+};
+
+}  // namespace xl_formula
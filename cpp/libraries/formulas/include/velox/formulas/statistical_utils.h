@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "array_kernels.h"
+#include "number_table.h"
+#include "types.h"
+
+namespace xl_formula {
+namespace statistics {
+
+/**
+ * @brief Per-engine cache of sorted copies of numeric arrays
+ *
+ * The first order-statistic call against an array only registers it and selects from an
+ * unsorted copy; from the second call on, the array is sorted once and every later
+ * quantile, LARGE/SMALL or RANK against it is answered from the sorted copy. Entries hold
+ * a weak reference to the array so a freed array's address can't be mistaken for it.
+ */
+class SortedArrayCache {
+  private:
+    struct Entry {
+        std::weak_ptr<const ArrayData> owner;
+        std::shared_ptr<const std::vector<double>> sorted;
+    };
+
+    std::unordered_map<const ArrayData*, Entry> entries_;
+    std::mutex mutex_;
+
+  public:
+    /// Maximum number of cached arrays before stale entries are evicted
+    static constexpr size_t kMaxEntries = 64;
+
+    /**
+     * @brief Sorted numbers of an array, once it has been requested before
+     * @param array Array the numbers come from
+     * @param numbers Numeric elements of the array, in any order
+     * @return Shared sorted copy, or nullptr on the first request for this array
+     */
+    std::shared_ptr<const std::vector<double>> get(const Value::ArrayType& array,
+                                                   NumberSpan numbers);
+
+    /**
+     * @brief Number of registered arrays
+     */
+    size_t size();
+
+    /**
+     * @brief Drop all cached copies
+     */
+    void clear();
+};
+
+/**
+ * @brief Numbers an order statistic is computed over
+ *
+ * Collects the numeric data of the arguments without copying packed arrays, and picks
+ * the cheapest algorithm per query: binary search when a sorted copy is cached,
+ * selection (std::nth_element) for single quantiles, and a partial sort for small k.
+ */
+class OrderStatistics {
+  private:
+    std::vector<double> owned_;
+    std::shared_ptr<const std::vector<double>> sorted_;
+    NumberSpan numbers_;
+
+  public:
+    OrderStatistics() = default;
+    OrderStatistics(const OrderStatistics&) = delete;
+    OrderStatistics& operator=(const OrderStatistics&) = delete;
+
+    /**
+     * @brief Collect the numbers of data arguments
+     *
+     * Numbers, logicals and numeric text given directly are counted; inside arrays only
+     * numbers are, as in Excel.
+     * @param context Context owning the sorted-copy cache
+     * @param args Data arguments
+     * @param use_cache Whether a single array argument may be served from the cache
+     * @return Empty value on success, or the first error found in the data
+     */
+    Value load(const Context& context, const std::vector<Value>& args, bool use_cache = true);
+
+    size_t size() const {
+        return numbers_.size();
+    }
+
+    bool empty() const {
+        return numbers_.empty();
+    }
+
+    bool isSorted() const {
+        return sorted_ != nullptr;
+    }
+
+    /**
+     * @brief k-th smallest number (0-based)
+     */
+    double kthSmallest(size_t k) const;
+
+    /**
+     * @brief k-th largest number (0-based)
+     */
+    double kthLargest(size_t k) const;
+
+    /**
+     * @brief Inclusive percentile with linear interpolation (PERCENTILE, QUARTILE, MEDIAN)
+     * @param p Fraction in [0, 1]
+     */
+    double percentile(double p) const;
+
+    /**
+     * @brief Count numbers below (or above) a value
+     * @param value Value to compare with
+     * @param above Count numbers greater than value instead of smaller
+     */
+    size_t countBeyond(double value, bool above) const;
+
+    /**
+     * @brief Whether value is one of the numbers
+     */
+    bool contains(double value) const;
+};
+
+/**
+ * @brief Sum of data arguments (SUM, AVERAGE)
+ *
+ * Counts the same numbers as OrderStatistics::load, streaming packed arrays through the
+ * sum kernel and adding scalars one by one, so no intermediate vector is built.
+ * @param args Data arguments
+ * @param sum Accumulator receiving the numbers
+ * @param count Receives how many numbers were added
+ * @return Empty value on success, or the first error found in the data
+ */
+Value accumulateSum(const std::vector<Value>& args, kernels::SumAccumulator& sum, size_t& count);
+
+/**
+ * @brief Frequencies of the numbers in data arguments (MODE, MODE.MULT)
+ *
+ * Counts the same numbers as OrderStatistics::load in one pass through an
+ * open-addressing table; positions are the order in which numbers were seen.
+ * @param args Data arguments
+ * @param table Receives the counts
+ * @return Empty value on success, or the first error found in the data
+ */
+Value tallyNumbers(const std::vector<Value>& args, NumberTable& table);
+
+/**
+ * @brief Moments of data arguments (STDEV, VAR)
+ *
+ * Counts the same numbers as OrderStatistics::load; packed arrays are streamed through
+ * the moments kernel without being copied.
+ * @param args Data arguments
+ * @param moments Receives count, mean and M2
+ * @return Empty value on success, or the first error found in the data
+ */
+Value accumulateMoments(const std::vector<Value>& args, kernels::Moments& moments);
+
+/**
+ * @brief Paired moments of two data sets (CORREL, RSQ, SLOPE, INTERCEPT, COVARIANCE)
+ *
+ * Two array arguments are paired element-wise up to the shorter length, skipping pairs
+ * where either side is not a number. Any other argument list is split in half: numbers
+ * from the first half pair with numbers from the second.
+ * @param args Data arguments (x first)
+ * @param moments Receives the moments and co-moment
+ * @return Empty value on success, or the first error found in the data
+ */
+Value accumulateCoMoments(const std::vector<Value>& args, kernels::CoMoments& moments);
+
+/**
+ * @brief Arrays with at least this many numbers go through the sorted-copy cache
+ */
+constexpr size_t kSortedCacheThreshold = 64;
+
+/**
+ * @brief Largest k for which LARGE/SMALL partially sort instead of selecting
+ */
+constexpr size_t kPartialSortLimit = 32;
+
+}  // namespace statistics
+}  // namespace xl_formula
@@ -1,7 +1,8 @@
 #pragma once
 
-#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <variant>
@@ -36,13 +37,85 @@ enum class ErrorType {
     PARSE_ERROR   ///< Parse error
 };
 
+class ArrayData;
+
+namespace lookup {
+class LookupIndexCache;
+}
+
+namespace statistics {
+class SortedArrayCache;
+}
+
+namespace dates {
+class BusinessCalendarCache;
+}
+
+/**
+ * @brief Read-only view over contiguous doubles (a minimal std::span<const double>)
+ */
+class NumberSpan {
+  private:
+    const double* data_ = nullptr;
+    size_t size_ = 0;
+
+  public:
+    NumberSpan() = default;
+    NumberSpan(const double* data, size_t size) : data_(data), size_(size) {}
+    NumberSpan(const std::vector<double>& numbers) : data_(numbers.data()), size_(numbers.size()) {}
+
+    const double* data() const {
+        return data_;
+    }
+    size_t size() const {
+        return size_;
+    }
+    bool empty() const {
+        return size_ == 0;
+    }
+    const double* begin() const {
+        return data_;
+    }
+    const double* end() const {
+        return data_ + size_;
+    }
+    double operator[](size_t index) const {
+        return data_[index];
+    }
+};
+
+/**
+ * @brief Date value stored as an Excel serial number (1900 date system)
+ *
+ * The whole part counts days from 1899-12-30, so 1900-03-01 is serial 61 as in Excel, and
+ * the fraction is the time of day. Excel also counts a fictitious 1900-02-29, so its serials
+ * before March 1900 are one lower than these. Date arithmetic is plain double arithmetic;
+ * calendar fields and text are only derived when asked for (see dates::splitDate).
+ */
+struct SerialDate {
+    double serial = 0.0;
+
+    constexpr SerialDate() = default;
+    constexpr explicit SerialDate(double value) : serial(value) {}
+
+    friend constexpr bool operator==(SerialDate a, SerialDate b) {
+        return a.serial == b.serial;
+    }
+    friend constexpr bool operator!=(SerialDate a, SerialDate b) {
+        return a.serial != b.serial;
+    }
+    friend constexpr bool operator<(SerialDate a, SerialDate b) {
+        return a.serial < b.serial;
+    }
+};
+
 /**
  * @brief Represents a value in the formula system
  */
 class Value {
   public:
-    using DateType = std::chrono::system_clock::time_point;
-    using ArrayType = std::shared_ptr<std::vector<Value>>;
+    using DateType = SerialDate;
+    using ArrayType = std::shared_ptr<const ArrayData>;
     using VariantType = std::variant<double, std::string, bool, DateType, ErrorType, ArrayType>;
 
   private:
@@ -92,6 +165,8 @@ class Value {
     DateType asDate() const;
     ErrorType asError() const;
     const std::vector<Value>& asArray() const;
+    const ArrayData& asArrayData() const;
+    const ArrayType& asArrayPtr() const;
 
     // Conversion utilities
     bool canConvertToNumber() const;
@@ -108,9 +183,9 @@ class Value {
     bool operator>(const Value& other) const;
     bool operator>=(const Value& other) const;
 
-    // Array constructor
-    Value(const std::vector<Value>& array)
-        : data_(std::make_shared<std::vector<Value>>(array)), type_(ValueType::ARRAY) {}
+    // Array constructors
+    Value(const std::vector<Value>& array);
+    explicit Value(ArrayType array) : data_(std::move(array)), type_(ValueType::ARRAY) {}
 
     // Static factory methods
     static Value error(ErrorType type) {
@@ -122,6 +197,97 @@ class Value {
     static Value array(const std::vector<Value>& elements) {
         return Value(elements);
     }
+
+    /**
+     * @brief Create an array backed by a packed double buffer (no per-element Values)
+     */
+    static Value numberArray(std::vector<double> numbers);
+};
+
+/**
+ * @brief Immutable storage behind an array Value
+ *
+ * Arrays of numbers are kept as a packed double buffer. Numbers mixed with a few
+ * errors or empties are kept as doubles plus a bitmap marking the non-numeric
+ * slots (whose double holds the ErrorType code; NONE means empty). Anything else
+ * falls back to a vector of Values. The Value vector returned by values() is
+ * built on first use for packed storage, so numeric consumers should read
+ * numbers() instead.
+ */
+class ArrayData {
+  public:
+    enum class Storage {
+        NUMERIC,  ///< Packed doubles only
+        MASKED,   ///< Packed doubles plus a bitmap of error/empty slots
+        GENERIC   ///< Vector of Values
+    };
+
+  private:
+    Storage storage_ = Storage::GENERIC;
+    std::vector<double> numbers_;
+    std::vector<uint64_t> non_numeric_;  // MASKED: bit i set when slot i is not a number
+    mutable std::vector<Value> values_;
+    mutable std::once_flag values_once_;
+
+    bool isMasked(size_t index) const {
+        return (non_numeric_[index / 64] >> (index % 64)) & 1u;
+    }
+
+  public:
+    /**
+     * @brief Build storage for a list of elements, packing it when the elements allow
+     * @param elements Array elements
+     * @return Shared immutable array storage
+     */
+    static std::shared_ptr<const ArrayData> fromValues(const std::vector<Value>& elements);
+
+    /**
+     * @brief Build numeric storage that takes ownership of a double buffer
+     */
+    static std::shared_ptr<const ArrayData> fromNumbers(std::vector<double> numbers);
+
+    Storage getStorage() const {
+        return storage_;
+    }
+    size_t size() const {
+        return storage_ == Storage::GENERIC ? values_.size() : numbers_.size();
+    }
+
+    /**
+     * @brief Check if every element is a number (numbers() is then a complete view)
+     */
+    bool isNumeric() const {
+        return storage_ == Storage::NUMERIC;
+    }
+
+    /**
+     * @brief Zero-copy view of the packed doubles
+     * @return All elements for NUMERIC storage, an empty span otherwise
+     */
+    NumberSpan numbers() const {
+        return storage_ == Storage::NUMERIC ? NumberSpan(numbers_) : NumberSpan();
+    }
+
+    /**
+     * @brief Element at index, without materializing the Value vector
+     */
+    Value at(size_t index) const;
+
+    /**
+     * @brief All elements as Values (materialized once for packed storage)
+     */
+    const std::vector<Value>& values() const;
+};
+
+/**
+ * @brief Time zone of the wall clock behind NOW and TODAY
+ *
+ * Date values themselves carry no zone (see dates::splitDate); the policy only decides
+ * which clock the current date and time are read from.
+ */
+enum class TimeZonePolicy : uint8_t {
+    LOCAL,  ///< Host time zone, as Excel does
+    UTC     ///< Coordinated Universal Time, for reproducible server-side evaluation
 };
 
 /**
@@ -130,6 +296,10 @@ class Value {
 class Context {
   private:
     std::unordered_map<std::string, Value> variables_;
+    TimeZonePolicy time_zone_ = TimeZonePolicy::LOCAL;
+    mutable std::shared_ptr<lookup::LookupIndexCache> lookup_cache_;
+    mutable std::shared_ptr<statistics::SortedArrayCache> sorted_cache_;
+    mutable std::shared_ptr<dates::BusinessCalendarCache> calendar_cache_;
 
   public:
     /**
@@ -146,6 +316,15 @@ class Context {
      */
     Value getVariable(const std::string& name) const;
 
+    /**
+     * @brief Look up a variable without copying it
+     * @param name Variable name
+     * @return Pointer to the stored value, or nullptr if not found. Stays valid until the
+     * variable is removed or another variable is added.
+     */
+    const Value* findVariable(const std::string& name) const;
+    Value* findVariable(const std::string& name);
+
     /**
      * @brief Check if a variable exists in the context
      * @param name Variable name
@@ -169,6 +348,34 @@ class Context {
      * @return Vector of variable names
      */
     std::vector<std::string> getVariableNames() const;
+
+    /**
+     * @brief Set the wall clock NOW and TODAY read (kept by clear())
+     */
+    void setTimeZonePolicy(TimeZonePolicy policy);
+
+    /**
+     * @brief Get the wall clock NOW and TODAY read
+     */
+    TimeZonePolicy getTimeZonePolicy() const;
+
+    /**
+     * @brief Get the lookup-index cache shared by lookups against this context
+     * @return Cache (created on first use; copies of the context share it)
+     */
+    lookup::LookupIndexCache& getLookupCache() const;
+
+    /**
+     * @brief Get the sorted-copy cache shared by order statistics against this context
+     * @return Cache (created on first use; copies of the context share it)
+     */
+    statistics::SortedArrayCache& getSortedArrayCache() const;
+
+    /**
+     * @brief Get the business-calendar cache shared by WORKDAY and NETWORKDAYS calls
+     * @return Cache (created on first use; copies of the context share it)
+     */
+    dates::BusinessCalendarCache& getCalendarCache() const;
 };
 
 }  // namespace xl_formula
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace xl_formula {
+
+/**
+ * @brief Excel wildcard pattern compiled once and matched without backtracking blowup
+ *
+ * Supports `*` (any run), `?` (any single character) and the `~` escape (`~*`, `~?`,
+ * `~~`). Matching is ASCII case-insensitive, like Excel. Both whole-text matching
+ * and leftmost search run in O(n·m) worst case; literal characters are located with
+ * memchr before any state is tracked.
+ *
+ * Used by the *IF criteria, SEARCH, and intended for MATCH/XLOOKUP wildcard modes.
+ */
+class WildcardPattern {
+  private:
+    enum class Token : uint8_t { LITERAL, ANY_ONE, ANY_RUN };
+
+    std::vector<Token> tokens_;
+    std::string chars_;  // lowercased literal per token (unused for wildcards)
+    bool has_wildcards_ = false;
+
+    bool prefilter(const std::string& text) const;
+
+  public:
+    WildcardPattern() = default;
+
+    /**
+     * @brief Compile an Excel wildcard pattern
+     * @param pattern Pattern text
+     * @return Compiled pattern
+     */
+    static WildcardPattern compile(const std::string& pattern);
+
+    /**
+     * @brief Check if text uses wildcard syntax (`*`, `?` or `~`)
+     */
+    static bool hasWildcardSyntax(const std::string& pattern);
+
+    /**
+     * @brief Check if the pattern contains unescaped `*` or `?`
+     */
+    bool hasWildcards() const {
+        return has_wildcards_;
+    }
+
+    /**
+     * @brief Match the whole text against the pattern
+     * @param text Text to test
+     * @return true if the entire text matches
+     */
+    bool matches(const std::string& text) const;
+
+    /**
+     * @brief Find the leftmost position where the pattern matches a prefix of the rest
+     * @param text Text to search
+     * @param start Position to start searching from
+     * @return 0-based position, or std::string::npos if there is no match
+     */
+    size_t find(const std::string& text, size_t start = 0) const;
+};
+
+}  // namespace xl_formula
@@ -41,6 +41,7 @@
  * - Comparison: =, <>, <, <=, >, >=
  * - Text concatenation: &
  * - Unary operators: +, -
+ * - Array broadcasting: `{1,2,3} * 2`, `{1,2} + {3,4}`, `{1,2,3} > 1` (element-wise)
  *
  * ### Built-in Functions
  * - **Math**: SUM, MAX, ABS, ROUND
@@ -64,6 +65,16 @@
  * });
  * ```
  *
+ * ### Prepared Formulas
+ *
+ * ```cpp
+ * auto prepared = engine.prepare("IF((A*B)/C > 10, (A*B)/C, 0)");
+ * auto result = engine.evaluate(prepared);  // (A*B)/C is computed once
+ *
+ * auto batch = engine.prepareBatch({"(A*B)/C + 1", "(A*B)/C * 2"});
+ * auto results = engine.evaluateBatch(batch);  // shared across both formulas
+ * ```
+ *
  * ### Error Handling
  *
  * The library provides comprehensive error handling with specific error types:
@@ -85,6 +96,7 @@
 
 // Evaluation engine
 #include "evaluator.h"
+#include "prepared.h"
 
 // Built-in functions
 #include "functions.h"
@@ -147,6 +159,9 @@ EvaluationResult evaluate(const std::string& formula,
  * auto parse_result = xl_formula::parse("SUM(A1:A10)");
  * if (parse_result.isSuccess()) {
  *     std::cout << "AST: " << parse_result.getAST()->toString() << std::endl;
+ *     // Dependencies for cache invalidation
+ *     const auto& refs = parse_result.getReferences();
+ *     // refs.variables, refs.functions, refs.is_volatile, refs.is_pure
  * }
  * ```
  */
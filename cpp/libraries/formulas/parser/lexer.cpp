@@ -123,8 +123,10 @@ Token Lexer::makeIdentifier() {
     size_t start_pos = position_;
     std::string identifier;
 
+    // A '.' followed by a letter continues the name, as in WORKDAY.INTL or MODE.MULT
     while (current_char_ != '\0' &&
-           (std::isalnum(current_char_) || current_char_ == '_' || current_char_ == ':')) {
+           (std::isalnum(current_char_) || current_char_ == '_' || current_char_ == ':' ||
+            (current_char_ == '.' && std::isalpha(static_cast<unsigned char>(peek()))))) {
         identifier += current_char_;
         advance();
     }
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <unordered_set>
+#include "velox/formulas/functions.h"
+#include "velox/formulas/parser.h"
+
+namespace xl_formula {
+
+namespace {
+
+/**
+ * @brief Collects variable and function references in a single AST walk
+ */
+class ReferenceCollector : public ASTVisitor {
+  private:
+    FormulaReferences& refs_;
+    std::unordered_set<std::string> seen_variables_;
+    std::unordered_set<std::string> seen_functions_;
+
+    void visitAll(const std::vector<std::unique_ptr<ASTNode>>& nodes) {
+        for (const auto& node : nodes) {
+            node->accept(*this);
+        }
+    }
+
+  public:
+    explicit ReferenceCollector(FormulaReferences& refs) : refs_(refs) {}
+
+    void visit(const LiteralNode& node) override {
+        (void)node;
+    }
+
+    void visit(const VariableNode& node) override {
+        if (seen_variables_.insert(node.getName()).second) {
+            refs_.variables.push_back(node.getName());
+        }
+    }
+
+    void visit(const BinaryOpNode& node) override {
+        const_cast<ASTNode&>(node.getLeft()).accept(*this);
+        const_cast<ASTNode&>(node.getRight()).accept(*this);
+    }
+
+    void visit(const UnaryOpNode& node) override {
+        const_cast<ASTNode&>(node.getOperand()).accept(*this);
+    }
+
+    void visit(const ArrayNode& node) override {
+        visitAll(node.getElements());
+    }
+
+    void visit(const FunctionCallNode& node) override {
+        std::string upper_name = node.getName();
+        std::transform(upper_name.begin(), upper_name.end(), upper_name.begin(), ::toupper);
+
+        if (seen_functions_.insert(upper_name).second) {
+            refs_.functions.push_back(upper_name);
+            if (functions::dispatcher::is_volatile_function(upper_name)) {
+                refs_.is_volatile = true;
+                refs_.is_pure = false;
+            } else if (!functions::dispatcher::is_builtin_function(upper_name)) {
+                refs_.is_pure = false;
+            }
+        }
+        visitAll(node.getArguments());
+    }
+};
+
+}  // namespace
+
+FormulaReferences FormulaReferences::collect(const ASTNode& ast) {
+    FormulaReferences refs;
+    ReferenceCollector collector(refs);
+    const_cast<ASTNode&>(ast).accept(collector);
+    return refs;
+}
+
+bool FormulaReferences::referencesVariable(const std::string& name) const {
+    return std::find(variables.begin(), variables.end(), name) != variables.end();
+}
+
+bool FormulaReferences::callsFunction(const std::string& name) const {
+    std::string upper_name = name;
+    std::transform(upper_name.begin(), upper_name.end(), upper_name.begin(), ::toupper);
+    return std::find(functions.begin(), functions.end(), upper_name) != functions.end();
+}
+
+}  // namespace xl_formula
@@ -0,0 +1,80 @@
+// Time to first evaluation of the monolithic and split builds of the web module
+//
+//   node bench/startup.mjs [runs]
+//
+// Each run starts a fresh Node process, so module compilation is never cached across runs,
+// and times init() plus the first evaluation of a core formula and of a formula calling
+// into a side module (for the split build, including loading that module). Download time
+// is not simulated; the wasm sizes are printed alongside as its proxy.
+import { execFileSync } from 'child_process';
+import fs from 'fs';
+import path from 'path';
+import { fileURLToPath } from 'url';
+
+const root = path.resolve(path.dirname(fileURLToPath(import.meta.url)), '..');
+const modules = ['text', 'datetime', 'lookup', 'engineering', 'financial'];
+
+// Node's fetch has no file: scheme; serve the package's wasm files from disk
+function serveFiles() {
+    const nodeFetch = globalThis.fetch;
+    globalThis.fetch = async (url, init) => {
+        const href = String(url);
+        if (!href.startsWith('file:') && /^[a-z]+:/.test(href)) return nodeFetch(url, init);
+        const file = href.startsWith('file:') ? fileURLToPath(href) : path.resolve(root, href);
+        const bytes = fs.readFileSync(fs.existsSync(file) ? file : path.join(root, 'bin', path.basename(file)));
+        return new Response(bytes, { headers: { 'Content-Type': 'application/wasm' } });
+    };
+}
+
+async function measure(lazyModules) {
+    serveFiles();
+    const start = performance.now();
+    const Formula = (await import(path.join(root, 'formula-wrapper.js'))).default;
+    if (!(await Formula.init({ simd: false, lazyModules }))) {
+        throw new Error(`${lazyModules ? 'split' : 'monolithic'} build did not load`);
+    }
+    const engine = new Formula.FormulaEngine();
+    engine.evaluate('SUM(1, 2, 3)');
+    const core = performance.now();
+    await Formula.loadFunctions('UPPER("velox")');
+    engine.evaluate('UPPER("velox")');
+    const text = performance.now();
+    return { init: core - start, text: text - start };
+}
+
+function size(file) {
+    const full = path.join(root, 'bin', file);
+    return fs.existsSync(full) ? fs.statSync(full).size : 0;
+}
+
+function median(values) {
+    const sorted = [...values].sort((a, b) => a - b);
+    return sorted[Math.floor(sorted.length / 2)];
+}
+
+if (process.argv[2] === '--child') {
+    process.stdout.write(JSON.stringify(await measure(process.argv[3] === 'split')));
+} else {
+    const runs = Number(process.argv[2]) || 10;
+    const sideModules = modules.reduce((total, name) => total + size(`formulas-${name}.wasm`), 0);
+    const configurations = [
+        { name: 'monolithic', arg: 'full', wasm: size('formulas.wasm') },
+        { name: 'split', arg: 'split', wasm: size('formulas-split.wasm') }
+    ];
+    for (const configuration of configurations) {
+        if (!configuration.wasm) {
+            console.log(`${configuration.name}: not built`);
+            continue;
+        }
+        const samples = [];
+        for (let i = 0; i < runs; ++i) {
+            const output = execFileSync(process.execPath,
+                [fileURLToPath(import.meta.url), '--child', configuration.arg]);
+            samples.push(JSON.parse(output));
+        }
+        const extra = configuration.arg === 'split' ? ` (+${(sideModules / 1024).toFixed(0)} KiB side modules)` : '';
+        console.log(`${configuration.name}: ${(configuration.wasm / 1024).toFixed(0)} KiB wasm${extra}`);
+        console.log(`  init + first SUM:   ${median(samples.map((s) => s.init)).toFixed(1)} ms`);
+        console.log(`  init + first UPPER: ${median(samples.map((s) => s.text)).toFixed(1)} ms`);
+    }
+}
@@ -5,16 +5,57 @@
 
 let FormulaModule = null;
 
+// Smallest module using a simd128 instruction (i8x16.splat), valid only where SIMD is supported
+const SIMD_PROBE = new Uint8Array([
+    0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0,
+    10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11
+]);
+
+/**
+ * Check whether the WebAssembly engine supports fixed-width SIMD (simd128)
+ * @returns {boolean}
+ */
+function supportsSimd() {
+    try {
+        return typeof WebAssembly === 'object' && WebAssembly.validate(SIMD_PROBE);
+    } catch {
+        return false;
+    }
+}
+
 /**
  * Initialize the Velox Formulas library
+ *
+ * Where the engine supports SIMD the simd128 build of the module is loaded, falling back
+ * to the baseline build if it is unavailable. With lazyModules: true the split build
+ * is loaded instead: a smaller core with math and logical functions, whose text, date,
+ * lookup, engineering and financial functions are fetched by loadFunctions().
+ * @param {{simd?: boolean|'auto', lazyModules?: boolean}} [options] -
+ *   simd: true requires the SIMD build, false loads the baseline build, 'auto' (default)
+ *   picks by feature detection; lazyModules: load the split build (default false)
  * @returns {Promise<boolean>} Promise that resolves when the library is ready
  */
-async function initFormula() {
+async function initFormula(options = {}) {
     if (FormulaModule) {
         return true;
     }
 
+    const simd = options.simd === undefined ? 'auto' : options.simd;
     try {
+        if (options.lazyModules) {
+            const Formula = (await import('./bin/formulas-split.js')).default;
+            FormulaModule = await Formula();
+            return true;
+        }
+        if (simd === true || (simd === 'auto' && supportsSimd())) {
+            try {
+                const Formula = (await import('./bin/formulas-simd.js')).default;
+                FormulaModule = await Formula();
+                return true;
+            } catch (error) {
+                if (simd === true) throw error;
+            }
+        }
         const Formula = (await import('./bin/formulas.js')).default;
         FormulaModule = await Formula();
         return true;
@@ -24,6 +65,42 @@ async function initFormula() {
     }
 }
 
+// Side modules being loaded or loaded, by name
+const functionModules = new Map();
+
+/**
+ * Load the function modules a formula needs (split build only)
+ *
+ * Resolves at once when every function the formula calls is already available, which is
+ * always the case outside the split build. Functions of a module that is not loaded
+ * evaluate to #NAME?, so await this before evaluating a formula that may use them.
+ * @param {string} formula - Formula whose functions to load
+ * @returns {Promise<string[]>} Names of the modules loaded by this call
+ */
+async function loadFunctions(formula) {
+    if (!isInitialized()) throw new Error('Velox Formulas not initialized');
+    // Modules built before the split have every function linked in and no binding
+    if (typeof FormulaModule.getMissingModules !== 'function') {
+        return [];
+    }
+    const missing = FormulaModule.getMissingModules(formula);
+    await Promise.all(missing.map((name) => {
+        if (!functionModules.has(name)) {
+            const url = new URL(`./bin/formulas-${name}.wasm`, import.meta.url).href;
+            functionModules.set(name, FormulaModule.loadDynamicLibrary(url, {
+                loadAsync: true,
+                global: true,
+                nodelete: true
+            }).catch((error) => {
+                functionModules.delete(name);
+                throw error;
+            }));
+        }
+        return functionModules.get(name);
+    }));
+    return missing;
+}
+
 /**
  * Check if the library is initialized
  * @returns {boolean} True if the library is ready to use
@@ -112,6 +189,34 @@ class EvaluationResult {
     getErrors() { return this._result.getErrors(); }
 }
 
+/**
+ * Formula parsed once for repeated evaluation with FormulaEngine.evaluateColumns
+ */
+class PreparedFormula {
+    constructor(jsPrepared) {
+        this._prepared = jsPrepared;
+    }
+
+    isSuccess() { return this._prepared.isSuccess(); }
+    getFormula() { return this._prepared.getFormula(); }
+    getVariables() { return this._prepared.analyze().variables; }
+
+    // Release the WASM-side handle
+    delete() { this._prepared.delete(); }
+}
+
+// Offsets of the columns from allocColumn, which a detached view no longer reports
+const allocatedColumns = new WeakMap();
+
+/**
+ * Offset of a Float64Array view on WASM memory, or null when the array must be copied
+ */
+function heapColumn(array) {
+    return array instanceof Float64Array && array.buffer === FormulaModule.HEAPF64.buffer
+        ? array.byteOffset
+        : null;
+}
+
 /**
  * Wrapper for FormulaEngine class
  */
@@ -182,6 +287,76 @@ class FormulaEngine {
         return new EvaluationResult(this._engine.evaluate(f));
     }
 
+    // Parse a formula once for evaluateColumns
+    prepare(formula) {
+        return new PreparedFormula(this._engine.prepare(normalizeFormula(formula)));
+    }
+
+    /**
+     * Evaluate a prepared formula once per row of Float64Array columns, in one WASM call
+     *
+     * Columns that are already views on WASM memory (see allocColumn) are used in place;
+     * other arrays are copied in for the call. Non-numeric results are written as NaN;
+     * dates as serial numbers and booleans as 1/0.
+     * @param {PreparedFormula} prepared - Formula from prepare()
+     * @param {Record<string, Float64Array|number[]>} columns - Values of each variable, by row
+     * @param {Float64Array} [out] - Receives the results; allocated when omitted
+     * @returns {{values: Float64Array, nonNumeric: number}}
+     */
+    evaluateColumns(prepared, columns, out) {
+        const names = Object.keys(columns);
+        const rows = names.length > 0 ? columns[names[0]].length : (out ? out.length : 0);
+        for (const name of names) {
+            if (columns[name].length !== rows) {
+                throw new Error(`Column '${name}' has ${columns[name].length} rows, expected ${rows}`);
+            }
+        }
+        if (out && out.length < rows) {
+            throw new Error(`Output has ${out.length} rows, expected ${rows}`);
+        }
+        const values = out || new Float64Array(rows);
+        const bytes = rows * Float64Array.BYTES_PER_ELEMENT;
+
+        // Read the offsets of columns already in WASM memory before anything is allocated:
+        // malloc may grow memory, which detaches their views and zeroes their byteOffset
+        const inHeap = names.map((name) => heapColumn(columns[name]));
+        const outInHeap = heapColumn(values);
+        const temporaries = [];
+        try {
+            const offsets = names.map((name, i) => {
+                if (inHeap[i] !== null) return inHeap[i];
+                const copy = FormulaModule._malloc(bytes);
+                temporaries.push(copy);
+                return copy;
+            });
+            let outOffset = outInHeap;
+            if (outOffset === null) {
+                outOffset = FormulaModule._malloc(bytes);
+                temporaries.push(outOffset);
+            }
+            // Copy through a view of the memory as it is after the last allocation
+            const heap = FormulaModule.HEAPF64;
+            names.forEach((name, i) => {
+                if (inHeap[i] === null) {
+                    heap.set(columns[name], offsets[i] / Float64Array.BYTES_PER_ELEMENT);
+                }
+            });
+
+            const nonNumeric = this._engine.evaluateColumns(
+                prepared._prepared, names, offsets, rows, outOffset, 1 /* threads */);
+            // Evaluation may grow memory too, so results are read through a fresh view
+            const results = new Float64Array(FormulaModule.HEAPF64.buffer, outOffset, rows);
+            if (outInHeap === null) {
+                values.set(results);
+                return { values, nonNumeric };
+            }
+            // A caller's column in WASM memory is returned as is unless growth detached it
+            return { values: values.buffer === results.buffer ? values : results, nonNumeric };
+        } finally {
+            temporaries.forEach((offset) => FormulaModule._free(offset));
+        }
+    }
+
     // Tooling-only: evaluate with trace for visualization
     evaluateWithTrace(formula) {
         try {
@@ -215,31 +390,83 @@ function evaluate(formula) {
     return new EvaluationResult(FormulaModule.evaluate(normalizeFormula(formula)));
 }
 
+/**
+ * Allocate a Float64Array column in WASM memory, usable by evaluateColumns without copying
+ *
+ * The view is detached when WASM memory grows; call allocColumn again or re-create the view
+ * from FormulaModule memory after evaluations that may allocate. Release with freeColumn.
+ * @param {number} rows - Number of values
+ * @returns {Float64Array}
+ */
+function allocColumn(rows) {
+    if (!isInitialized()) throw new Error('Velox Formulas not initialized');
+    const offset = FormulaModule._malloc(rows * Float64Array.BYTES_PER_ELEMENT);
+    const column = new Float64Array(FormulaModule.HEAPF64.buffer, offset, rows);
+    allocatedColumns.set(column, offset);
+    return column;
+}
+
+/**
+ * Release a column from allocColumn, even if memory growth has since detached it
+ * @param {Float64Array} column
+ */
+function freeColumn(column) {
+    if (!isInitialized()) throw new Error('Velox Formulas not initialized');
+    const offset = allocatedColumns.get(column);
+    if (offset === undefined) throw new Error('Column was not allocated by allocColumn');
+    allocatedColumns.delete(column);
+    FormulaModule._free(offset);
+}
+
 function getVersion() {
     if (!isInitialized()) throw new Error('Velox Formulas not initialized');
     return FormulaModule.getVersion();
 }
 
+/**
+ * Instruction set of the loaded module's numeric kernels
+ * @returns {string} "simd128" for the SIMD build, "scalar" for the baseline build
+ */
+function getSimdTarget() {
+    if (!isInitialized()) throw new Error('Velox Formulas not initialized');
+    // Modules built before the SIMD variant existed have no binding and are scalar
+    return typeof FormulaModule.getSimdTarget === 'function'
+        ? FormulaModule.getSimdTarget()
+        : 'scalar';
+}
+
 // Export named exports
 export {
     initFormula as init,
     isInitialized,
+    supportsSimd,
     Value,
     EvaluationResult,
+    PreparedFormula,
     FormulaEngine,
     evaluate,
-    getVersion
+    allocColumn,
+    freeColumn,
+    getVersion,
+    getSimdTarget,
+    loadFunctions
 };
 
 // Create default export object
 const Formula = {
     init: initFormula,
     isInitialized,
+    supportsSimd,
     Value,
     EvaluationResult,
+    PreparedFormula,
     FormulaEngine,
     evaluate,
-    getVersion
+    allocColumn,
+    freeColumn,
+    getVersion,
+    getSimdTarget,
+    loadFunctions
 };
 
 // Support CommonJS
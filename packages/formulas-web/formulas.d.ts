@@ -49,6 +49,22 @@ export interface EvaluateWithTraceReturn {
     trace: TraceNode | null;
 }
 
+export interface PreparedFormula {
+    isSuccess(): boolean;
+    getFormula(): string;
+    /** Referenced variable names, in first-use order */
+    getVariables(): string[];
+    /** Release the WASM-side handle */
+    delete(): void;
+}
+
+export interface ColumnResults {
+    /** One result per row; NaN where the result is not a number, date or boolean */
+    values: Float64Array;
+    /** Number of rows written as NaN */
+    nonNumeric: number;
+}
+
 export interface FormulaEngine {
     // Variable management
     setVariable(name: string, value: Value | number | string | boolean): FormulaEngine;
@@ -64,6 +80,13 @@ export interface FormulaEngine {
     // Formula evaluation (supports both '=FORMULA' and 'FORMULA' input)
     evaluate(formula: string, variables?: Record<string, number | string | boolean | Value>): EvaluationResult;
 
+    // Parse once for column evaluation
+    prepare(formula: string): PreparedFormula;
+
+    // Evaluate once per row of equally long columns in a single WASM call
+    evaluateColumns(prepared: PreparedFormula, columns: Record<string, Float64Array | number[]>,
+                    out?: Float64Array): ColumnResults;
+
     // Tooling-only evaluation with trace tree for visualization
     evaluateWithTrace(formula: string): EvaluateWithTraceReturn;
 }
@@ -72,18 +95,36 @@ export interface FormulaEngineConstructor {
     new(): FormulaEngine;
 }
 
+export interface InitOptions {
+    /** true requires the simd128 build, false loads the baseline one, 'auto' (default) detects */
+    simd?: boolean | 'auto';
+    /** Load the split build; functions outside math and logical come from loadFunctions() */
+    lazyModules?: boolean;
+}
+
 export interface FormulaAPI {
-    init(): Promise<boolean>;
+    init(options?: InitOptions): Promise<boolean>;
     isInitialized(): boolean;
+    /** True when the WebAssembly engine supports simd128 */
+    supportsSimd(): boolean;
     
     Value: ValueConstructor;
     EvaluationResult: any; // Constructor not typically used directly
+    PreparedFormula: any; // Obtained from FormulaEngine.prepare
     FormulaEngine: FormulaEngineConstructor;
     
     // Quick evaluation function (supports both '=FORMULA' and 'FORMULA' input)
     evaluate(formula: string): EvaluationResult;
-    
+
+    // Float64Array columns in WASM memory, used by evaluateColumns without copying
+    allocColumn(rows: number): Float64Array;
+    freeColumn(column: Float64Array): void;
+
     getVersion(): string;
+    /** Instruction set of the loaded module's kernels: "simd128" or "scalar" */
+    getSimdTarget(): string;
+    /** Load the side modules a formula's functions live in; resolves to the names loaded */
+    loadFunctions(formula: string): Promise<string[]>;
 }
 
 declare const Formula: FormulaAPI;
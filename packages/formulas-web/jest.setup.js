@@ -20,7 +20,8 @@ if (typeof performance === 'undefined') {
 global.fetch = global.fetch || ((url) => {
   // If it's requesting the WASM file, load it from filesystem
   if (url.includes('formulas.wasm') || url.endsWith('.wasm')) {
-    const wasmPath = path.resolve(process.cwd(), 'formulas.wasm');
+    // formulas.wasm or formulas-simd.wasm, depending on the variant being tested
+    const wasmPath = path.resolve(process.cwd(), path.basename(String(url).split('?')[0]));
     
     try {
       if (fs.existsSync(wasmPath)) {
@@ -85,7 +86,10 @@ const initializeWasm = async () => {
     console.log('📦 Wrapper module loaded, initializing WASM...');
     
     // Initialize the WASM module with proper async handling
-    const initResult = await globalXLFormulaModule.init();
+    // VELOX_FORMULAS_SIMD=1 runs the suite against the simd128 build
+    const initResult = await globalXLFormulaModule.init({
+      simd: process.env.VELOX_FORMULAS_SIMD === '1',
+    });
     console.log('🔄 Global init result:', initResult);
     
     // Give it a moment to fully initialize
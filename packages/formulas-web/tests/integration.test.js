@@ -39,6 +39,12 @@ describe('XL Formula Integration Tests', () => {
       expect(typeof engine.evaluate).toBe('function');
     });
 
+    test('loads the requested build variant', () => {
+      const expected = process.env.VELOX_FORMULAS_SIMD === '1' ? 'simd128' : 'scalar';
+      expect(XLFormulaModule.getSimdTarget()).toBe(expected);
+      expect(typeof XLFormulaModule.supportsSimd()).toBe('boolean');
+    });
+
     test('evaluate with per-call variables', () => {
       const result = engine.evaluate('X + Y + 1', { X: 10, Y: 5 });
       expect(result.isSuccess()).toBe(true);
@@ -46,6 +52,60 @@ describe('XL Formula Integration Tests', () => {
       expect(value.isNumber()).toBe(true);
       expect(value.asNumber()).toBe(16);
     });
+
+    test('evaluateColumns fills an output column in one call', () => {
+      const prepared = engine.prepare('=IF(qty > 0, price * qty, "none")');
+      expect(prepared.isSuccess()).toBe(true);
+      try {
+        const { values, nonNumeric } = engine.evaluateColumns(prepared, {
+          price: new Float64Array([2, 3.5, 4]),
+          qty: [5, 2, 0],
+        });
+        expect(nonNumeric).toBe(1);
+        expect(Array.from(values.subarray(0, 2))).toEqual([10, 7]);
+        expect(Number.isNaN(values[2])).toBe(true);
+        expect(engine.hasVariable('price')).toBe(false);
+      } finally {
+        prepared.delete();
+      }
+    });
+
+    test('evaluateColumns uses columns allocated in WASM memory in place', () => {
+      const prepared = engine.prepare('x * 2 + 1');
+      const x = XLFormulaModule.allocColumn(4);
+      const out = XLFormulaModule.allocColumn(4);
+      try {
+        x.set([0, 1, 2.5, -3]);
+        const { values, nonNumeric } = engine.evaluateColumns(prepared, { x }, out);
+        expect(values).toBe(out);
+        expect(nonNumeric).toBe(0);
+        expect(Array.from(out)).toEqual([1, 3, 6, -5]);
+      } finally {
+        XLFormulaModule.freeColumn(x);
+        XLFormulaModule.freeColumn(out);
+        prepared.delete();
+      }
+    });
+
+    test('evaluateColumns reads columns in WASM memory after copies grow it', () => {
+      // Three 800k-row columns outgrow the 16 MB initial memory, detaching the view of x
+      const rows = 800000;
+      const prepared = engine.prepare('x + y');
+      const x = XLFormulaModule.allocColumn(rows);
+      try {
+        x.fill(2);
+        const { values, nonNumeric } = engine.evaluateColumns(prepared, {
+          y: new Float64Array(rows).fill(1),
+          x,
+        });
+        expect(nonNumeric).toBe(0);
+        expect(values[0]).toBe(3);
+        expect(values[rows - 1]).toBe(3);
+      } finally {
+        XLFormulaModule.freeColumn(x);
+        prepared.delete();
+      }
+    });
   });
 
   describe('Math Functions', () => {
@@ -0,0 +1,137 @@
+/* Exercises the C interface (c_api.h) from plain C, as an FFI binding would */
+#include <velox/formulas/c_api.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                          \
+    do {                                                                          \
+        if (!(condition)) {                                                       \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++failures;                                                           \
+        }                                                                         \
+    } while (0)
+
+static void testVersion(void) {
+    CHECK(velox_api_version() == VELOX_C_API_VERSION);
+}
+
+static void testVariablesAndScalarEvaluation(void) {
+    velox_engine* engine = velox_engine_create();
+    CHECK(engine != NULL);
+
+    CHECK(velox_engine_set_number(engine, "rate", 0.25) == VELOX_OK);
+    CHECK(velox_engine_set_text(engine, "label", "total") == VELOX_OK);
+    CHECK(velox_engine_set_boolean(engine, "flag", 1) == VELOX_OK);
+    CHECK(velox_engine_set_number(NULL, "rate", 1.0) == VELOX_INVALID_ARGUMENT);
+
+    const char* names[] = {"rate", "label", "flag", "missing"};
+    double values[4];
+    velox_status codes[4];
+    CHECK(velox_engine_get_numbers(engine, names, 4, values, codes) == 2);
+    CHECK(values[0] == 0.25 && codes[0] == VELOX_OK);
+    CHECK(isnan(values[1]) && codes[1] == VELOX_NOT_NUMBER);
+    CHECK(values[2] == 1.0 && codes[2] == VELOX_OK);
+    CHECK(isnan(values[3]) && codes[3] == VELOX_NOT_NUMBER);
+
+    velox_prepared* prepared = velox_prepare(engine, "rate * 4 + IF(flag, 1, 0)");
+    CHECK(prepared != NULL);
+    CHECK(velox_prepared_status(prepared) == VELOX_OK);
+    CHECK(velox_prepared_variable_count(prepared) == 2);
+    CHECK(strcmp(velox_prepared_variable_name(prepared, 0), "rate") == 0);
+    CHECK(velox_prepared_variable_name(prepared, 2) == NULL);
+
+    double result = 0.0;
+    CHECK(velox_evaluate(engine, prepared, &result) == VELOX_OK);
+    CHECK(result == 2.0);
+
+    CHECK(velox_engine_remove(engine, "rate") == VELOX_OK);
+    CHECK(velox_engine_get_numbers(engine, names, 1, values, NULL) == 1);
+
+    velox_prepared_destroy(prepared);
+    velox_engine_destroy(engine);
+}
+
+static void testColumns(void) {
+    enum { ROWS = 5000 };
+    static double price[ROWS];
+    static double quantity[ROWS];
+    static double out[ROWS];
+    static double threaded[ROWS];
+    static velox_status codes[ROWS];
+    size_t i;
+
+    for (i = 0; i < ROWS; ++i) {
+        price[i] = (double)(i % 100);
+        quantity[i] = (double)(i % 7);
+    }
+
+    velox_engine* engine = velox_engine_create();
+    CHECK(velox_engine_set_number(engine, "discount", 0.5) == VELOX_OK);
+    velox_prepared* prepared = velox_prepare(engine, "price / quantity * discount");
+
+    const char* names[] = {"price", "quantity"};
+    const double* columns[] = {price, quantity};
+    /* Every seventh row divides by zero */
+    const size_t failed =
+            velox_evaluate_columns(engine, prepared, names, columns, 2, ROWS, out, codes, 1);
+    CHECK(failed == (ROWS + 6) / 7);
+    for (i = 0; i < ROWS; ++i) {
+        if (quantity[i] == 0.0) {
+            CHECK(codes[i] == VELOX_DIV_ZERO && isnan(out[i]));
+        } else {
+            CHECK(codes[i] == VELOX_OK && out[i] == price[i] / quantity[i] * 0.5);
+        }
+    }
+
+    /* Worker threads produce the same rows; codes are optional */
+    CHECK(velox_evaluate_columns(engine, prepared, names, columns, 2, ROWS, threaded, NULL, 4) ==
+          failed);
+    for (i = 0; i < ROWS; ++i) {
+        CHECK(codes[i] != VELOX_OK || threaded[i] == out[i]);
+    }
+
+    /* Columns are bound only during the call */
+    double value = 0.0;
+    CHECK(velox_engine_get_numbers(engine, names, 1, &value, NULL) == 1);
+
+    /* Text results are not numbers */
+    velox_prepared* text = velox_prepare(engine, "IF(price > 50, \"high\", price)");
+    CHECK(velox_evaluate_columns(engine, text, names, columns, 1, ROWS, out, codes, 1) > 0);
+    CHECK(codes[99] == VELOX_NOT_NUMBER && codes[1] == VELOX_OK && out[1] == 1.0);
+    velox_prepared_destroy(text);
+
+    /* A NaN result fails the row whether or not codes are requested */
+    const double gaps[] = {1.0, NAN, 3.0};
+    const double* gap_columns[] = {gaps};
+    velox_prepared* scaled = velox_prepare(engine, "price * 2");
+    CHECK(velox_evaluate_columns(engine, scaled, names, gap_columns, 1, 3, out, codes, 1) == 1);
+    CHECK(codes[0] == VELOX_OK && codes[1] == VELOX_NOT_NUMBER && isnan(out[1]));
+    CHECK(velox_evaluate_columns(engine, scaled, names, gap_columns, 1, 3, out, NULL, 1) == 1);
+    CHECK(velox_evaluate_columns(engine, scaled, names, gap_columns, 1, 3, out, NULL, 4) == 1);
+    velox_prepared_destroy(scaled);
+
+    /* Parse errors and invalid arguments fill every row */
+    velox_prepared* broken = velox_prepare(engine, "price +");
+    CHECK(velox_prepared_status(broken) == VELOX_PARSE_ERROR);
+    CHECK(velox_evaluate_columns(engine, broken, names, columns, 2, 3, out, codes, 1) == 3);
+    CHECK(codes[0] == VELOX_PARSE_ERROR && codes[2] == VELOX_PARSE_ERROR && isnan(out[0]));
+    CHECK(velox_evaluate_columns(NULL, prepared, names, columns, 2, 3, out, codes, 1) == 3);
+    CHECK(codes[1] == VELOX_INVALID_ARGUMENT);
+    velox_prepared_destroy(broken);
+
+    velox_prepared_destroy(prepared);
+    velox_engine_destroy(engine);
+}
+
+int main(void) {
+    testVersion();
+    testVariablesAndScalarEvaluation();
+    testColumns();
+    if (failures == 0) {
+        printf("C API tests passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
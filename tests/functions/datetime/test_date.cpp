@@ -1,6 +1,4 @@
 #include <gtest/gtest.h>
-#include <chrono>
-#include <ctime>
 #include "velox/formulas/functions.h"
 
 using namespace xl_formula;
@@ -21,13 +19,11 @@ TEST_F(DateFunctionTest, ValidDate_ReturnsDate) {
 
     EXPECT_TRUE(result.isDate());
 
-    auto date_val = result.asDate();
-    auto time_t = std::chrono::system_clock::to_time_t(date_val);
-    auto local_tm = *std::localtime(&time_t);
+    auto fields = dates::splitDate(result.asDate());
 
-    EXPECT_EQ(2023, local_tm.tm_year + 1900);
-    EXPECT_EQ(12, local_tm.tm_mon + 1);
-    EXPECT_EQ(25, local_tm.tm_mday);
+    EXPECT_EQ(2023, fields.date.year);
+    EXPECT_EQ(12u, fields.date.month);
+    EXPECT_EQ(25u, fields.date.day);
 }
 
 TEST_F(DateFunctionTest, MinimumValidDate_ReturnsDate) {
@@ -35,13 +31,11 @@ TEST_F(DateFunctionTest, MinimumValidDate_ReturnsDate) {
 
     EXPECT_TRUE(result.isDate());
 
-    auto date_val = result.asDate();
-    auto time_t = std::chrono::system_clock::to_time_t(date_val);
-    auto local_tm = *std::localtime(&time_t);
+    auto fields = dates::splitDate(result.asDate());
 
-    EXPECT_EQ(1900, local_tm.tm_year + 1900);
-    EXPECT_EQ(1, local_tm.tm_mon + 1);
-    EXPECT_EQ(1, local_tm.tm_mday);
+    EXPECT_EQ(1900, fields.date.year);
+    EXPECT_EQ(1u, fields.date.month);
+    EXPECT_EQ(1u, fields.date.day);
 }
 
 TEST_F(DateFunctionTest, MaximumValidDate_ReturnsDate) {
@@ -49,13 +43,11 @@ TEST_F(DateFunctionTest, MaximumValidDate_ReturnsDate) {
 
     EXPECT_TRUE(result.isDate());
 
-    auto date_val = result.asDate();
-    auto time_t = std::chrono::system_clock::to_time_t(date_val);
-    auto local_tm = *std::localtime(&time_t);
+    auto fields = dates::splitDate(result.asDate());
 
-    EXPECT_EQ(2099, local_tm.tm_year + 1900);
-    EXPECT_EQ(12, local_tm.tm_mon + 1);
-    EXPECT_EQ(31, local_tm.tm_mday);
+    EXPECT_EQ(2099, fields.date.year);
+    EXPECT_EQ(12u, fields.date.month);
+    EXPECT_EQ(31u, fields.date.day);
 }
 
 // Argument validation tests
@@ -174,19 +166,47 @@ TEST_F(DateFunctionTest, LeapYear_February29_ReturnsDate) {
     EXPECT_TRUE(result.isDate());
 }
 
-TEST_F(DateFunctionTest, NonLeapYear_February29_HandledBySystem) {
-    // Note: mktime will handle invalid dates by adjusting them
+TEST_F(DateFunctionTest, NonLeapYear_February29_RollsOver) {
+    // Out-of-range days roll into the next month
     auto result = callDate({Value(2023.0), Value(2.0), Value(29.0)});
 
-    // The system will likely adjust this to March 1st
-    EXPECT_TRUE(result.isDate());
+    ASSERT_TRUE(result.isDate());
+    auto fields = dates::splitDate(result.asDate());
+    EXPECT_EQ(2023, fields.date.year);
+    EXPECT_EQ(3u, fields.date.month);
+    EXPECT_EQ(1u, fields.date.day);
 }
 
 TEST_F(DateFunctionTest, Edate_And_Eomonth_Basic) {
     auto start = callDate({Value(2024.0), Value(1.0), Value(31.0)});
     ASSERT_TRUE(start.isDate());
     auto next = edate({start, Value(1.0)}, context);
-    EXPECT_TRUE(next.isDate());
+    ASSERT_TRUE(next.isDate());
     auto eom = eomonth({start, Value(1.0)}, context);
-    EXPECT_TRUE(eom.isDate());
+    ASSERT_TRUE(eom.isDate());
+
+    // Jan 31 + 1 month clamps to the end of February in a leap year
+    auto next_fields = dates::splitDate(next.asDate());
+    EXPECT_EQ(2u, next_fields.date.month);
+    EXPECT_EQ(29u, next_fields.date.day);
+    auto eom_fields = dates::splitDate(eom.asDate());
+    EXPECT_EQ(2u, eom_fields.date.month);
+    EXPECT_EQ(29u, eom_fields.date.day);
+
+    auto back = eomonth({start, Value(-13.0)}, context);
+    ASSERT_TRUE(back.isDate());
+    auto back_fields = dates::splitDate(back.asDate());
+    EXPECT_EQ(2022, back_fields.date.year);
+    EXPECT_EQ(12u, back_fields.date.month);
+    EXPECT_EQ(31u, back_fields.date.day);
+}
+
+TEST_F(DateFunctionTest, FieldsDoNotDependOnTheHostTimeZone) {
+    // Dates are floating calendar times, so splitting one never consults TZ
+    auto result = callDate({Value(2024.0), Value(3.0), Value(31.0)});
+    ASSERT_TRUE(result.isDate());
+    EXPECT_EQ("2024-03-31 00:00:00", result.toString());
+    EXPECT_EQ(2024.0, year({result}, context).asNumber());
+    EXPECT_EQ(3.0, month({result}, context).asNumber());
+    EXPECT_EQ(31.0, day({result}, context).asNumber());
 }
\ No newline at end of file
@@ -1,6 +1,4 @@
 #include <gtest/gtest.h>
-#include <chrono>
-#include <ctime>
 #include "velox/formulas/functions.h"
 
 using namespace xl_formula;
@@ -16,17 +14,8 @@ class HourFunctionTest : public ::testing::Test {
 
     // Helper function to create a date with time
     Value::DateType makeDateTime(int year, int month, int day, int hour, int min, int sec) {
-        std::tm time_info = {};
-        time_info.tm_year = year - 1900;
-        time_info.tm_mon = month - 1;
-        time_info.tm_mday = day;
-        time_info.tm_hour = hour;
-        time_info.tm_min = min;
-        time_info.tm_sec = sec;
-        time_info.tm_isdst = -1;
-
-        std::time_t time_val = std::mktime(&time_info);
-        return std::chrono::system_clock::from_time_t(time_val);
+        return dates::makeDate(dates::daysFromCivil(year, month, day),
+                               hour * 3600 + min * 60 + sec);
     }
 };
 
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <string>
 #include <thread>
 #include "velox/formulas/functions.h"
 
@@ -10,6 +13,10 @@ class NowFunctionTest : public ::testing::Test {
   protected:
     Context context;
 
+    void SetUp() override {
+        context.setTimeZonePolicy(TimeZonePolicy::UTC);
+    }
+
     Value callNow(const std::vector<Value>& args = {}) {
         return now(args, context);
     }
@@ -38,15 +45,15 @@ TEST_F(NowFunctionTest, WithMultipleArguments_ReturnsError) {
 
 // Value verification tests
 TEST_F(NowFunctionTest, ReturnsCurrentTime) {
-    auto before = std::chrono::system_clock::now();
+    auto before = dates::currentDateTime(TimeZonePolicy::UTC);
     auto result = callNow();
-    auto after = std::chrono::system_clock::now();
+    auto after = dates::currentDateTime(TimeZonePolicy::UTC);
 
     EXPECT_TRUE(result.isDate());
 
     auto result_time = result.asDate();
-    EXPECT_GE(result_time, before);
-    EXPECT_LE(result_time, after);
+    EXPECT_GE(result_time.serial, before.serial);
+    EXPECT_LE(result_time.serial, after.serial);
 }
 
 TEST_F(NowFunctionTest, ConsecutiveCalls_IncreasingTime) {
@@ -57,8 +64,46 @@ TEST_F(NowFunctionTest, ConsecutiveCalls_IncreasingTime) {
 
     EXPECT_TRUE(result1.isDate());
     EXPECT_TRUE(result2.isDate());
-    EXPECT_LE(result1.asDate(), result2.asDate());
+    EXPECT_LE(result1.asDate().serial, result2.asDate().serial);
+}
+
+#if !defined(_WIN32)
+// The host zone is pinned to a fixed offset, so LOCAL differs from UTC on any machine
+TEST_F(NowFunctionTest, LocalPolicy_MatchesLocaltime) {
+    const char* saved = std::getenv("TZ");
+    const std::string saved_tz = saved ? saved : "";
+    setenv("TZ", "XST-5:30", 1);
+    tzset();
+    context.setTimeZonePolicy(TimeZonePolicy::LOCAL);
+
+    auto localSerial = [](std::time_t instant) {
+        std::tm local{};
+        localtime_r(&instant, &local);
+        return dates::makeDate(
+                       dates::daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday),
+                       local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec)
+                .serial;
+    };
+    const std::time_t before = std::time(nullptr);
+    auto result = callNow();
+    const std::time_t after = std::time(nullptr);
+    const double utc = dates::currentDateTime(TimeZonePolicy::UTC).serial;
+    const double lowest = localSerial(before);
+    const double beyond = localSerial(after + 1);
+
+    if (saved) {
+        setenv("TZ", saved_tz.c_str(), 1);
+    } else {
+        unsetenv("TZ");
+    }
+    tzset();
+
+    ASSERT_TRUE(result.isDate());
+    EXPECT_GE(result.asDate().serial, lowest);
+    EXPECT_LT(result.asDate().serial, beyond);
+    EXPECT_NEAR(5.5 / 24.0, result.asDate().serial - utc, 2.0 / 86400.0);
 }
+#endif
 
 // Error handling tests
 TEST_F(NowFunctionTest, WithErrorArgument_ReturnsError) {
@@ -1,6 +1,4 @@
 #include <gtest/gtest.h>
-#include <chrono>
-#include <ctime>
 #include "velox/formulas/functions.h"
 
 using namespace xl_formula;
@@ -10,6 +8,10 @@ class TodayFunctionTest : public ::testing::Test {
   protected:
     Context context;
 
+    void SetUp() override {
+        context.setTimeZonePolicy(TimeZonePolicy::UTC);
+    }
+
     Value callToday(const std::vector<Value>& args = {}) {
         return today(args, context);
     }
@@ -43,23 +45,16 @@ TEST_F(TodayFunctionTest, ReturnsCurrentDate) {
     EXPECT_TRUE(result.isDate());
 
     // Check that it's today's date at midnight
-    auto result_time = result.asDate();
-    auto time_t = std::chrono::system_clock::to_time_t(result_time);
-    auto local_tm = *std::localtime(&time_t);
+    auto fields = dates::splitDate(result.asDate());
 
     // Should be midnight (00:00:00)
-    EXPECT_EQ(0, local_tm.tm_hour);
-    EXPECT_EQ(0, local_tm.tm_min);
-    EXPECT_EQ(0, local_tm.tm_sec);
-
-    // Should be today's date
-    auto now = std::chrono::system_clock::now();
-    auto now_time_t = std::chrono::system_clock::to_time_t(now);
-    auto now_tm = *std::localtime(&now_time_t);
-
-    EXPECT_EQ(now_tm.tm_year, local_tm.tm_year);
-    EXPECT_EQ(now_tm.tm_mon, local_tm.tm_mon);
-    EXPECT_EQ(now_tm.tm_mday, local_tm.tm_mday);
+    EXPECT_EQ(0u, fields.hour);
+    EXPECT_EQ(0u, fields.minute);
+    EXPECT_EQ(0u, fields.second);
+
+    // Should be today's date on the UTC clock
+    auto now = dates::splitDate(dates::currentDateTime(TimeZonePolicy::UTC));
+    EXPECT_EQ(now.days, fields.days);
 }
 
 TEST_F(TodayFunctionTest, ConsistentResults_SameDay) {
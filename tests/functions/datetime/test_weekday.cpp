@@ -1,6 +1,4 @@
 #include <gtest/gtest.h>
-#include <chrono>
-#include <ctime>
 #include "velox/formulas/functions.h"
 
 using namespace xl_formula;
@@ -17,17 +15,7 @@ class WeekdayFunctionTest : public ::testing::Test {
     // Helper function to create a date for a known weekday
     // January 1, 2023 was a Sunday
     Value::DateType makeDate(int year, int month, int day) {
-        std::tm time_info = {};
-        time_info.tm_year = year - 1900;
-        time_info.tm_mon = month - 1;
-        time_info.tm_mday = day;
-        time_info.tm_hour = 0;
-        time_info.tm_min = 0;
-        time_info.tm_sec = 0;
-        time_info.tm_isdst = -1;
-
-        std::time_t time_val = std::mktime(&time_info);
-        return std::chrono::system_clock::from_time_t(time_val);
+        return dates::makeDate(dates::daysFromCivil(year, month, day));
     }
 };
 
@@ -211,17 +199,7 @@ TEST_F(WeekdayFunctionTest, LeapYearDate_ReturnsCorrectWeekday) {
 
 TEST_F(WeekdayFunctionTest, DateWithTime_IgnoresTime) {
     // Create date with time components
-    std::tm time_info = {};
-    time_info.tm_year = 2023 - 1900;
-    time_info.tm_mon = 1 - 1;  // January
-    time_info.tm_mday = 1;
-    time_info.tm_hour = 14;  // 2 PM
-    time_info.tm_min = 30;
-    time_info.tm_sec = 45;
-    time_info.tm_isdst = -1;
-
-    std::time_t time_val = std::mktime(&time_info);
-    auto date_val = std::chrono::system_clock::from_time_t(time_val);
+    auto date_val = dates::makeDate(dates::daysFromCivil(2023, 1, 1), 14 * 3600 + 30 * 60 + 45);
 
     auto result = callWeekday({Value(date_val)});
 
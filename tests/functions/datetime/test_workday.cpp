@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "velox/formulas/business_calendar.h"
+#include "velox/formulas/xl-formula.h"
+
+using namespace xl_formula;
+
+class WorkdayFunctionTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        engine = std::make_unique<FormulaEngine>();
+    }
+
+    Value eval(const std::string& formula) {
+        return engine->evaluate(formula).getValue();
+    }
+
+    std::string evalDate(const std::string& formula) {
+        Value result = eval(formula);
+        EXPECT_TRUE(result.isDate()) << formula;
+        return result.isDate() ? result.toString().substr(0, 10) : "";
+    }
+
+    std::unique_ptr<FormulaEngine> engine;
+};
+
+TEST_F(WorkdayFunctionTest, WorkdaySkipsWeekends) {
+    EXPECT_EQ("2024-01-08", evalDate("WORKDAY(DATE(2024,1,5), 1)"));
+    EXPECT_EQ("2024-01-15", evalDate("WORKDAY(DATE(2024,1,1), 10)"));
+    EXPECT_EQ("2024-01-05", evalDate("WORKDAY(DATE(2024,1,8), -1)"));
+    EXPECT_EQ("2024-01-08", evalDate("WORKDAY(DATE(2024,1,6), 1)"));
+    EXPECT_EQ("2024-01-05", evalDate("WORKDAY(DATE(2024,1,6), -1)"));
+    EXPECT_EQ("2024-01-06", evalDate("WORKDAY(DATE(2024,1,6), 0)"));
+    EXPECT_EQ("2024-01-08", evalDate("WORKDAY(45296, 1.9)"));
+}
+
+TEST_F(WorkdayFunctionTest, WorkdaySkipsHolidays) {
+    EXPECT_EQ("2024-01-16", evalDate("WORKDAY(DATE(2024,1,12), 1, DATE(2024,1,15))"));
+    EXPECT_EQ("2024-01-12", evalDate("WORKDAY(DATE(2024,1,16), -1, DATE(2024,1,15))"));
+    EXPECT_EQ("2025-01-02",
+              evalDate("WORKDAY(DATE(2024,12,24), 4, {45651, 45652, 45658, 45658})"));
+}
+
+TEST_F(WorkdayFunctionTest, WorkdayIntlUsesCustomWeekends) {
+    EXPECT_EQ("2024-01-07", evalDate("WORKDAY.INTL(DATE(2024,1,4), 1, 7)"));
+    EXPECT_EQ("2024-01-08", evalDate("WORKDAY.INTL(DATE(2024,1,5), 1, \"0000011\")"));
+    EXPECT_EQ("2024-01-06", evalDate("WORKDAY.INTL(DATE(2024,1,5), 1, 11)"));
+    EXPECT_EQ("2024-01-09",
+              evalDate("WORKDAY.INTL(DATE(2024,1,5), 2, 11, DATE(2024,1,8))"));
+}
+
+TEST_F(WorkdayFunctionTest, NetworkdaysCountsBothEnds) {
+    EXPECT_DOUBLE_EQ(23.0, eval("NETWORKDAYS(DATE(2024,1,1), DATE(2024,1,31))").asNumber());
+    EXPECT_DOUBLE_EQ(262.0, eval("NETWORKDAYS(DATE(2024,1,1), DATE(2024,12,31))").asNumber());
+    EXPECT_DOUBLE_EQ(-262.0, eval("NETWORKDAYS(DATE(2024,12,31), DATE(2024,1,1))").asNumber());
+    EXPECT_DOUBLE_EQ(0.0, eval("NETWORKDAYS(DATE(2024,1,6), DATE(2024,1,7))").asNumber());
+    EXPECT_DOUBLE_EQ(1.0, eval("NETWORKDAYS(DATE(2024,1,8), DATE(2024,1,8))").asNumber());
+}
+
+TEST_F(WorkdayFunctionTest, NetworkdaysSkipsHolidaysOnWorkingDaysOnce) {
+    // Jan 6 is a Saturday and Jan 1 is listed twice
+    EXPECT_DOUBLE_EQ(21.0, eval("NETWORKDAYS(DATE(2024,1,1), DATE(2024,1,31), "
+                                "{45292, 45306, 45297, 45292})")
+                                   .asNumber());
+    EXPECT_DOUBLE_EQ(27.0, eval("NETWORKDAYS.INTL(DATE(2024,1,1), DATE(2024,1,31), 11)")
+                                   .asNumber());
+    EXPECT_DOUBLE_EQ(26.0, eval("NETWORKDAYS.INTL(DATE(2024,1,1), DATE(2024,1,31), "
+                                "\"0000001\", DATE(2024,1,1))")
+                                   .asNumber());
+}
+
+TEST_F(WorkdayFunctionTest, InvalidArguments) {
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("WORKDAY(DATE(2024,1,1))").asError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("WORKDAY(\"x\", 1)").asError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR,
+              eval("NETWORKDAYS(DATE(2024,1,1), DATE(2024,2,1), \"x\")").asError());
+    EXPECT_EQ(ErrorType::NUM_ERROR, eval("WORKDAY(-1, 1)").asError());
+    EXPECT_EQ(ErrorType::NUM_ERROR, eval("WORKDAY(1, -5)").asError());
+    EXPECT_EQ(ErrorType::NUM_ERROR, eval("WORKDAY.INTL(DATE(2024,1,1), 1, 8)").asError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR,
+              eval("WORKDAY.INTL(DATE(2024,1,1), 1, \"1111111\")").asError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR,
+              eval("NETWORKDAYS.INTL(DATE(2024,1,1), DATE(2024,2,1), \"00000\")").asError());
+
+    engine->setVariable("bad", Value::array({Value(1.0), Value::error(ErrorType::DIV_ZERO)}));
+    EXPECT_EQ(ErrorType::DIV_ZERO,
+              eval("NETWORKDAYS(DATE(2024,1,1), DATE(2024,2,1), bad)").asError());
+}
+
+TEST_F(WorkdayFunctionTest, HolidayTablesShareACachedCalendar) {
+    std::vector<Value> holidays;
+    for (int year = 2000; year < 2050; ++year) {
+        holidays.push_back(Value(dates::makeDate(dates::CivilDate{year, 12, 25})));
+        holidays.push_back(Value(dates::makeDate(dates::CivilDate{year, 1, 1})));
+    }
+    engine->setVariable("holidays", Value::array(holidays));
+
+    // 2024: Jan 1 is a Monday and Dec 25 a Wednesday
+    EXPECT_DOUBLE_EQ(260.0,
+                     eval("NETWORKDAYS(DATE(2024,1,1), DATE(2024,12,31), holidays)").asNumber());
+    EXPECT_EQ("2024-12-26", evalDate("WORKDAY(DATE(2024,12,24), 1, holidays)"));
+    EXPECT_EQ(1u, engine->getContext().getCalendarCache().size());
+
+    eval("NETWORKDAYS.INTL(DATE(2024,1,1), DATE(2024,12,31), 11, holidays)");
+    EXPECT_EQ(2u, engine->getContext().getCalendarCache().size());
+}
@@ -1,6 +1,4 @@
 #include <gtest/gtest.h>
-#include <chrono>
-#include <ctime>
 #include "velox/formulas/functions.h"
 
 using namespace xl_formula;
@@ -16,17 +14,7 @@ class YearFunctionTest : public ::testing::Test {
 
     // Helper function to create a date
     Value::DateType makeDate(int year, int month, int day) {
-        std::tm time_info = {};
-        time_info.tm_year = year - 1900;
-        time_info.tm_mon = month - 1;
-        time_info.tm_mday = day;
-        time_info.tm_hour = 0;
-        time_info.tm_min = 0;
-        time_info.tm_sec = 0;
-        time_info.tm_isdst = -1;
-
-        std::time_t time_val = std::mktime(&time_info);
-        return std::chrono::system_clock::from_time_t(time_val);
+        return dates::makeDate(dates::daysFromCivil(year, month, day));
     }
 };
 
@@ -128,17 +116,7 @@ TEST_F(YearFunctionTest, NewYearsEve_ReturnsCorrectYear) {
 
 TEST_F(YearFunctionTest, DateWithTime_ReturnsCorrectYear) {
     // Create a date with specific time components
-    std::tm time_info = {};
-    time_info.tm_year = 2023 - 1900;
-    time_info.tm_mon = 6 - 1;  // June
-    time_info.tm_mday = 15;
-    time_info.tm_hour = 14;  // 2 PM
-    time_info.tm_min = 30;
-    time_info.tm_sec = 45;
-    time_info.tm_isdst = -1;
-
-    std::time_t time_val = std::mktime(&time_info);
-    auto date_val = std::chrono::system_clock::from_time_t(time_val);
+    auto date_val = dates::makeDate(dates::daysFromCivil(2023, 6, 15), 14 * 3600 + 30 * 60 + 45);
 
     auto result = callYear({Value(date_val)});
 
@@ -65,4 +65,16 @@ TEST_F(IrrFunctionTest, ErrorPropagation) {
     auto result = callIrr({Value::error(ErrorType::VALUE_ERROR), Value(500.0), Value(400.0)});
     EXPECT_TRUE(result.isError());
     EXPECT_EQ(ErrorType::VALUE_ERROR, result.asError());
-}
\ No newline at end of file
+}
+
+TEST_F(IrrFunctionTest, DistantGuessAndHighRates) {
+    // Newton from far away still reaches the root near the data
+    auto result = callIrr({Value::numberArray({-1000.0, 300.0, 400.0, 500.0}), Value(50.0)});
+    ASSERT_TRUE(result.isNumber());
+    EXPECT_NEAR(0.0889634, result.asNumber(), 1e-6);
+
+    // Rates above 1000% are found too
+    result = callIrr({Value::numberArray({-1.0, 20.0})});
+    ASSERT_TRUE(result.isNumber());
+    EXPECT_NEAR(19.0, result.asNumber(), 1e-9);
+}
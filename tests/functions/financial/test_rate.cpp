@@ -74,4 +74,11 @@ TEST_F(RateFunctionTest, ErrorPropagation) {
     auto result = callRate({Value::error(ErrorType::VALUE_ERROR), Value(-1000.0), Value(7721.73)});
     EXPECT_TRUE(result.isError());
     EXPECT_EQ(ErrorType::VALUE_ERROR, result.asError());
-}
\ No newline at end of file
+}
+
+TEST_F(RateFunctionTest, PaymentsAtPeriodStart) {
+    auto result = callRate({Value(48.0), Value(-200.0), Value(8000.0), Value(0.0), Value(1.0)});
+
+    ASSERT_TRUE(result.isNumber());
+    EXPECT_NEAR(0.00805298, result.asNumber(), 1e-8);
+}
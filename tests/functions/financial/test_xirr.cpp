@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "velox/formulas/functions.h"
+#include "velox/formulas/types.h"
+
+using namespace xl_formula;
+using namespace xl_formula::functions::builtin;
+
+class XirrFunctionTest : public ::testing::Test {
+  protected:
+    Context context;
+
+    Value callXirr(const std::vector<Value>& args) {
+        return xirr(args, context);
+    }
+
+    static Value flows() {
+        return Value::numberArray({-10000.0, 2750.0, 4250.0, 3250.0, 2750.0});
+    }
+
+    static Value days() {
+        // 2008-01-01, 2008-03-01, 2008-10-30, 2009-02-15, 2009-04-01
+        return Value::numberArray({39448.0, 39508.0, 39751.0, 39859.0, 39904.0});
+    }
+};
+
+TEST_F(XirrFunctionTest, BasicXirrCalculation) {
+    auto result = callXirr({flows(), days()});
+
+    ASSERT_TRUE(result.isNumber());
+    EXPECT_NEAR(0.373362535, result.asNumber(), 1e-8);
+}
+
+TEST_F(XirrFunctionTest, GuessAndFractionalDays) {
+    // Day numbers are truncated, so fractions of a day change nothing
+    auto result = callXirr({flows(),
+                            Value::numberArray({39448.5, 39508.2, 39751.9, 39859.0, 39904.7}),
+                            Value(2.0)});
+
+    ASSERT_TRUE(result.isNumber());
+    EXPECT_NEAR(0.373362535, result.asNumber(), 1e-8);
+}
+
+TEST_F(XirrFunctionTest, EngineEvaluation) {
+    FormulaEngine engine;
+    auto result = engine.evaluate("XIRR({-1000, 1100}, {0, 365})");
+
+    ASSERT_TRUE(result.getValue().isNumber());
+    EXPECT_NEAR(0.1, result.getValue().asNumber(), 1e-10);
+}
+
+TEST_F(XirrFunctionTest, InvalidData) {
+    // Mismatched lengths
+    auto result = callXirr({flows(), Value::numberArray({39448.0, 39508.0})});
+    EXPECT_EQ(ErrorType::NUM_ERROR, result.asError());
+
+    // A date before the first one
+    result = callXirr({Value::numberArray({-100.0, 110.0}), Value::numberArray({39448.0, 39000.0})});
+    EXPECT_EQ(ErrorType::NUM_ERROR, result.asError());
+
+    // No sign change
+    result = callXirr({Value::numberArray({100.0, 110.0}), Value::numberArray({0.0, 365.0})});
+    EXPECT_EQ(ErrorType::NUM_ERROR, result.asError());
+
+    // Non-numeric cash flow
+    result = callXirr({Value::array({Value(-100.0), Value("x")}), Value::numberArray({0.0, 1.0})});
+    EXPECT_EQ(ErrorType::VALUE_ERROR, result.asError());
+
+    // Too few arguments
+    result = callXirr({flows()});
+    EXPECT_EQ(ErrorType::VALUE_ERROR, result.asError());
+
+    result = callXirr({flows(), Value::error(ErrorType::NA_ERROR)});
+    EXPECT_EQ(ErrorType::NA_ERROR, result.asError());
+}
@@ -14,15 +14,7 @@ class IfsFunctionTest : public ::testing::Test {
 
     // Helper function to create a date
     Value::DateType makeDate(int year, int month, int day) {
-        std::tm time_info = {};
-        time_info.tm_year = year - 1900;
-        time_info.tm_mon = month - 1;
-        time_info.tm_mday = day;
-        time_info.tm_hour = 0;
-        time_info.tm_min = 0;
-        time_info.tm_sec = 0;
-
-        return std::chrono::system_clock::from_time_t(std::mktime(&time_info));
+        return dates::makeDate(dates::daysFromCivil(year, month, day));
     }
 };
 
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "velox/formulas/lookup_index.h"
+#include "velox/formulas/xl-formula.h"
+
+using namespace xl_formula;
+
+class IndexMatchFunctionTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        engine = std::make_unique<FormulaEngine>();
+    }
+
+    Value eval(const std::string& formula) {
+        return engine->evaluate(formula).getValue();
+    }
+
+    std::unique_ptr<FormulaEngine> engine;
+};
+
+TEST_F(IndexMatchFunctionTest, IndexIntoVectorsAndTables) {
+    EXPECT_DOUBLE_EQ(20.0, eval("INDEX({10, 20, 30}, 2)").asNumber());
+    EXPECT_DOUBLE_EQ(3.0, eval("INDEX({{1, 2}, {3, 4}}, 2, 1)").asNumber());
+    EXPECT_DOUBLE_EQ(2.0, eval("INDEX({{1, 2, 3}}, 2)").asNumber());
+    EXPECT_EQ(eval("{3, 4}"), eval("INDEX({{1, 2}, {3, 4}}, 2, 0)"));
+    EXPECT_EQ(eval("{2, 4}"), eval("INDEX({{1, 2}, {3, 4}}, 0, 2)"));
+}
+
+TEST_F(IndexMatchFunctionTest, IndexOutOfRange) {
+    EXPECT_EQ(ErrorType::REF_ERROR, eval("INDEX({10, 20, 30}, 4)").asError());
+    EXPECT_EQ(ErrorType::REF_ERROR, eval("INDEX({{1, 2}, {3, 4}}, 1, 3)").asError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("INDEX({10, 20}, -1)").asError());
+}
+
+TEST_F(IndexMatchFunctionTest, MatchTypes) {
+    EXPECT_DOUBLE_EQ(2.0, eval("MATCH(25, {10, 20, 30})").asNumber());
+    EXPECT_DOUBLE_EQ(3.0, eval("MATCH(30, {10, 20, 30}, 0)").asNumber());
+    EXPECT_DOUBLE_EQ(2.0, eval("MATCH(25, {40, 30, 20}, -1)").asNumber());
+    EXPECT_DOUBLE_EQ(2.0, eval("MATCH(\"B*\", {\"apple\", \"banana\"}, 0)").asNumber());
+    EXPECT_EQ(ErrorType::NA_ERROR, eval("MATCH(5, {10, 20, 30})").asError());
+    EXPECT_EQ(ErrorType::NA_ERROR, eval("MATCH(\"x\", {\"a\", \"b\"}, 0)").asError());
+}
+
+TEST_F(IndexMatchFunctionTest, MatchDuplicatesAndTypes) {
+    // Approximate match takes the last of equal keys; exact takes the first
+    EXPECT_DOUBLE_EQ(3.0, eval("MATCH(2, {1, 2, 2, 3})").asNumber());
+    EXPECT_DOUBLE_EQ(2.0, eval("MATCH(2, {1, 2, 2, 3}, 0)").asNumber());
+    // Text never equals a number
+    EXPECT_EQ(ErrorType::NA_ERROR, eval("MATCH(\"1\", {1, 2}, 0)").asError());
+}
+
+TEST_F(IndexMatchFunctionTest, IndexedAndLinearSearchesAgree) {
+    std::vector<Value> keys;
+    for (int i = 0; i < 100; ++i) {
+        keys.push_back(Value(static_cast<double>((i * 37) % 100)));
+    }
+    engine->setVariable("keys", Value::array(keys));
+    for (int probe : {0, 37, 50, 99}) {
+        int expected = 0;
+        for (int i = 0; i < 100; ++i) {
+            if ((i * 37) % 100 == probe) {
+                expected = i + 1;
+            }
+        }
+        auto result = eval("MATCH(" + std::to_string(probe) + ", keys, 0)");
+        EXPECT_DOUBLE_EQ(expected, result.asNumber());
+    }
+    // Exact, floor and ceiling lookups share one index per table
+    EXPECT_DOUBLE_EQ(51.0, eval("MATCH(50.5, keys, 1)").asNumber());
+    EXPECT_DOUBLE_EQ(eval("MATCH(51, keys, 0)").asNumber(),
+                     eval("MATCH(50.5, keys, -1)").asNumber());
+    EXPECT_EQ(1u, engine->getContext().getLookupCache().size());
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include "velox/formulas/xl-formula.h"
+
+using namespace xl_formula;
+
+class SortFilterUniqueTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        engine = std::make_unique<FormulaEngine>();
+    }
+
+    Value eval(const std::string& formula) {
+        return engine->evaluate(formula).getValue();
+    }
+
+    std::unique_ptr<FormulaEngine> engine;
+};
+
+TEST_F(SortFilterUniqueTest, SortFlatArrays) {
+    EXPECT_EQ(eval("{1, 2, 3}"), eval("SORT({3, 1, 2})"));
+    EXPECT_EQ(eval("{3, 2, 1}"), eval("SORT({3, 1, 2}, 1, -1)"));
+    // Numbers before text before logicals, text compared case-insensitively
+    EXPECT_EQ(eval("{2, \"a\", \"B\", TRUE}"), eval("SORT({TRUE, \"B\", 2, \"a\"})"));
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("SORT({1, 2}, 1, 0)").asError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("SORT({1, 2}, 2)").asError());
+}
+
+TEST_F(SortFilterUniqueTest, SortLargeNumericArraysUsesRadixPath) {
+    // Enough elements for the radix kernel, with negatives, zeros of both signs and duplicates
+    std::vector<double> numbers;
+    for (int i = 0; i < 1000; ++i) {
+        numbers.push_back(static_cast<double>((i * 7919) % 613) - 300.5);
+    }
+    numbers.push_back(-0.0);
+    numbers.push_back(0.0);
+    numbers.push_back(-1e300);
+    numbers.push_back(1e-300);
+    engine->setVariable("data", Value::numberArray(numbers));
+
+    std::vector<double> expected = numbers;
+    std::sort(expected.begin(), expected.end());
+    auto ascending = eval("SORT(data)");
+    ASSERT_TRUE(ascending.isArray());
+    ASSERT_EQ(expected.size(), ascending.asArrayData().size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_DOUBLE_EQ(expected[i], ascending.asArrayData().at(i).asNumber());
+    }
+
+    std::sort(expected.begin(), expected.end(), std::greater<double>());
+    auto descending = eval("SORT(data, 1, -1)");
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_DOUBLE_EQ(expected[i], descending.asArrayData().at(i).asNumber());
+    }
+}
+
+TEST_F(SortFilterUniqueTest, SortTables) {
+    EXPECT_EQ(eval("{{1, \"a\"}, {2, \"b\"}}"), eval("SORT({{2, \"b\"}, {1, \"a\"}})"));
+    EXPECT_EQ(eval("{{2, \"a\"}, {1, \"b\"}}"), eval("SORT({{1, \"b\"}, {2, \"a\"}}, 2)"));
+    // by_col sorts the columns by the values of a row
+    EXPECT_EQ(eval("{{1, 2, 3}, {\"x\", \"y\", \"z\"}}"),
+              eval("SORT({{3, 1, 2}, {\"z\", \"x\", \"y\"}}, 1, 1, TRUE)"));
+}
+
+TEST_F(SortFilterUniqueTest, SortIsStable) {
+    EXPECT_EQ(eval("{{1, \"a\"}, {1, \"c\"}, {2, \"b\"}}"),
+              eval("SORT({{2, \"b\"}, {1, \"a\"}, {1, \"c\"}})"));
+    EXPECT_EQ(eval("{{2, \"b\"}, {1, \"a\"}, {1, \"c\"}}"),
+              eval("SORT({{1, \"a\"}, {2, \"b\"}, {1, \"c\"}}, 1, -1)"));
+}
+
+TEST_F(SortFilterUniqueTest, SortByKeys) {
+    EXPECT_EQ(eval("{\"b\", \"c\", \"a\"}"), eval("SORTBY({\"a\", \"b\", \"c\"}, {3, 1, 2})"));
+    EXPECT_EQ(eval("{\"b\", \"a\", \"c\"}"), eval("SORTBY({\"a\", \"b\", \"c\"}, {1, 2, 1}, -1)"));
+    // The second key breaks ties left by the first
+    EXPECT_EQ(eval("{\"d\", \"b\", \"c\", \"a\"}"),
+              eval("SORTBY({\"a\", \"b\", \"c\", \"d\"}, {2, 1, 2, 1}, 1, {1, 2, 3, 4}, -1)"));
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("SORTBY({1, 2, 3}, {1, 2})").asError());
+}
+
+TEST_F(SortFilterUniqueTest, FilterWithMasks) {
+    EXPECT_EQ(eval("{3, 4}"), eval("FILTER({1, 2, 3, 4}, {1, 2, 3, 4} > 2)"));
+    EXPECT_EQ(eval("{\"a\", \"c\"}"), eval("FILTER({\"a\", \"b\", \"c\"}, {TRUE, FALSE, TRUE})"));
+    EXPECT_EQ(eval("{{2, \"b\"}}"), eval("FILTER({{1, \"a\"}, {2, \"b\"}}, {0, 1})"));
+    EXPECT_EQ("none", eval("FILTER({\"a\", \"b\"}, {FALSE, FALSE}, \"none\")").asText());
+    EXPECT_EQ(ErrorType::NA_ERROR, eval("FILTER({1, 2}, {0, 0})").asError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("FILTER({1, 2, 3}, {1, 0})").asError());
+}
+
+TEST_F(SortFilterUniqueTest, FilterLargePackedArray) {
+    // 200 packed elements span several mask words
+    auto result = eval("FILTER(SEQUENCE(200), SEQUENCE(200) > 130)");
+    ASSERT_TRUE(result.isArray());
+    ASSERT_EQ(70u, result.asArrayData().size());
+    EXPECT_DOUBLE_EQ(131.0, result.asArrayData().at(0).asNumber());
+    EXPECT_DOUBLE_EQ(200.0, result.asArrayData().at(69).asNumber());
+    // Packed numeric flags
+    EXPECT_EQ(eval("{2, 4}"), eval("FILTER({1, 2, 3, 4}, {0, 1, 0, 1} * 2)"));
+}
+
+TEST_F(SortFilterUniqueTest, UniqueValues) {
+    EXPECT_EQ(eval("{1, 2, 3}"), eval("UNIQUE({1, 2, 2, 3, 1})"));
+    EXPECT_EQ(eval("{3}"), eval("UNIQUE({1, 2, 2, 3, 1}, FALSE, TRUE)"));
+    // Text compares case-insensitively and keeps the first spelling
+    EXPECT_EQ(eval("{\"a\", \"b\"}"), eval("UNIQUE({\"a\", \"A\", \"b\"})"));
+    EXPECT_EQ(eval("{\"b\"}"), eval("UNIQUE({\"a\", \"A\", \"b\"}, FALSE, TRUE)"));
+    EXPECT_EQ(ErrorType::NA_ERROR, eval("UNIQUE({1, 1}, FALSE, TRUE)").asError());
+}
+
+TEST_F(SortFilterUniqueTest, UniqueRowsAndColumns) {
+    EXPECT_EQ(eval("{{1, \"a\"}, {2, \"b\"}}"), eval("UNIQUE({{1, \"a\"}, {2, \"b\"}, {1, \"A\"}})"));
+    EXPECT_EQ(eval("{{1, 2}, {\"a\", \"b\"}}"),
+              eval("UNIQUE({{1, 2, 1}, {\"a\", \"b\", \"a\"}}, TRUE)"));
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "velox/formulas/lookup_index.h"
+#include "velox/formulas/xl-formula.h"
+
+using namespace xl_formula;
+
+class VlookupFunctionTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        engine = std::make_unique<FormulaEngine>();
+    }
+
+    Value eval(const std::string& formula) {
+        return engine->evaluate(formula).getValue();
+    }
+
+    std::unique_ptr<FormulaEngine> engine;
+};
+
+TEST_F(VlookupFunctionTest, ExactMatch) {
+    EXPECT_EQ("b", eval("VLOOKUP(2, {{1, \"a\"}, {2, \"b\"}, {3, \"c\"}}, 2, FALSE)").asText());
+    EXPECT_DOUBLE_EQ(3.0, eval("VLOOKUP(\"C\", {{\"a\", 1}, {\"c\", 3}}, 2, FALSE)").asNumber());
+    EXPECT_EQ(ErrorType::NA_ERROR,
+              eval("VLOOKUP(4, {{1, \"a\"}, {2, \"b\"}}, 2, FALSE)").asError());
+}
+
+TEST_F(VlookupFunctionTest, ApproximateMatch) {
+    EXPECT_EQ("b", eval("VLOOKUP(2.5, {{1, \"a\"}, {2, \"b\"}, {3, \"c\"}}, 2)").asText());
+    EXPECT_EQ("c", eval("VLOOKUP(99, {{1, \"a\"}, {2, \"b\"}, {3, \"c\"}}, 2, TRUE)").asText());
+    EXPECT_EQ(ErrorType::NA_ERROR, eval("VLOOKUP(0, {{1, \"a\"}, {2, \"b\"}}, 2)").asError());
+}
+
+TEST_F(VlookupFunctionTest, WildcardExactMatch) {
+    auto result = eval("VLOOKUP(\"ba*\", {{\"apple\", 1}, {\"banana\", 2}}, 2, FALSE)");
+    EXPECT_DOUBLE_EQ(2.0, result.asNumber());
+}
+
+TEST_F(VlookupFunctionTest, InvalidArguments) {
+    EXPECT_EQ(ErrorType::REF_ERROR, eval("VLOOKUP(1, {{1, 2}}, 3, FALSE)").asError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("VLOOKUP(1, {{1, 2}}, 0, FALSE)").asError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("VLOOKUP(1, {{1, 2}, 3}, 1, FALSE)").asError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("VLOOKUP(1, {{1, 2}})").asError());
+}
+
+TEST_F(VlookupFunctionTest, LargeTableUsesCachedIndex) {
+    std::vector<Value> rows;
+    for (int i = 0; i < 500; ++i) {
+        rows.push_back(Value::array({Value(i * 2.0), Value("row" + std::to_string(i))}));
+    }
+    engine->setVariable("table", Value::array(rows));
+
+    EXPECT_EQ("row21", eval("VLOOKUP(42, table, 2, FALSE)").asText());
+    EXPECT_EQ("row21", eval("VLOOKUP(43, table, 2, TRUE)").asText());
+    EXPECT_EQ(ErrorType::NA_ERROR, eval("VLOOKUP(43, table, 2, FALSE)").asError());
+    EXPECT_EQ("row499", eval("VLOOKUP(5000, table, 2)").asText());
+    EXPECT_EQ(1u, engine->getContext().getLookupCache().size());
+}
+
+TEST_F(VlookupFunctionTest, HlookupMatchesInFirstRow) {
+    auto result = eval("HLOOKUP(\"b\", {{\"a\", \"b\", \"c\"}, {1, 2, 3}}, 2, FALSE)");
+    EXPECT_DOUBLE_EQ(2.0, result.asNumber());
+    EXPECT_DOUBLE_EQ(20.0, eval("HLOOKUP(25, {{10, 20, 30}, {10, 20, 30}}, 2)").asNumber());
+    EXPECT_EQ(ErrorType::REF_ERROR, eval("HLOOKUP(10, {{10, 20}, {1, 2}}, 3)").asError());
+}
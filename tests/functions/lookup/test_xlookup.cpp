@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "velox/formulas/xl-formula.h"
+
+using namespace xl_formula;
+
+class XlookupFunctionTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        engine = std::make_unique<FormulaEngine>();
+    }
+
+    Value eval(const std::string& formula) {
+        return engine->evaluate(formula).getValue();
+    }
+
+    std::unique_ptr<FormulaEngine> engine;
+};
+
+TEST_F(XlookupFunctionTest, ExactMatch) {
+    EXPECT_DOUBLE_EQ(2.0, eval("XLOOKUP(\"b\", {\"a\", \"b\", \"c\"}, {1, 2, 3})").asNumber());
+    EXPECT_EQ(ErrorType::NA_ERROR, eval("XLOOKUP(\"z\", {\"a\", \"b\"}, {1, 2})").asError());
+    EXPECT_EQ("none", eval("XLOOKUP(\"z\", {\"a\", \"b\"}, {1, 2}, \"none\")").asText());
+}
+
+TEST_F(XlookupFunctionTest, NearestMatchModes) {
+    EXPECT_EQ("y", eval("XLOOKUP(25, {10, 20, 30}, {\"x\", \"y\", \"z\"}, \"-\", -1)").asText());
+    EXPECT_EQ("z", eval("XLOOKUP(25, {10, 20, 30}, {\"x\", \"y\", \"z\"}, \"-\", 1)").asText());
+    EXPECT_EQ("-", eval("XLOOKUP(5, {10, 20, 30}, {\"x\", \"y\", \"z\"}, \"-\", -1)").asText());
+    // Works on unsorted data
+    EXPECT_EQ("y", eval("XLOOKUP(15, {30, 10, 20}, {\"z\", \"x\", \"y\"}, \"-\", 1)").asText());
+}
+
+TEST_F(XlookupFunctionTest, WildcardAndSearchModes) {
+    engine->setVariable("codes", Value::array({Value("a1"), Value("b1"), Value("b2")}));
+    EXPECT_DOUBLE_EQ(2.0, eval("XLOOKUP(\"b?\", codes, {1, 2, 3}, 0, 2)").asNumber());
+    EXPECT_DOUBLE_EQ(3.0, eval("XLOOKUP(\"b?\", codes, {1, 2, 3}, 0, 2, -1)").asNumber());
+    // Without match_mode 2 the pattern is taken literally
+    EXPECT_EQ(ErrorType::NA_ERROR, eval("XLOOKUP(\"b?\", {\"b1\"}, {1})").asError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("XLOOKUP(1, {1}, {1}, 0, 3)").asError());
+}
+
+TEST_F(XlookupFunctionTest, ReturnsRowsAndRejectsMismatchedSizes) {
+    EXPECT_EQ(eval("{3, 4}"), eval("XLOOKUP(\"b\", {\"a\", \"b\"}, {{1, 2}, {3, 4}})"));
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("XLOOKUP(1, {1, 2, 3}, {1, 2})").asError());
+}
@@ -109,4 +109,19 @@ TEST_F(AverageFunctionTest, ZeroValues_HandlesCorrectly) {
 
     EXPECT_TRUE(result.isNumber());
     EXPECT_DOUBLE_EQ(0.0, result.asNumber());
-}
\ No newline at end of file
+}
+
+TEST_F(AverageFunctionTest, Arrays_AverageNumbersOnly) {
+    auto result = callAverage(
+            {Value::numberArray({2.0, 4.0}), Value::array({Value(6.0), Value("x")}), Value(8.0)});
+
+    EXPECT_TRUE(result.isNumber());
+    EXPECT_DOUBLE_EQ(5.0, result.asNumber());
+}
+
+TEST_F(AverageFunctionTest, ArrayWithoutNumbers_ReturnsDivZero) {
+    auto result = callAverage({Value::array({Value("a"), Value("b")})});
+
+    EXPECT_TRUE(result.isError());
+    EXPECT_EQ(ErrorType::DIV_ZERO, result.asError());
+}
@@ -59,4 +59,13 @@ TEST_F(AverageifFunctionTest, TooManyArguments) {
     auto result = engine->evaluate("AVERAGEIF(5, 5, 10, 15)");
     ASSERT_TRUE(result.isSuccess());
     EXPECT_TRUE(result.getValue().isError());
-}
\ No newline at end of file
+}
+
+TEST_F(AverageifFunctionTest, ArrayRange) {
+    auto result = engine->evaluate("AVERAGEIF({1, 5, 10}, \">=5\")");
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_DOUBLE_EQ(7.5, result.getValue().asNumber());
+
+    result = engine->evaluate("AVERAGEIF({1, 2, 3}, \">5\")");
+    EXPECT_EQ(ErrorType::DIV_ZERO, result.getValue().asError());
+}
@@ -47,4 +47,13 @@ TEST_F(AverageifsFunctionTest, EvenNumberOfArguments) {
     auto result = engine->evaluate("AVERAGEIFS(10, 5, 5, 8)");
     ASSERT_TRUE(result.isSuccess());
     EXPECT_TRUE(result.getValue().isError());
-}
\ No newline at end of file
+}
+
+TEST_F(AverageifsFunctionTest, ArrayRanges) {
+    auto result = engine->evaluate("AVERAGEIFS({10, 20, 30}, {1, 2, 3}, \">1\")");
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_DOUBLE_EQ(25.0, result.getValue().asNumber());
+
+    result = engine->evaluate("AVERAGEIFS({10, 20, 30}, {1, 2, 3}, \">5\")");
+    EXPECT_EQ(ErrorType::DIV_ZERO, result.getValue().asError());
+}
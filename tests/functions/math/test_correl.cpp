@@ -54,3 +54,31 @@ TEST(CorrelFunctionTest, SlopeAndIntercept) {
     ASSERT_TRUE(b.isNumber());
     EXPECT_NEAR(b.asNumber(), 0.0, 1e-12);
 }
+
+TEST(CorrelFunctionTest, PackedArraysAcrossBlocks) {
+    std::vector<double> x(1000);
+    std::vector<double> y(1000);
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] = static_cast<double>(i);
+        y[i] = 3.0 * static_cast<double>(i) - 7.0;
+    }
+    std::vector<Value> args = {Value::numberArray(x), Value::numberArray(y)};
+    EXPECT_NEAR(1.0, correl(args, Context{}).asNumber(), 1e-12);
+    EXPECT_NEAR(1.0, rsq(args, Context{}).asNumber(), 1e-12);
+    // SLOPE/INTERCEPT take y first
+    std::vector<Value> yx = {Value::numberArray(y), Value::numberArray(x)};
+    EXPECT_NEAR(3.0, slope(yx, Context{}).asNumber(), 1e-12);
+    EXPECT_NEAR(-7.0, intercept(yx, Context{}).asNumber(), 1e-9);
+}
+
+TEST(CorrelFunctionTest, NonNumericPairsAreSkipped) {
+    std::vector<Value> a = {Value(1.0), Value("x"), Value(2.0), Value(3.0)};
+    std::vector<Value> b = {Value(2.0), Value(100.0), Value(4.0), Value(6.0)};
+    auto res = correl({Value(a), Value(b)}, Context{});
+    ASSERT_TRUE(res.isNumber());
+    EXPECT_NEAR(1.0, res.asNumber(), 1e-12);
+
+    std::vector<Value> withError = {Value(1.0), Value::error(xl_formula::ErrorType::NA_ERROR)};
+    auto err = correl({Value(withError), Value(b)}, Context{});
+    EXPECT_TRUE(err.isError());
+}
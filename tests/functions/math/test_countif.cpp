@@ -189,4 +189,89 @@ TEST_F(CountIfFunctionTest, NumericTextCriteria_ConvertsCorrectly) {
 
     EXPECT_TRUE(result.isNumber());
     EXPECT_DOUBLE_EQ(1.0, result.asNumber());  // matches the numeric 5.0
-}
\ No newline at end of file
+}
+
+// Array range tests
+TEST_F(CountIfFunctionTest, ArrayRange_CountsMatchingElements) {
+    Value range = Value::array({Value(1.0), Value(2.0), Value(3.0), Value(150.0), Value(100.0)});
+    EXPECT_DOUBLE_EQ(2.0, callCountIf({range, Value(">=100")}).asNumber());
+    EXPECT_DOUBLE_EQ(1.0, callCountIf({range, Value(3.0)}).asNumber());
+    EXPECT_DOUBLE_EQ(1.0, callCountIf({range, Value("150")}).asNumber());
+    EXPECT_DOUBLE_EQ(0.0, callCountIf({range, Value("apple")}).asNumber());
+
+    Value mixed = Value::array({Value("apple"), Value(5.0), Value("apricot"), Value::empty()});
+    EXPECT_DOUBLE_EQ(2.0, callCountIf({mixed, Value("ap*")}).asNumber());
+    EXPECT_DOUBLE_EQ(1.0, callCountIf({mixed, Value("")}).asNumber());
+    EXPECT_DOUBLE_EQ(1.0, callCountIf({mixed, Value(">4")}).asNumber());
+}
+
+TEST_F(CountIfFunctionTest, WildcardBacktracking_CountsCorrectly) {
+    auto result = callCountIf({Value("axbxbxc"), Value("abc"), Value("acb"), Value("a*b*c")});
+
+    EXPECT_TRUE(result.isNumber());
+    EXPECT_DOUBLE_EQ(2.0, result.asNumber());
+
+    Value range = Value::array({Value("axbxbxc"), Value("abc"), Value("acb")});
+    EXPECT_DOUBLE_EQ(2.0, callCountIf({range, Value("a*b*c")}).asNumber());
+}
+
+TEST_F(CountIfFunctionTest, WildcardCaseAndEscape_CountsCorrectly) {
+    EXPECT_DOUBLE_EQ(2.0, callCountIf({Value("Apple"), Value("APPLY"), Value("app*")}).asNumber());
+    EXPECT_DOUBLE_EQ(1.0, callCountIf({Value("why?"), Value("whys"), Value("why~?")}).asNumber());
+    EXPECT_DOUBLE_EQ(1.0, callCountIf({Value("5*"), Value("55"), Value("5~*")}).asNumber());
+
+    Value range = Value::array({Value("Apple"), Value("APPLY"), Value("why?"), Value("whys"),
+                                Value("5*"), Value("55")});
+    EXPECT_DOUBLE_EQ(2.0, callCountIf({range, Value("app*")}).asNumber());
+    EXPECT_DOUBLE_EQ(1.0, callCountIf({range, Value("why~?")}).asNumber());
+    EXPECT_DOUBLE_EQ(1.0, callCountIf({range, Value("5~*")}).asNumber());
+}
+
+TEST_F(CountIfFunctionTest, CompiledCriteria_CountsAndSumsExpectedElements) {
+    const Value values = Value::array({Value(-1.0), Value(0.0), Value(99.5), Value(100.0),
+                                       Value(100.0), Value(250.0), Value("b"), Value("abc"),
+                                       Value(true), Value::empty(), Value("")});
+    // Long packed array 0..202 to exercise the SIMD body and tail
+    std::vector<Value> numbers;
+    for (int i = 0; i < 203; ++i) {
+        numbers.push_back(Value(static_cast<double>(i)));
+    }
+    const Value packed = Value::array(numbers);
+
+    // Numeric operators only match numbers, and "<>" only non-empty text
+    struct Case {
+        Value criteria;
+        size_t mixed_count;
+        size_t packed_count;
+        double packed_sum;
+    };
+    const std::vector<Case> cases = {
+            {Value(100.0), 2, 1, 100.0},   {Value(">=100"), 3, 103, 15553.0},
+            {Value("<100"), 3, 100, 4950.0}, {Value("<>100"), 4, 202, 20403.0},
+            {Value("=b"), 1, 0, 0.0},       {Value(">a"), 2, 0, 0.0},
+            {Value("a?c"), 1, 0, 0.0},      {Value("100"), 2, 1, 100.0},
+            {Value(true), 1, 0, 0.0},       {Value(""), 2, 0, 0.0},
+            {Value("<>"), 2, 0, 0.0}};
+
+    for (const auto& c : cases) {
+        auto compiled = conditional::CompiledCriteria::compile(c.criteria);
+        EXPECT_EQ(c.mixed_count, compiled.countMatches(values.asArrayData()))
+                << c.criteria.toString();
+        EXPECT_EQ(c.packed_count, compiled.countMatches(packed.asArrayData()))
+                << c.criteria.toString();
+        EXPECT_DOUBLE_EQ(static_cast<double>(c.mixed_count),
+                         callCountIf({values, c.criteria}).asNumber())
+                << c.criteria.toString();
+        EXPECT_DOUBLE_EQ(c.packed_sum, sumif({packed, c.criteria}, context).asNumber())
+                << c.criteria.toString();
+    }
+}
+
+TEST_F(CountIfFunctionTest, TextCriteria_IgnoreCase) {
+    Value range = Value::array({Value("Apple"), Value("APPLE"), Value("banana"), Value("apple")});
+    EXPECT_DOUBLE_EQ(3.0, callCountIf({range, Value("apple")}).asNumber());
+    EXPECT_DOUBLE_EQ(3.0, callCountIf({range, Value("=APPLE")}).asNumber());
+    EXPECT_DOUBLE_EQ(1.0, callCountIf({range, Value("<>Apple")}).asNumber());
+    EXPECT_DOUBLE_EQ(1.0, callCountIf({range, Value(">APPLEZ")}).asNumber());
+    EXPECT_DOUBLE_EQ(0.0, callCountIf({range, Value("appl")}).asNumber());
+}
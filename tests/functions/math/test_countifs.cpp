@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include "velox/formulas/xl-formula.h"
+
+using namespace xl_formula;
+
+class CountifsFunctionTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        engine = std::make_unique<FormulaEngine>();
+    }
+
+    std::unique_ptr<FormulaEngine> engine;
+};
+
+TEST_F(CountifsFunctionTest, SingleCriteria) {
+    auto result = engine->evaluate("COUNTIFS({1, 2, 3, 4}, \">2\")");
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_DOUBLE_EQ(2.0, result.getValue().asNumber());
+}
+
+TEST_F(CountifsFunctionTest, MultipleCriteria) {
+    auto result =
+            engine->evaluate("COUNTIFS({1, 2, 3, 4}, \">1\", {\"a\", \"b\", \"a\", \"a\"}, \"a\")");
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_DOUBLE_EQ(2.0, result.getValue().asNumber());
+}
+
+TEST_F(CountifsFunctionTest, WildcardAndBlankCriteria) {
+    engine->setVariable("names", Value::array({Value("apple"), Value("banana"), Value::empty(),
+                                               Value("apricot")}));
+    EXPECT_DOUBLE_EQ(2.0, engine->evaluate("COUNTIFS(names, \"ap*\")").getValue().asNumber());
+    EXPECT_DOUBLE_EQ(1.0, engine->evaluate("COUNTIFS(names, \"\")").getValue().asNumber());
+}
+
+TEST_F(CountifsFunctionTest, SingleValues) {
+    EXPECT_DOUBLE_EQ(1.0, engine->evaluate("COUNTIFS(5, \">1\", 3, 3)").getValue().asNumber());
+    EXPECT_DOUBLE_EQ(0.0, engine->evaluate("COUNTIFS(5, \">1\", 3, 4)").getValue().asNumber());
+}
+
+TEST_F(CountifsFunctionTest, MismatchedRanges) {
+    auto result = engine->evaluate("COUNTIFS({1, 2, 3}, \">1\", {1, 2}, \">1\")");
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, result.getValue().asError());
+}
+
+TEST_F(CountifsFunctionTest, InvalidArgumentCount) {
+    EXPECT_TRUE(engine->evaluate("COUNTIFS({1, 2})").getValue().isError());
+    EXPECT_TRUE(engine->evaluate("COUNTIFS({1, 2}, 1, {1, 2})").getValue().isError());
+}
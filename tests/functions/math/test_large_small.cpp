@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include "velox/formulas/xl-formula.h"
+
+using namespace xl_formula;
+
+class LargeSmallTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        engine = std::make_unique<FormulaEngine>();
+    }
+
+    Value eval(const std::string& formula) {
+        return engine->evaluate(formula).getValue();
+    }
+
+    std::unique_ptr<FormulaEngine> engine;
+};
+
+TEST_F(LargeSmallTest, KthValues) {
+    EXPECT_DOUBLE_EQ(5.0, eval("LARGE({3, 5, 3, 5, 4}, 1)").asNumber());
+    EXPECT_DOUBLE_EQ(4.0, eval("LARGE({3, 5, 3, 5, 4}, 3)").asNumber());
+    EXPECT_DOUBLE_EQ(3.0, eval("SMALL({3, 5, 3, 5, 4}, 1)").asNumber());
+    EXPECT_DOUBLE_EQ(5.0, eval("SMALL({3, 5, 3, 5, 4}, 4)").asNumber());
+    // Text and logicals inside arrays are skipped
+    EXPECT_DOUBLE_EQ(2.0, eval("SMALL({\"a\", 2, TRUE, 7}, 1)").asNumber());
+}
+
+TEST_F(LargeSmallTest, OutOfRangeK) {
+    EXPECT_EQ(ErrorType::NUM_ERROR, eval("LARGE({1, 2, 3}, 0)").asError());
+    EXPECT_EQ(ErrorType::NUM_ERROR, eval("SMALL({1, 2, 3}, 4)").asError());
+    EXPECT_EQ(ErrorType::NUM_ERROR, eval("LARGE({\"a\"}, 1)").asError());
+    EXPECT_EQ(ErrorType::DIV_ZERO, eval("SMALL({1, 1/0}, 1)").asError());
+}
+
+TEST_F(LargeSmallTest, LargeArraysSmallAndLargeK) {
+    engine->setVariable("data", engine->evaluate("SEQUENCE(5000, 1, 5000, -1)").getValue());
+    // Small k partially sorts, large k selects, repeats hit the sorted copy
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_DOUBLE_EQ(4998.0, eval("LARGE(data, 3)").asNumber());
+        EXPECT_DOUBLE_EQ(3.0, eval("SMALL(data, 3)").asNumber());
+        EXPECT_DOUBLE_EQ(3000.0, eval("LARGE(data, 2001)").asNumber());
+        EXPECT_DOUBLE_EQ(2001.0, eval("SMALL(data, 2001)").asNumber());
+    }
+}
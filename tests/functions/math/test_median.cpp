@@ -144,4 +144,23 @@ TEST_F(MedianFunctionTest, DuplicateValues_ReturnsCorrectMedian) {
 
     EXPECT_TRUE(result.isNumber());
     EXPECT_DOUBLE_EQ(2.0, result.asNumber());
-}
\ No newline at end of file
+}
+
+TEST_F(MedianFunctionTest, ArrayArguments_FlattenNumbers) {
+    auto result = callMedian({Value::array({Value(5.0), Value("x"), Value(1.0)}), Value(3.0)});
+
+    EXPECT_TRUE(result.isNumber());
+    EXPECT_DOUBLE_EQ(3.0, result.asNumber());  // [5, 1, 3] -> median is 3
+}
+
+TEST_F(MedianFunctionTest, RepeatedLargeArray_ReturnsSameMedian) {
+    std::vector<double> numbers;
+    for (int i = 0; i < 100; ++i) {
+        numbers.push_back(static_cast<double>((i * 31) % 100));
+    }
+    Value array = Value::numberArray(numbers);
+
+    // The second call is served from the context's sorted copy
+    EXPECT_DOUBLE_EQ(49.5, callMedian({array}).asNumber());
+    EXPECT_DOUBLE_EQ(49.5, callMedian({array}).asNumber());
+}
@@ -153,4 +153,39 @@ TEST_F(ModeFunctionTest, AllSameNumbers_ReturnsThatNumber) {
 
     EXPECT_TRUE(result.isNumber());
     EXPECT_DOUBLE_EQ(5.0, result.asNumber());
-}
\ No newline at end of file
+}
+
+TEST_F(ModeFunctionTest, Arrays_CountNumbersOnly) {
+    std::vector<double> numbers;
+    for (int i = 0; i < 1000; ++i) {
+        numbers.push_back(i % 10 == 3 ? 42.0 : static_cast<double>(i));
+    }
+    auto result = callMode({Value::numberArray(numbers)});
+    EXPECT_TRUE(result.isNumber());
+    EXPECT_DOUBLE_EQ(42.0, result.asNumber());
+
+    result = callMode({Value::array({Value(1.0), Value("1"), Value(2.0)}), Value(2.0)});
+    EXPECT_TRUE(result.isNumber());
+    EXPECT_DOUBLE_EQ(2.0, result.asNumber());
+
+    result = callMode({Value::array({Value(1.0), Value::error(ErrorType::NA_ERROR)})});
+    EXPECT_TRUE(result.isError());
+    EXPECT_EQ(ErrorType::NA_ERROR, result.asError());
+}
+
+TEST_F(ModeFunctionTest, ModeMult_ReturnsAllModesInOrder) {
+    auto result = builtin::mode_mult(
+            {Value(3.0), Value::numberArray({1.0, 2.0, 2.0, 1.0, 3.0}), Value(4.0)}, context);
+    ASSERT_TRUE(result.isArray());
+    const auto& modes = result.asArrayData();
+    ASSERT_EQ(3u, modes.size());
+    EXPECT_DOUBLE_EQ(3.0, modes.at(0).asNumber());
+    EXPECT_DOUBLE_EQ(1.0, modes.at(1).asNumber());
+    EXPECT_DOUBLE_EQ(2.0, modes.at(2).asNumber());
+
+    result = builtin::mode_mult({Value(1.0), Value(2.0), Value(3.0)}, context);
+    EXPECT_EQ(ErrorType::NA_ERROR, result.asError());
+
+    result = builtin::mode_mult({Value("text")}, context);
+    EXPECT_EQ(ErrorType::NA_ERROR, result.asError());
+}
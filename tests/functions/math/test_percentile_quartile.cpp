@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "velox/formulas/xl-formula.h"
+
+using namespace xl_formula;
+
+class PercentileQuartileTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        engine = std::make_unique<FormulaEngine>();
+    }
+
+    Value eval(const std::string& formula) {
+        return engine->evaluate(formula).getValue();
+    }
+
+    std::unique_ptr<FormulaEngine> engine;
+};
+
+TEST_F(PercentileQuartileTest, PercentileInterpolates) {
+    EXPECT_DOUBLE_EQ(1.75, eval("PERCENTILE({1, 2, 3, 4}, 0.25)").asNumber());
+    EXPECT_DOUBLE_EQ(1.0, eval("PERCENTILE({4, 3, 2, 1}, 0)").asNumber());
+    EXPECT_DOUBLE_EQ(30.0, eval("PERCENTILE({10, 30, 20}, 1)").asNumber());
+    EXPECT_DOUBLE_EQ(5.0, eval("PERCENTILE(5, 0.3)").asNumber());
+}
+
+TEST_F(PercentileQuartileTest, PercentileErrors) {
+    EXPECT_EQ(ErrorType::NUM_ERROR, eval("PERCENTILE({1, 2}, 1.5)").asError());
+    EXPECT_EQ(ErrorType::NUM_ERROR, eval("PERCENTILE({1, 2}, -0.1)").asError());
+    EXPECT_EQ(ErrorType::NUM_ERROR, eval("PERCENTILE({\"a\"}, 0.5)").asError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("PERCENTILE({1, 2})").asError());
+}
+
+TEST_F(PercentileQuartileTest, Quartiles) {
+    EXPECT_DOUBLE_EQ(1.0, eval("QUARTILE({1, 2, 3, 4, 5}, 0)").asNumber());
+    EXPECT_DOUBLE_EQ(2.0, eval("QUARTILE({1, 2, 3, 4, 5}, 1)").asNumber());
+    EXPECT_DOUBLE_EQ(3.25, eval("QUARTILE({1, 2, 3, 4}, 3)").asNumber());
+    EXPECT_DOUBLE_EQ(5.0, eval("QUARTILE({1, 2, 3, 4, 5}, 4.9)").asNumber());
+    EXPECT_EQ(ErrorType::NUM_ERROR, eval("QUARTILE({1, 2}, 5)").asError());
+}
+
+TEST_F(PercentileQuartileTest, RepeatedCallsOnOneArray) {
+    // Later calls are answered from the engine's sorted copy of the array
+    engine->setVariable("data", engine->evaluate("SEQUENCE(1001, 1, 0)").getValue());
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_DOUBLE_EQ(250.0, eval("QUARTILE(data, 1)").asNumber());
+        EXPECT_DOUBLE_EQ(900.0, eval("PERCENTILE(data, 0.9)").asNumber());
+        EXPECT_DOUBLE_EQ(100.25, eval("PERCENTILE(data, 0.10025)").asNumber());
+        EXPECT_DOUBLE_EQ(500.0, eval("MEDIAN(data)").asNumber());
+    }
+}
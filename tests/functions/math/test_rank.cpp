@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include "velox/formulas/xl-formula.h"
+
+using namespace xl_formula;
+
+class RankFunctionTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        engine = std::make_unique<FormulaEngine>();
+    }
+
+    Value eval(const std::string& formula) {
+        return engine->evaluate(formula).getValue();
+    }
+
+    std::unique_ptr<FormulaEngine> engine;
+};
+
+TEST_F(RankFunctionTest, DescendingByDefault) {
+    EXPECT_DOUBLE_EQ(1.0, eval("RANK(7, {7, 3, 5, 3})").asNumber());
+    EXPECT_DOUBLE_EQ(3.0, eval("RANK(3, {7, 3, 5, 3})").asNumber());
+    EXPECT_DOUBLE_EQ(3.0, eval("RANK(3, {7, 3, 5, 3}, 0)").asNumber());
+}
+
+TEST_F(RankFunctionTest, AscendingAndTies) {
+    EXPECT_DOUBLE_EQ(1.0, eval("RANK(3, {7, 3, 5, 3}, 1)").asNumber());
+    EXPECT_DOUBLE_EQ(3.0, eval("RANK(5, {7, 3, 5, 3}, 1)").asNumber());
+}
+
+TEST_F(RankFunctionTest, Errors) {
+    EXPECT_EQ(ErrorType::NA_ERROR, eval("RANK(4, {7, 3, 5})").asError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("RANK(\"x\", {1, 2})").asError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("RANK(1)").asError());
+}
+
+TEST_F(RankFunctionTest, RankingAgainstALargeArray) {
+    engine->setVariable("data", engine->evaluate("SEQUENCE(2000, 1, 2, 2)").getValue());
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_DOUBLE_EQ(1.0, eval("RANK(4000, data)").asNumber());
+        EXPECT_DOUBLE_EQ(2000.0, eval("RANK(2, data)").asNumber());
+        EXPECT_DOUBLE_EQ(50.0, eval("RANK(100, data, 1)").asNumber());
+        EXPECT_EQ(ErrorType::NA_ERROR, eval("RANK(3, data)").asError());
+    }
+}
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+#include "velox/formulas/xl-formula.h"
+
+using namespace xl_formula;
+
+class SequenceFunctionTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        engine = std::make_unique<FormulaEngine>();
+    }
+
+    Value eval(const std::string& formula) {
+        return engine->evaluate(formula).getValue();
+    }
+
+    std::unique_ptr<FormulaEngine> engine;
+};
+
+TEST_F(SequenceFunctionTest, SingleRowOrColumn) {
+    EXPECT_EQ(eval("{1, 2, 3, 4}"), eval("SEQUENCE(4)"));
+    EXPECT_EQ(eval("{5, 3, 1}"), eval("SEQUENCE(1, 3, 5, -2)"));
+    EXPECT_TRUE(eval("SEQUENCE(4)").asArrayData().isNumeric());
+}
+
+TEST_F(SequenceFunctionTest, TwoDimensional) {
+    EXPECT_EQ(eval("{{0, 10}, {20, 30}}"), eval("SEQUENCE(2, 2, 0, 10)"));
+    EXPECT_DOUBLE_EQ(6.0, eval("INDEX(SEQUENCE(2, 3), 2, 3)").asNumber());
+}
+
+TEST_F(SequenceFunctionTest, InvalidSizes) {
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("SEQUENCE(0)").asError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("SEQUENCE(2, -1)").asError());
+    EXPECT_EQ(ErrorType::NUM_ERROR, eval("SEQUENCE(1, 20000)").asError());
+    EXPECT_EQ(ErrorType::NUM_ERROR, eval("SEQUENCE(1e6, 1e4)").asError());
+    EXPECT_EQ(ErrorType::NUM_ERROR, eval("SEQUENCE(4096, 1025)").asError());
+    EXPECT_EQ(4096u, eval("SEQUENCE(4096)").asArrayData().size());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, eval("SEQUENCE(\"x\")").asError());
+}
@@ -151,4 +151,30 @@ TEST_F(StdevFunctionTest, ComplexScenario_ReturnsCorrectStdev) {
     EXPECT_TRUE(result.isNumber());
     // Mean = 3, Variance = 2.5, Stdev = sqrt(2.5) ≈ 1.581
     EXPECT_NEAR(1.5811388300841898, result.asNumber(), 1e-10);
-}
\ No newline at end of file
+}
+
+TEST_F(StdevFunctionTest, ArrayArguments_StreamPackedNumbers) {
+    std::vector<double> numbers;
+    for (int i = 1; i <= 1000; ++i) {
+        numbers.push_back(static_cast<double>(i));
+    }
+    // Packed array plus a scalar: 1..1001
+    auto result = callStdev({Value::numberArray(numbers), Value(1001.0)});
+
+    EXPECT_TRUE(result.isNumber());
+    EXPECT_NEAR(std::sqrt(1001.0 * 1002.0 / 12.0), result.asNumber(), 1e-9);
+}
+
+TEST_F(StdevFunctionTest, LargeOffset_StaysAccurate) {
+    auto result = callStdev({Value(1e9 + 1.0), Value(1e9 + 2.0), Value(1e9 + 3.0)});
+
+    EXPECT_TRUE(result.isNumber());
+    EXPECT_DOUBLE_EQ(1.0, result.asNumber());
+}
+
+TEST_F(StdevFunctionTest, ArrayWithText_SkipsText) {
+    auto result = callStdev({Value::array({Value(1.0), Value("x"), Value(3.0), Value(true)})});
+
+    EXPECT_TRUE(result.isNumber());
+    EXPECT_NEAR(std::sqrt(2.0), result.asNumber(), 1e-12);
+}
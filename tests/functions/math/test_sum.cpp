@@ -81,4 +81,21 @@ TEST_F(SumFunctionTest, LargeNumbers_HandlesCorrectly) {
 
     EXPECT_TRUE(result.isNumber());
     EXPECT_DOUBLE_EQ(6000000.0, result.asNumber());
-}
\ No newline at end of file
+}
+
+TEST_F(SumFunctionTest, Arrays_SumNumbersOnly) {
+    auto packed = Value::numberArray({1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0});
+    auto mixed = Value::array({Value(10.0), Value("text"), Value(true), Value(20.0)});
+
+    auto result = callSum({packed, mixed, Value(100.0)});
+
+    EXPECT_TRUE(result.isNumber());
+    EXPECT_DOUBLE_EQ(175.0, result.asNumber());  // 45 + 30 + 100; text and TRUE in arrays skipped
+}
+
+TEST_F(SumFunctionTest, ArrayWithError_PropagatesError) {
+    auto result = callSum({Value::array({Value(1.0), Value::error(ErrorType::NA_ERROR)})});
+
+    EXPECT_TRUE(result.isError());
+    EXPECT_EQ(ErrorType::NA_ERROR, result.asError());
+}
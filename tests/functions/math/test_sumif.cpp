@@ -64,4 +64,16 @@ TEST_F(SumifFunctionTest, TooManyArguments) {
     auto result = engine->evaluate("SUMIF(5, 5, 10, 15)");
     ASSERT_TRUE(result.isSuccess());
     EXPECT_TRUE(result.getValue().isError());
-}
\ No newline at end of file
+}
+
+TEST_F(SumifFunctionTest, ArrayRange) {
+    auto result = engine->evaluate("SUMIF({1, 5, 10}, \">=5\")");
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_DOUBLE_EQ(15.0, result.getValue().asNumber());
+
+    result = engine->evaluate("SUMIF({\"a\", \"b\", \"a\"}, \"a\", {1, 2, 4})");
+    EXPECT_DOUBLE_EQ(5.0, result.getValue().asNumber());
+
+    result = engine->evaluate("SUMIF({1, 2, 3}, \">1\", {1, 2})");
+    EXPECT_EQ(ErrorType::VALUE_ERROR, result.getValue().asError());
+}
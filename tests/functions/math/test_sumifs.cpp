@@ -46,4 +46,42 @@ TEST_F(SumifsFunctionTest, EvenNumberOfArguments) {
     auto result = engine->evaluate("SUMIFS(10, 5, 5, 8)");
     ASSERT_TRUE(result.isSuccess());
     EXPECT_TRUE(result.getValue().isError());
-}
\ No newline at end of file
+}
+
+TEST_F(SumifsFunctionTest, ArrayRanges) {
+    auto result = engine->evaluate(
+            "SUMIFS({10, 20, 30, 40}, {\"a\", \"b\", \"a\", \"a\"}, \"a\", {1, 2, 3, 4}, \">1\")");
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_DOUBLE_EQ(70.0, result.getValue().asNumber());
+
+    // No row satisfies both criteria
+    result = engine->evaluate("SUMIFS({10, 20}, {1, 2}, \">1\", {1, 2}, \"<2\")");
+    EXPECT_DOUBLE_EQ(0.0, result.getValue().asNumber());
+
+    // Criteria ranges must match the sum range
+    result = engine->evaluate("SUMIFS({10, 20, 30}, {1, 2}, \">1\")");
+    EXPECT_EQ(ErrorType::VALUE_ERROR, result.getValue().asError());
+    result = engine->evaluate("SUMIFS({10, 20}, 1, \">0\")");
+    EXPECT_EQ(ErrorType::VALUE_ERROR, result.getValue().asError());
+}
+
+TEST_F(SumifsFunctionTest, LargeRangesAcrossWordBoundaries) {
+    const int n = 1000;
+    std::vector<Value> amounts, regions, months;
+    double expected = 0.0;
+    for (int i = 0; i < n; ++i) {
+        amounts.push_back(Value(static_cast<double>(i)));
+        regions.push_back(Value(i % 3 == 0 ? "east" : "west"));
+        months.push_back(Value(static_cast<double>(i % 12 + 1)));
+        if (i % 3 == 0 && i % 12 + 1 >= 6) {
+            expected += i;
+        }
+    }
+    engine->setVariable("amounts", Value::array(amounts));
+    engine->setVariable("regions", Value::array(regions));
+    engine->setVariable("months", Value::array(months));
+
+    auto result = engine->evaluate("SUMIFS(amounts, regions, \"east\", months, \">=6\")");
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_DOUBLE_EQ(expected, result.getValue().asNumber());
+}
@@ -52,4 +52,36 @@ TEST_F(SumproductFunctionTest, EmptyArguments) {
     auto result = engine->evaluate("SUMPRODUCT()");
     ASSERT_TRUE(result.isSuccess());
     EXPECT_TRUE(result.getValue().isError());
-}
\ No newline at end of file
+}
+
+TEST_F(SumproductFunctionTest, Arrays) {
+    auto result = engine->evaluate("SUMPRODUCT({1, 2, 3}, {4, 5, 6})");
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_DOUBLE_EQ(result.getValue().asNumber(), 32.0);
+
+    // Non-numeric entries count as zero
+    result = engine->evaluate("SUMPRODUCT({1, \"x\", 3}, {4, 5, 6})");
+    EXPECT_DOUBLE_EQ(result.getValue().asNumber(), 22.0);
+
+    // Mismatched sizes
+    result = engine->evaluate("SUMPRODUCT({1, 2}, {4, 5, 6})");
+    EXPECT_EQ(result.getValue().asError(), ErrorType::VALUE_ERROR);
+}
+
+TEST_F(SumproductFunctionTest, PackedArrayKernels) {
+    // One array sums it
+    auto result = engine->evaluate("SUMPRODUCT({1, 2, 3})");
+    EXPECT_DOUBLE_EQ(result.getValue().asNumber(), 6.0);
+
+    // Two arrays take the dot product kernel
+    result = engine->evaluate("SUMPRODUCT(SEQUENCE(2000), SEQUENCE(2000))");
+    EXPECT_DOUBLE_EQ(result.getValue().asNumber(), 2000.0 * 2001.0 * 4001.0 / 6.0);
+
+    // More arrays are multiplied block by block, across a block boundary here
+    result = engine->evaluate(
+            "SUMPRODUCT(SEQUENCE(1500), SEQUENCE(1500, 1, 1, 0), SEQUENCE(1500, 1, 2, 0))");
+    EXPECT_DOUBLE_EQ(result.getValue().asNumber(), 1500.0 * 1501.0);
+
+    result = engine->evaluate("SUMPRODUCT({1, 2}, {3, 4}, {5, 6}, {7, 8})");
+    EXPECT_DOUBLE_EQ(result.getValue().asNumber(), 1.0 * 3 * 5 * 7 + 2.0 * 4 * 6 * 8);
+}
@@ -91,3 +91,14 @@ TEST_F(SumsqFunctionTest, ManyArguments_WorksCorrectly) {
     // 1^2 + 2^2 + 3^2 + 4^2 + 5^2 = 1 + 4 + 9 + 16 + 25 = 55
     EXPECT_DOUBLE_EQ(55.0, result.asNumber());
 }
+
+TEST_F(SumsqFunctionTest, Arrays_SquaresNumbersOnly) {
+    auto result = callSumsq({Value::numberArray({1.0, 2.0, 3.0, 4.0, 5.0}),
+                             Value::array({Value(6.0), Value("x")}), Value(7.0)});
+    ASSERT_TRUE(result.isNumber());
+    EXPECT_DOUBLE_EQ(55.0 + 36.0 + 49.0, result.asNumber());
+
+    result = callSumsq({Value::array({Value(1.0), Value::error(ErrorType::REF_ERROR)})});
+    ASSERT_TRUE(result.isError());
+    EXPECT_EQ(ErrorType::REF_ERROR, result.asError());
+}
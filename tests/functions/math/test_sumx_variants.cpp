@@ -24,3 +24,19 @@ TEST(SumXVariantsTest, SumXMY2_Flat) {
     ASSERT_TRUE(res.isNumber());
     EXPECT_DOUBLE_EQ(res.asNumber(), (5 - 2) * (5 - 2) + (7 - 4) * (7 - 4));
 }
+
+TEST(SumXVariantsTest, PackedArrays_TruncateToShorter) {
+    auto x = Value::numberArray({1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0});
+    auto y = Value::numberArray({7.0, 6.0, 5.0, 4.0, 3.0, 2.0});
+    double my2 = 0.0, py2 = 0.0, mxy2 = 0.0;
+    for (int i = 1; i <= 6; ++i) {
+        const double a = i;
+        const double b = 8 - i;
+        my2 += a * a - b * b;
+        py2 += a * a + b * b;
+        mxy2 += (a - b) * (a - b);
+    }
+    EXPECT_DOUBLE_EQ(sumx2my2({x, y}, Context{}).asNumber(), my2);
+    EXPECT_DOUBLE_EQ(sumx2py2({x, y}, Context{}).asNumber(), py2);
+    EXPECT_DOUBLE_EQ(sumxmy2({x, y}, Context{}).asNumber(), mxy2);
+}
@@ -23,17 +23,16 @@ TEST(NonStdFunctionsTest, NearestDateFromArray) {
     Value nowVal = nowRes.getValue();
 
     // Build array: now-1d, now, now+2d
-    auto now_tp = nowVal.asDate();
-    auto day = std::chrono::hours(24);
-    std::vector<Value> arr = { Value(now_tp - day), Value(now_tp), Value(now_tp + day + day) };
+    double now = nowVal.asDate().serial;
+    std::vector<Value> arr = { Value(Value::DateType(now - 1)), Value(Value::DateType(now)),
+                               Value(Value::DateType(now + 2)) };
     engine.setVariable("ARR", Value(arr));
     auto res = engine.evaluate("NS_NEARESTDATE(ARR)");
     ASSERT_TRUE(res.isSuccess());
     auto v = res.getValue();
     ASSERT_TRUE(v.isDate());
     // Expect exact now
-    ASSERT_EQ(std::chrono::duration_cast<std::chrono::seconds>(v.asDate().time_since_epoch()).count(),
-              std::chrono::duration_cast<std::chrono::seconds>(now_tp.time_since_epoch()).count());
+    ASSERT_DOUBLE_EQ(now, v.asDate().serial);
 }
 
 TEST(NonStdFunctionsTest, FurthestDateFromArray) {
@@ -41,17 +40,15 @@ TEST(NonStdFunctionsTest, FurthestDateFromArray) {
     auto nowRes = engine.evaluate("NOW()");
     ASSERT_TRUE(nowRes.isSuccess());
     Value nowVal = nowRes.getValue();
-    auto now_tp = nowVal.asDate();
-    auto day = std::chrono::hours(24);
-    std::vector<Value> arr = { Value(now_tp - day * 1), Value(now_tp + day * 3) };
+    double now = nowVal.asDate().serial;
+    std::vector<Value> arr = { Value(Value::DateType(now - 1)), Value(Value::DateType(now + 3)) };
     engine.setVariable("ARR", Value(arr));
     auto res = engine.evaluate("NS_FURTHESTDATE(ARR)");
     ASSERT_TRUE(res.isSuccess());
     auto v = res.getValue();
     ASSERT_TRUE(v.isDate());
     // Furthest is +3d
-    ASSERT_EQ(std::chrono::duration_cast<std::chrono::seconds>(v.asDate().time_since_epoch()).count(),
-              std::chrono::duration_cast<std::chrono::seconds>((now_tp + day * 3).time_since_epoch()).count());
+    ASSERT_DOUBLE_EQ(now + 3, v.asDate().serial);
 }
 
 
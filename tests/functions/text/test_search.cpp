@@ -200,4 +200,19 @@ TEST_F(SearchFunctionTest, ErrorInThirdArgument_PropagatesError) {
 
     EXPECT_TRUE(result.isError());
     EXPECT_EQ(ErrorType::DIV_ZERO, result.asError());
-}
\ No newline at end of file
+}
+
+TEST_F(SearchFunctionTest, Wildcards_MatchPattern) {
+    EXPECT_DOUBLE_EQ(2.0, callSearch({Value("b*d"), Value("abcd")}).asNumber());
+    EXPECT_DOUBLE_EQ(3.0, callSearch({Value("L?O"), Value("Hello")}).asNumber());
+    EXPECT_DOUBLE_EQ(6.0, callSearch({Value("a?c"), Value("abxa-abc"), Value(2.0)}).asNumber());
+
+    auto result = callSearch({Value("x*y"), Value("abcd")});
+    EXPECT_TRUE(result.isError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, result.asError());
+}
+
+TEST_F(SearchFunctionTest, EscapedWildcards_MatchLiterally) {
+    EXPECT_DOUBLE_EQ(4.0, callSearch({Value("~?"), Value("why? yes")}).asNumber());
+    EXPECT_DOUBLE_EQ(2.0, callSearch({Value("~*"), Value("5*3")}).asNumber());
+}
@@ -34,11 +34,12 @@ TEST_F(TextFunctionTest, TooManyArguments_ReturnsError) {
     EXPECT_EQ(ErrorType::VALUE_ERROR, result.asError());
 }
 
-TEST_F(TextFunctionTest, NonNumericFirstArgument_ReturnsError) {
+TEST_F(TextFunctionTest, NonNumericFirstArgument_IsReturnedUnchanged) {
     auto result = callText({Value("abc"), Value("0.00")});
 
-    EXPECT_TRUE(result.isError());
-    EXPECT_EQ(ErrorType::VALUE_ERROR, result.asError());
+    EXPECT_TRUE(result.isText());
+    EXPECT_EQ("abc", result.asText());
+    EXPECT_EQ("abc", callText({Value("abc"), Value("yyyy-mm-dd")}).asText());
 }
 
 TEST_F(TextFunctionTest, EmptyFormatText_ReturnsError) {
@@ -87,8 +88,7 @@ TEST_F(TextFunctionTest, DateFormat_FormatsCorrectly) {
     auto result = callText({Value(45000.0), Value("MM/DD/YYYY")});
 
     EXPECT_TRUE(result.isText());
-    // Note: This is a simplified date implementation
-    EXPECT_TRUE(result.asText().find("/") != std::string::npos);
+    EXPECT_EQ("03/15/2023", result.asText());
 }
 
 TEST_F(TextFunctionTest, ZeroValue_FormatsCorrectly) {
@@ -116,7 +116,7 @@ TEST_F(TextFunctionTest, SmallDecimal_FormatsCorrectly) {
     auto result = callText({Value(0.001), Value("0.000")});
 
     EXPECT_TRUE(result.isText());
-    EXPECT_EQ("0.001000", result.asText());
+    EXPECT_EQ("0.001", result.asText());
 }
 
 TEST_F(TextFunctionTest, BooleanInput_ConvertsToNumberFirst) {
@@ -140,12 +140,11 @@ TEST_F(TextFunctionTest, ErrorInSecondArgument_PropagatesError) {
     EXPECT_EQ(ErrorType::DIV_ZERO, result.asError());
 }
 
-TEST_F(TextFunctionTest, DefaultFormat_HandlesUnknownFormat) {
+TEST_F(TextFunctionTest, UnknownFormat_ReturnsError) {
     auto result = callText({Value(123.456), Value("unknown_format")});
 
-    EXPECT_TRUE(result.isText());
-    // Should fall back to default format
-    EXPECT_TRUE(result.asText().find("123.456") != std::string::npos);
+    EXPECT_TRUE(result.isError());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, result.asError());
 }
 
 TEST_F(TextFunctionTest, HashFormat_HandlesHashFormat) {
@@ -167,4 +166,39 @@ TEST_F(TextFunctionTest, CurrencyHashFormat_HandlesCurrencyHash) {
 
     EXPECT_TRUE(result.isText());
     EXPECT_EQ("$123.45", result.asText());
-}
\ No newline at end of file
+}
+
+TEST_F(TextFunctionTest, ThousandsSeparator_GroupsDigits) {
+    auto result = callText({Value(-1234567.891), Value("$#,##0.00")});
+
+    EXPECT_TRUE(result.isText());
+    EXPECT_EQ("-$1,234,567.89", result.asText());
+}
+
+TEST_F(TextFunctionTest, DateValue_UsesCalendarFields) {
+    auto result = callText(
+            {Value(Value::DateType(45000.75)), Value("dddd, mmmm d, yyyy h:mm AM/PM")});
+
+    EXPECT_TRUE(result.isText());
+    EXPECT_EQ("Wednesday, March 15, 2023 6:00 PM", result.asText());
+}
+
+TEST_F(TextFunctionTest, Sections_PickNegativeAndZeroFormats) {
+    EXPECT_EQ("(5.00)", callText({Value(-5.0), Value("0.00;(0.00);\"zero\"")}).asText());
+    EXPECT_EQ("zero", callText({Value(0.0), Value("0.00;(0.00);\"zero\"")}).asText());
+}
+
+TEST_F(TextFunctionTest, TextValue_UsesTextSection) {
+    auto result = callText({Value("abc"), Value("0;-0;0;\"[\"@\"]\"")});
+
+    EXPECT_TRUE(result.isText());
+    EXPECT_EQ("[abc]", result.asText());
+}
+
+TEST_F(TextFunctionTest, LongResult_IsNotTruncated) {
+    auto result = callText({Value(1e200), Value("#,##0")});
+
+    EXPECT_TRUE(result.isText());
+    EXPECT_EQ(267u, result.asText().size());
+    EXPECT_EQ("100,000,000,000,000,", result.asText().substr(0, 20));
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <velox/formulas/business_calendar.h>
+#include <velox/formulas/civil_date.h>
+#include <random>
+
+using namespace xl_formula;
+using namespace xl_formula::dates;
+
+namespace {
+
+// Day-by-day reference for the counts the calendar computes in O(1)
+int64_t bruteCount(WeekendMask weekend, const std::vector<int64_t>& holidays, int64_t first,
+                   int64_t last) {
+    int64_t count = 0;
+    for (int64_t day = first; day <= last; ++day) {
+        const bool weekend_day = (weekend >> weekdayFromDays(day)) & 1u;
+        const bool holiday =
+                std::find(holidays.begin(), holidays.end(), day) != holidays.end();
+        count += !weekend_day && !holiday;
+    }
+    return count;
+}
+
+}  // namespace
+
+TEST(BusinessCalendarTest, WeekPatternWithoutHolidays) {
+    BusinessCalendar calendar(kSaturdaySunday, {});
+    const int64_t monday = daysFromCivil(2024, 1, 1);
+
+    EXPECT_TRUE(calendar.isBusinessDay(monday));
+    EXPECT_FALSE(calendar.isBusinessDay(monday + 5));
+    EXPECT_EQ(5, calendar.count(monday, monday + 6));
+    EXPECT_EQ(-5, calendar.count(monday + 6, monday));
+    EXPECT_EQ(monday + 7, calendar.advance(monday, 5));
+    EXPECT_EQ(monday - 3, calendar.advance(monday, -1));
+    EXPECT_EQ(monday + 5, calendar.advance(monday + 5, 0));
+}
+
+TEST(BusinessCalendarTest, MatchesDayByDayCountsAcrossYears) {
+    std::mt19937 random(42);
+    const int64_t origin = daysFromCivil(1995, 3, 1);
+    std::uniform_int_distribution<int64_t> offset(0, 365 * 12);
+
+    for (WeekendMask weekend : {kSaturdaySunday, WeekendMask{0x01}, WeekendMask{0x3E}}) {
+        std::vector<int64_t> holidays;
+        for (int i = 0; i < 40; ++i) {
+            holidays.push_back(origin + 365 * 2 + offset(random) / 2);
+        }
+        holidays.push_back(holidays.front());
+        BusinessCalendar calendar(weekend, holidays);
+
+        for (int trial = 0; trial < 200; ++trial) {
+            int64_t first = origin + offset(random);
+            int64_t last = origin + offset(random);
+            if (last < first) {
+                std::swap(first, last);
+            }
+            ASSERT_EQ(bruteCount(weekend, holidays, first, last), calendar.count(first, last));
+
+            const int64_t steps = static_cast<int64_t>(offset(random) % 300) + 1;
+            const int64_t forward = calendar.advance(first, steps);
+            EXPECT_TRUE(calendar.isBusinessDay(forward));
+            EXPECT_EQ(steps, bruteCount(weekend, holidays, first + 1, forward));
+            const int64_t backward = calendar.advance(last, -steps);
+            EXPECT_TRUE(calendar.isBusinessDay(backward));
+            EXPECT_EQ(steps, bruteCount(weekend, holidays, backward, last - 1));
+        }
+    }
+}
+
+TEST(BusinessCalendarTest, CacheKeysOnHolidayArrayAndWeekend) {
+    Context context;
+    Value holidays = Value::array({Value(45292.0), Value(45306.0)});
+
+    std::shared_ptr<const BusinessCalendar> first;
+    std::shared_ptr<const BusinessCalendar> second;
+    ASSERT_TRUE(getBusinessCalendar(context, kSaturdaySunday, &holidays, first).isEmpty());
+    ASSERT_TRUE(getBusinessCalendar(context, kSaturdaySunday, &holidays, second).isEmpty());
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(1u, context.getCalendarCache().size());
+
+    ASSERT_TRUE(getBusinessCalendar(context, 0x01, &holidays, second).isEmpty());
+    EXPECT_NE(first.get(), second.get());
+    EXPECT_EQ(2u, context.getCalendarCache().size());
+
+    context.clear();
+    EXPECT_EQ(0u, context.getCalendarCache().size());
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <velox/formulas/civil_date.h>
+
+using namespace xl_formula;
+using namespace xl_formula::dates;
+
+static_assert(daysFromCivil(1970, 1, 1) == 0, "epoch");
+static_assert(daysFromCivil(2000, 3, 1) == 11017, "after a leap day");
+static_assert(civilFromDays(-1).year == 1969 && civilFromDays(-1).day == 31, "before epoch");
+static_assert(weekdayFromDays(0) == 4, "1970-01-01 was a Thursday");
+
+TEST(CivilDateTest, RoundTripsEveryDayOfFourCenturies) {
+    const int64_t first = daysFromCivil(1800, 1, 1);
+    const int64_t last = daysFromCivil(2200, 12, 31);
+    for (int64_t days = first; days <= last; ++days) {
+        CivilDate date = civilFromDays(days);
+        ASSERT_EQ(days, daysFromCivil(date.year, date.month, date.day));
+        ASSERT_GE(date.day, 1u);
+        ASSERT_LE(date.day, daysInMonth(date.year, date.month));
+    }
+}
+
+TEST(CivilDateTest, LeapYears) {
+    EXPECT_TRUE(isLeapYear(2024));
+    EXPECT_TRUE(isLeapYear(2000));
+    EXPECT_FALSE(isLeapYear(1900));
+    EXPECT_FALSE(isLeapYear(2023));
+    EXPECT_EQ(29u, daysInMonth(2024, 2));
+    EXPECT_EQ(28u, daysInMonth(2100, 2));
+}
+
+TEST(CivilDateTest, OutOfRangeFieldsRollOver) {
+    EXPECT_EQ(daysFromCivil(2024, 3, 1), daysFromCivil(2024, 2, 30));
+    EXPECT_EQ(daysFromCivil(2023, 12, 31), daysFromCivil(2024, 1, 0));
+}
+
+TEST(CivilDateTest, WeekdayOfNegativeDays) {
+    EXPECT_EQ(3u, weekdayFromDays(-1));  // 1969-12-31, Wednesday
+    EXPECT_EQ(0u, weekdayFromDays(daysFromCivil(2024, 3, 31)));
+    EXPECT_EQ(1u, weekdayFromDays(daysFromCivil(1900, 1, 1)));
+}
+
+TEST(CivilDateTest, AddMonthsClampsToMonthEnd) {
+    CivilDate jan31{2024, 1, 31};
+    CivilDate feb = addMonths(jan31, 1, false);
+    EXPECT_EQ(2024, feb.year);
+    EXPECT_EQ(2u, feb.month);
+    EXPECT_EQ(29u, feb.day);
+
+    CivilDate back = addMonths(jan31, -2, false);
+    EXPECT_EQ(2023, back.year);
+    EXPECT_EQ(11u, back.month);
+    EXPECT_EQ(30u, back.day);
+
+    CivilDate end = addMonths(CivilDate{2024, 4, 10}, 0, true);
+    EXPECT_EQ(30u, end.day);
+}
+
+TEST(CivilDateTest, SplitAndMakeDate) {
+    auto date = makeDate(daysFromCivil(1969, 7, 20), 20 * 3600 + 17 * 60 + 40);
+    DateTime fields = splitDate(date);
+    EXPECT_EQ(1969, fields.date.year);
+    EXPECT_EQ(7u, fields.date.month);
+    EXPECT_EQ(20u, fields.date.day);
+    EXPECT_EQ(20u, fields.hour);
+    EXPECT_EQ(17u, fields.minute);
+    EXPECT_EQ(40u, fields.second);
+
+    std::tm tm = toTm(date);
+    EXPECT_EQ(69, tm.tm_year);
+    EXPECT_EQ(6, tm.tm_mon);
+    EXPECT_EQ(0, tm.tm_wday);
+    EXPECT_EQ(200, tm.tm_yday);
+}
+
+TEST(CivilDateTest, SerialNumbersFollowThe1900DateSystem) {
+    EXPECT_EQ(61.0, makeDate(CivilDate{1900, 3, 1}).serial);
+    EXPECT_EQ(25569.0, makeDate(CivilDate{1970, 1, 1}).serial);
+    EXPECT_EQ(45000.0, makeDate(CivilDate{2023, 3, 15}).serial);
+    EXPECT_EQ(2958465.0, makeDate(CivilDate{9999, 12, 31}).serial);
+
+    // 0.1 of a day is not exact in binary; fields round to the nearest second
+    DateTime fields = splitDate(Value::DateType(45000.1));
+    EXPECT_EQ(2u, fields.hour);
+    EXPECT_EQ(24u, fields.minute);
+    EXPECT_EQ(0u, fields.second);
+}
+
+TEST(CivilDateTest, UnixSecondsUnderUtcPolicy) {
+    auto date = makeDate(CivilDate{2001, 9, 9});
+    EXPECT_EQ(1000000000 - (1 * 3600 + 46 * 60 + 40),
+              toUnixSeconds(date, TimeZonePolicy::UTC));
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <velox/formulas/financial_utils.h>
+#include <cmath>
+#include <vector>
+
+using namespace xl_formula;
+using namespace xl_formula::financial;
+
+TEST(FinancialUtilsTest, PresentValueMatchesDiscounting) {
+    std::vector<double> flows = {-1000.0, 500.0, 400.0, 300.0, 200.0};
+    double expected = 0.0;
+    for (size_t i = 0; i < flows.size(); ++i) {
+        expected += flows[i] / std::pow(1.07, static_cast<double>(i + 1));
+    }
+    EXPECT_NEAR(expected, presentValue(NumberSpan(flows), 0.07), 1e-10);
+    EXPECT_EQ(0.0, presentValue(NumberSpan(), 0.07));
+}
+
+TEST(FinancialUtilsTest, IrrPicksTheRootNearTheGuess) {
+    // -1 + 2.3 / (1 + r) - 1.32 / (1 + r)^2 has roots at 10% and 20%
+    std::vector<double> flows = {-1.0, 2.3, -1.32};
+    auto low = solveIrr(NumberSpan(flows), 0.05);
+    ASSERT_TRUE(low.converged);
+    EXPECT_NEAR(0.1, low.rate, 1e-12);
+
+    auto high = solveIrr(NumberSpan(flows), 0.3);
+    ASSERT_TRUE(high.converged);
+    EXPECT_NEAR(0.2, high.rate, 1e-12);
+}
+
+TEST(FinancialUtilsTest, SolversReportMissingRoots) {
+    std::vector<double> positive = {1.0, 1.0, 1.0};
+    EXPECT_FALSE(solveIrr(NumberSpan(positive), 0.1).converged);
+
+    // Payment and present value of the same sign never balance
+    auto annuity = solveAnnuityRate(10.0, 1000.0, 1000.0, 0.0, 0.0, 0.01);
+    EXPECT_FALSE(annuity.converged);
+}
+
+TEST(FinancialUtilsTest, AnnuityRateHandlesZeroRate) {
+    auto result = solveAnnuityRate(10.0, -100.0, 1000.0, 0.0, 0.0, 0.0);
+    ASSERT_TRUE(result.converged);
+    EXPECT_NEAR(0.0, result.rate, 1e-12);
+}
+
+TEST(FinancialUtilsTest, BatchWarmStartMatchesColdSolves) {
+    std::vector<std::vector<double>> storage;
+    for (int k = 0; k < 50; ++k) {
+        std::vector<double> flows(20, 80.0 + k);
+        flows[0] = -1000.0;
+        storage.push_back(flows);
+    }
+    std::vector<NumberSpan> spans(storage.begin(), storage.end());
+
+    auto warm = solveIrrBatch(spans, 0.1, true);
+    auto cold = solveIrrBatch(spans, 0.1, false);
+    ASSERT_EQ(spans.size(), warm.size());
+    int warm_evaluations = 0;
+    int cold_evaluations = 0;
+    for (size_t i = 0; i < spans.size(); ++i) {
+        ASSERT_TRUE(warm[i].converged);
+        ASSERT_TRUE(cold[i].converged);
+        EXPECT_NEAR(cold[i].rate, warm[i].rate, 1e-10);
+        EXPECT_NEAR(0.0, presentValue(spans[i], warm[i].rate), 1e-8);
+        warm_evaluations += warm[i].iterations;
+        cold_evaluations += cold[i].iterations;
+    }
+    EXPECT_LT(warm_evaluations, cold_evaluations);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <velox/formulas/functions.h>
+
+using namespace xl_formula;
+using namespace xl_formula::functions::dispatcher;
+
+TEST(FunctionModulesTest, EveryBuiltinIsDispatched) {
+    for (const auto& name : get_builtin_function_names()) {
+        EXPECT_TRUE(is_builtin_function(name)) << name;
+    }
+}
+
+TEST(FunctionModulesTest, ModulesAreLinkedIntoNativeBuilds) {
+    for (auto module : {FunctionModule::TEXT, FunctionModule::DATETIME, FunctionModule::LOOKUP,
+                        FunctionModule::ENGINEERING, FunctionModule::FINANCIAL}) {
+        EXPECT_TRUE(is_function_module_loaded(module)) << function_module_name(module);
+    }
+}
+
+TEST(FunctionModulesTest, FindsModuleOfFunction) {
+    FunctionModule module;
+    ASSERT_TRUE(find_function_module("TEXT", module));
+    EXPECT_STREQ(function_module_name(module), "text");
+    ASSERT_TRUE(find_function_module("NETWORKDAYS.INTL", module));
+    EXPECT_STREQ(function_module_name(module), "datetime");
+    ASSERT_TRUE(find_function_module("XLOOKUP", module));
+    EXPECT_STREQ(function_module_name(module), "lookup");
+    ASSERT_TRUE(find_function_module("DEC2BIN", module));
+    EXPECT_STREQ(function_module_name(module), "engineering");
+    ASSERT_TRUE(find_function_module("NPV", module));
+    EXPECT_STREQ(function_module_name(module), "financial");
+}
+
+TEST(FunctionModulesTest, CoreAndUnknownNamesHaveNoModule) {
+    FunctionModule module;
+    EXPECT_FALSE(find_function_module("SUM", module));
+    EXPECT_FALSE(find_function_module("IF", module));
+    EXPECT_FALSE(find_function_module("NOT_A_FUNCTION", module));
+}
+
+TEST(FunctionModulesTest, ModuleFunctionsEvaluate) {
+    Context context;
+    auto result = dispatch_builtin_function("UPPER", {Value("abc")}, context);
+    ASSERT_TRUE(result.isText());
+    EXPECT_EQ(result.asText(), "ABC");
+    result = dispatch_builtin_function("DEC2BIN", {Value(5.0)}, context);
+    ASSERT_TRUE(result.isText());
+    EXPECT_EQ(result.asText(), "101");
+}
+
+// module_of_hash() and each <category>_module.cpp switch list the same names separately
+TEST(FunctionModulesTest, ModuleDispatchersAnswerExactlyTheirNames) {
+    const std::pair<FunctionModule, ModuleDispatch> dispatchers[] = {
+            {FunctionModule::TEXT, dispatch_text_function},
+            {FunctionModule::DATETIME, dispatch_datetime_function},
+            {FunctionModule::LOOKUP, dispatch_lookup_function},
+            {FunctionModule::ENGINEERING, dispatch_engineering_function},
+            {FunctionModule::FINANCIAL, dispatch_financial_function}};
+    Context context;
+    for (const auto& name : get_builtin_function_names()) {
+        FunctionModule owner;
+        const bool in_module = find_function_module(name, owner);
+        for (const auto& [module, dispatch] : dispatchers) {
+            const bool answers = !dispatch(name, {}, context).isEmpty();
+            EXPECT_EQ(in_module && owner == module, answers)
+                    << name << " in " << function_module_name(module);
+        }
+    }
+}
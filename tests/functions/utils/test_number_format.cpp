@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <velox/formulas/number_format.h>
+#include <string>
+
+using namespace xl_formula;
+using format::NumberFormat;
+
+class NumberFormatTest : public ::testing::Test {
+  protected:
+    std::string format(const std::string& pattern, double value) {
+        auto compiled = NumberFormat::compile(pattern);
+        EXPECT_TRUE(compiled.isValid()) << pattern;
+        char buffer[512];
+        size_t length = compiled.format(value, buffer, sizeof(buffer));
+        if (length == NumberFormat::npos) {
+            return "<npos>";
+        }
+        return std::string(buffer, length);
+    }
+};
+
+TEST_F(NumberFormatTest, DigitPlaceholders) {
+    EXPECT_EQ("123", format("0", 123.45));
+    EXPECT_EQ("00042", format("00000", 42));
+    EXPECT_EQ(".5", format("#.##", 0.5));
+    EXPECT_EQ("0.50", format("0.00", 0.5));
+    EXPECT_EQ("1.5 ", format("0.0?", 1.5));
+    EXPECT_EQ("1.01", format("0.00", 1.005));
+    EXPECT_EQ("-2", format("0", -1.5));
+    EXPECT_EQ("0", format("0", -0.4));
+}
+
+TEST_F(NumberFormatTest, ThousandsSeparatorAndScaling) {
+    EXPECT_EQ("1,234,568", format("#,##0", 1234567.8));
+    EXPECT_EQ("999", format("#,##0", 999));
+    EXPECT_EQ("1,235K", format("#,##0,\"K\"", 1234567));
+    EXPECT_EQ("1.2", format("0.0,,", 1234567));
+}
+
+TEST_F(NumberFormatTest, PercentAndScientific) {
+    EXPECT_EQ("12.5%", format("0.0%", 0.125));
+    EXPECT_EQ("1.23E+05", format("0.00E+00", 123456));
+    EXPECT_EQ("1.00E+01", format("0.00E+00", 9.999));
+    EXPECT_EQ("5.0E-03", format("0.0E+00", 0.005));
+    EXPECT_EQ("123.5E+3", format("##0.0E+0", 123456));
+}
+
+TEST_F(NumberFormatTest, LiteralsAndTags) {
+    EXPECT_EQ("USD 5.00", format("\"USD \"0.00", 5));
+    EXPECT_EQ("#5", format("\\#0", 5));
+    EXPECT_EQ("€5", format("[$€-407]0", 5));
+    EXPECT_EQ("5", format("[Red]0", 5));
+    EXPECT_EQ("5 ", format("0_)", 5));
+}
+
+TEST_F(NumberFormatTest, SectionsAndGeneral) {
+    EXPECT_EQ("(3)", format("0;(0)", -3));
+    EXPECT_EQ("-", format("0;-0;\"-\"", 0));
+    EXPECT_EQ("0.1234567891", format("General", 0.12345678912));
+    EXPECT_EQ("1234567", format("General", 1234567));
+}
+
+TEST_F(NumberFormatTest, DateAndTimeCodes) {
+    // 45000.5 is 2023-03-15 12:00, a Wednesday
+    EXPECT_EQ("2023-03-15", format("yyyy-mm-dd", 45000.5));
+    EXPECT_EQ("3/15/23", format("m/d/yy", 45000.5));
+    EXPECT_EQ("Wed 15 Mar", format("ddd d mmm", 45000.5));
+    EXPECT_EQ("M", format("mmmmm", 45000.5));
+    EXPECT_EQ("12:00:00", format("hh:mm:ss", 45000.5));
+    EXPECT_EQ("12:00 PM", format("h:mm AM/PM", 45000.5));
+    EXPECT_EQ("12:00 am", format("h:mm am/pm", 45000.0));
+    EXPECT_EQ("00:00:01.5", format("hh:mm:ss.0", 1.5 / 86400));
+    EXPECT_EQ("<npos>", format("yyyy", -1));
+}
+
+TEST_F(NumberFormatTest, InvalidFormats) {
+    EXPECT_FALSE(NumberFormat::compile("\"open").isValid());
+    EXPECT_FALSE(NumberFormat::compile("0;0;0;@;0").isValid());
+    EXPECT_FALSE(NumberFormat::compile("0.00 yyyy").isValid());
+    EXPECT_FALSE(NumberFormat::compile("[Bogus]0").isValid());
+}
+
+TEST_F(NumberFormatTest, BufferTooSmallReportsFullLength) {
+    auto compiled = NumberFormat::compile("#,##0.00");
+    char buffer[4];
+    EXPECT_EQ(12u, compiled.format(1234567.5, buffer, sizeof(buffer)));
+    EXPECT_EQ("1,23", std::string(buffer, sizeof(buffer)));
+}
+
+TEST_F(NumberFormatTest, CacheSharesCompiledFormats) {
+    auto first = NumberFormat::cached("0.00%");
+    auto second = NumberFormat::cached("0.00%");
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_NE(first.get(), NumberFormat::cached("0.0%").get());
+}
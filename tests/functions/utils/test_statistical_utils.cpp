@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <velox/formulas/statistical_utils.h>
+#include <algorithm>
+#include <vector>
+
+using namespace xl_formula;
+using namespace xl_formula::statistics;
+
+class OrderStatisticsTest : public ::testing::Test {
+  protected:
+    Context context;
+
+    static Value bigArray(size_t n) {
+        std::vector<double> numbers(n);
+        for (size_t i = 0; i < n; ++i) {
+            numbers[i] = static_cast<double>((i * 37) % n);  // a permutation of 0..n-1
+        }
+        return Value::numberArray(std::move(numbers));
+    }
+};
+
+TEST_F(OrderStatisticsTest, CollectsScalarsAndArrayNumbers) {
+    OrderStatistics data;
+    auto error = data.load(context, {Value(3.0), Value("2"), Value(true), Value::empty(),
+                                     Value::array({Value(5.0), Value("x"), Value(false)})});
+    ASSERT_TRUE(error.isEmpty());
+    // Numeric text and logicals count as arguments, but not inside arrays
+    EXPECT_EQ(4u, data.size());
+    EXPECT_DOUBLE_EQ(1.0, data.kthSmallest(0));
+    EXPECT_DOUBLE_EQ(5.0, data.kthLargest(0));
+}
+
+TEST_F(OrderStatisticsTest, PropagatesErrorsInsideArrays) {
+    OrderStatistics data;
+    auto error =
+            data.load(context, {Value::array({Value(1.0), Value::error(ErrorType::REF_ERROR)})});
+    EXPECT_EQ(ErrorType::REF_ERROR, error.asError());
+}
+
+TEST_F(OrderStatisticsTest, SelectionMatchesSortedOrder) {
+    std::vector<double> numbers = {9, -1, 4, 4, 0, 7, 3, 12, -6, 2};
+    OrderStatistics data;
+    ASSERT_TRUE(data.load(context, {Value::numberArray(numbers)}).isEmpty());
+    std::vector<double> sorted = numbers;
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t k = 0; k < sorted.size(); ++k) {
+        EXPECT_DOUBLE_EQ(sorted[k], data.kthSmallest(k));
+        EXPECT_DOUBLE_EQ(sorted[sorted.size() - 1 - k], data.kthLargest(k));
+    }
+    EXPECT_DOUBLE_EQ(3.5, data.percentile(0.5));
+    EXPECT_EQ(3u, data.countBeyond(4.0, true));
+    EXPECT_EQ(5u, data.countBeyond(4.0, false));
+}
+
+TEST_F(OrderStatisticsTest, SecondLoadOfAnArrayUsesSortedCopy) {
+    Value array = bigArray(1000);
+    OrderStatistics first;
+    ASSERT_TRUE(first.load(context, {array}).isEmpty());
+    EXPECT_FALSE(first.isSorted());
+    EXPECT_DOUBLE_EQ(499.5, first.percentile(0.5));
+
+    OrderStatistics second;
+    ASSERT_TRUE(second.load(context, {array}).isEmpty());
+    EXPECT_TRUE(second.isSorted());
+    EXPECT_DOUBLE_EQ(499.5, second.percentile(0.5));
+    EXPECT_DOUBLE_EQ(990.0, second.kthLargest(9));
+    EXPECT_DOUBLE_EQ(250.0, second.kthSmallest(250));
+    EXPECT_EQ(1u, context.getSortedArrayCache().size());
+
+    // Small arrays and multi-argument data are never cached
+    OrderStatistics small;
+    ASSERT_TRUE(small.load(context, {Value::numberArray({3, 1, 2})}).isEmpty());
+    ASSERT_TRUE(small.load(context, {Value::numberArray({3, 1, 2})}).isEmpty());
+    EXPECT_FALSE(small.isSorted());
+
+    context.clear();
+    EXPECT_EQ(0u, context.getSortedArrayCache().size());
+}
+
+TEST_F(OrderStatisticsTest, CacheDetectsReplacedArrays) {
+    SortedArrayCache cache;
+    for (int i = 0; i < 3; ++i) {
+        // A fresh array per iteration may reuse the previous one's address
+        Value array = bigArray(100);
+        NumberSpan numbers = array.asArrayData().numbers();
+        EXPECT_EQ(nullptr, cache.get(array.asArrayPtr(), numbers));
+        auto sorted = cache.get(array.asArrayPtr(), numbers);
+        ASSERT_NE(nullptr, sorted);
+        EXPECT_TRUE(std::is_sorted(sorted->begin(), sorted->end()));
+    }
+}
+
+TEST_F(OrderStatisticsTest, TallyCountsNumbersInFirstSeenOrder) {
+    NumberTable table;
+    auto nested = Value::array({Value(7.0), Value("x"), Value::numberArray({-0.0, 2.0})});
+    ASSERT_TRUE(tallyNumbers({Value(2.0), nested, Value::numberArray({0.0, 7.0, 2.0})}, table)
+                        .isEmpty());
+
+    ASSERT_EQ(3u, table.size());
+    EXPECT_EQ(2.0, table.entries()[0].key);
+    EXPECT_EQ(3u, table.entries()[0].count);
+    EXPECT_EQ(0u, table.entries()[0].first);
+    EXPECT_EQ(7.0, table.entries()[1].key);
+    EXPECT_EQ(1u, table.entries()[1].first);
+
+    // -0 and 0 tally together
+    const NumberTable::Entry* zero = table.find(0.0);
+    ASSERT_NE(nullptr, zero);
+    EXPECT_EQ(2u, zero->count);
+    EXPECT_EQ(zero, table.find(-0.0));
+    EXPECT_EQ(nullptr, table.find(5.0));
+
+    NumberTable errors;
+    auto result = tallyNumbers({Value::array({Value(1.0), Value::error(ErrorType::NA_ERROR)})},
+                               errors);
+    EXPECT_EQ(ErrorType::NA_ERROR, result.asError());
+}
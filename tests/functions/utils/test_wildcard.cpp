@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <velox/formulas/wildcard.h>
+#include <string>
+
+using namespace xl_formula;
+
+class WildcardPatternTest : public ::testing::Test {
+  protected:
+    bool matches(const std::string& pattern, const std::string& text) {
+        return WildcardPattern::compile(pattern).matches(text);
+    }
+
+    size_t find(const std::string& pattern, const std::string& text, size_t start = 0) {
+        return WildcardPattern::compile(pattern).find(text, start);
+    }
+};
+
+TEST_F(WildcardPatternTest, Matches_LiteralsAndSingleCharacter) {
+    EXPECT_TRUE(matches("abc", "abc"));
+    EXPECT_FALSE(matches("abc", "abcd"));
+    EXPECT_TRUE(matches("a?c", "abc"));
+    EXPECT_FALSE(matches("a?c", "ac"));
+    EXPECT_TRUE(matches("", ""));
+    EXPECT_FALSE(matches("", "a"));
+}
+
+TEST_F(WildcardPatternTest, Matches_StarBacktracks) {
+    // A greedy scan without backtracking rejects these
+    EXPECT_TRUE(matches("a*b*c", "axbxbxc"));
+    EXPECT_TRUE(matches("*ab", "aab"));
+    EXPECT_TRUE(matches("a*a", "aaa"));
+    EXPECT_FALSE(matches("a*b*c", "axbxbx"));
+    EXPECT_TRUE(matches("*", ""));
+    EXPECT_TRUE(matches("**?", "x"));
+}
+
+TEST_F(WildcardPatternTest, Matches_CaseInsensitive) {
+    EXPECT_TRUE(matches("APP*", "apple"));
+    EXPECT_TRUE(matches("*LE", "Apple"));
+    EXPECT_FALSE(matches("*LX", "Apple"));
+}
+
+TEST_F(WildcardPatternTest, Matches_TildeEscape) {
+    EXPECT_TRUE(matches("what~?", "what?"));
+    EXPECT_FALSE(matches("what~?", "whats"));
+    EXPECT_TRUE(matches("~*", "*"));
+    EXPECT_FALSE(matches("~*", "x"));
+    EXPECT_TRUE(matches("a~~b", "a~b"));
+    // A tilde before an ordinary character is literal
+    EXPECT_TRUE(matches("a~b", "a~b"));
+
+    EXPECT_TRUE(WildcardPattern::compile("a*").hasWildcards());
+    EXPECT_FALSE(WildcardPattern::compile("a~*").hasWildcards());
+}
+
+TEST_F(WildcardPatternTest, Matches_AdversarialInputStaysFast) {
+    std::string text(20000, 'a');
+    std::string pattern;
+    for (int i = 0; i < 20; ++i) {
+        pattern += "*a";
+    }
+    EXPECT_TRUE(matches(pattern, text));
+    EXPECT_FALSE(matches(pattern + "*b", text));
+}
+
+TEST_F(WildcardPatternTest, Find_LeftmostMatch) {
+    EXPECT_EQ(1u, find("b*d", "abcd"));
+    EXPECT_EQ(2u, find("l?o", "Hello"));
+    EXPECT_EQ(0u, find("*", "abc"));
+    EXPECT_EQ(4u, find("O", "hello world"));
+    EXPECT_EQ(7u, find("o", "hello world", 5));
+    EXPECT_EQ(std::string::npos, find("x*y", "abcd"));
+    EXPECT_EQ(std::string::npos, find("abc?", "abc"));
+}
+
+TEST_F(WildcardPatternTest, Find_PrefersEarlierStartOverEarlierEnd) {
+    // The match from 0 ends later than the one from 3, but starts first
+    EXPECT_EQ(0u, find("a*z", "abcaz"));
+    EXPECT_EQ(2u, find("?c", "abbc"));
+}
@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <cmath>
+#include <velox/formulas/array_kernels.h>
 #include <velox/formulas/evaluator.h>
 #include <velox/formulas/parser.h>
 
@@ -150,6 +152,33 @@ TEST_F(EvaluatorTest, ArithmeticErrors) {
     checkNumberResult("TRUE * FALSE", 0.0);
 }
 
+TEST_F(EvaluatorTest, DateArithmeticOnSerialNumbers) {
+    Value later = evaluateFormula("DATE(2024, 1, 31) + 30");
+    ASSERT_TRUE(later.isDate());
+    EXPECT_DOUBLE_EQ(45322.0 + 30.0, later.asDate().serial);
+    EXPECT_EQ("2024-03-01 00:00:00", later.toString());
+
+    Value earlier = evaluateFormula("DATE(2024, 3, 1) - 0.25");
+    ASSERT_TRUE(earlier.isDate());
+    EXPECT_EQ("2024-02-29 18:00:00", earlier.toString());
+
+    checkNumberResult("MONTH(1 + DATE(2024, 2, 29))", 3.0);
+    checkNumberResult("DATE(2024, 3, 1) - DATE(2023, 3, 1)", 366.0);
+    checkNumberResult("DATE(2024, 1, 1) * 1", 45292.0);
+}
+
+TEST_F(EvaluatorTest, DatesCompareWithNumbersBySerial) {
+    checkBooleanResult("DATE(2024, 1, 1) = 45292", true);
+    checkBooleanResult("45292 = DATE(2024, 1, 1)", true);
+    checkBooleanResult("DATE(2024, 1, 1) <> 45292", false);
+    checkBooleanResult("DATE(2024, 1, 1) < 45293", true);
+    checkBooleanResult("DATE(2024, 1, 1) >= 45293", false);
+    checkBooleanResult("45291.5 < DATE(2024, 1, 1)", true);
+    checkNumberResult("MATCH(45292, {1, DATE(2024, 1, 1)}, 0)", 2.0);
+    checkNumberResult("MATCH(DATE(2024, 1, 1), {1, 45292}, 0)", 2.0);
+    checkNumberResult("MATCH(45300, {1, DATE(2024, 1, 1), 45400}, 1)", 2.0);
+}
+
 TEST_F(EvaluatorTest, SumFunction) {
     checkNumberResult("SUM()", 0.0);
     checkNumberResult("SUM(1)", 1.0);
@@ -246,6 +275,154 @@ TEST_F(EvaluatorTest, FunctionErrors) {
     checkErrorResult("ABS(\"hello\")", ErrorType::VALUE_ERROR);
 }
 
+TEST_F(EvaluatorTest, ArrayBroadcasting) {
+    EXPECT_EQ(evaluateFormula("{2, 4, 6}"), evaluateFormula("{1, 2, 3} * 2"));
+    EXPECT_EQ(evaluateFormula("{9, 8, 7}"), evaluateFormula("A1 - {1, 2, 3}"));
+    EXPECT_EQ(evaluateFormula("{11, 22, 33}"), evaluateFormula("{1, 2, 3} + {A1, A2, A3}"));
+    EXPECT_EQ(evaluateFormula("{1, 4, 9}"), evaluateFormula("{1, 2, 3} ^ 2"));
+    EXPECT_EQ(evaluateFormula("{FALSE, TRUE, TRUE}"), evaluateFormula("{1, 2, 3} >= 2"));
+    EXPECT_EQ(evaluateFormula("{TRUE, FALSE}"), evaluateFormula("{1, 2} = {1, 3}"));
+
+    // A single-element array behaves like a scalar
+    EXPECT_EQ(evaluateFormula("{5, 6}"), evaluateFormula("{4} + {1, 2}"));
+}
+
+TEST_F(EvaluatorTest, ArrayBroadcastingPerElementErrors) {
+    Value result = evaluateFormula("{1, 2, 3} / {1, 0, 3}");
+    ASSERT_TRUE(result.isArray());
+    ASSERT_EQ(3u, result.asArray().size());
+    EXPECT_DOUBLE_EQ(1.0, result.asArray()[0].asNumber());
+    EXPECT_EQ(ErrorType::DIV_ZERO, result.asArray()[1].asError());
+    EXPECT_DOUBLE_EQ(1.0, result.asArray()[2].asNumber());
+
+    // Mismatched lengths pad with #N/A
+    result = evaluateFormula("{1, 2, 3} + {10, 20}");
+    ASSERT_EQ(3u, result.asArray().size());
+    EXPECT_DOUBLE_EQ(22.0, result.asArray()[1].asNumber());
+    EXPECT_EQ(ErrorType::NA_ERROR, result.asArray()[2].asError());
+
+    // Non-numeric elements take the scalar path
+    result = evaluateFormula("{1, \"x\", TRUE} + 1");
+    EXPECT_DOUBLE_EQ(2.0, result.asArray()[0].asNumber());
+    EXPECT_EQ(ErrorType::VALUE_ERROR, result.asArray()[1].asError());
+    EXPECT_DOUBLE_EQ(2.0, result.asArray()[2].asNumber());
+
+    result = evaluateFormula("{-1, 4} ^ 0.5");
+    EXPECT_EQ(ErrorType::NUM_ERROR, result.asArray()[0].asError());
+    EXPECT_DOUBLE_EQ(2.0, result.asArray()[1].asNumber());
+
+    EXPECT_EQ(evaluateFormula("{\"a1\", \"a2\"}"), evaluateFormula("\"a\" & {1, 2}"));
+}
+
+TEST_F(EvaluatorTest, ArrayKernelsMatchScalarSemantics) {
+    // Odd length exercises both the vector body and the scalar tail
+    const size_t n = 1001;
+    std::vector<double> a(n);
+    std::vector<double> b(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = static_cast<double>(i) * 0.5 - 100.0;
+        b[i] = static_cast<double>(n - i) * 0.25;
+    }
+    std::vector<double> out(n);
+    using Op = BinaryOpNode::Operator;
+    kernels::binaryArrayArray(Op::DIVIDE, a.data(), b.data(), out.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_DOUBLE_EQ(a[i] / b[i], out[i]) << i;
+    }
+    kernels::binaryArrayScalar(Op::LESS_EQUAL, a.data(), 0.0, out.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(a[i] <= 0.0 ? 1.0 : 0.0, out[i]) << i;
+    }
+    kernels::binaryScalarArray(Op::SUBTRACT, 1.0, b.data(), out.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_DOUBLE_EQ(1.0 - b[i], out[i]) << i;
+    }
+}
+
+TEST_F(EvaluatorTest, MomentKernelsMatchTwoPassAndStayStable) {
+    // Several blocks plus a partial one, offset far from zero where sum-of-squares fails
+    const size_t n = 1000;
+    std::vector<double> x(n);
+    std::vector<double> y(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = 1e9 + static_cast<double>(i % 7);
+        y[i] = -1e9 + 2.0 * static_cast<double>(i % 7) + static_cast<double>(i % 3);
+    }
+    double mx = 0.0;
+    double my = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        mx += (x[i] - 1e9) / n;
+        my += (y[i] + 1e9) / n;
+    }
+    double sxx = 0.0;
+    double syy = 0.0;
+    double sxy = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const double dx = x[i] - 1e9 - mx;
+        const double dy = y[i] + 1e9 - my;
+        sxx += dx * dx;
+        syy += dy * dy;
+        sxy += dx * dy;
+    }
+
+    auto m = kernels::moments(x.data(), n);
+    EXPECT_EQ(n, m.count);
+    EXPECT_NEAR(1e9 + mx, m.mean, 1e-6);
+    EXPECT_NEAR(sxx, m.m2, sxx * 1e-9);
+
+    auto c = kernels::coMoments(x.data(), y.data(), n);
+    EXPECT_EQ(n, c.count);
+    EXPECT_NEAR(sxx, c.m2_x, sxx * 1e-9);
+    EXPECT_NEAR(syy, c.m2_y, syy * 1e-9);
+    EXPECT_NEAR(sxy, c.c_xy, sxy * 1e-9);
+
+    EXPECT_EQ(0u, kernels::moments(x.data(), 0).count);
+}
+
+TEST_F(EvaluatorTest, SumKernelsMatchScalarLoopsAndCompensate) {
+    // Small integers sum exactly, so every mode must agree with the scalar loops; the odd
+    // length exercises the tails after the unrolled vector loops
+    const size_t n = 37;
+    std::vector<double> x(n);
+    std::vector<double> y(n);
+    double sum = 0.0;
+    double squares = 0.0;
+    double dot = 0.0;
+    double diff2 = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = static_cast<double>(i % 5) - 2.0;
+        y[i] = static_cast<double>(i % 3) + 1.0;
+        sum += x[i];
+        squares += x[i] * x[i];
+        dot += x[i] * y[i];
+        diff2 += (x[i] - y[i]) * (x[i] - y[i]);
+    }
+    for (auto mode : {kernels::Summation::FAST, kernels::Summation::COMPENSATED}) {
+        EXPECT_EQ(sum, kernels::sum(x.data(), n, mode));
+        EXPECT_EQ(squares, kernels::sumSquares(x.data(), n, mode));
+        EXPECT_EQ(dot, kernels::dotProduct(x.data(), y.data(), n, mode));
+        EXPECT_EQ(diff2,
+                  kernels::sumPairs(x.data(), y.data(), n, kernels::PairTerm::X_MINUS_Y_SQUARED,
+                                    mode));
+        EXPECT_EQ(0.0, kernels::sum(x.data(), 0, mode));
+    }
+    EXPECT_EQ(squares - kernels::sumSquares(y.data(), n, kernels::Summation::FAST),
+              kernels::sumPairs(x.data(), y.data(), n, kernels::PairTerm::X2_MINUS_Y2,
+                                kernels::Summation::FAST));
+
+    // Ones added to 1e16 are below its rounding step; only compensation keeps them
+    std::vector<double> values(1001, 1.0);
+    values[0] = 1e16;
+    EXPECT_EQ(1e16 + 1000.0, kernels::sum(values.data(), values.size(),
+                                          kernels::Summation::COMPENSATED));
+
+    kernels::SumAccumulator neumaier(kernels::Summation::COMPENSATED);
+    for (double v : {1.0, 1e100, 1.0, -1e100}) {
+        neumaier.add(v);
+    }
+    EXPECT_EQ(2.0, neumaier.total());
+}
+
 class FormulaEngineTest : public ::testing::Test {
   protected:
     FormulaEngine engine;
@@ -282,6 +459,23 @@ TEST_F(FormulaEngineTest, VariableManagement) {
     EXPECT_TRUE(nonexistent.isEmpty());
 }
 
+TEST_F(FormulaEngineTest, GetVariablesWritesNumbers) {
+    engine.setVariable("flag", Value(true));
+    const std::vector<std::string> names{"A2", "text", "flag", "missing", "A1"};
+    std::vector<double> out(names.size());
+
+    EXPECT_EQ(2u, engine.getVariables(names, out.data()));
+    EXPECT_DOUBLE_EQ(20.0, out[0]);
+    EXPECT_TRUE(std::isnan(out[1]));
+    EXPECT_DOUBLE_EQ(1.0, out[2]);
+    EXPECT_TRUE(std::isnan(out[3]));
+    EXPECT_DOUBLE_EQ(10.0, out[4]);
+
+    ASSERT_NE(nullptr, engine.findVariable("text"));
+    EXPECT_EQ("Hello", engine.findVariable("text")->asText());
+    EXPECT_EQ(nullptr, engine.findVariable("missing"));
+}
+
 TEST_F(FormulaEngineTest, CustomFunction) {
     // Register a simple DOUBLE function
     engine.registerFunction("DOUBLE",
@@ -44,6 +44,7 @@ TEST_F(LexerTest, Identifiers) {
     tokenizeAndCheck("A1", {TokenType::IDENTIFIER});
     tokenizeAndCheck("SUM", {TokenType::IDENTIFIER});
     tokenizeAndCheck("my_var", {TokenType::IDENTIFIER});
+    tokenizeAndCheck("WORKDAY.INTL", {TokenType::IDENTIFIER});
 }
 
 TEST_F(LexerTest, Operators) {
@@ -194,4 +195,37 @@ TEST_F(ParserTest, WhitespaceHandling) {
     parseAndCheckSuccess("  1  +  2  ");
     parseAndCheckSuccess("\t1\n+\r2\r\n");
     parseAndCheckSuccess("SUM( 1 , 2 , 3 )");
-}
\ No newline at end of file
+}
+
+TEST(FormulaReferencesTest, CollectsVariablesAndFunctions) {
+    Parser parser;
+    auto result = parser.parse("IF(price > 10, round(price * qty, 2), SUM(qty, bonus))");
+    ASSERT_TRUE(result.isSuccess());
+
+    const auto& refs = result.getReferences();
+    EXPECT_EQ((std::vector<std::string>{"price", "qty", "bonus"}), refs.variables);
+    EXPECT_EQ((std::vector<std::string>{"IF", "ROUND", "SUM"}), refs.functions);
+    EXPECT_FALSE(refs.is_volatile);
+    EXPECT_TRUE(refs.is_pure);
+    EXPECT_TRUE(refs.referencesVariable("qty"));
+    EXPECT_FALSE(refs.referencesVariable("QTY"));
+    EXPECT_TRUE(refs.callsFunction("Round"));
+}
+
+TEST(FormulaReferencesTest, VolatileAndCustomFunctions) {
+    Parser parser;
+    auto result = parser.parse("{1, x, TODAY()}");
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_EQ((std::vector<std::string>{"x"}), result.getReferences().variables);
+    EXPECT_TRUE(result.getReferences().is_volatile);
+    EXPECT_FALSE(result.getReferences().is_pure);
+
+    result = parser.parse("MY_CUSTOM(1) + 2");
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_FALSE(result.getReferences().is_volatile);
+    EXPECT_FALSE(result.getReferences().is_pure);
+
+    result = parser.parse("1 +");
+    EXPECT_FALSE(result.isSuccess());
+    EXPECT_TRUE(result.getReferences().variables.empty());
+}
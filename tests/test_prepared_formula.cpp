@@ -0,0 +1,282 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <velox/formulas/xl-formula.h>
+
+using namespace xl_formula;
+
+class PreparedFormulaTest : public ::testing::Test {
+  protected:
+    FormulaEngine engine;
+
+    void SetUp() override {
+        engine.setVariable("A", Value(6.0));
+        engine.setVariable("B", Value(4.0));
+        engine.setVariable("C", Value(2.0));
+        engine.setVariable("name", Value("Velox"));
+    }
+};
+
+TEST_F(PreparedFormulaTest, PrepareAndEvaluate) {
+    auto prepared = engine.prepare("A * B + C");
+    ASSERT_TRUE(prepared.isSuccess());
+    EXPECT_EQ("A * B + C", prepared.getFormula());
+
+    auto result = engine.evaluate(prepared);
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_DOUBLE_EQ(26.0, result.getValue().asNumber());
+
+    // Prepared formulas observe context changes
+    engine.setVariable("C", Value(10.0));
+    EXPECT_DOUBLE_EQ(34.0, engine.evaluate(prepared).getValue().asNumber());
+}
+
+TEST_F(PreparedFormulaTest, ParseErrorIsReported) {
+    auto prepared = engine.prepare("A * (B + ");
+    EXPECT_FALSE(prepared.isSuccess());
+    EXPECT_FALSE(prepared.getErrors().empty());
+
+    auto result = engine.evaluate(prepared);
+    EXPECT_FALSE(result.isSuccess());
+    EXPECT_EQ(ErrorType::PARSE_ERROR, result.getValue().asError());
+}
+
+TEST_F(PreparedFormulaTest, RepeatedSubexpressionsAreShared) {
+    auto prepared = engine.prepare("IF((A*B)/C > 10, (A*B)/C, (A*B)/C + 1)");
+    ASSERT_TRUE(prepared.isSuccess());
+    // (A*B)/C and its child A*B
+    EXPECT_EQ(2u, prepared.getSharedSubexpressionCount());
+
+    auto result = engine.evaluate(prepared);
+    ASSERT_TRUE(result.isSuccess());
+    EXPECT_DOUBLE_EQ(12.0, result.getValue().asNumber());
+}
+
+TEST_F(PreparedFormulaTest, StructuralMatchIgnoresFunctionNameCase) {
+    auto prepared = engine.prepare("sum(A, B) + SUM(A, B)");
+    EXPECT_EQ(1u, prepared.getSharedSubexpressionCount());
+    EXPECT_DOUBLE_EQ(20.0, engine.evaluate(prepared).getValue().asNumber());
+}
+
+TEST_F(PreparedFormulaTest, LeavesAndDistinctSubtreesAreNotShared) {
+    EXPECT_EQ(0u, engine.prepare("A + A + B").getSharedSubexpressionCount());
+    EXPECT_EQ(0u, engine.prepare("A * B + B * A").getSharedSubexpressionCount());
+    EXPECT_EQ(0u, engine.prepare("(A - 1) + (A - \"1\")").getSharedSubexpressionCount());
+}
+
+TEST_F(PreparedFormulaTest, VolatileAndCustomFunctionsAreNotShared) {
+    EXPECT_EQ(0u, engine.prepare("RAND() + RAND()").getSharedSubexpressionCount());
+    EXPECT_EQ(0u, engine.prepare("A * NOW() + A * NOW()").getSharedSubexpressionCount());
+
+    int calls = 0;
+    engine.registerFunction("COUNTER", [&calls](const std::vector<Value>&, const Context&) {
+        return Value(static_cast<double>(++calls));
+    });
+    auto prepared = engine.prepare("COUNTER() + COUNTER()");
+    EXPECT_EQ(0u, prepared.getSharedSubexpressionCount());
+    EXPECT_DOUBLE_EQ(3.0, engine.evaluate(prepared).getValue().asNumber());
+    EXPECT_EQ(2, calls);
+}
+
+TEST_F(PreparedFormulaTest, SharedErrorsPropagate) {
+    engine.setVariable("C", Value(0.0));
+    auto prepared = engine.prepare("IFERROR(A / C, -1) + IFERROR(A / C, -1)");
+    // A / C and the IFERROR call (-1 is folded to a literal)
+    EXPECT_EQ(2u, prepared.getSharedSubexpressionCount());
+    EXPECT_DOUBLE_EQ(-2.0, engine.evaluate(prepared).getValue().asNumber());
+}
+
+TEST_F(PreparedFormulaTest, BatchSharesAcrossFormulas) {
+    auto batch = engine.prepareBatch({"(A*B)/C + 1", "(A*B)/C * 2", "LEN(name)", "A +"});
+    ASSERT_EQ(4u, batch.size());
+    EXPECT_EQ(0u, batch[0].getSharedSubexpressionCount());
+    EXPECT_EQ(2u, batch.getSharedSubexpressionCount());
+
+    auto results = engine.evaluateBatch(batch);
+    ASSERT_EQ(4u, results.size());
+    EXPECT_DOUBLE_EQ(13.0, results[0].getValue().asNumber());
+    EXPECT_DOUBLE_EQ(24.0, results[1].getValue().asNumber());
+    EXPECT_DOUBLE_EQ(5.0, results[2].getValue().asNumber());
+    EXPECT_FALSE(results[3].isSuccess());
+
+    // A new batch evaluation recomputes shared values from the current context
+    engine.setVariable("C", Value(3.0));
+    results = engine.evaluateBatch(batch);
+    EXPECT_DOUBLE_EQ(9.0, results[0].getValue().asNumber());
+    EXPECT_DOUBLE_EQ(16.0, results[1].getValue().asNumber());
+}
+
+TEST_F(PreparedFormulaTest, MatchesUnpreparedEvaluation) {
+    const std::vector<std::string> formulas = {
+            "SUM(A, B, C) * SUM(A, B, C) - MAX(A, B)",
+            "IF(A > B, CONCATENATE(name, \"!\"), CONCATENATE(name, \"!\"))",
+            "{1, 2, 3} = {1, 2, 3}",
+            "-(A ^ 2) + -(A ^ 2)",
+            "ROUND(A / 7, 2) & \"-\" & ROUND(A / 7, 2)",
+    };
+    for (const auto& formula : formulas) {
+        auto expected = engine.evaluate(formula);
+        auto actual = engine.evaluate(engine.prepare(formula));
+        EXPECT_EQ(expected.isSuccess(), actual.isSuccess()) << formula;
+        EXPECT_EQ(expected.getValue(), actual.getValue()) << formula;
+    }
+}
+
+TEST_F(PreparedFormulaTest, PrepareFoldsConstantSubexpressions) {
+    auto prepared = engine.prepare("2 * 3 + SUM(1, 2, 3)");
+    EXPECT_TRUE(prepared.isConstant());
+    EXPECT_DOUBLE_EQ(12.0, engine.evaluate(prepared).getValue().asNumber());
+
+    prepared = engine.prepare("A * (2 + 3)");
+    EXPECT_FALSE(prepared.isConstant());
+    EXPECT_EQ("BinaryOp(*, Variable(A), Literal(5))", prepared.getAST()->toString());
+
+    // Errors fold like any other value
+    prepared = engine.prepare("1 / 0");
+    EXPECT_TRUE(prepared.isConstant());
+    EXPECT_EQ(ErrorType::DIV_ZERO, engine.evaluate(prepared).getValue().asError());
+
+    // Volatile calls are left in place
+    EXPECT_FALSE(engine.prepare("RAND() * 0").isConstant());
+}
+
+TEST_F(PreparedFormulaTest, SpecializeSubstitutesKnownVariables) {
+    auto prepared = engine.prepare("income * rate + MAX(floor, 300) - deduction");
+    auto residual = engine.specialize(
+            prepared, {{"rate", Value(0.25)}, {"floor", Value(100.0)}, {"deduction", Value(50.0)}});
+    ASSERT_TRUE(residual.isSuccess());
+    EXPECT_FALSE(residual.isConstant());
+    EXPECT_EQ(
+            "BinaryOp(-, BinaryOp(+, BinaryOp(*, Variable(income), Literal(0.25)), "
+            "Literal(300)), Literal(50))",
+            residual.getAST()->toString());
+
+    engine.setVariable("income", Value(1000.0));
+    EXPECT_DOUBLE_EQ(500.0, engine.evaluate(residual).getValue().asNumber());
+
+    // The original prepared formula is unchanged
+    engine.setVariable("rate", Value(0.5));
+    engine.setVariable("floor", Value(400.0));
+    engine.setVariable("deduction", Value(0.0));
+    EXPECT_DOUBLE_EQ(900.0, engine.evaluate(prepared).getValue().asNumber());
+}
+
+TEST_F(PreparedFormulaTest, SpecializeToConstant) {
+    auto prepared = engine.prepare("IF(x > 10, \"high\", \"low\")");
+    auto residual = engine.specialize(prepared, {{"x", Value(42.0)}});
+    EXPECT_TRUE(residual.isConstant());
+    EXPECT_EQ("high", engine.evaluate(residual).getValue().asText());
+
+    // Unset values behave like missing variables
+    residual = engine.specialize(prepared, {{"x", Value::empty()}});
+    EXPECT_EQ(ErrorType::NAME_ERROR, engine.evaluate(residual).getValue().asError());
+}
+
+TEST_F(PreparedFormulaTest, SpecializeKeepsCustomFunctions) {
+    engine.registerFunction("TWICE", [](const std::vector<Value>& args, const Context&) {
+        return Value(args[0].toNumber() * 2);
+    });
+    auto residual = engine.specialize(engine.prepare("TWICE(k) + A"), {{"k", Value(5.0)}});
+    EXPECT_EQ("BinaryOp(+, FunctionCall(TWICE, [Literal(5)]), Variable(A))",
+              residual.getAST()->toString());
+    EXPECT_DOUBLE_EQ(16.0, engine.evaluate(residual).getValue().asNumber());
+}
+
+TEST_F(PreparedFormulaTest, ReferencesReflectResidualFormula) {
+    auto prepared = engine.prepare("income * rate + ROUND(bonus, 0)");
+    EXPECT_EQ((std::vector<std::string>{"income", "rate", "bonus"}),
+              prepared.getReferences().variables);
+
+    auto residual = engine.specialize(prepared, {{"rate", Value(0.2)}, {"bonus", Value(9.6)}});
+    EXPECT_EQ((std::vector<std::string>{"income"}), residual.getReferences().variables);
+    EXPECT_TRUE(residual.getReferences().functions.empty());
+}
+
+TEST_F(PreparedFormulaTest, EvaluateColumnsBindsOneRowAtATime) {
+    auto prepared = engine.prepare("IF((X*Y)/C > 10, (X*Y)/C, 0) + A");
+    ASSERT_TRUE(prepared.isSuccess());
+
+    const std::vector<double> x = {1.0, 10.0, 6.0};
+    const std::vector<double> y = {2.0, 4.0, 5.0};
+    std::vector<double> out(3);
+    size_t non_numeric =
+            engine.evaluateColumns(prepared, {"X", "Y"}, {x.data(), y.data()}, 3, out.data());
+
+    EXPECT_EQ(0u, non_numeric);
+    EXPECT_DOUBLE_EQ(6.0, out[0]);
+    EXPECT_DOUBLE_EQ(26.0, out[1]);
+    EXPECT_DOUBLE_EQ(21.0, out[2]);
+
+    // Column variables are not left behind in the context
+    EXPECT_FALSE(engine.getContext().hasVariable("X"));
+    EXPECT_FALSE(engine.getContext().hasVariable("Y"));
+}
+
+TEST_F(PreparedFormulaTest, EvaluateColumnsWritesNaNForNonNumericResults) {
+    auto prepared = engine.prepare("IF(A > 0, 1 / A, \"none\")");
+    const std::vector<double> a = {4.0, 0.0, -1.0};
+    std::vector<double> out(3);
+    size_t non_numeric = engine.evaluateColumns(prepared, {"A"}, {a.data()}, 3, out.data());
+
+    EXPECT_EQ(2u, non_numeric);
+    EXPECT_DOUBLE_EQ(0.25, out[0]);
+    EXPECT_TRUE(std::isnan(out[1]));
+    EXPECT_TRUE(std::isnan(out[2]));
+
+    // A existed before the call and keeps its value
+    EXPECT_DOUBLE_EQ(6.0, engine.getVariable("A").asNumber());
+
+    auto broken = engine.prepare("A +");
+    EXPECT_EQ(3u, engine.evaluateColumns(broken, {"A"}, {a.data()}, 3, out.data()));
+    EXPECT_TRUE(std::isnan(out[0]));
+}
+
+TEST_F(PreparedFormulaTest, EvaluateColumnsReportsRowErrors) {
+    auto prepared = engine.prepare("IF(A > 0, 1 / A, IF(A = 0, 1 / A, \"none\"))");
+    const std::vector<double> a = {4.0, 0.0, -1.0};
+    std::vector<double> out(3);
+    std::vector<ErrorType> errors(3);
+    EXPECT_EQ(2u, engine.evaluateColumns(prepared, {"A"}, {a.data()}, 3, out.data(), 1,
+                                         errors.data()));
+    EXPECT_EQ(ErrorType::NONE, errors[0]);
+    EXPECT_EQ(ErrorType::DIV_ZERO, errors[1]);
+    // Text is not an error, only not a number
+    EXPECT_EQ(ErrorType::NONE, errors[2]);
+    EXPECT_TRUE(std::isnan(out[2]));
+
+    auto broken = engine.prepare("A +");
+    engine.evaluateColumns(broken, {"A"}, {a.data()}, 3, out.data(), 1, errors.data());
+    EXPECT_EQ(ErrorType::PARSE_ERROR, errors[0]);
+    EXPECT_EQ(ErrorType::PARSE_ERROR, errors[2]);
+}
+
+TEST_F(PreparedFormulaTest, EvaluateColumnsAcrossThreadsMatchesSingleThread) {
+    engine.setVariable("T", engine.evaluate("{{0, 10}, {1, 20}, {2, 30}}").getValue());
+    auto prepared = engine.prepare(
+            "IF(MOD(X, 7) = 0, \"skip\", X * A + VLOOKUP(MOD(X, 3), T, 2, FALSE))");
+    ASSERT_TRUE(prepared.isSuccess());
+
+    const size_t rows = 4 * FormulaEngine::kMinRowsPerThread + 17;
+    std::vector<double> x(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        x[i] = static_cast<double>(i);
+    }
+    std::vector<double> serial(rows);
+    std::vector<double> parallel(rows);
+    size_t serial_non_numeric =
+            engine.evaluateColumns(prepared, {"X"}, {x.data()}, rows, serial.data());
+    size_t parallel_non_numeric =
+            engine.evaluateColumns(prepared, {"X"}, {x.data()}, rows, parallel.data(), 4);
+
+    EXPECT_EQ((rows + 6) / 7, serial_non_numeric);
+    EXPECT_EQ(serial_non_numeric, parallel_non_numeric);
+    for (size_t i = 0; i < rows; ++i) {
+        if (std::isnan(serial[i])) {
+            EXPECT_TRUE(std::isnan(parallel[i])) << "row " << i;
+        } else {
+            EXPECT_DOUBLE_EQ(serial[i], parallel[i]) << "row " << i;
+        }
+    }
+    // Workers evaluate against copies; the engine's variables are untouched
+    EXPECT_FALSE(engine.getContext().hasVariable("X"));
+    EXPECT_DOUBLE_EQ(6.0, engine.getVariable("A").asNumber());
+}
@@ -62,6 +62,23 @@ TEST_F(ValueTest, BooleanConstructorAndAccessors) {
     EXPECT_EQ("FALSE", boolean_false.toString());
 }
 
+TEST_F(ValueTest, DateIsAnExcelSerialNumber) {
+    Value date(Value::DateType(45000.5));
+
+    EXPECT_TRUE(date.isDate());
+    EXPECT_FALSE(date.isNumber());
+    EXPECT_EQ(ValueType::DATE, date.getType());
+    EXPECT_DOUBLE_EQ(45000.5, date.asDate().serial);
+    EXPECT_TRUE(date.canConvertToNumber());
+    EXPECT_DOUBLE_EQ(45000.5, date.toNumber());
+    EXPECT_EQ("2023-03-15 12:00:00", date.toString());
+    EXPECT_TRUE(Value(Value::DateType(1.0)) < date);
+    EXPECT_TRUE(date == Value(45000.5));
+    EXPECT_TRUE(Value(45000.0) < date);
+    EXPECT_FALSE(date < Value(45000.5));
+    EXPECT_TRUE(date < Value("text"));
+}
+
 TEST_F(ValueTest, ErrorConstructorAndAccessors) {
     Value error(ErrorType::DIV_ZERO);
 
@@ -138,6 +155,37 @@ TEST_F(ValueTest, StaticFactoryMethods) {
     EXPECT_TRUE(empty.isEmpty());
 }
 
+TEST_F(ValueTest, ArrayStorageIsPackedForNumbers) {
+    Value numbers = Value::array({Value(1.0), Value(2.0), Value(3.0)});
+    const ArrayData& data = numbers.asArrayData();
+    EXPECT_EQ(ArrayData::Storage::NUMERIC, data.getStorage());
+    ASSERT_EQ(3u, data.numbers().size());
+    EXPECT_DOUBLE_EQ(2.0, data.numbers()[1]);
+    EXPECT_EQ("{1, 2, 3}", numbers.toString());
+
+    // The Value view is still available and matches
+    ASSERT_EQ(3u, numbers.asArray().size());
+    EXPECT_DOUBLE_EQ(3.0, numbers.asArray()[2].asNumber());
+    EXPECT_EQ(numbers, Value::numberArray({1.0, 2.0, 3.0}));
+}
+
+TEST_F(ValueTest, ArrayStorageMasksErrorsAndEmpties) {
+    Value masked = Value::array({Value(1.0), Value::error(ErrorType::NA_ERROR), Value::empty()});
+    const ArrayData& data = masked.asArrayData();
+    EXPECT_EQ(ArrayData::Storage::MASKED, data.getStorage());
+    EXPECT_FALSE(data.isNumeric());
+    EXPECT_TRUE(data.numbers().empty());
+    EXPECT_DOUBLE_EQ(1.0, data.at(0).asNumber());
+    EXPECT_EQ(ErrorType::NA_ERROR, data.at(1).asError());
+    EXPECT_TRUE(data.at(2).isEmpty());
+    EXPECT_TRUE(masked.asArray()[2].isEmpty());
+
+    Value mixed = Value::array({Value(1.0), Value("text"), Value(true)});
+    EXPECT_EQ(ArrayData::Storage::GENERIC, mixed.asArrayData().getStorage());
+    EXPECT_EQ("text", mixed.asArrayData().at(1).asText());
+    EXPECT_NE(mixed, masked);
+}
+
 class ContextTest : public ::testing::Test {
   protected:
     Context context;
@@ -171,6 +219,20 @@ TEST_F(ContextTest, SetAndGetVariable) {
     EXPECT_TRUE(b1.isEmpty());
 }
 
+TEST_F(ContextTest, FindVariableReturnsStoredValue) {
+    const Context& const_context = context;
+    const Value* a2 = const_context.findVariable("A2");
+    ASSERT_NE(nullptr, a2);
+    EXPECT_EQ("Hello", a2->asText());
+    EXPECT_EQ(nullptr, const_context.findVariable("B1"));
+
+    // The non-const lookup updates the binding in place
+    Value* a1 = context.findVariable("A1");
+    ASSERT_NE(nullptr, a1);
+    *a1 = Value(42.0);
+    EXPECT_DOUBLE_EQ(42.0, context.getVariable("A1").asNumber());
+}
+
 TEST_F(ContextTest, RemoveVariable) {
     EXPECT_TRUE(context.hasVariable("A1"));
 